@@ -313,6 +313,55 @@ public:
 		_check_for_collisions();
 	}
 
+	// Two stage alternative to update(), allowing the pairing culls of the changed items
+	// to run on several threads. Call update_tree(), then cull_changed_item() once for every
+	// index below get_changed_item_count(), then update_collisions_culled() to send the pair
+	// callbacks. cull_changed_item() only reads from the tree and can run concurrently, but
+	// nothing else may be called on the BVH until update_collisions_culled().
+	void update_tree() {
+		BVH_LOCKED_FUNCTION
+		tree.update();
+#ifdef BVH_INTEGRITY_CHECKS
+		tree._integrity_check_all();
+#endif
+
+		// Only ever grow, so the hit lists keep their capacity between updates.
+		if (changed_item_hits.size() < changed_items.size()) {
+			changed_item_hits.resize(changed_items.size());
+		}
+	}
+
+	uint32_t get_changed_item_count() const {
+		return changed_items.size();
+	}
+
+	void cull_changed_item(uint32_t p_index) {
+		DEV_ASSERT(p_index < changed_items.size() && p_index < changed_item_hits.size());
+		const BVHHandle &h = changed_items[p_index];
+
+		typename BVHTREE_CLASS::CullParams params;
+		tree.item_fill_cullparams(h, params);
+
+		// use the expanded aabb for pairing
+		params.abb.from(tree._pairs[h.id()].expanded_aabb);
+
+		tree.cull_aabb_to(params, changed_item_hits[p_index]);
+	}
+
+	void update_collisions_culled() {
+		BVH_LOCKED_FUNCTION
+		for (uint32_t n = 0; n < changed_items.size(); n++) {
+			const BVHHandle &h = changed_items[n];
+
+			BVHABB_CLASS abb;
+			abb.from(tree._pairs[h.id()].expanded_aabb);
+
+			_find_leavers(h, abb, false);
+			_collide_hits(h, changed_item_hits[n]);
+		}
+		_reset();
+	}
+
 	// prefer calling this directly as type safe
 	void set_tree(const BVHHandle &p_handle, uint32_t p_tree_id, uint32_t p_tree_collision_mask, bool p_force_collision_check = true) {
 		DEV_ASSERT(!p_handle.is_invalid());
@@ -455,28 +504,32 @@ private:
 			// paired, and send callbacks
 			_find_leavers(h, abb, p_full_check);
 
-			uint32_t changed_item_ref_id = h.id();
-
 			params.abb = abb;
 
 			params.result_count_overall = 0; // might not be needed
 			tree.cull_aabb(params, false);
 
-			for (const uint32_t ref_id : tree._cull_hits) {
-				// don't collide against ourself
-				if (ref_id == changed_item_ref_id) {
-					continue;
-				}
+			_collide_hits(h, tree._cull_hits);
+		}
+		_reset();
+	}
 
-				// checkmasks is already done in the cull routine.
-				BVHHandle h_collidee;
-				h_collidee.set_id(ref_id);
+	void _collide_hits(BVHHandle p_handle, const LocalVector<uint32_t> &p_hits) {
+		uint32_t changed_item_ref_id = p_handle.id();
 
-				// find NEW enterers, and send callbacks for them only
-				_collide(h, h_collidee);
+		for (const uint32_t ref_id : p_hits) {
+			// don't collide against ourself
+			if (ref_id == changed_item_ref_id) {
+				continue;
 			}
+
+			// checkmasks is already done in the cull routine.
+			BVHHandle h_collidee;
+			h_collidee.set_id(ref_id);
+
+			// find NEW enterers, and send callbacks for them only
+			_collide(p_handle, h_collidee);
 		}
-		_reset();
 	}
 
 public:
@@ -770,6 +823,8 @@ private:
 	// for collision pairing,
 	// maintain a list of all items moved etc on each frame / tick
 	LocalVector<BVHHandle> changed_items;
+	// Per changed item results of cull_changed_item().
+	LocalVector<LocalVector<uint32_t>> changed_item_hits;
 	uint32_t _tick = 1; // Start from 1 so items with 0 indicate never updated.
 
 	class BVHLockedFunction {
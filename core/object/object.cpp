@@ -39,6 +39,7 @@
 #include "core/string/print_string.h"
 #include "core/string/translation_server.h"
 #include "core/variant/typed_array.h"
+#include "core/variant/variant_internal.h"
 
 #ifdef DEBUG_ENABLED
 
@@ -1207,14 +1208,97 @@ Error Object::_emit_signal(const Variant **p_args, int p_argcount, Callable::Cal
 	return emit_signalp(signal, args, argc);
 }
 
+void Object::SignalData::clear_emit_slots() {
+	if (emit_slots) {
+		if (emit_slots->refcount.unref()) {
+			memdelete(emit_slots);
+		}
+		emit_slots = nullptr;
+	}
+}
+
+Object::SignalData &Object::SignalData::operator=(const SignalData &p_other) {
+	if (this != &p_other) {
+		clear_emit_slots();
+		user = p_other.user;
+		slot_map = p_other.slot_map;
+		removable = p_other.removable;
+	}
+	return *this;
+}
+
+Object::SignalData::EmitSlots *Object::_get_emit_slots(SignalData *p_signal) {
+	if (!p_signal->emit_slots) {
+		SignalData::EmitSlots *emit_slots = memnew(SignalData::EmitSlots);
+		emit_slots->refcount.init();
+		emit_slots->entries.resize(p_signal->slot_map.size());
+
+		uint32_t i = 0;
+		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : p_signal->slot_map) {
+			SignalData::EmitSlots::Entry &entry = emit_slots->entries[i++];
+			entry.callable = slot_kv.value.conn.callable;
+			entry.flags = slot_kv.value.conn.flags;
+			emit_slots->has_one_shot = emit_slots->has_one_shot || (entry.flags & CONNECT_ONE_SHOT);
+
+			// Same lookup as `Object::callp()` does for objects without script. Extension classes are left
+			// out, their method binds go away when the extension is reloaded.
+			if (!entry.callable.is_custom()) {
+				Object *target = entry.callable.get_object();
+				const StringName method = entry.callable.get_method();
+				if (target && !target->_extension && method != CoreStringName(free_)) {
+					entry.method = ClassDB::get_method(target->get_class_name(), method);
+				}
+			}
+		}
+
+		p_signal->emit_slots = emit_slots;
+	}
+
+	p_signal->emit_slots->refcount.ref();
+	return p_signal->emit_slots;
+}
+
+// Calls a native method connected to a signal. Arguments that already have the types the method takes
+// go through the validated call, which skips converting them.
+static void _call_connected_method(Object *p_target, const MethodBind *p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
+#ifdef DEBUG_ENABLED
+	_ObjectDebugLock debug_lock(p_target);
+#endif
+
+	r_error.error = Callable::CallError::CALL_OK;
+
+	if (p_argcount == p_method->get_argument_count() && !p_method->is_vararg()) {
+		bool validated = true;
+		for (int i = 0; i < p_argcount; i++) {
+			// Object arguments also need their class checked, which only the regular call does.
+			const Variant::Type type = p_method->get_argument_type(i);
+			if (type == Variant::OBJECT || (type != Variant::NIL && type != p_args[i]->get_type())) {
+				validated = false;
+				break;
+			}
+		}
+
+		if (validated) {
+			if (p_method->has_return()) {
+				Variant ret;
+				VariantInternal::initialize(&ret, p_method->get_argument_type(-1));
+				p_method->validated_call(p_target, p_args, &ret);
+			} else {
+				p_method->validated_call(p_target, p_args, nullptr);
+			}
+			return;
+		}
+	}
+
+	p_method->call(p_target, p_args, p_argcount, r_error);
+}
+
 Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount) {
 	if (_block_signals) {
 		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
 	}
 
-	Callable *slot_callables = nullptr;
-	uint32_t *slot_flags = nullptr;
-	uint32_t slot_count = 0;
+	SignalData::EmitSlots *emit_slots = nullptr;
 
 	{
 		OBJ_SIGNAL_LOCK
@@ -1236,28 +1320,21 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 
 		// Ensure that disconnecting the signal or even deleting the object
 		// will not affect the signal calling.
-		slot_callables = (Callable *)alloca(sizeof(Callable) * s->slot_map.size());
-		slot_flags = (uint32_t *)alloca(sizeof(uint32_t) * s->slot_map.size());
-
-		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-			memnew_placement(&slot_callables[slot_count], Callable(slot_kv.value.conn.callable));
-			slot_flags[slot_count] = slot_kv.value.conn.flags;
-			++slot_count;
-		}
-
-		DEV_ASSERT(slot_count == s->slot_map.size());
+		emit_slots = _get_emit_slots(s);
 
 		// Disconnect all one-shot connections before emitting to prevent recursion.
-		for (uint32_t i = 0; i < slot_count; ++i) {
-			bool disconnect = slot_flags[i] & CONNECT_ONE_SHOT;
+		if (emit_slots->has_one_shot) {
+			for (const SignalData::EmitSlots::Entry &entry : emit_slots->entries) {
+				bool disconnect = entry.flags & CONNECT_ONE_SHOT;
 #ifdef TOOLS_ENABLED
-			if (disconnect && (slot_flags[i] & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
-				// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
-				disconnect = false;
-			}
+				if (disconnect && (entry.flags & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
+					// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
+					disconnect = false;
+				}
 #endif
-			if (disconnect) {
-				_disconnect(p_name, slot_callables[i]);
+				if (disconnect) {
+					_disconnect(p_name, entry.callable);
+				}
 			}
 		}
 	}
@@ -1266,11 +1343,24 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 
 	Error err = OK;
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		const Callable &callable = slot_callables[i];
-		const uint32_t &flags = slot_flags[i];
+	for (const SignalData::EmitSlots::Entry &entry : emit_slots->entries) {
+		const Callable &callable = entry.callable;
+		const uint32_t &flags = entry.flags;
+
+		// Native methods are called without looking them up again, unless a script may override them.
+		Object *native_target = nullptr;
+		if (entry.method && !(flags & CONNECT_DEFERRED)) {
+			native_target = ObjectDB::get_instance(callable.get_object_id());
+			if (!native_target) {
+				// Target might have been deleted during signal callback, this is expected and OK.
+				continue;
+			}
+			if (native_target->script_instance) {
+				native_target = nullptr;
+			}
+		}
 
-		if (!callable.is_valid()) {
+		if (!native_target && !callable.is_valid()) {
 			// Target might have been deleted during signal callback, this is expected and OK.
 			continue;
 		}
@@ -1283,8 +1373,12 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		} else {
 			Callable::CallError ce;
 			_emitting = true;
-			Variant ret;
-			callable.callp(args, argc, ret, ce);
+			if (native_target) {
+				_call_connected_method(native_target, entry.method, args, argc, ce);
+			} else {
+				Variant ret;
+				callable.callp(args, argc, ret, ce);
+			}
 			_emitting = false;
 
 			if (ce.error != Callable::CallError::CALL_OK) {
@@ -1304,8 +1398,8 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		}
 	}
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		slot_callables[i].~Callable();
+	if (emit_slots->refcount.unref()) {
+		memdelete(emit_slots);
 	}
 
 	return err;
@@ -1533,6 +1627,7 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 
 	//use callable version as key, so binds can be ignored
 	s->slot_map[*p_callable.get_base_comparator()] = slot;
+	s->clear_emit_slots();
 
 	return OK;
 }
@@ -1613,6 +1708,7 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 	}
 
 	s->slot_map.erase(*p_callable.get_base_comparator());
+	s->clear_emit_slots();
 
 	if (s->slot_map.is_empty() && ClassDB::has_signal(get_class_name(), p_signal)) {
 		//not user signal, delete
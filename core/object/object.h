@@ -39,6 +39,7 @@
 #include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rb_map.h"
 #include "core/templates/safe_refcount.h"
 #include "core/variant/callable_bind.h"
@@ -617,9 +618,32 @@ private:
 			List<Connection>::Element *cE = nullptr;
 		};
 
+		// Flat copy of the slots used for emitting, built on the first emission after they change.
+		// Emissions keep a reference to it, so connections made or removed meanwhile don't affect them.
+		struct EmitSlots {
+			struct Entry {
+				Callable callable;
+				uint32_t flags = 0;
+				MethodBind *method = nullptr; // Native method of the target, called directly if it has no script.
+			};
+
+			SafeRefCount refcount;
+			LocalVector<Entry> entries;
+			bool has_one_shot = false;
+		};
+
 		MethodInfo user;
 		HashMap<Callable, Slot, HashableHasher<Callable>> slot_map;
+		EmitSlots *emit_slots = nullptr;
 		bool removable = false;
+
+		void clear_emit_slots();
+
+		SignalData() {}
+		SignalData(const SignalData &p_other) :
+				user(p_other.user), slot_map(p_other.slot_map), removable(p_other.removable) {}
+		SignalData &operator=(const SignalData &p_other);
+		~SignalData() { clear_emit_slots(); }
 	};
 	friend struct _ObjectSignalLock;
 	mutable Mutex *signal_mutex = nullptr;
@@ -769,6 +793,7 @@ protected:
 	static void _get_property_list_from_classdb(const StringName &p_class, List<PropertyInfo> *p_list, bool p_no_inheritance, const Object *p_validator);
 
 	bool _disconnect(const StringName &p_signal, const Callable &p_callable, bool p_force = false);
+	static SignalData::EmitSlots *_get_emit_slots(SignalData *p_signal);
 
 	virtual bool _uses_signal_mutex() const;
 
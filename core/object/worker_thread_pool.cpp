@@ -48,6 +48,64 @@ void WorkerThreadPool::Task::free_template_userdata() {
 
 WorkerThreadPool *WorkerThreadPool::singleton = nullptr;
 
+// Each pick takes this fraction of what is left in a range, so chunks start large
+// to amortize the atomics and get smaller towards the end to balance the tail.
+#define GROUP_RANGE_CHUNK_DIVISOR 8
+
+static _FORCE_INLINE_ uint64_t _pack_group_range(uint32_t p_begin, uint32_t p_end) {
+	return (uint64_t(p_end) << 32) | p_begin;
+}
+
+bool WorkerThreadPool::Group::take_chunk(uint32_t p_slot, uint32_t &r_from, uint32_t &r_to) {
+	std::atomic<uint64_t> &bounds = ranges[p_slot].bounds;
+	uint64_t current = bounds.load(std::memory_order_acquire);
+	while (true) {
+		const uint32_t begin = uint32_t(current);
+		const uint32_t end = uint32_t(current >> 32);
+		if (begin >= end) {
+			return false;
+		}
+		const uint32_t chunk = MAX(1u, (end - begin) / GROUP_RANGE_CHUNK_DIVISOR);
+		if (bounds.compare_exchange_weak(current, _pack_group_range(begin + chunk, end), std::memory_order_acq_rel, std::memory_order_acquire)) {
+			r_from = begin;
+			r_to = begin + chunk;
+			return true;
+		}
+	}
+}
+
+bool WorkerThreadPool::Group::steal_range(uint32_t p_slot) {
+	for (uint32_t i = 1; i < tasks_used; i++) {
+		std::atomic<uint64_t> &bounds = ranges[(p_slot + i) % tasks_used].bounds;
+		uint64_t current = bounds.load(std::memory_order_acquire);
+		while (true) {
+			const uint32_t begin = uint32_t(current);
+			const uint32_t end = uint32_t(current >> 32);
+			if (begin >= end) {
+				break;
+			}
+			const uint32_t stolen = (end - begin + 1) / 2;
+			if (bounds.compare_exchange_weak(current, _pack_group_range(begin, end - stolen), std::memory_order_acq_rel, std::memory_order_acquire)) {
+				// Only the owner writes to its own range while it is empty, and the stolen
+				// elements can't be handed out again, so a plain store can't race with thieves.
+				ranges[p_slot].bounds.store(_pack_group_range(end - stolen, end), std::memory_order_release);
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void WorkerThreadPool::_process_group_element(Task *p_task, uint32_t p_index) {
+	if (p_task->native_group_func) {
+		p_task->native_group_func(p_task->native_func_userdata, p_index);
+	} else if (p_task->template_userdata) {
+		p_task->template_userdata->callback_indexed(p_index);
+	} else {
+		p_task->callable.call(p_index);
+	}
+}
+
 #ifdef THREADS_ENABLED
 thread_local WorkerThreadPool::UnlockableLocks WorkerThreadPool::unlockable_locks[MAX_UNLOCKABLE_LOCKS];
 #endif
@@ -91,25 +149,42 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		// Handling a group
 		bool do_post = false;
 
-		while (true) {
-			uint32_t work_index = p_task->group->index.postincrement();
+		if (p_task->group->ranges) {
+			while (true) {
+				uint32_t from = 0;
+				uint32_t to = 0;
+				if (!p_task->group->take_chunk(p_task->group_slot, from, to)) {
+					if (p_task->group->steal_range(p_task->group_slot)) {
+						continue;
+					}
+					break; // Every range is drained, the remaining elements are being processed.
+				}
 
-			if (work_index >= p_task->group->max) {
-				break;
-			}
-			if (p_task->native_group_func) {
-				p_task->native_group_func(p_task->native_func_userdata, work_index);
-			} else if (p_task->template_userdata) {
-				p_task->template_userdata->callback_indexed(work_index);
-			} else {
-				p_task->callable.call(work_index);
+				for (uint32_t work_index = from; work_index < to; work_index++) {
+					_process_group_element(p_task, work_index);
+				}
+
+				uint32_t completed_amount = p_task->group->completed_index.add(to - from);
+
+				if (completed_amount == p_task->group->max) {
+					do_post = true;
+				}
 			}
+		} else {
+			while (true) {
+				uint32_t work_index = p_task->group->index.postincrement();
+
+				if (work_index >= p_task->group->max) {
+					break;
+				}
+				_process_group_element(p_task, work_index);
 
-			// This is the only way to ensure posting is done when all tasks are really complete.
-			uint32_t completed_amount = p_task->group->completed_index.increment();
+				// This is the only way to ensure posting is done when all tasks are really complete.
+				uint32_t completed_amount = p_task->group->completed_index.increment();
 
-			if (completed_amount == p_task->group->max) {
-				do_post = true;
+				if (completed_amount == p_task->group->max) {
+					do_post = true;
+				}
 			}
 		}
 
@@ -613,10 +688,13 @@ void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
 		return;
 	}
 
-	ThreadData &td = threads[task->pool_thread_index];
-	td.yield_is_over = true;
-	td.signaled = true;
-	td.cond_var.notify_one();
+	_notify_yield_over(threads[task->pool_thread_index]);
+}
+
+void WorkerThreadPool::_notify_yield_over(ThreadData &p_thread) {
+	p_thread.yield_is_over = true;
+	p_thread.signaled = true;
+	p_thread.cond_var.notify_one();
 }
 
 WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
@@ -625,9 +703,22 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 		p_tasks = MAX(1u, threads.size());
 	}
 
+	GroupRange *ranges = nullptr;
+	if (work_stealing && p_elements > 0 && p_tasks > 0) {
+		// Allocated before locking, ranges are only read by the tasks of this group.
+		ranges = (GroupRange *)Memory::alloc_aligned_static(sizeof(GroupRange) * p_tasks, alignof(GroupRange));
+		for (int i = 0; i < p_tasks; i++) {
+			memnew_placement(&ranges[i], GroupRange);
+			uint32_t from = uint64_t(p_elements) * i / p_tasks;
+			uint32_t to = uint64_t(p_elements) * (i + 1) / p_tasks;
+			ranges[i].bounds.store(_pack_group_range(from, to), std::memory_order_relaxed);
+		}
+	}
+
 	MutexLock<BinaryMutex> lock(task_mutex);
 
 	Group *group = group_allocator.alloc();
+	group->ranges = ranges;
 	GroupID id = last_task++;
 	group->max = p_elements;
 	group->self = id;
@@ -652,6 +743,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 			task->native_func_userdata = p_userdata;
 			task->description = p_description;
 			task->group = group;
+			task->group_slot = i;
 			task->callable = p_callable;
 			task->template_userdata = p_template_userdata;
 			tasks_posted[i] = task;
@@ -726,6 +818,229 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 #endif
 }
 
+WorkerThreadPool::TaskGraph::NodeID WorkerThreadPool::TaskGraph::_add_node(void (*p_func)(void *), void (*p_group_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_is_group, int p_elements, int p_tasks, const String &p_description) {
+	if (pool) {
+		if (p_template_userdata) {
+			memdelete(p_template_userdata);
+		}
+		ERR_FAIL_V_MSG(UINT32_MAX, "Can't add nodes to a task graph while it's running.");
+	}
+
+	Node *node = memnew(Node);
+	node->graph = this;
+	node->native_func = p_func;
+	node->native_group_func = p_group_func;
+	node->native_func_userdata = p_userdata;
+	node->template_userdata = p_template_userdata;
+	node->is_group = p_is_group;
+	node->elements = p_elements;
+	node->tasks = p_tasks;
+	node->description = p_description;
+	nodes.push_back(node);
+	return nodes.size() - 1;
+}
+
+WorkerThreadPool::TaskGraph::NodeID WorkerThreadPool::TaskGraph::add_native_task(void (*p_func)(void *), void *p_userdata, const String &p_description) {
+	ERR_FAIL_NULL_V(p_func, UINT32_MAX);
+	return _add_node(p_func, nullptr, p_userdata, nullptr, false, 0, 0, p_description);
+}
+
+WorkerThreadPool::TaskGraph::NodeID WorkerThreadPool::TaskGraph::add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, const String &p_description) {
+	ERR_FAIL_NULL_V(p_func, UINT32_MAX);
+	ERR_FAIL_COND_V(p_elements < 0, UINT32_MAX);
+	return _add_node(nullptr, p_func, p_userdata, nullptr, true, p_elements, p_tasks, p_description);
+}
+
+void WorkerThreadPool::TaskGraph::add_dependency(NodeID p_node, NodeID p_depends_on) {
+	ERR_FAIL_COND_MSG(pool, "Can't add dependencies to a task graph while it's running.");
+	ERR_FAIL_UNSIGNED_INDEX(p_node, nodes.size());
+	ERR_FAIL_UNSIGNED_INDEX(p_depends_on, nodes.size());
+	ERR_FAIL_COND_MSG(p_node == p_depends_on, "A task graph node can't depend on itself.");
+
+	nodes[p_depends_on]->dependents.push_back(p_node);
+	nodes[p_node]->dependency_count++;
+}
+
+WorkerThreadPool::TaskGraph::~TaskGraph() {
+	if (pool) {
+		ERR_PRINT("Task graph destroyed while running, wait for its completion first.");
+		// The nodes are still referenced by the tasks running them.
+		pool->wait_for_task_graph_completion(this);
+	}
+	for (Node *node : nodes) {
+		if (node->template_userdata) {
+			memdelete(node->template_userdata);
+		}
+		memdelete(node);
+	}
+}
+
+void WorkerThreadPool::TaskGraph::_task_func(void *p_node) {
+	Node *node = (Node *)p_node;
+	if (node->native_func) {
+		node->native_func(node->native_func_userdata);
+	} else {
+		node->template_userdata->callback();
+	}
+	_node_completed(node);
+}
+
+void WorkerThreadPool::TaskGraph::_group_func(void *p_node, uint32_t p_index) {
+	Node *node = (Node *)p_node;
+	if (node->native_group_func) {
+		node->native_group_func(node->native_func_userdata, p_index);
+	} else {
+		node->template_userdata->callback_indexed(p_index);
+	}
+	if (node->completed_elements.increment() == (uint32_t)node->elements) {
+		_node_completed(node);
+	}
+}
+
+void WorkerThreadPool::TaskGraph::_post_node(Node *p_node) {
+	if (p_node->is_group) {
+		if (p_node->elements == 0) {
+			// Nothing to process, so there's no group to post either.
+			_node_completed(p_node);
+			_node_release(p_node);
+			return;
+		}
+		p_node->id = p_node->graph->pool->add_native_group_task(_group_func, p_node, p_node->elements, p_node->tasks, p_node->graph->high_priority, p_node->description);
+	} else {
+		p_node->id = p_node->graph->pool->add_native_task(_task_func, p_node, p_node->graph->high_priority, p_node->description);
+	}
+	// The node may already be done, but the graph can't be considered complete before
+	// its ID is stored, since the waiter needs it to release the task or group.
+	_node_release(p_node);
+}
+
+void WorkerThreadPool::TaskGraph::_node_completed(Node *p_node) {
+	TaskGraph *graph = p_node->graph;
+	for (NodeID dependent_id : p_node->dependents) {
+		Node *dependent = graph->nodes[dependent_id];
+		if (dependent->pending_dependencies.decrement() == 0) {
+			_post_node(dependent);
+		}
+	}
+	_node_release(p_node);
+}
+
+void WorkerThreadPool::TaskGraph::_node_release(Node *p_node) {
+	if (p_node->pending_references.decrement() == 0) {
+		TaskGraph *graph = p_node->graph;
+		if (graph->pending_nodes.decrement() == 0) {
+			graph->done_semaphore.post();
+
+			int waiter_thread_index = -1;
+			{
+				MutexLock lock(graph->waiter_mutex);
+				SWAP(waiter_thread_index, graph->waiter_thread_index);
+			}
+			if (waiter_thread_index != -1) {
+				MutexLock task_lock(graph->pool->task_mutex);
+				graph->pool->_notify_yield_over(graph->pool->threads[waiter_thread_index]);
+			}
+		}
+	}
+}
+
+void WorkerThreadPool::submit_task_graph(TaskGraph *p_graph, bool p_high_priority) {
+	ERR_FAIL_NULL(p_graph);
+	ERR_FAIL_COND_MSG(p_graph->pool, "Task graph is already running, wait for its completion before submitting it again.");
+
+	const uint32_t node_count = p_graph->nodes.size();
+	if (node_count == 0) {
+		return;
+	}
+
+	{
+		// Make sure the graph can run to completion, a cycle would never be posted.
+		LocalVector<uint32_t> dependency_counts;
+		LocalVector<TaskGraph::NodeID> ready;
+		dependency_counts.resize(node_count);
+		ready.reserve(node_count);
+		for (uint32_t i = 0; i < node_count; i++) {
+			dependency_counts[i] = p_graph->nodes[i]->dependency_count;
+			if (dependency_counts[i] == 0) {
+				ready.push_back(i);
+			}
+		}
+		for (uint32_t i = 0; i < ready.size(); i++) {
+			for (TaskGraph::NodeID dependent_id : p_graph->nodes[ready[i]]->dependents) {
+				if (--dependency_counts[dependent_id] == 0) {
+					ready.push_back(dependent_id);
+				}
+			}
+		}
+		ERR_FAIL_COND_MSG(ready.size() != node_count, "Task graph has a dependency cycle, it can't be submitted.");
+	}
+
+	p_graph->pool = this;
+	p_graph->high_priority = p_high_priority;
+	p_graph->pending_nodes.set(node_count);
+	for (TaskGraph::Node *node : p_graph->nodes) {
+		node->id = INVALID_TASK_ID;
+		node->pending_dependencies.set(node->dependency_count);
+		node->completed_elements.set(0);
+		node->pending_references.set(2);
+	}
+
+	for (TaskGraph::Node *node : p_graph->nodes) {
+		if (node->dependency_count == 0) {
+			TaskGraph::_post_node(node);
+		}
+	}
+}
+
+void WorkerThreadPool::wait_for_task_graph_completion(TaskGraph *p_graph) {
+	ERR_FAIL_NULL(p_graph);
+	if (!p_graph->pool) {
+		return; // Empty or not submitted.
+	}
+	ERR_FAIL_COND_MSG(p_graph->pool != this, "Task graph was submitted to another pool.");
+
+	const int thread_index = get_thread_index();
+	if (thread_index != -1) {
+		// Blocking a pool thread could starve the graph, with a single thread it would never finish.
+		// Instead, keep processing tasks until the last node notifies this thread.
+		while (true) {
+			{
+				MutexLock lock(p_graph->waiter_mutex);
+				if (p_graph->pending_nodes.get() == 0) {
+					p_graph->waiter_thread_index = -1;
+					break;
+				}
+				p_graph->waiter_thread_index = thread_index;
+			}
+			yield();
+		}
+		// The semaphore is posted right before the notification, consume it for the next run.
+		p_graph->done_semaphore.wait();
+	} else {
+		if (this == singleton) {
+			_unlock_unlockable_mutexes();
+		}
+		p_graph->done_semaphore.wait();
+		if (this == singleton) {
+			_lock_unlockable_mutexes();
+		}
+	}
+
+	// Everything is done at this point, this only releases the tasks and groups.
+	for (TaskGraph::Node *node : p_graph->nodes) {
+		if (node->id == INVALID_TASK_ID) {
+			continue;
+		}
+		if (node->is_group) {
+			wait_for_group_task_completion(node->id);
+		} else {
+			wait_for_task_completion(node->id);
+		}
+	}
+
+	p_graph->pool = nullptr;
+}
+
 int WorkerThreadPool::get_thread_index() const {
 	Thread::ID tid = Thread::get_caller_id();
 	return thread_ids.has(tid) ? thread_ids[tid] : -1;
@@ -775,10 +1090,11 @@ void WorkerThreadPool::thread_exit_unlock_allowance_zone(uint32_t p_zone_id) {
 }
 #endif
 
-void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio) {
+void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio, bool p_work_stealing) {
 	ERR_FAIL_COND(threads.size() > 0);
 
 	runlevel = RUNLEVEL_NORMAL;
+	work_stealing = p_work_stealing;
 
 	if (p_thread_count < 0) {
 		p_thread_count = OS::get_singleton()->get_default_thread_pool_size();
@@ -786,7 +1102,7 @@ void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio)
 
 	max_low_priority_threads = CLAMP(p_thread_count * p_low_priority_task_ratio, 1, p_thread_count - 1);
 
-	print_verbose(vformat("WorkerThreadPool: %d threads, %d max low-priority.", p_thread_count, max_low_priority_threads));
+	print_verbose(vformat("WorkerThreadPool: %d threads, %d max low-priority%s.", p_thread_count, max_low_priority_threads, work_stealing ? ", work stealing" : ""));
 
 	threads.resize(p_thread_count);
 
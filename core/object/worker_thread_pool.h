@@ -59,6 +59,14 @@ private:
 		virtual ~BaseTemplateUserdata() {}
 	};
 
+	// In work-stealing mode, the elements of a group are split into one range per task.
+	// Each task takes shrinking chunks from the front of its own range, and once that is
+	// drained it steals half of what is left at the back of another one.
+	// Aligned to keep the ranges on separate cache lines, so they must be allocated with Memory::alloc_aligned_static().
+	struct alignas(64) GroupRange {
+		std::atomic<uint64_t> bounds; // Begin in the low 32 bits, end in the high 32 bits.
+	};
+
 	struct Group {
 		GroupID self = -1;
 		SafeNumeric<uint32_t> index;
@@ -68,6 +76,16 @@ private:
 		SafeFlag completed;
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
+		GroupRange *ranges = nullptr; // Only used in work-stealing mode.
+
+		bool take_chunk(uint32_t p_slot, uint32_t &r_from, uint32_t &r_to);
+		bool steal_range(uint32_t p_slot);
+
+		~Group() {
+			if (ranges) {
+				Memory::free_aligned_static(ranges);
+			}
+		}
 	};
 
 	struct Task {
@@ -81,6 +99,7 @@ private:
 		bool completed : 1;
 		bool pending_notify_yield_over : 1;
 		Group *group = nullptr;
+		uint32_t group_slot = 0;
 		SelfList<Task> task_elem;
 		uint32_t waiting_pool = 0;
 		uint32_t waiting_user = 0;
@@ -160,6 +179,7 @@ private:
 			PagedAllocator<HashMapElement<GroupID, Group *>, false, GROUPS_PAGE_SIZE>>
 			groups;
 
+	bool work_stealing = false;
 	uint32_t max_low_priority_threads = 0;
 	uint32_t low_priority_threads_used = 0;
 	uint32_t notify_index = 0; // For rotating across threads, no help distributing load.
@@ -171,6 +191,7 @@ private:
 	static void _thread_function(void *p_user);
 
 	void _process_task(Task *task);
+	_FORCE_INLINE_ void _process_group_element(Task *p_task, uint32_t p_index);
 
 	void _post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, MutexLock<BinaryMutex> &p_lock);
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
@@ -212,6 +233,7 @@ private:
 	};
 
 	void _wait_collaboratively(ThreadData *p_caller_pool_thread, Task *p_task);
+	void _notify_yield_over(ThreadData &p_thread);
 
 	void _switch_runlevel(Runlevel p_runlevel);
 	bool _handle_runlevel(ThreadData *p_thread_data, MutexLock<BinaryMutex> &p_lock);
@@ -260,6 +282,87 @@ public:
 	bool is_group_task_completed(GroupID p_group) const;
 	void wait_for_group_task_completion(GroupID p_group);
 
+	// A set of tasks and groups with dependencies between them. Once submitted, each node
+	// is posted as soon as every node it depends on is done, so independent phases overlap
+	// and the caller only waits once. A graph can be submitted again after being awaited.
+	class TaskGraph {
+		friend class WorkerThreadPool;
+
+	public:
+		typedef uint32_t NodeID;
+
+	private:
+		struct Node {
+			TaskGraph *graph = nullptr;
+			void (*native_func)(void *) = nullptr;
+			void (*native_group_func)(void *, uint32_t) = nullptr;
+			void *native_func_userdata = nullptr;
+			BaseTemplateUserdata *template_userdata = nullptr;
+			bool is_group = false;
+			int elements = 0;
+			int tasks = -1;
+			String description;
+			LocalVector<NodeID> dependents;
+			uint32_t dependency_count = 0;
+			int64_t id = INVALID_TASK_ID; // TaskID or GroupID, once posted.
+			SafeNumeric<uint32_t> pending_dependencies;
+			SafeNumeric<uint32_t> completed_elements;
+			SafeNumeric<uint32_t> pending_references; // Released once done and once its ID is stored.
+		};
+
+		LocalVector<Node *> nodes;
+		WorkerThreadPool *pool = nullptr; // Set while submitted.
+		bool high_priority = false;
+		SafeNumeric<uint32_t> pending_nodes;
+		Semaphore done_semaphore;
+		// A pool thread waiting for the graph keeps processing tasks, it's notified when the graph is done.
+		BinaryMutex waiter_mutex;
+		int waiter_thread_index = -1;
+
+		NodeID _add_node(void (*p_func)(void *), void (*p_group_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_is_group, int p_elements, int p_tasks, const String &p_description);
+
+		static void _task_func(void *p_node);
+		static void _group_func(void *p_node, uint32_t p_index);
+		static void _post_node(Node *p_node);
+		static void _node_completed(Node *p_node);
+		static void _node_release(Node *p_node);
+
+	public:
+		template <typename C, typename M, typename U>
+		NodeID add_template_task(C *p_instance, M p_method, U p_userdata, const String &p_description = String()) {
+			typedef TaskUserData<C, M, U> TUD;
+			TUD *ud = memnew(TUD);
+			ud->instance = p_instance;
+			ud->method = p_method;
+			ud->userdata = p_userdata;
+			return _add_node(nullptr, nullptr, nullptr, ud, false, 0, 0, p_description);
+		}
+		NodeID add_native_task(void (*p_func)(void *), void *p_userdata, const String &p_description = String());
+
+		template <typename C, typename M, typename U>
+		NodeID add_template_group_task(C *p_instance, M p_method, U p_userdata, int p_elements, int p_tasks = -1, const String &p_description = String()) {
+			typedef GroupUserData<C, M, U> GroupUD;
+			GroupUD *ud = memnew(GroupUD);
+			ud->instance = p_instance;
+			ud->method = p_method;
+			ud->userdata = p_userdata;
+			return _add_node(nullptr, nullptr, nullptr, ud, true, p_elements, p_tasks, p_description);
+		}
+		NodeID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, const String &p_description = String());
+
+		// `p_node` won't start before `p_depends_on` is done.
+		void add_dependency(NodeID p_node, NodeID p_depends_on);
+
+		uint32_t get_node_count() const { return nodes.size(); }
+
+		~TaskGraph();
+	};
+
+	void submit_task_graph(TaskGraph *p_graph, bool p_high_priority = false);
+	void wait_for_task_graph_completion(TaskGraph *p_graph);
+
+	bool is_work_stealing_enabled() const { return work_stealing; }
+
 	_FORCE_INLINE_ int get_thread_count() const {
 #ifdef THREADS_ENABLED
 		return threads.size();
@@ -288,7 +391,7 @@ public:
 	static void thread_exit_unlock_allowance_zone(uint32_t p_zone_id) {}
 #endif
 
-	void init(int p_thread_count = -1, float p_low_priority_task_ratio = 0.3);
+	void init(int p_thread_count = -1, float p_low_priority_task_ratio = 0.3, bool p_work_stealing = false);
 	void exit_languages_threads();
 	void finish();
 	WorkerThreadPool(bool p_singleton = true);
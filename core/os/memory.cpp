@@ -30,9 +30,11 @@
 
 #include "memory.h"
 
+#include "core/os/small_object_allocator.h"
 #include "core/templates/safe_refcount.h"
 
 #include <cstdlib>
+#include <cstring>
 
 void *operator new(size_t p_size, const char *p_description) {
 	return Memory::alloc_static(p_size, false);
@@ -61,6 +63,64 @@ SafeNumeric<uint64_t> Memory::mem_usage;
 SafeNumeric<uint64_t> Memory::max_usage;
 #endif
 
+// Small blocks come from SmallObjectAllocator when it's enabled, everything else from the system allocator.
+
+_FORCE_INLINE_ static void *_mem_alloc(size_t p_bytes) {
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+	if (p_bytes <= SmallObjectAllocator::MAX_SIZE) {
+		void *mem = SmallObjectAllocator::alloc(p_bytes);
+		if (mem) {
+			return mem;
+		}
+	}
+#endif
+	return malloc(p_bytes);
+}
+
+_FORCE_INLINE_ static void *_mem_alloc_zeroed(size_t p_bytes) {
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+	if (p_bytes <= SmallObjectAllocator::MAX_SIZE) {
+		void *mem = SmallObjectAllocator::alloc(p_bytes);
+		if (mem) {
+			memset(mem, 0, p_bytes);
+			return mem;
+		}
+	}
+#endif
+	return calloc(1, p_bytes);
+}
+
+_FORCE_INLINE_ static void *_mem_realloc(void *p_mem, size_t p_bytes) {
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+	size_t block_size = SmallObjectAllocator::get_block_size(p_mem);
+	if (block_size) {
+		if (p_bytes == 0) {
+			SmallObjectAllocator::free(p_mem);
+			return nullptr;
+		}
+		if (p_bytes <= block_size && p_bytes > block_size / 2) {
+			return p_mem;
+		}
+		void *mem = _mem_alloc(p_bytes);
+		if (mem) {
+			memcpy(mem, p_mem, MIN(block_size, p_bytes));
+			SmallObjectAllocator::free(p_mem);
+		}
+		return mem;
+	}
+#endif
+	return realloc(p_mem, p_bytes);
+}
+
+_FORCE_INLINE_ static void _mem_free(void *p_mem) {
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+	if (SmallObjectAllocator::free(p_mem)) {
+		return;
+	}
+#endif
+	free(p_mem);
+}
+
 void *Memory::alloc_aligned_static(size_t p_bytes, size_t p_alignment) {
 	DEV_ASSERT(is_power_of_2(p_alignment));
 
@@ -103,9 +163,9 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 
 	void *mem;
 	if constexpr (p_ensure_zero) {
-		mem = calloc(1, p_bytes + (prepad ? DATA_OFFSET : 0));
+		mem = _mem_alloc_zeroed(p_bytes + (prepad ? DATA_OFFSET : 0));
 	} else {
-		mem = malloc(p_bytes + (prepad ? DATA_OFFSET : 0));
+		mem = _mem_alloc(p_bytes + (prepad ? DATA_OFFSET : 0));
 	}
 
 	ERR_FAIL_NULL_V(mem, nullptr);
@@ -156,12 +216,12 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 #endif
 
 		if (p_bytes == 0) {
-			free(mem);
+			_mem_free(mem);
 			return nullptr;
 		} else {
 			*s = p_bytes;
 
-			mem = (uint8_t *)realloc(mem, p_bytes + DATA_OFFSET);
+			mem = (uint8_t *)_mem_realloc(mem, p_bytes + DATA_OFFSET);
 			ERR_FAIL_NULL_V(mem, nullptr);
 
 			s = (uint64_t *)(mem + SIZE_OFFSET);
@@ -171,7 +231,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 			return mem + DATA_OFFSET;
 		}
 	} else {
-		mem = (uint8_t *)realloc(mem, p_bytes);
+		mem = (uint8_t *)_mem_realloc(mem, p_bytes);
 
 		ERR_FAIL_COND_V(mem == nullptr && p_bytes > 0, nullptr);
 
@@ -198,9 +258,9 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 		mem_usage.sub(*s);
 #endif
 
-		free(mem);
+		_mem_free(mem);
 	} else {
-		free(mem);
+		_mem_free(mem);
 	}
 }
 
@@ -0,0 +1,356 @@
+/**************************************************************************/
+/*  small_object_allocator.cpp                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "small_object_allocator.h"
+
+#include "core/os/spin_lock.h"
+
+#include <atomic>
+#include <cstdlib>
+
+namespace {
+
+constexpr uint32_t SPAN_SHIFT = 16;
+constexpr size_t SPAN_SIZE = size_t(1) << SPAN_SHIFT;
+// Spans are requested from the system in chunks, to amortize the padding needed to align them.
+constexpr uint32_t SPANS_PER_CHUNK = 16;
+
+// The size class of each span is stored in a two-level map covering a 48-bit address space.
+// Memory above it is never used for spans.
+constexpr uint32_t ADDRESS_BITS = 48;
+constexpr uint32_t LEAF_BITS = 16;
+constexpr uint32_t ROOT_BITS = ADDRESS_BITS - SPAN_SHIFT - LEAF_BITS;
+
+constexpr uint32_t SIZE_CLASS_COUNT = 16;
+// Class 0 marks memory not owned by the allocator.
+constexpr uint16_t size_class_bytes[SIZE_CLASS_COUNT + 1] = { 0, 16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 448, 512 };
+static_assert(size_class_bytes[SIZE_CLASS_COUNT] == SmallObjectAllocator::MAX_SIZE);
+
+struct SizeClassTable {
+	static constexpr uint32_t LOOKUP_SIZE = SmallObjectAllocator::MAX_SIZE / 16 + 1;
+
+	uint8_t classes[LOOKUP_SIZE] = {};
+	// Blocks moved at once between a thread cache and the global pool, about 8 KiB worth.
+	uint32_t batch_sizes[SIZE_CLASS_COUNT + 1] = {};
+
+	constexpr SizeClassTable() {
+		uint8_t size_class = 1;
+		for (uint32_t i = 0; i < LOOKUP_SIZE; i++) {
+			while (size_class_bytes[size_class] < i * 16) {
+				size_class++;
+			}
+			classes[i] = size_class;
+		}
+		for (uint32_t i = 1; i <= SIZE_CLASS_COUNT; i++) {
+			uint32_t batch_size = 8192 / size_class_bytes[i];
+			batch_sizes[i] = batch_size < 8 ? 8 : (batch_size > 64 ? 64 : batch_size);
+		}
+	}
+};
+
+constexpr SizeClassTable size_class_table;
+
+struct FreeBlock {
+	FreeBlock *next;
+};
+
+// Everything below is constant-initialized, so it's usable before static constructors run.
+
+struct CentralList {
+	SpinLock lock;
+	FreeBlock *head = nullptr;
+	// Next block to carve from the span currently assigned to this class.
+	uint8_t *span_cursor = nullptr;
+	uint8_t *span_end = nullptr;
+};
+
+CentralList central_lists[SIZE_CLASS_COUNT + 1];
+
+SpinLock chunk_lock;
+uint8_t *chunk_cursor = nullptr;
+uint32_t chunk_spans_left = 0;
+
+std::atomic<uint8_t *> span_map[size_t(1) << ROOT_BITS];
+
+std::atomic<int64_t> used_bytes;
+std::atomic<int64_t> allocation_count;
+std::atomic<uint64_t> reserved_bytes;
+
+struct ThreadCache {
+	FreeBlock *lists[SIZE_CLASS_COUNT + 1];
+	uint32_t counts[SIZE_CLASS_COUNT + 1];
+	// Statistics not yet published to the global counters.
+	int64_t unpublished_bytes;
+	int64_t unpublished_allocations;
+	bool registered;
+	bool released;
+};
+
+// Trivial, so accessing it doesn't go through a TLS initialization guard.
+thread_local ThreadCache thread_cache = {};
+
+_FORCE_INLINE_ uint8_t _get_size_class(const void *p_ptr) {
+	uint64_t address = (uint64_t)(uintptr_t)p_ptr;
+	if (unlikely(address >> ADDRESS_BITS)) {
+		return 0;
+	}
+	const uint8_t *leaf = span_map[address >> (SPAN_SHIFT + LEAF_BITS)].load(std::memory_order_acquire);
+	if (!leaf) {
+		return 0;
+	}
+	return leaf[(address >> SPAN_SHIFT) & ((uint64_t(1) << LEAF_BITS) - 1)];
+}
+
+// Must be called with chunk_lock held.
+bool _set_span_size_class(uint8_t *p_span, uint8_t p_size_class) {
+	uint64_t address = (uint64_t)(uintptr_t)p_span;
+	std::atomic<uint8_t *> &root_entry = span_map[address >> (SPAN_SHIFT + LEAF_BITS)];
+	uint8_t *leaf = root_entry.load(std::memory_order_relaxed);
+	if (!leaf) {
+		leaf = (uint8_t *)calloc(1, size_t(1) << LEAF_BITS);
+		if (!leaf) {
+			return false;
+		}
+		root_entry.store(leaf, std::memory_order_release);
+	}
+	leaf[(address >> SPAN_SHIFT) & ((uint64_t(1) << LEAF_BITS) - 1)] = p_size_class;
+	return true;
+}
+
+uint8_t *_take_span(uint8_t p_size_class) {
+	chunk_lock.lock();
+
+	if (chunk_spans_left == 0) {
+		uint8_t *chunk = (uint8_t *)malloc(SPAN_SIZE * (SPANS_PER_CHUNK + 1));
+		if (!chunk) {
+			chunk_lock.unlock();
+			return nullptr;
+		}
+		uint8_t *aligned = (uint8_t *)(((uintptr_t)chunk + SPAN_SIZE - 1) & ~(uintptr_t)(SPAN_SIZE - 1));
+		if (((uint64_t)(uintptr_t)(aligned + SPAN_SIZE * SPANS_PER_CHUNK - 1)) >> ADDRESS_BITS) {
+			// Not addressable by the span map, let the system allocator handle these sizes.
+			::free(chunk);
+			chunk_lock.unlock();
+			return nullptr;
+		}
+		chunk_cursor = aligned;
+		chunk_spans_left = SPANS_PER_CHUNK;
+	}
+
+	uint8_t *span = chunk_cursor;
+	if (!_set_span_size_class(span, p_size_class)) {
+		chunk_lock.unlock();
+		return nullptr;
+	}
+	chunk_cursor += SPAN_SIZE;
+	chunk_spans_left--;
+
+	chunk_lock.unlock();
+
+	reserved_bytes.fetch_add(SPAN_SIZE, std::memory_order_relaxed);
+	return span;
+}
+
+void _publish_stats(ThreadCache &p_cache) {
+	used_bytes.fetch_add(p_cache.unpublished_bytes, std::memory_order_relaxed);
+	allocation_count.fetch_add(p_cache.unpublished_allocations, std::memory_order_relaxed);
+	p_cache.unpublished_bytes = 0;
+	p_cache.unpublished_allocations = 0;
+}
+
+// Hands a linked run of blocks back to the global pool.
+void _release_blocks(uint8_t p_size_class, FreeBlock *p_head, FreeBlock *p_tail) {
+	CentralList &list = central_lists[p_size_class];
+	list.lock.lock();
+	p_tail->next = list.head;
+	list.head = p_head;
+	list.lock.unlock();
+}
+
+void _release_thread_cache() {
+	ThreadCache &cache = thread_cache;
+	for (uint8_t size_class = 1; size_class <= SIZE_CLASS_COUNT; size_class++) {
+		FreeBlock *head = cache.lists[size_class];
+		if (!head) {
+			continue;
+		}
+		FreeBlock *tail = head;
+		while (tail->next) {
+			tail = tail->next;
+		}
+		_release_blocks(size_class, head, tail);
+		cache.lists[size_class] = nullptr;
+		cache.counts[size_class] = 0;
+	}
+	_publish_stats(cache);
+	// Blocks freed from now on go straight to the global pool.
+	cache.released = true;
+}
+
+struct ThreadCacheReleaser {
+	~ThreadCacheReleaser() {
+		_release_thread_cache();
+	}
+};
+
+thread_local ThreadCacheReleaser thread_cache_releaser;
+
+_FORCE_INLINE_ void _register_thread_cache(ThreadCache &p_cache) {
+	if (unlikely(!p_cache.registered)) {
+		// Using it makes sure its destructor runs when the thread exits.
+		(void)&thread_cache_releaser;
+		p_cache.registered = true;
+	}
+}
+
+FreeBlock *_refill(ThreadCache &p_cache, uint8_t p_size_class) {
+	if (p_cache.released) {
+		return nullptr;
+	}
+	_register_thread_cache(p_cache);
+
+	const uint32_t batch_size = size_class_table.batch_sizes[p_size_class];
+	const uint32_t block_size = size_class_bytes[p_size_class];
+	CentralList &list = central_lists[p_size_class];
+
+	FreeBlock *head = nullptr;
+	uint32_t count = 0;
+
+	list.lock.lock();
+	while (list.head && count < batch_size) {
+		FreeBlock *block = list.head;
+		list.head = block->next;
+		block->next = head;
+		head = block;
+		count++;
+	}
+	while (count < batch_size) {
+		if (list.span_cursor == list.span_end) {
+			uint8_t *span = _take_span(p_size_class);
+			if (!span) {
+				break;
+			}
+			list.span_cursor = span;
+			list.span_end = span + (SPAN_SIZE / block_size) * block_size;
+		}
+		FreeBlock *block = (FreeBlock *)list.span_cursor;
+		list.span_cursor += block_size;
+		block->next = head;
+		head = block;
+		count++;
+	}
+	list.lock.unlock();
+
+	p_cache.lists[p_size_class] = head;
+	p_cache.counts[p_size_class] = count;
+	_publish_stats(p_cache);
+	return head;
+}
+
+} // namespace
+
+void *SmallObjectAllocator::alloc(size_t p_bytes) {
+	if (unlikely(p_bytes > MAX_SIZE)) {
+		return nullptr;
+	}
+
+	const uint8_t size_class = size_class_table.classes[(p_bytes + 15) >> 4];
+	ThreadCache &cache = thread_cache;
+
+	FreeBlock *block = cache.lists[size_class];
+	if (unlikely(!block)) {
+		block = _refill(cache, size_class);
+		if (!block) {
+			return nullptr;
+		}
+	}
+
+	cache.lists[size_class] = block->next;
+	cache.counts[size_class]--;
+	cache.unpublished_bytes += size_class_bytes[size_class];
+	cache.unpublished_allocations++;
+	return block;
+}
+
+bool SmallObjectAllocator::free(void *p_ptr) {
+	const uint8_t size_class = _get_size_class(p_ptr);
+	if (size_class == 0) {
+		return false;
+	}
+
+	FreeBlock *block = (FreeBlock *)p_ptr;
+	ThreadCache &cache = thread_cache;
+
+	if (unlikely(cache.released)) {
+		_release_blocks(size_class, block, block);
+		used_bytes.fetch_sub(size_class_bytes[size_class], std::memory_order_relaxed);
+		allocation_count.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+	_register_thread_cache(cache);
+
+	block->next = cache.lists[size_class];
+	cache.lists[size_class] = block;
+	cache.counts[size_class]++;
+	cache.unpublished_bytes -= size_class_bytes[size_class];
+	cache.unpublished_allocations--;
+
+	const uint32_t batch_size = size_class_table.batch_sizes[size_class];
+	if (unlikely(cache.counts[size_class] > batch_size * 2)) {
+		// Keep a batch around, and give the rest back so other threads can reuse it.
+		FreeBlock *tail = block;
+		for (uint32_t i = 1; i < batch_size; i++) {
+			tail = tail->next;
+		}
+		cache.lists[size_class] = tail->next;
+		cache.counts[size_class] -= batch_size;
+		_release_blocks(size_class, block, tail);
+		_publish_stats(cache);
+	}
+	return true;
+}
+
+size_t SmallObjectAllocator::get_block_size(const void *p_ptr) {
+	return size_class_bytes[_get_size_class(p_ptr)];
+}
+
+uint64_t SmallObjectAllocator::get_used_bytes() {
+	int64_t used = used_bytes.load(std::memory_order_relaxed);
+	return used > 0 ? used : 0;
+}
+
+uint64_t SmallObjectAllocator::get_reserved_bytes() {
+	return reserved_bytes.load(std::memory_order_relaxed);
+}
+
+uint64_t SmallObjectAllocator::get_allocation_count() {
+	int64_t count = allocation_count.load(std::memory_order_relaxed);
+	return count > 0 ? count : 0;
+}
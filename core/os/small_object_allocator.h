@@ -0,0 +1,58 @@
+/**************************************************************************/
+/*  small_object_allocator.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/typedefs.h"
+
+// Thread-caching allocator for small blocks, used by Memory::alloc_static when
+// built with `small_object_allocator=yes`.
+//
+// Blocks are carved from 64 KiB spans, each span holding blocks of a single size class.
+// Every thread keeps a free list per size class and exchanges blocks with a global
+// pool in batches, so most allocations and frees don't take any lock. Spans are kept
+// for the lifetime of the process; freed blocks are reused, but not returned to the system.
+class SmallObjectAllocator {
+public:
+	static constexpr size_t MAX_SIZE = 512;
+
+	// Returns nullptr if p_bytes is larger than MAX_SIZE or no memory is available.
+	static void *alloc(size_t p_bytes);
+	// Returns false, doing nothing, if p_ptr wasn't allocated here.
+	static bool free(void *p_ptr);
+	// Usable size of a block, or 0 if p_ptr wasn't allocated here.
+	static size_t get_block_size(const void *p_ptr);
+
+	// Statistics are gathered per thread and published in batches, so they may lag
+	// slightly behind the actual usage.
+	static uint64_t get_used_bytes();
+	static uint64_t get_reserved_bytes();
+	static uint64_t get_allocation_count();
+};
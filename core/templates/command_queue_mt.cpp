@@ -30,9 +30,108 @@
 
 #include "command_queue_mt.h"
 
+thread_local CommandQueueMT::ThreadBatch CommandQueueMT::thread_batch;
+
+void CommandQueueMT::_publish_thread_batch(bool p_keep_staging) {
+	Batch *batch = thread_batch.batch;
+	if (batch->command_mem.is_empty()) {
+		if (!p_keep_staging) {
+			memdelete(batch);
+			thread_batch.batch = nullptr;
+		}
+		return;
+	}
+
+	batch->next = published_batches.load(std::memory_order_relaxed);
+	while (!published_batches.compare_exchange_weak(batch->next, batch, std::memory_order_release, std::memory_order_relaxed)) {
+	}
+
+	if (p_keep_staging) {
+		thread_batch.batch = memnew(Batch);
+		thread_batch.batch->command_mem.reserve(BATCH_PUBLISH_SIZE_KB * 1024);
+	} else {
+		thread_batch.batch = nullptr;
+	}
+
+	// Once per batch, not per command. Like in a regular push, the pump is woken up with the mutex
+	// held, so it can't miss the batch between a flush and the pump task being changed or cleared.
+	MutexLock lock(mutex);
+	pending.store(true);
+	_notify_pump();
+}
+
+// Must be called with the mutex locked. Returns whether any command was added.
+bool CommandQueueMT::_splice_published_batches() {
+	Batch *batch = published_batches.exchange(nullptr, std::memory_order_acquire);
+	if (!batch) {
+		return false;
+	}
+
+	// The list has the most recent batch first.
+	Batch *ordered = nullptr;
+	while (batch) {
+		Batch *next = batch->next;
+		batch->next = ordered;
+		ordered = batch;
+		batch = next;
+	}
+
+	while (ordered) {
+		// Commands are relocated bitwise, like when the main buffer grows.
+		uint64_t size = command_mem.size();
+		command_mem.resize(size + ordered->command_mem.size());
+		memcpy(&command_mem[size], ordered->command_mem.ptr(), ordered->command_mem.size());
+
+		Batch *next = ordered->next;
+		memdelete(ordered);
+		ordered = next;
+	}
+	return true;
+}
+
+void CommandQueueMT::begin_batch() {
+	if (thread_batch.queue == this) {
+		thread_batch.depth++;
+		return;
+	}
+	if (thread_batch.queue) {
+		// Only one queue batches at a time on a thread, commands to this one are pushed right away.
+		thread_batch.unbatched_depth++;
+		return;
+	}
+
+	thread_batch.queue = this;
+	thread_batch.depth = 1;
+	thread_batch.batch = memnew(Batch);
+	thread_batch.batch->command_mem.reserve(BATCH_PUBLISH_SIZE_KB * 1024);
+}
+
+void CommandQueueMT::end_batch() {
+	if (thread_batch.queue != this) {
+		ERR_FAIL_COND_MSG(thread_batch.unbatched_depth == 0, "This command queue isn't batching commands on this thread.");
+		thread_batch.unbatched_depth--;
+		return;
+	}
+
+	thread_batch.depth--;
+	if (thread_batch.depth > 0) {
+		return;
+	}
+
+	_publish_thread_batch(false);
+	thread_batch.queue = nullptr;
+}
+
 CommandQueueMT::CommandQueueMT() {
 	command_mem.reserve(DEFAULT_COMMAND_MEM_SIZE_KB * 1024);
 }
 
 CommandQueueMT::~CommandQueueMT() {
+	// Like commands left in the main buffer, those of batches never flushed are dropped.
+	Batch *batch = published_batches.exchange(nullptr);
+	while (batch) {
+		Batch *next = batch->next;
+		memdelete(batch);
+		batch = next;
+	}
 }
@@ -104,6 +104,24 @@ class CommandQueueMT {
 	/***** BASE *******/
 
 	static const uint32_t DEFAULT_COMMAND_MEM_SIZE_KB = 64;
+	static const uint32_t BATCH_PUBLISH_SIZE_KB = 16;
+
+	// Commands staged by a producer thread between begin_batch() and end_batch().
+	// Published batches form a lock-free LIFO list, which is spliced into the
+	// main command buffer in publishing order whenever the mutex is taken.
+	struct Batch {
+		Batch *next = nullptr;
+		LocalVector<uint8_t> command_mem;
+	};
+
+	struct ThreadBatch {
+		CommandQueueMT *queue = nullptr;
+		Batch *batch = nullptr;
+		uint32_t depth = 0;
+		uint32_t unbatched_depth = 0; // Batches begun on other queues meanwhile.
+	};
+
+	static thread_local ThreadBatch thread_batch;
 
 	BinaryMutex mutex;
 	LocalVector<uint8_t> command_mem;
@@ -111,32 +129,56 @@ class CommandQueueMT {
 	uint32_t sync_head = 0;
 	uint32_t sync_tail = 0;
 	uint32_t sync_awaiters = 0;
-	WorkerThreadPool::TaskID pump_task_id = WorkerThreadPool::INVALID_TASK_ID;
+	std::atomic<WorkerThreadPool::TaskID> pump_task_id{ WorkerThreadPool::INVALID_TASK_ID };
 	uint64_t flush_read_ptr = 0;
 	std::atomic<bool> pending{ false };
+	std::atomic<Batch *> published_batches{ nullptr };
 
 	template <typename T, typename... Args>
-	_FORCE_INLINE_ void create_command(Args &&...p_args) {
+	_FORCE_INLINE_ static void create_command(LocalVector<uint8_t> &p_command_mem, Args &&...p_args) {
 		// alloc size is size+T+safeguard
 		constexpr uint64_t alloc_size = ((sizeof(T) + 8U - 1U) & ~(8U - 1U));
 		static_assert(alloc_size < UINT32_MAX, "Type too large to fit in the command queue.");
 
-		uint64_t size = command_mem.size();
-		command_mem.resize(size + alloc_size + sizeof(uint64_t));
-		*(uint64_t *)&command_mem[size] = alloc_size;
-		void *cmd = &command_mem[size + sizeof(uint64_t)];
+		uint64_t size = p_command_mem.size();
+		p_command_mem.resize(size + alloc_size + sizeof(uint64_t));
+		*(uint64_t *)&p_command_mem[size] = alloc_size;
+		void *cmd = &p_command_mem[size + sizeof(uint64_t)];
 		new (cmd) T(std::forward<Args>(p_args)...);
-		pending.store(true);
 	}
 
+	// Must be called with the mutex locked.
+	_FORCE_INLINE_ void _notify_pump() {
+		WorkerThreadPool::TaskID pump = pump_task_id.load(std::memory_order_acquire);
+		if (pump != WorkerThreadPool::INVALID_TASK_ID) {
+			WorkerThreadPool::get_singleton()->notify_yield_over(pump);
+		}
+	}
+
+	void _publish_thread_batch(bool p_keep_staging = true);
+	bool _splice_published_batches();
+
 	template <typename T, bool NeedsSync, typename... Args>
 	_FORCE_INLINE_ void _push_internal(Args &&...args) {
+		if (thread_batch.queue == this) {
+			if constexpr (!NeedsSync) {
+				create_command<T>(thread_batch.batch->command_mem, std::forward<Args>(args)...);
+				if (thread_batch.batch->command_mem.size() >= BATCH_PUBLISH_SIZE_KB * 1024) {
+					_publish_thread_batch(); // Keep latency bounded for long batches.
+				}
+				return;
+			} else {
+				// Staged commands must run before the one being awaited.
+				_publish_thread_batch();
+			}
+		}
+
 		MutexLock mlock(mutex);
-		create_command<T>(std::forward<Args>(args)...);
+		_splice_published_batches(); // Keep batches published earlier ahead of this command.
+		create_command<T>(command_mem, std::forward<Args>(args)...);
+		pending.store(true);
 
-		if (pump_task_id != WorkerThreadPool::INVALID_TASK_ID) {
-			WorkerThreadPool::get_singleton()->notify_yield_over(pump_task_id);
-		}
+		_notify_pump();
 
 		if constexpr (NeedsSync) {
 			sync_tail++;
@@ -161,7 +203,7 @@ class CommandQueueMT {
 
 		MutexLock lock(mutex);
 
-		while (flush_read_ptr < command_mem.size()) {
+		while (flush_read_ptr < command_mem.size() || _splice_published_batches()) {
 			uint64_t size = *(uint64_t *)&command_mem[flush_read_ptr];
 			flush_read_ptr += 8;
 			CommandBase *cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
@@ -188,6 +230,9 @@ class CommandQueueMT {
 
 		command_mem.clear();
 		pending.store(false);
+		if (published_batches.load(std::memory_order_acquire)) {
+			pending.store(true); // Published after the last splice, leave it for the next flush.
+		}
 		flush_read_ptr = 0;
 
 		_prevent_sync_wraparound();
@@ -241,15 +286,23 @@ public:
 		push_and_sync(this, &CommandQueueMT::_no_op);
 	}
 
+	// Between these calls, commands pushed without syncing by the calling thread are
+	// staged in a buffer of its own and published in batches, so the thread doesn't
+	// contend on the queue mutex for each of them. Calls can be nested. A batch begun
+	// while the thread is batching for another queue is ignored.
+	void begin_batch();
+	void end_batch();
+
 	void wait_and_flush() {
-		ERR_FAIL_COND(pump_task_id == WorkerThreadPool::INVALID_TASK_ID);
-		WorkerThreadPool::get_singleton()->wait_for_task_completion(pump_task_id);
+		WorkerThreadPool::TaskID pump = pump_task_id.load(std::memory_order_acquire);
+		ERR_FAIL_COND(pump == WorkerThreadPool::INVALID_TASK_ID);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(pump);
 		_flush();
 	}
 
 	void set_pump_task_id(WorkerThreadPool::TaskID p_task_id) {
 		MutexLock lock(mutex);
-		pump_task_id = p_task_id;
+		pump_task_id.store(p_task_id, std::memory_order_release);
 	}
 
 	CommandQueueMT();
@@ -100,6 +100,7 @@
 #include "editor/export/project_zip_packer.h"
 #include "editor/export/register_exporters.h"
 #include "editor/export/shader_baker_export_plugin.h"
+#include "editor/export/shader_compiler_cache_export_plugin.h"
 #include "editor/file_system/dependency_editor.h"
 #include "editor/file_system/editor_paths.h"
 #include "editor/gui/editor_about.h"
@@ -8667,6 +8668,11 @@ EditorNode::EditorNode() {
 
 	EditorExport::get_singleton()->add_export_plugin(dedicated_server_export_plugin);
 
+	Ref<ShaderCompilerCacheExportPlugin> shader_compiler_cache_export_plugin;
+	shader_compiler_cache_export_plugin.instantiate();
+
+	EditorExport::get_singleton()->add_export_plugin(shader_compiler_cache_export_plugin);
+
 	Ref<ShaderBakerExportPlugin> shader_baker_export_plugin;
 	shader_baker_export_plugin.instantiate();
 
@@ -0,0 +1,89 @@
+/**************************************************************************/
+/*  shader_compiler_cache_export_plugin.cpp                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "shader_compiler_cache_export_plugin.h"
+
+#include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
+#include "core/io/resource_loader.h"
+#include "editor/file_system/editor_file_system.h"
+#include "scene/resources/shader.h"
+#include "servers/rendering/shader_compiler.h"
+
+void ShaderCompilerCacheExportPlugin::_compile_shaders(EditorFileSystemDirectory *p_dir) {
+	for (int i = 0; i < p_dir->get_subdir_count(); i++) {
+		_compile_shaders(p_dir->get_subdir(i));
+	}
+
+	for (int i = 0; i < p_dir->get_file_count(); i++) {
+		if (!ClassDB::is_parent_class(p_dir->get_file_type(i), "Shader")) {
+			continue;
+		}
+		Ref<Shader> shader = ResourceLoader::load(p_dir->get_file_path(i));
+		if (shader.is_null()) {
+			continue;
+		}
+		// Waits for the renderer to compile the shader, which records its cache key.
+		List<PropertyInfo> parameters;
+		RS::get_singleton()->get_shader_parameter_list(shader->get_rid(), &parameters);
+	}
+}
+
+void ShaderCompilerCacheExportPlugin::_export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) {
+	bool shader_cache_enabled = GLOBAL_GET("rendering/shader_compiler/shader_cache/enabled");
+	const String &cache_dir = ShaderCompiler::get_cache_user_dir();
+	if (!shader_cache_enabled || cache_dir.is_empty()) {
+		return;
+	}
+
+	Ref<DirAccess> da = DirAccess::open(cache_dir);
+	if (da.is_null()) {
+		return;
+	}
+
+	// The cache directory keeps an entry for every version of every shader ever edited, so only
+	// the entries of the shaders used since startup are exported, after compiling the project's
+	// shader files. Shaders embedded in scenes are covered once those scenes have been opened.
+	_compile_shaders(EditorFileSystem::get_singleton()->get_filesystem());
+	const HashSet<String> used_keys = ShaderCompiler::get_used_cache_keys();
+
+	// Entries are named after a hash of everything they depend on, so they can be shipped as is.
+	// The ones built for another renderer or engine version are never looked up at runtime.
+	const String export_dir = "res://.godot/shader_cache/ShaderCompiler";
+	for (const String &file : da->get_files()) {
+		if (file.get_extension() != "cache" || !used_keys.has(file.get_basename())) {
+			continue;
+		}
+		Vector<uint8_t> data = FileAccess::get_file_as_bytes(cache_dir.path_join(file));
+		if (!data.is_empty()) {
+			add_file(export_dir.path_join(file), data, false);
+		}
+	}
+}
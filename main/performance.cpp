@@ -31,6 +31,7 @@
 #include "performance.h"
 
 #include "core/os/os.h"
+#include "core/os/small_object_allocator.h"
 #include "core/variant/typed_array.h"
 #include "scene/main/node.h"
 #include "scene/main/scene_tree.h"
@@ -129,6 +130,9 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_EDGE_FREE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
+	BIND_ENUM_CONSTANT(MEMORY_SMALL_OBJECT_USED);
+	BIND_ENUM_CONSTANT(MEMORY_SMALL_OBJECT_RESERVED);
+	BIND_ENUM_CONSTANT(MEMORY_SMALL_OBJECT_COUNT);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -209,6 +213,9 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation_3d/edges_free"),
 		PNAME("navigation_3d/obstacles"),
 #endif // NAVIGATION_3D_DISABLED
+		PNAME("memory/small_object_used"),
+		PNAME("memory/small_object_reserved"),
+		PNAME("memory/small_object_count"),
 	};
 	static_assert(std::size(names) == MONITOR_MAX);
 
@@ -432,6 +439,12 @@ double Performance::get_monitor(Monitor p_monitor) const {
 		case NAVIGATION_3D_OBSTACLE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
+		case MEMORY_SMALL_OBJECT_USED:
+			return SmallObjectAllocator::get_used_bytes();
+		case MEMORY_SMALL_OBJECT_RESERVED:
+			return SmallObjectAllocator::get_reserved_bytes();
+		case MEMORY_SMALL_OBJECT_COUNT:
+			return SmallObjectAllocator::get_allocation_count();
 
 		default: {
 		}
@@ -503,6 +516,9 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
 
 	};
 	static_assert((sizeof(types) / sizeof(MonitorType)) == MONITOR_MAX);
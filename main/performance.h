@@ -125,6 +125,9 @@ public:
 		NAVIGATION_3D_EDGE_CONNECTION_COUNT,
 		NAVIGATION_3D_EDGE_FREE_COUNT,
 		NAVIGATION_3D_OBSTACLE_COUNT,
+		MEMORY_SMALL_OBJECT_USED,
+		MEMORY_SMALL_OBJECT_RESERVED,
+		MEMORY_SMALL_OBJECT_COUNT,
 		MONITOR_MAX
 	};
 
@@ -31,6 +31,7 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
@@ -742,6 +743,47 @@ void GDScript::_restore_old_static_data() {
 
 #endif
 
+#ifdef DEBUG_ENABLED
+// Measures a script compilation for the profiler. Scripts compiled meanwhile, such as dependencies
+// finished by `GDScriptCache::finish_compiling()`, only count towards its total time.
+class GDScriptCompileTimer {
+	static thread_local uint64_t nested_time;
+
+	String path;
+	uint64_t start = 0;
+	uint64_t outer_nested_time = 0;
+	bool running = true;
+
+public:
+	void end() {
+		if (!running) {
+			return;
+		}
+		running = false;
+
+		const uint64_t total_time = OS::get_singleton()->get_ticks_usec() - start;
+		const uint64_t self_time = total_time - MIN(nested_time, total_time);
+		nested_time = outer_nested_time + total_time;
+		if (!path.is_empty()) {
+			GDScriptLanguage::get_singleton()->profiling_add_compile_time(path, self_time, total_time);
+		}
+	}
+
+	GDScriptCompileTimer(const String &p_path) :
+			path(p_path) {
+		start = OS::get_singleton()->get_ticks_usec();
+		outer_nested_time = nested_time;
+		nested_time = 0;
+	}
+
+	~GDScriptCompileTimer() {
+		end();
+	}
+};
+
+thread_local uint64_t GDScriptCompileTimer::nested_time = 0;
+#endif
+
 Error GDScript::reload(bool p_keep_state) {
 	if (reloading) {
 		return OK;
@@ -811,6 +853,10 @@ Error GDScript::reload(bool p_keep_state) {
 	}
 #endif
 
+#ifdef DEBUG_ENABLED
+	GDScriptCompileTimer compile_timer(path);
+#endif
+
 	valid = false;
 	GDScriptParser parser;
 	Error err;
@@ -866,6 +912,14 @@ Error GDScript::reload(bool p_keep_state) {
 		}
 	}
 
+	if (GDScriptBytecodeCache::is_enabled() && is_root_script()) {
+		GDScriptBytecodeCache::save(this, parser);
+	}
+
+#ifdef DEBUG_ENABLED
+	compile_timer.end();
+#endif
+
 #ifdef TOOLS_ENABLED
 	// Done after compilation because it needs the GDScript object's inner class GDScript objects,
 	// which are made by calling make_scripts() within compiler.compile() above.
@@ -1420,6 +1474,16 @@ GDScript::GDScript() :
 	}
 
 	path = vformat("gdscript://%d.gd", get_instance_id());
+	inline_cache_epoch.set(GDScriptLanguage::get_singleton()->next_script_epoch());
+}
+
+void GDScript::invalidate_inline_caches() {
+	// Epochs come from a single counter, so a script allocated where a freed one lived never
+	// matches entries resolved for the old one, and the newest epoch in a chain is always the highest.
+	inline_cache_epoch.set(GDScriptLanguage::get_singleton()->next_script_epoch());
+	for (KeyValue<StringName, Ref<GDScript>> &E : subclasses) {
+		E.value->invalidate_inline_caches();
+	}
 }
 
 void GDScript::_save_orphaned_subclasses(ClearData *p_clear_data) {
@@ -1568,6 +1632,8 @@ void GDScript::clear(ClearData *p_clear_data) {
 		}
 	}
 
+	invalidate_inline_caches();
+
 	for (const KeyValue<StringName, GDScriptFunction *> &E : member_functions) {
 		clear_data->functions.insert(E.value);
 	}
@@ -2288,6 +2354,10 @@ void GDScriptLanguage::init() {
 	}
 #endif
 
+	if (GLOBAL_GET("debug/settings/gdscript/sampling_profiler")) {
+		GDScriptSamplingProfiler::start(GLOBAL_GET("debug/settings/gdscript/sampling_profiler_interval_usec"));
+	}
+
 #ifdef TESTS_ENABLED
 	GDScriptTests::GDScriptTestRunner::handle_cmdline();
 #endif
@@ -2329,8 +2399,18 @@ void GDScriptLanguage::finish() {
 	}
 	finishing = true;
 
+	if (GDScriptSamplingProfiler::is_active()) {
+		GDScriptSamplingProfiler::stop();
+		const String output = GLOBAL_GET("debug/settings/gdscript/sampling_profiler_output");
+		if (GDScriptSamplingProfiler::save(output) == OK) {
+			print_line(vformat(R"(GDScript sampling profile saved to "%s".)", ProjectSettings::get_singleton()->globalize_path(output)));
+		}
+	}
+	GDScriptSamplingProfiler::clear();
+
 	// Clear the cache before parsing the script_list
 	GDScriptCache::clear();
+	GDScriptBytecodeCache::clear();
 
 	// Clear dependencies between scripts, to ensure cyclic references are broken
 	// (to avoid leaks at exit).
@@ -2385,6 +2465,7 @@ void GDScriptLanguage::profiling_start() {
 		elem->self()->profile.last_native_calls.clear();
 		elem = elem->next();
 	}
+	compile_profiles.clear();
 
 	profiling = true;
 #endif
@@ -2438,6 +2519,18 @@ int GDScriptLanguage::profiling_get_accumulated_data(ProfilingInfo *p_info_arr,
 		p_info_arr[last_non_internal].internal_time = nat_time;
 		elem = elem->next();
 	}
+
+	for (const KeyValue<String, CompileProfile> &E : compile_profiles) {
+		if (current >= p_info_max) {
+			break;
+		}
+		p_info_arr[current].call_count = E.value.call_count;
+		p_info_arr[current].self_time = E.value.self_time;
+		p_info_arr[current].total_time = E.value.total_time;
+		p_info_arr[current].internal_time = 0;
+		p_info_arr[current].signature = E.value.signature;
+		current++;
+	}
 #endif
 
 	return current;
@@ -2479,11 +2572,45 @@ int GDScriptLanguage::profiling_get_frame_data(ProfilingInfo *p_info_arr, int p_
 		}
 		elem = elem->next();
 	}
+
+	for (const KeyValue<String, CompileProfile> &E : compile_profiles) {
+		if (current >= p_info_max) {
+			break;
+		}
+		if (E.value.last_frame_call_count > 0) {
+			p_info_arr[current].call_count = E.value.last_frame_call_count;
+			p_info_arr[current].self_time = E.value.last_frame_self_time;
+			p_info_arr[current].total_time = E.value.last_frame_total_time;
+			p_info_arr[current].internal_time = 0;
+			p_info_arr[current].signature = E.value.signature;
+			current++;
+		}
+	}
 #endif
 
 	return current;
 }
 
+#ifdef DEBUG_ENABLED
+void GDScriptLanguage::profiling_add_compile_time(const String &p_path, uint64_t p_self_time, uint64_t p_total_time) {
+	MutexLock lock(mutex);
+	if (!profiling) {
+		return;
+	}
+
+	CompileProfile &profile = compile_profiles[p_path];
+	if (profile.signature.is_empty()) {
+		profile.signature = p_path + "::0::@compile";
+	}
+	profile.call_count++;
+	profile.self_time += p_self_time;
+	profile.total_time += p_total_time;
+	profile.frame_call_count++;
+	profile.frame_self_time += p_self_time;
+	profile.frame_total_time += p_total_time;
+}
+#endif
+
 void GDScriptLanguage::profiling_collate_native_call_data(bool p_accumulated) {
 #ifdef DEBUG_ENABLED
 	// The same native call can be called from multiple functions, so join them together here.
@@ -2725,6 +2852,15 @@ void GDScriptLanguage::frame() {
 			elem->self()->profile.native_calls.clear();
 			elem = elem->next();
 		}
+
+		for (KeyValue<String, CompileProfile> &E : compile_profiles) {
+			E.value.last_frame_call_count = E.value.frame_call_count;
+			E.value.last_frame_self_time = E.value.frame_self_time;
+			E.value.last_frame_total_time = E.value.frame_total_time;
+			E.value.frame_call_count = 0;
+			E.value.frame_self_time = 0;
+			E.value.frame_total_time = 0;
+		}
 	}
 
 #endif
@@ -2959,6 +3095,11 @@ GDScriptLanguage::GDScriptLanguage() {
 	_debug_max_call_stack = GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/settings/gdscript/max_call_stack", PROPERTY_HINT_RANGE, "512," + itos(GDScriptFunction::MAX_CALL_DEPTH - 1) + ",1"), 1024);
 	track_call_stack = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_call_stacks", false);
 	track_locals = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_local_variables", false);
+	optimize_bytecode = GLOBAL_DEF_RST("debug/settings/gdscript/optimize_bytecode", true);
+	cache_bytecode = GLOBAL_DEF_RST("debug/settings/gdscript/cache_compiled_bytecode", false);
+	GLOBAL_DEF_RST("debug/settings/gdscript/sampling_profiler", false);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/settings/gdscript/sampling_profiler_interval_usec", PROPERTY_HINT_RANGE, "100,100000,1,suffix:µs"), 1000);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::STRING, "debug/settings/gdscript/sampling_profiler_output", PROPERTY_HINT_SAVE_FILE, "*.folded,*.json"), "user://gdscript_profile.folded");
 
 #ifdef DEBUG_ENABLED
 	track_call_stack = true;
@@ -3029,7 +3170,12 @@ Ref<GDScript> GDScriptLanguage::get_script_by_fully_qualified_name(const String
 Ref<Resource> ResourceFormatLoaderGDScript::load(const String &p_path, const String &p_original_path, Error *r_error, bool p_use_sub_threads, float *r_progress, CacheMode p_cache_mode) {
 	Error err;
 	bool ignoring = p_cache_mode == CACHE_MODE_IGNORE || p_cache_mode == CACHE_MODE_IGNORE_DEEP;
+	Vector<String> preparsed;
+	if (!ignoring && GDScriptCache::get_cached_script(p_original_path).is_null()) {
+		preparsed = GDScriptCache::preparse(p_original_path);
+	}
 	Ref<GDScript> scr = GDScriptCache::get_full_script(p_original_path, err, "", ignoring);
+	GDScriptCache::release_preparsed(preparsed);
 
 	if (err && scr.is_valid()) {
 		// If !scr.is_valid(), the error was likely from scr->load_source_code(), which already generates an error.
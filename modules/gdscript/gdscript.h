@@ -31,6 +31,7 @@
 #pragma once
 
 #include "gdscript_function.h"
+#include "gdscript_sampling_profiler.h"
 
 #include "core/debugger/engine_debugger.h"
 #include "core/debugger/script_debugger.h"
@@ -89,6 +90,7 @@ class GDScript : public Script {
 	friend class GDScriptLambdaCallable;
 	friend class GDScriptLambdaSelfCallable;
 	friend class GDScriptLanguage;
+	friend class GDScriptBytecodeCache;
 	friend struct GDScriptUtilityFunctionsDefinitions;
 
 	Ref<GDScriptNativeClass> native;
@@ -179,6 +181,9 @@ private:
 	RBSet<Object *> instances;
 	bool destructing = false;
 	bool clearing = false;
+	// Bumped whenever the functions or member layout of this script are cleared or rebuilt.
+	// Inline cache entries keyed on the script are only valid for the epoch they were resolved in.
+	SafeNumeric<uint32_t> inline_cache_epoch;
 	//exported members
 	String source;
 	Vector<uint8_t> binary_tokens;
@@ -257,6 +262,8 @@ public:
 	bool is_root_script() const { return _owner == nullptr; }
 	String get_fully_qualified_name() const { return fully_qualified_name; }
 	const HashMap<StringName, Ref<GDScript>> &get_subclasses() const { return subclasses; }
+	_FORCE_INLINE_ uint32_t get_inline_cache_epoch() const { return inline_cache_epoch.get(); }
+	void invalidate_inline_caches();
 	const HashMap<StringName, Variant> &get_constants() const { return constants; }
 	const HashSet<StringName> &get_members() const { return members; }
 	const GDScriptDataType &get_member_type(const StringName &p_member) const {
@@ -450,6 +457,8 @@ class GDScriptLanguage : public ScriptLanguage {
 
 	bool track_call_stack = false;
 	bool track_locals = false;
+	bool optimize_bytecode = true;
+	bool cache_bytecode = false;
 
 	static CallLevel *_get_stack_level(uint32_t p_level);
 
@@ -466,10 +475,29 @@ class GDScriptLanguage : public ScriptLanguage {
 	friend class GDScriptFunction;
 
 	SelfList<GDScriptFunction>::List function_list;
+
+	// Hands out the per-script inline cache epochs, see `GDScript::invalidate_inline_caches()`.
+	SafeNumeric<uint32_t> script_epoch;
+
 #ifdef DEBUG_ENABLED
 	bool profiling;
 	bool profile_native_calls;
 	uint64_t script_frame_time;
+
+	// Time spent compiling each script while profiling, reported as a `@compile` pseudo-function.
+	struct CompileProfile {
+		String signature;
+		uint64_t call_count = 0;
+		uint64_t self_time = 0;
+		uint64_t total_time = 0;
+		uint64_t frame_call_count = 0;
+		uint64_t frame_self_time = 0;
+		uint64_t frame_total_time = 0;
+		uint64_t last_frame_call_count = 0;
+		uint64_t last_frame_self_time = 0;
+		uint64_t last_frame_total_time = 0;
+	};
+	HashMap<String, CompileProfile> compile_profiles;
 #endif
 
 	HashMap<String, ObjectID> orphan_subclasses;
@@ -484,6 +512,8 @@ public:
 	bool debug_break_parse(const String &p_file, int p_line, const String &p_error);
 
 	_FORCE_INLINE_ void enter_function(CallLevel *call_level, GDScriptInstance *p_instance, GDScriptFunction *p_function, Variant *p_stack, int *p_ip, int *p_line) {
+		GDScriptSamplingProfiler::enter(p_function);
+
 		if (!track_call_stack) {
 			return;
 		}
@@ -518,6 +548,8 @@ public:
 	}
 
 	_FORCE_INLINE_ void exit_function() {
+		GDScriptSamplingProfiler::exit();
+
 		if (!track_call_stack) {
 			return;
 		}
@@ -580,6 +612,12 @@ public:
 
 	_FORCE_INLINE_ bool should_track_call_stack() const { return track_call_stack; }
 	_FORCE_INLINE_ bool should_track_locals() const { return track_locals; }
+	_FORCE_INLINE_ bool should_optimize_bytecode() const { return optimize_bytecode; }
+	_FORCE_INLINE_ bool should_cache_bytecode() const { return cache_bytecode; }
+	uint32_t next_script_epoch() { return script_epoch.increment(); }
+	// Only affects functions compiled afterwards.
+	void set_optimize_bytecode(bool p_enabled) { optimize_bytecode = p_enabled; }
+	void set_cache_bytecode(bool p_enabled) { cache_bytecode = p_enabled; }
 	_FORCE_INLINE_ int get_global_array_size() const { return global_array.size(); }
 	_FORCE_INLINE_ Variant *get_global_array() { return _global_array; }
 	_FORCE_INLINE_ const HashMap<StringName, int> &get_global_map() const { return globals; }
@@ -657,6 +695,9 @@ public:
 
 	virtual int profiling_get_accumulated_data(ProfilingInfo *p_info_arr, int p_info_max) override;
 	virtual int profiling_get_frame_data(ProfilingInfo *p_info_arr, int p_info_max) override;
+#ifdef DEBUG_ENABLED
+	void profiling_add_compile_time(const String &p_path, uint64_t p_self_time, uint64_t p_total_time);
+#endif
 
 	/* LOADER FUNCTIONS */
 
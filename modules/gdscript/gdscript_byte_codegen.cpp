@@ -30,6 +30,8 @@
 
 #include "gdscript_byte_codegen.h"
 
+#include "gdscript_native_compiler.h"
+
 #include "core/debugger/engine_debugger.h"
 
 uint32_t GDScriptByteCodeGenerator::add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) {
@@ -135,6 +137,9 @@ uint32_t GDScriptByteCodeGenerator::add_temporary(const GDScriptDataType &p_type
 void GDScriptByteCodeGenerator::pop_temporary() {
 	ERR_FAIL_COND(used_temporaries.is_empty());
 	int slot_idx = used_temporaries.back()->get();
+	if (copy_assign_pos >= 0) {
+		_propagate_copy(slot_idx);
+	}
 	if (temporaries[slot_idx].can_contain_object) {
 		// Avoid keeping in the stack long-lived references to objects,
 		// which may prevent `RefCounted` objects from being freed.
@@ -146,6 +151,30 @@ void GDScriptByteCodeGenerator::pop_temporary() {
 	used_temporaries.pop_back();
 }
 
+void GDScriptByteCodeGenerator::_propagate_copy(int p_temporary) {
+	const int assign_pos = copy_assign_pos;
+	// Only when nothing was written or became a jump target since the assignment, so the temporary is never read again.
+	if (opcodes.size() != assign_pos + 3 || last_jump_target > assign_pos) {
+		copy_assign_pos = -1;
+		return;
+	}
+	Vector<int> &indices = temporaries.write[p_temporary].bytecode_indices;
+	const int count = indices.size();
+	if (count < 2 || indices[count - 1] != assign_pos + 2) {
+		return; // Another temporary.
+	}
+	copy_assign_pos = -1;
+	if (indices[count - 2] != copy_producer_target) {
+		return;
+	}
+
+	// Let the operator write the local and drop the assignment.
+	opcodes.write[copy_producer_target] = opcodes[assign_pos + 1];
+	opcodes.resize(assign_pos);
+	indices.resize(count - 2);
+	copy_producer_end = -1;
+}
+
 void GDScriptByteCodeGenerator::start_parameters() {
 	if (function->_default_arg_count > 0) {
 		append(GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT);
@@ -173,6 +202,8 @@ void GDScriptByteCodeGenerator::write_start(GDScript *p_script, const StringName
 	function->return_type = p_return_type;
 	function->rpc_config = p_rpc_config;
 	function->_argument_count = 0;
+
+	optimize_bytecode = GDScriptLanguage::get_singleton()->should_optimize_bytecode();
 }
 
 GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
@@ -193,6 +224,10 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		}
 	}
 
+	if (optimize_bytecode) {
+		fuse_instructions();
+	}
+
 	if (constant_map.size()) {
 		function->_constant_count = constant_map.size();
 		function->constants.resize(constant_map.size());
@@ -228,6 +263,11 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_code_size = 0;
 	}
 
+	if (inline_cache_count) {
+		function->_inline_cache_count = inline_cache_count;
+		function->_inline_caches = memnew_arr(GDScriptFunction::InlineCache, inline_cache_count);
+	}
+
 	if (function->default_arguments.size()) {
 		function->_default_arg_count = function->default_arguments.size() - 1;
 		function->_default_arg_ptr = &function->default_arguments[0];
@@ -408,10 +448,51 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 	function->gds_utilities_names = gds_utilities_names;
 #endif
 
+	GDScriptNativeCompiler::bind(function);
+
 	ended = true;
 	return function;
 }
 
+void GDScriptByteCodeGenerator::fuse_instructions() {
+	// Instructions are only retagged in place and never moved, so jump targets, default argument
+	// offsets and temporary slots stay valid. The instruction absorbed by a superinstruction is left
+	// untouched right after it, which keeps it a valid jump target and gives the fused handler its operands.
+	int *code = opcodes.ptrw();
+	const int code_size = opcodes.size();
+
+	for (int i = 0; i < fusion_candidates.size(); i++) {
+		const int ip = fusion_candidates[i];
+
+		switch (code[ip]) {
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED: {
+				const int next = ip + 5;
+				ERR_CONTINUE(next >= code_size);
+				if (code[next] == GDScriptFunction::OPCODE_JUMP_IF) {
+					code[ip] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF;
+				} else if (code[next] == GDScriptFunction::OPCODE_JUMP_IF_NOT) {
+					code[ip] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+				}
+			} break;
+			case GDScriptFunction::OPCODE_GET_MEMBER: {
+				const int next = ip + 3;
+				ERR_CONTINUE(next >= code_size);
+				// Candidates are in code order, so a following operator has not been retagged yet.
+				// Fusing it with a jump afterwards is fine, the fused handler only reads its operands.
+				// Typed operators share the validated layout and evaluator index, so they can be absorbed too.
+				if (code[next] == GDScriptFunction::OPCODE_OPERATOR_VALIDATED || (code[next] >= GDScriptFunction::OPCODE_OPERATOR_ADD_INT && code[next] <= GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT)) {
+					code[ip] = GDScriptFunction::OPCODE_GET_MEMBER_OPERATOR_VALIDATED;
+				}
+			} break;
+			default: {
+				ERR_PRINT("Unexpected opcode in bytecode fusion candidates.");
+			} break;
+		}
+	}
+
+	fusion_candidates.clear();
+}
+
 #ifdef DEBUG_ENABLED
 void GDScriptByteCodeGenerator::set_signature(const String &p_signature) {
 	function->profile.signature = p_signature;
@@ -551,11 +632,76 @@ void GDScriptByteCodeGenerator::write_type_adjust(const Address &p_target, Varia
 	append(p_target);
 }
 
+// Opcodes with a dedicated VM handler working on the unboxed payloads. They share the
+// OPCODE_OPERATOR_VALIDATED layout, so the evaluator index is still emitted after the operands.
+static GDScriptFunction::Opcode _get_typed_operator_opcode(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type) {
+#define TYPED_OPERATOR_CASE(m_operator, m_type) \
+	case Variant::OP_##m_operator:              \
+		return GDScriptFunction::OPCODE_OPERATOR_##m_operator##_##m_type;
+
+	if (p_left_type == Variant::INT && p_right_type == Variant::INT) {
+		switch (p_operator) {
+			TYPED_OPERATOR_CASE(ADD, INT)
+			TYPED_OPERATOR_CASE(SUBTRACT, INT)
+			TYPED_OPERATOR_CASE(MULTIPLY, INT)
+			TYPED_OPERATOR_CASE(EQUAL, INT)
+			TYPED_OPERATOR_CASE(NOT_EQUAL, INT)
+			TYPED_OPERATOR_CASE(LESS, INT)
+			TYPED_OPERATOR_CASE(LESS_EQUAL, INT)
+			TYPED_OPERATOR_CASE(GREATER, INT)
+			TYPED_OPERATOR_CASE(GREATER_EQUAL, INT)
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::FLOAT && p_right_type == Variant::FLOAT) {
+		switch (p_operator) {
+			TYPED_OPERATOR_CASE(ADD, FLOAT)
+			TYPED_OPERATOR_CASE(SUBTRACT, FLOAT)
+			TYPED_OPERATOR_CASE(MULTIPLY, FLOAT)
+			TYPED_OPERATOR_CASE(EQUAL, FLOAT)
+			TYPED_OPERATOR_CASE(NOT_EQUAL, FLOAT)
+			TYPED_OPERATOR_CASE(LESS, FLOAT)
+			TYPED_OPERATOR_CASE(LESS_EQUAL, FLOAT)
+			TYPED_OPERATOR_CASE(GREATER, FLOAT)
+			TYPED_OPERATOR_CASE(GREATER_EQUAL, FLOAT)
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::VECTOR2 && p_right_type == Variant::VECTOR2) {
+		switch (p_operator) {
+			TYPED_OPERATOR_CASE(ADD, VECTOR2)
+			TYPED_OPERATOR_CASE(SUBTRACT, VECTOR2)
+			TYPED_OPERATOR_CASE(MULTIPLY, VECTOR2)
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::VECTOR3 && p_right_type == Variant::VECTOR3) {
+		switch (p_operator) {
+			TYPED_OPERATOR_CASE(ADD, VECTOR3)
+			TYPED_OPERATOR_CASE(SUBTRACT, VECTOR3)
+			TYPED_OPERATOR_CASE(MULTIPLY, VECTOR3)
+			default:
+				break;
+		}
+	} else if (p_operator == Variant::OP_MULTIPLY && p_right_type == Variant::FLOAT) {
+		if (p_left_type == Variant::VECTOR2) {
+			return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT;
+		} else if (p_left_type == Variant::VECTOR3) {
+			return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT;
+		}
+	}
+
+#undef TYPED_OPERATOR_CASE
+
+	return GDScriptFunction::OPCODE_OPERATOR_VALIDATED;
+}
+
 void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand) {
 	if (HAS_BUILTIN_TYPE(p_left_operand)) {
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, Variant::NIL);
 
+		add_fusion_candidate();
 		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
 		append(p_left_operand);
 		append(Address());
@@ -613,7 +759,13 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
-		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
+		GDScriptFunction::Opcode opcode = _get_typed_operator_opcode(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
+		if (opcode == GDScriptFunction::OPCODE_OPERATOR_VALIDATED) {
+			// Typed operators (including `int` and `float` comparisons) are cheaper on their own than the
+			// evaluator call of a fused jump, so only the remaining validated operators are fused with jumps.
+			add_fusion_candidate();
+		}
+		append_opcode(opcode);
 		append(p_left_operand);
 		append(p_right_operand);
 		append(p_target);
@@ -628,6 +780,7 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 	append_opcode(GDScriptFunction::OPCODE_OPERATOR);
 	append(p_left_operand);
 	append(p_right_operand);
+	const int target_pos = opcodes.size();
 	append(p_target);
 	append(p_operator);
 	append(0); // Signature storage.
@@ -636,6 +789,11 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 	for (int i = 0; i < _pointer_size; i++) {
 		append(0); // Space for function pointer.
 	}
+
+	if (p_target.mode == Address::TEMPORARY) {
+		copy_producer_target = target_pos;
+		copy_producer_end = opcodes.size();
+	}
 }
 
 void GDScriptByteCodeGenerator::write_type_test(const Address &p_target, const Address &p_source, const GDScriptDataType &p_type) {
@@ -859,6 +1017,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -877,6 +1036,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -886,6 +1046,7 @@ void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const S
 }
 
 void GDScriptByteCodeGenerator::write_get_member(const Address &p_target, const StringName &p_name) {
+	add_fusion_candidate();
 	append_opcode(GDScriptFunction::OPCODE_GET_MEMBER);
 	append(p_target);
 	append(p_name);
@@ -993,9 +1154,22 @@ void GDScriptByteCodeGenerator::write_assign(const Address &p_target, const Addr
 		append(p_source);
 		append(p_target.type.builtin_type);
 	} else {
+		if (optimize_bytecode && p_target.mode == p_source.mode && p_target.address == p_source.address && p_target.mode != Address::NIL) {
+			// Assigning a variable to itself is a no-op.
+			return;
+		}
+		// An untyped operator computing a temporary right before it is assigned to an untyped local can write the
+		// local directly. It is decided once the temporary is popped, since only then it is known not to be read again.
+		// The operator initializes its target before reading the operands, so the local must not be one of them.
+		// Typed and validated operators are left alone, they expect their target to already hold the result type.
+		const bool propagate = optimize_bytecode && p_source.mode == Address::TEMPORARY && p_target.mode == Address::LOCAL_VARIABLE && !p_target.type.has_type &&
+				copy_producer_end == opcodes.size() && last_jump_target != opcodes.size() &&
+				opcodes[copy_producer_target - 2] != address_of(p_target) && opcodes[copy_producer_target - 1] != address_of(p_target);
+		const int assign_pos = opcodes.size();
 		append_opcode(GDScriptFunction::OPCODE_ASSIGN);
 		append(p_target);
 		append(p_source);
+		copy_assign_pos = propagate ? assign_pos : -1;
 	}
 }
 
@@ -1026,6 +1200,7 @@ void GDScriptByteCodeGenerator::write_assign_default_parameter(const Address &p_
 void GDScriptByteCodeGenerator::write_store_global(const Address &p_dst, int p_global_index) {
 	append_opcode(GDScriptFunction::OPCODE_STORE_GLOBAL);
 	append(p_dst);
+	function->global_index_offsets.push_back(opcodes.size());
 	append(p_global_index);
 }
 
@@ -1091,6 +1266,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1116,6 +1292,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1350,6 +1527,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1363,6 +1541,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1376,6 +1555,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
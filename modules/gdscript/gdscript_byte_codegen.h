@@ -74,9 +74,17 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	};
 
 	bool ended = false;
+	bool optimize_bytecode = false;
 	GDScriptFunction *function = nullptr;
 
 	Vector<int> opcodes;
+	Vector<int> fusion_candidates; // Instructions the optimizer may fuse with the one that follows.
+
+	// Copy propagation of an untyped operator result into a local, see `write_assign()`.
+	int copy_producer_target = -1; // Position of the operator target operand.
+	int copy_producer_end = -1;
+	int copy_assign_pos = -1;
+	int last_jump_target = -1;
 	List<RBMap<StringName, int>> stack_id_stack;
 	RBMap<StringName, int> stack_identifiers;
 	List<int> stack_identifiers_counts;
@@ -97,6 +105,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	int max_locals = 0;
 	int current_line = 0;
 	int instr_args_max = 0;
+	int inline_cache_count = 0;
 
 #ifdef DEBUG_ENABLED
 	List<int> temp_stack;
@@ -449,10 +458,24 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		opcodes.push_back(get_lambda_function_pos(p_lambda_function));
 	}
 
+	void append_inline_cache() {
+		opcodes.push_back(inline_cache_count++);
+	}
+
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
+		last_jump_target = opcodes.size();
 	}
 
+	void add_fusion_candidate() {
+		if (optimize_bytecode) {
+			fusion_candidates.push_back(opcodes.size());
+		}
+	}
+
+	void fuse_instructions();
+	void _propagate_copy(int p_temporary);
+
 public:
 	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
@@ -0,0 +1,2080 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript_cache.h"
+#include "gdscript_native_compiler.h"
+#include "gdscript_parser.h"
+
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/debugger/engine_debugger.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/object/class_db.h"
+#include "core/os/os.h"
+#include "core/version.h"
+
+static constexpr int MAX_VARIANT_DEPTH = 64;
+static const char *CACHE_MAGIC = "GDBC";
+
+// What follows an opcode, one character per code word. For instructions taking a variable number of
+// addresses (`variadic`), these are the words after the opcode, the address count and the addresses.
+// a: address, j: jump target, t: Variant::Type, n: global name, v: Variant::Operator, o: validated operator, i: inline cache,
+// s/g: named setter/getter, k/K: keyed setter/getter, x/X: indexed setter/getter, b: built-in method,
+// c: constructor, u: utility, U: GDScript utility, m: method bind, l: lambda, G: global array index,
+// #: count of variadic arguments, -: any value.
+struct OpcodeLayout {
+	const char *operands = nullptr; // `nullptr` for values that aren't opcodes.
+	bool variadic = false;
+	// Addresses a variadic instruction reads for `#` arguments: `#` * `addresses_per_argument` + `extra_addresses`.
+	int addresses_per_argument = 1;
+	int extra_addresses = 0;
+};
+
+static OpcodeLayout _get_opcode_layout(int p_opcode) {
+	if (p_opcode >= GDScriptFunction::OPCODE_OPERATOR_ADD_INT && p_opcode <= GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT) {
+		return { "aaao" };
+	}
+	if (p_opcode >= GDScriptFunction::OPCODE_ITERATE_BEGIN && p_opcode <= GDScriptFunction::OPCODE_ITERATE_BEGIN_OBJECT) {
+		return { "aaaj" };
+	}
+	if (p_opcode >= GDScriptFunction::OPCODE_ITERATE && p_opcode <= GDScriptFunction::OPCODE_ITERATE_OBJECT) {
+		return { "aaaj" };
+	}
+	if (p_opcode >= GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL && p_opcode <= GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY) {
+		return { "a" };
+	}
+
+	switch (p_opcode) {
+		case GDScriptFunction::OPCODE_OPERATOR:
+			return { "aaav" }; // Followed by the slots the VM caches the evaluator it found in.
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT:
+			return { "aaao" };
+		case GDScriptFunction::OPCODE_TYPE_TEST_BUILTIN:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+		case GDScriptFunction::OPCODE_CAST_TO_BUILTIN:
+			return { "aat" };
+		case GDScriptFunction::OPCODE_TYPE_TEST_ARRAY:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_ARRAY:
+			return { "aaatn" };
+		case GDScriptFunction::OPCODE_TYPE_TEST_DICTIONARY:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_DICTIONARY:
+			return { "aaaatntn" };
+		case GDScriptFunction::OPCODE_TYPE_TEST_NATIVE:
+			return { "aan" };
+		case GDScriptFunction::OPCODE_TYPE_TEST_SCRIPT:
+		case GDScriptFunction::OPCODE_SET_KEYED:
+		case GDScriptFunction::OPCODE_GET_KEYED:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_NATIVE:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_SCRIPT:
+		case GDScriptFunction::OPCODE_CAST_TO_NATIVE:
+		case GDScriptFunction::OPCODE_CAST_TO_SCRIPT:
+			return { "aaa" };
+		case GDScriptFunction::OPCODE_SET_KEYED_VALIDATED:
+			return { "aaak" };
+		case GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED:
+			return { "aaax" };
+		case GDScriptFunction::OPCODE_GET_KEYED_VALIDATED:
+			return { "aaaK" };
+		case GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED:
+			return { "aaaX" };
+		case GDScriptFunction::OPCODE_SET_NAMED:
+		case GDScriptFunction::OPCODE_GET_NAMED:
+			return { "aani" };
+		case GDScriptFunction::OPCODE_SET_NAMED_VALIDATED:
+			return { "aas" };
+		case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED:
+			return { "aag" };
+		case GDScriptFunction::OPCODE_SET_MEMBER:
+		case GDScriptFunction::OPCODE_GET_MEMBER:
+		case GDScriptFunction::OPCODE_GET_MEMBER_OPERATOR_VALIDATED:
+		case GDScriptFunction::OPCODE_STORE_NAMED_GLOBAL:
+			return { "an" };
+		case GDScriptFunction::OPCODE_SET_STATIC_VARIABLE:
+		case GDScriptFunction::OPCODE_GET_STATIC_VARIABLE:
+			return { "aa-" }; // The VM checks the index against the script's static variables.
+		case GDScriptFunction::OPCODE_ASSIGN:
+		case GDScriptFunction::OPCODE_ASSERT:
+			return { "aa" };
+		case GDScriptFunction::OPCODE_ASSIGN_NULL:
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+		case GDScriptFunction::OPCODE_AWAIT:
+		case GDScriptFunction::OPCODE_AWAIT_RESUME:
+		case GDScriptFunction::OPCODE_RETURN:
+			return { "a" };
+		case GDScriptFunction::OPCODE_CONSTRUCT:
+			return { "#t", true, 1, 1 };
+		case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED:
+			return { "#c", true, 1, 1 };
+		case GDScriptFunction::OPCODE_CONSTRUCT_ARRAY:
+			return { "#", true, 1, 1 };
+		case GDScriptFunction::OPCODE_CONSTRUCT_TYPED_ARRAY:
+			return { "#tn", true, 1, 2 };
+		case GDScriptFunction::OPCODE_CONSTRUCT_DICTIONARY:
+			return { "#", true, 2, 1 };
+		case GDScriptFunction::OPCODE_CONSTRUCT_TYPED_DICTIONARY:
+			return { "#tntn", true, 2, 3 };
+		case GDScriptFunction::OPCODE_CALL:
+		case GDScriptFunction::OPCODE_CALL_RETURN:
+		case GDScriptFunction::OPCODE_CALL_ASYNC:
+			return { "#ni", true, 1, 2 };
+		case GDScriptFunction::OPCODE_CALL_UTILITY:
+		case GDScriptFunction::OPCODE_CALL_SELF_BASE:
+			return { "#n", true, 1, 1 };
+		case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED:
+			return { "#u", true, 1, 1 };
+		case GDScriptFunction::OPCODE_CALL_GDSCRIPT_UTILITY:
+			return { "#U", true, 1, 1 };
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED:
+			return { "#b", true, 1, 2 };
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_RET:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN:
+			return { "#m", true, 1, 2 };
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_STATIC:
+			return { "tn#", true, 1, 1 };
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC:
+			return { "m#", true, 1, 1 };
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN:
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN:
+			return { "#m", true, 1, 1 };
+		case GDScriptFunction::OPCODE_CREATE_LAMBDA:
+		case GDScriptFunction::OPCODE_CREATE_SELF_LAMBDA:
+			return { "#l", true, 1, 1 };
+		case GDScriptFunction::OPCODE_JUMP:
+			return { "j" };
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+		case GDScriptFunction::OPCODE_JUMP_IF_SHARED:
+			return { "aj" };
+		case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT:
+		case GDScriptFunction::OPCODE_BREAKPOINT:
+		case GDScriptFunction::OPCODE_END:
+			return { "" };
+		case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN:
+			return { "at" };
+		case GDScriptFunction::OPCODE_RETURN_TYPED_ARRAY:
+			return { "aatn" };
+		case GDScriptFunction::OPCODE_RETURN_TYPED_DICTIONARY:
+			return { "aaatntn" };
+		case GDScriptFunction::OPCODE_RETURN_TYPED_NATIVE:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_SCRIPT:
+			return { "aa" };
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_RANGE:
+			return { "aaaaaj" };
+		case GDScriptFunction::OPCODE_ITERATE_RANGE:
+			return { "aaaaj" };
+		case GDScriptFunction::OPCODE_STORE_GLOBAL:
+			return { "aG" };
+		case GDScriptFunction::OPCODE_LINE:
+			return { "-" };
+		default:
+			return {};
+	}
+}
+
+Mutex GDScriptBytecodeCache::mutex;
+GDScriptBytecodeCache::ReverseLookup *GDScriptBytecodeCache::reverse_lookup = nullptr;
+HashMap<String, String> GDScriptBytecodeCache::source_hashes;
+
+struct GDScriptBytecodeCache::Writer {
+	LocalVector<uint8_t> data;
+
+	void put_u8(uint8_t p_value) {
+		data.push_back(p_value);
+	}
+
+	void put_32(uint32_t p_value) {
+		const uint32_t offset = data.size();
+		data.resize(offset + 4);
+		encode_uint32(p_value, data.ptr() + offset);
+	}
+
+	void put_buffer(const uint8_t *p_buffer, int p_size) {
+		const uint32_t offset = data.size();
+		data.resize(offset + p_size);
+		memcpy(data.ptr() + offset, p_buffer, p_size);
+	}
+
+	void put_string(const String &p_string) {
+		const CharString utf8 = p_string.utf8();
+		put_32(utf8.length());
+		put_buffer((const uint8_t *)utf8.get_data(), utf8.length());
+	}
+};
+
+// Reading past the end or finding anything unexpected sets `failed`, after which every getter
+// returns a default value. Callers check `failed` once after reading a whole record.
+struct GDScriptBytecodeCache::Reader {
+	const uint8_t *data = nullptr;
+	int size = 0;
+	int position = 0;
+	bool failed = false;
+
+	bool has(int p_bytes) {
+		if (failed || p_bytes < 0 || size - position < p_bytes) {
+			failed = true;
+			return false;
+		}
+		return true;
+	}
+
+	uint8_t get_u8() {
+		if (!has(1)) {
+			return 0;
+		}
+		return data[position++];
+	}
+
+	uint32_t get_32() {
+		if (!has(4)) {
+			return 0;
+		}
+		const uint32_t value = decode_uint32(data + position);
+		position += 4;
+		return value;
+	}
+
+	int get_int() {
+		return int32_t(get_32());
+	}
+
+	// Counts can't exceed the bytes left, so a corrupted file can't trigger huge allocations.
+	int get_count() {
+		const uint32_t count = get_32();
+		if (failed || count > uint32_t(size - position)) {
+			failed = true;
+			return 0;
+		}
+		return count;
+	}
+
+	Variant::Type get_type() {
+		const uint32_t type = get_32();
+		if (type >= Variant::VARIANT_MAX) {
+			failed = true;
+			return Variant::NIL;
+		}
+		return Variant::Type(type);
+	}
+
+	String get_string() {
+		const int length = get_count();
+		if (failed) {
+			return String();
+		}
+		const String string = String::utf8((const char *)data + position, length);
+		position += length;
+		return string;
+	}
+};
+
+struct GDScriptBytecodeCache::SaveContext {
+	HashMap<ObjectID, StringName> global_objects; // Objects in the global array, saved by name.
+	HashMap<int, StringName> global_names; // Global array indices embedded in code, saved by name.
+};
+
+struct GDScriptBytecodeCache::LoadContext {
+	GDScript *root = nullptr;
+	String path;
+};
+
+String GDScriptBytecodeCache::_get_cache_file(const String &p_path) {
+	return String("user://gdscript_cache").path_join(p_path.md5_text() + ".gdbc");
+}
+
+String GDScriptBytecodeCache::_get_build_key() {
+	String key = vformat("%s.%s", GODOT_VERSION_FULL_BUILD, GODOT_VERSION_HASH);
+#ifdef DEBUG_ENABLED
+	key += ".debug";
+#endif
+#ifdef TOOLS_ENABLED
+	key += ".tools";
+#endif
+	if (GDScriptLanguage::get_singleton()->should_optimize_bytecode()) {
+		key += ".optimized";
+	}
+
+	// Autoload singletons change how identifiers are compiled without touching any script.
+	uint32_t autoloads_hash = hash_murmur3_one_32(0);
+	for (const KeyValue<StringName, ProjectSettings::AutoloadInfo> &E : ProjectSettings::get_singleton()->get_autoload_list()) {
+		autoloads_hash = hash_murmur3_one_32(E.key.hash(), autoloads_hash);
+		autoloads_hash = hash_murmur3_one_32(E.value.path.hash(), autoloads_hash);
+		autoloads_hash = hash_murmur3_one_32(E.value.is_singleton, autoloads_hash);
+	}
+	key += "." + itos(hash_fmix32(autoloads_hash));
+
+	// Catches opcodes being added, removed or changing operands in builds that share a version and commit hash.
+	uint32_t opcodes_hash = hash_murmur3_one_32(GDScriptFunction::OPCODE_END);
+	for (int i = 0; i <= GDScriptFunction::OPCODE_END; i++) {
+		const OpcodeLayout layout = _get_opcode_layout(i);
+		opcodes_hash = hash_murmur3_one_32(layout.operands ? String(layout.operands).hash() : 0, opcodes_hash);
+		opcodes_hash = hash_murmur3_one_32(layout.variadic, opcodes_hash);
+		opcodes_hash = hash_murmur3_one_32(layout.addresses_per_argument, opcodes_hash);
+		opcodes_hash = hash_murmur3_one_32(layout.extra_addresses, opcodes_hash);
+	}
+	key += "." + itos(hash_fmix32(opcodes_hash));
+
+	return key;
+}
+
+String GDScriptBytecodeCache::_get_source_hash(const String &p_path) {
+	if (const String *hash = source_hashes.getptr(p_path)) {
+		return *hash;
+	}
+
+	const String remapped_path = ResourceLoader::path_remap(p_path);
+	const String hash = FileAccess::exists(remapped_path) ? FileAccess::get_md5(remapped_path) : String();
+	source_hashes.insert(p_path, hash);
+	return hash;
+}
+
+const GDScriptBytecodeCache::ReverseLookup &GDScriptBytecodeCache::_get_reverse_lookup() {
+	if (reverse_lookup) {
+		return *reverse_lookup;
+	}
+
+	reverse_lookup = memnew(ReverseLookup);
+	ReverseLookup &lookup = *reverse_lookup;
+
+	for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+		const Variant::Type type = Variant::Type(i);
+
+		for (int op = 0; op < Variant::OP_MAX; op++) {
+			for (int j = 0; j < Variant::VARIANT_MAX; j++) {
+				Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(Variant::Operator(op), type, Variant::Type(j));
+				if (evaluator && !lookup.operators.has(evaluator)) {
+					ReverseLookup::Operator key;
+					key.op = Variant::Operator(op);
+					key.left = type;
+					key.right = Variant::Type(j);
+					lookup.operators.insert(evaluator, key);
+				}
+			}
+		}
+
+		List<StringName> members;
+		Variant::get_member_list(type, &members);
+		for (const StringName &member : members) {
+			ReverseLookup::Member key;
+			key.type = type;
+			key.name = member;
+			if (Variant::ValidatedSetter setter = Variant::get_member_validated_setter(type, member)) {
+				lookup.setters.insert(setter, key);
+			}
+			if (Variant::ValidatedGetter getter = Variant::get_member_validated_getter(type, member)) {
+				lookup.getters.insert(getter, key);
+			}
+		}
+
+		if (Variant::ValidatedKeyedSetter keyed_setter = Variant::get_member_validated_keyed_setter(type)) {
+			lookup.keyed_setters.insert(keyed_setter, type);
+		}
+		if (Variant::ValidatedKeyedGetter keyed_getter = Variant::get_member_validated_keyed_getter(type)) {
+			lookup.keyed_getters.insert(keyed_getter, type);
+		}
+		if (Variant::ValidatedIndexedSetter indexed_setter = Variant::get_member_validated_indexed_setter(type)) {
+			lookup.indexed_setters.insert(indexed_setter, type);
+		}
+		if (Variant::ValidatedIndexedGetter indexed_getter = Variant::get_member_validated_indexed_getter(type)) {
+			lookup.indexed_getters.insert(indexed_getter, type);
+		}
+
+		List<StringName> methods;
+		Variant::get_builtin_method_list(type, &methods);
+		for (const StringName &method : methods) {
+			if (Variant::ValidatedBuiltInMethod builtin_method = Variant::get_validated_builtin_method(type, method)) {
+				ReverseLookup::Member key;
+				key.type = type;
+				key.name = method;
+				lookup.builtin_methods.insert(builtin_method, key);
+			}
+		}
+
+		for (int c = 0; c < Variant::get_constructor_count(type); c++) {
+			if (Variant::ValidatedConstructor constructor = Variant::get_validated_constructor(type, c)) {
+				ReverseLookup::Constructor key;
+				key.type = type;
+				key.index = c;
+				lookup.constructors.insert(constructor, key);
+			}
+		}
+	}
+
+	List<StringName> utilities;
+	Variant::get_utility_function_list(&utilities);
+	for (const StringName &utility : utilities) {
+		if (Variant::ValidatedUtilityFunction function = Variant::get_validated_utility_function(utility)) {
+			lookup.utilities.insert(function, utility);
+		}
+	}
+
+	List<StringName> gds_utilities;
+	GDScriptUtilityFunctions::get_function_list(&gds_utilities);
+	for (const StringName &utility : gds_utilities) {
+		if (GDScriptUtilityFunctions::FunctionPtr function = GDScriptUtilityFunctions::get_function(utility)) {
+			lookup.gds_utilities.insert(function, utility);
+		}
+	}
+
+	return lookup;
+}
+
+void GDScriptBytecodeCache::_collect_dependencies(GDScriptParser *p_parser, const String &p_root_path, HashSet<String> &r_dependencies) {
+	// Scripts the analyzer looked into, directly or through other scripts. Constants and types can be
+	// folded in from any of them, so all of them must be unchanged for the compiled code to be valid.
+	for (const KeyValue<String, Ref<GDScriptParserRef>> &E : p_parser->get_depended_parsers()) {
+		if (E.key == p_root_path || r_dependencies.has(E.key)) {
+			continue;
+		}
+		r_dependencies.insert(E.key);
+		if (E.value.is_valid()) {
+			_collect_dependencies(E.value->get_parser(), p_root_path, r_dependencies);
+		}
+	}
+}
+
+/* Writing */
+
+bool GDScriptBytecodeCache::_write_script_reference(Writer &p_writer, const Script *p_script) {
+	if (p_script == nullptr) {
+		p_writer.put_u8(SCRIPT_REF_NONE);
+		return true;
+	}
+
+	const GDScript *gdscript = Object::cast_to<GDScript>(p_script);
+	if (gdscript) {
+		Vector<StringName> class_names;
+		const GDScript *root = gdscript;
+		while (root->_owner) {
+			class_names.push_back(root->local_name);
+			root = root->_owner;
+		}
+		if (root->path.is_empty() || root->path.contains("::")) {
+			return false; // Built-in scripts can't be found by path alone.
+		}
+
+		p_writer.put_u8(SCRIPT_REF_GDSCRIPT);
+		p_writer.put_string(root->path);
+		p_writer.put_32(class_names.size());
+		for (int i = class_names.size() - 1; i >= 0; i--) {
+			p_writer.put_string(class_names[i]);
+		}
+		return true;
+	}
+
+	if (p_script->get_path().is_empty() || p_script->is_built_in()) {
+		return false;
+	}
+	p_writer.put_u8(SCRIPT_REF_RESOURCE);
+	p_writer.put_string(p_script->get_path());
+	return true;
+}
+
+bool GDScriptBytecodeCache::_write_variant(Writer &p_writer, const Variant &p_variant, SaveContext &p_context, int p_depth) {
+	if (p_depth > MAX_VARIANT_DEPTH) {
+		return false;
+	}
+
+	switch (p_variant.get_type()) {
+		case Variant::CALLABLE:
+		case Variant::SIGNAL:
+		case Variant::RID: {
+			return false; // Only meaningful in the run they were created in.
+		} break;
+		case Variant::ARRAY: {
+			const Array array = p_variant;
+			p_writer.put_u8(VARIANT_ARRAY);
+			p_writer.put_u8(array.is_read_only());
+			p_writer.put_32(array.get_typed_builtin());
+			p_writer.put_string(array.get_typed_class_name());
+			if (!_write_script_reference(p_writer, Object::cast_to<Script>(array.get_typed_script()))) {
+				return false;
+			}
+			p_writer.put_32(array.size());
+			for (int i = 0; i < array.size(); i++) {
+				if (!_write_variant(p_writer, array[i], p_context, p_depth + 1)) {
+					return false;
+				}
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			const Dictionary dictionary = p_variant;
+			p_writer.put_u8(VARIANT_DICTIONARY);
+			p_writer.put_u8(dictionary.is_read_only());
+			p_writer.put_32(dictionary.get_typed_key_builtin());
+			p_writer.put_string(dictionary.get_typed_key_class_name());
+			if (!_write_script_reference(p_writer, Object::cast_to<Script>(dictionary.get_typed_key_script()))) {
+				return false;
+			}
+			p_writer.put_32(dictionary.get_typed_value_builtin());
+			p_writer.put_string(dictionary.get_typed_value_class_name());
+			if (!_write_script_reference(p_writer, Object::cast_to<Script>(dictionary.get_typed_value_script()))) {
+				return false;
+			}
+			p_writer.put_32(dictionary.size());
+			for (const KeyValue<Variant, Variant> &kv : dictionary) {
+				if (!_write_variant(p_writer, kv.key, p_context, p_depth + 1) || !_write_variant(p_writer, kv.value, p_context, p_depth + 1)) {
+					return false;
+				}
+			}
+		} break;
+		case Variant::OBJECT: {
+			bool was_freed = false;
+			Object *object = p_variant.get_validated_object_with_check(was_freed);
+			if (was_freed) {
+				return false;
+			}
+			if (object == nullptr) {
+				p_writer.put_u8(VARIANT_NULL_OBJECT);
+				break;
+			}
+			if (const StringName *global = p_context.global_objects.getptr(object->get_instance_id())) {
+				p_writer.put_u8(VARIANT_GLOBAL);
+				p_writer.put_string(*global);
+				break;
+			}
+			if (const Script *script = Object::cast_to<Script>(object)) {
+				p_writer.put_u8(VARIANT_SCRIPT);
+				return _write_script_reference(p_writer, script);
+			}
+			const Resource *resource = Object::cast_to<Resource>(object);
+			if (resource && !resource->get_path().is_empty() && !resource->is_built_in()) {
+				p_writer.put_u8(VARIANT_RESOURCE);
+				p_writer.put_string(resource->get_path());
+				break;
+			}
+			return false;
+		} break;
+		default: {
+			int length = 0;
+			if (encode_variant(p_variant, nullptr, length) != OK) {
+				return false;
+			}
+			p_writer.put_u8(VARIANT_PLAIN);
+			p_writer.put_32(length);
+			const uint32_t offset = p_writer.data.size();
+			p_writer.data.resize(offset + length);
+			encode_variant(p_variant, p_writer.data.ptr() + offset, length);
+		} break;
+	}
+
+	return true;
+}
+
+bool GDScriptBytecodeCache::_write_data_type(Writer &p_writer, const GDScriptDataType &p_data_type) {
+	p_writer.put_u8(p_data_type.kind);
+	p_writer.put_u8(p_data_type.has_type);
+	p_writer.put_32(p_data_type.builtin_type);
+	p_writer.put_string(p_data_type.native_type);
+	// Types referring to classes of the same file hold no reference, to avoid cycles.
+	p_writer.put_u8(p_data_type.script_type_ref.is_valid());
+	if (!_write_script_reference(p_writer, p_data_type.script_type)) {
+		return false;
+	}
+	p_writer.put_32(p_data_type.container_element_types.size());
+	for (const GDScriptDataType &element_type : p_data_type.container_element_types) {
+		if (!_write_data_type(p_writer, element_type)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void GDScriptBytecodeCache::_write_property_info(Writer &p_writer, const PropertyInfo &p_info) {
+	p_writer.put_32(p_info.type);
+	p_writer.put_string(p_info.name);
+	p_writer.put_string(p_info.class_name);
+	p_writer.put_32(p_info.hint);
+	p_writer.put_string(p_info.hint_string);
+	p_writer.put_32(p_info.usage);
+}
+
+bool GDScriptBytecodeCache::_write_method_info(Writer &p_writer, const MethodInfo &p_info, SaveContext &p_context) {
+	p_writer.put_string(p_info.name);
+	_write_property_info(p_writer, p_info.return_val);
+	p_writer.put_32(p_info.flags);
+	p_writer.put_32(p_info.id);
+	p_writer.put_32(p_info.arguments.size());
+	for (const PropertyInfo &argument : p_info.arguments) {
+		_write_property_info(p_writer, argument);
+	}
+	p_writer.put_32(p_info.default_arguments.size());
+	for (const Variant &default_argument : p_info.default_arguments) {
+		if (!_write_variant(p_writer, default_argument, p_context)) {
+			return false;
+		}
+	}
+	p_writer.put_32(p_info.return_val_metadata);
+	p_writer.put_32(p_info.arguments_metadata.size());
+	for (int metadata : p_info.arguments_metadata) {
+		p_writer.put_32(metadata);
+	}
+	return true;
+}
+
+bool GDScriptBytecodeCache::_write_function(Writer &p_writer, const GDScriptFunction *p_function, SaveContext &p_context) {
+	const ReverseLookup &lookup = _get_reverse_lookup();
+
+	p_writer.put_string(p_function->name);
+	p_writer.put_u8(p_function->_static);
+	p_writer.put_32(p_function->_initial_line);
+	p_writer.put_32(p_function->_argument_count);
+	p_writer.put_32(p_function->_vararg_index);
+	p_writer.put_32(p_function->_stack_size);
+	p_writer.put_32(p_function->_instruction_args_size);
+
+	p_writer.put_32(p_function->argument_types.size());
+	for (const GDScriptDataType &argument_type : p_function->argument_types) {
+		if (!_write_data_type(p_writer, argument_type)) {
+			return false;
+		}
+	}
+	if (!_write_data_type(p_writer, p_function->return_type)) {
+		return false;
+	}
+	if (!_write_method_info(p_writer, p_function->method_info, p_context)) {
+		return false;
+	}
+	if (!_write_variant(p_writer, p_function->rpc_config, p_context)) {
+		return false;
+	}
+
+	p_writer.put_32(p_function->temporary_slots.size());
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		p_writer.put_32(E.key);
+		p_writer.put_32(E.value);
+	}
+
+	// Code only holds stack addresses, jump offsets and indices into the tables below, except for
+	// the global array indices which are remapped by name on load.
+	p_writer.put_32(p_function->code.size());
+	for (int word : p_function->code) {
+		p_writer.put_32(word);
+	}
+	p_writer.put_32(p_function->global_index_offsets.size());
+	for (int offset : p_function->global_index_offsets) {
+		const StringName *global = p_context.global_names.getptr(p_function->code[offset]);
+		if (global == nullptr) {
+			return false;
+		}
+		p_writer.put_32(offset);
+		p_writer.put_string(*global);
+	}
+
+	p_writer.put_32(p_function->default_arguments.size());
+	for (int default_argument : p_function->default_arguments) {
+		p_writer.put_32(default_argument);
+	}
+
+	p_writer.put_32(p_function->constants.size());
+	for (const Variant &constant : p_function->constants) {
+		if (!_write_variant(p_writer, constant, p_context)) {
+			return false;
+		}
+	}
+
+	p_writer.put_32(p_function->global_names.size());
+	for (const StringName &global_name : p_function->global_names) {
+		p_writer.put_string(global_name);
+	}
+
+	// Validated functions are stored as what they were looked up by.
+	p_writer.put_32(p_function->operator_funcs.size());
+	for (Variant::ValidatedOperatorEvaluator evaluator : p_function->operator_funcs) {
+		const ReverseLookup::Operator *key = lookup.operators.getptr(evaluator);
+		if (key == nullptr) {
+			return false;
+		}
+		p_writer.put_32(key->op);
+		p_writer.put_32(key->left);
+		p_writer.put_32(key->right);
+	}
+
+	p_writer.put_32(p_function->setters.size());
+	for (Variant::ValidatedSetter setter : p_function->setters) {
+		const ReverseLookup::Member *key = lookup.setters.getptr(setter);
+		if (key == nullptr) {
+			return false;
+		}
+		p_writer.put_32(key->type);
+		p_writer.put_string(key->name);
+	}
+
+	p_writer.put_32(p_function->getters.size());
+	for (Variant::ValidatedGetter getter : p_function->getters) {
+		const ReverseLookup::Member *key = lookup.getters.getptr(getter);
+		if (key == nullptr) {
+			return false;
+		}
+		p_writer.put_32(key->type);
+		p_writer.put_string(key->name);
+	}
+
+	p_writer.put_32(p_function->keyed_setters.size());
+	for (Variant::ValidatedKeyedSetter keyed_setter : p_function->keyed_setters) {
+		const Variant::Type *type = lookup.keyed_setters.getptr(keyed_setter);
+		if (type == nullptr) {
+			return false;
+		}
+		p_writer.put_32(*type);
+	}
+
+	p_writer.put_32(p_function->keyed_getters.size());
+	for (Variant::ValidatedKeyedGetter keyed_getter : p_function->keyed_getters) {
+		const Variant::Type *type = lookup.keyed_getters.getptr(keyed_getter);
+		if (type == nullptr) {
+			return false;
+		}
+		p_writer.put_32(*type);
+	}
+
+	p_writer.put_32(p_function->indexed_setters.size());
+	for (Variant::ValidatedIndexedSetter indexed_setter : p_function->indexed_setters) {
+		const Variant::Type *type = lookup.indexed_setters.getptr(indexed_setter);
+		if (type == nullptr) {
+			return false;
+		}
+		p_writer.put_32(*type);
+	}
+
+	p_writer.put_32(p_function->indexed_getters.size());
+	for (Variant::ValidatedIndexedGetter indexed_getter : p_function->indexed_getters) {
+		const Variant::Type *type = lookup.indexed_getters.getptr(indexed_getter);
+		if (type == nullptr) {
+			return false;
+		}
+		p_writer.put_32(*type);
+	}
+
+	p_writer.put_32(p_function->builtin_methods.size());
+	for (Variant::ValidatedBuiltInMethod builtin_method : p_function->builtin_methods) {
+		const ReverseLookup::Member *key = lookup.builtin_methods.getptr(builtin_method);
+		if (key == nullptr) {
+			return false;
+		}
+		p_writer.put_32(key->type);
+		p_writer.put_string(key->name);
+	}
+
+	p_writer.put_32(p_function->constructors.size());
+	for (Variant::ValidatedConstructor constructor : p_function->constructors) {
+		const ReverseLookup::Constructor *key = lookup.constructors.getptr(constructor);
+		if (key == nullptr) {
+			return false;
+		}
+		p_writer.put_32(key->type);
+		p_writer.put_32(key->index);
+	}
+
+	p_writer.put_32(p_function->utilities.size());
+	for (Variant::ValidatedUtilityFunction utility : p_function->utilities) {
+		const StringName *name = lookup.utilities.getptr(utility);
+		if (name == nullptr) {
+			return false;
+		}
+		p_writer.put_string(*name);
+	}
+
+	p_writer.put_32(p_function->gds_utilities.size());
+	for (GDScriptUtilityFunctions::FunctionPtr gds_utility : p_function->gds_utilities) {
+		const StringName *name = lookup.gds_utilities.getptr(gds_utility);
+		if (name == nullptr) {
+			return false;
+		}
+		p_writer.put_string(*name);
+	}
+
+	// Method binds are found again by class and name. The hash makes sure a changed extension
+	// signature doesn't reach code compiled for validated calls with the old one.
+	p_writer.put_32(p_function->methods.size());
+	for (const MethodBind *method : p_function->methods) {
+		if (ClassDB::get_method(method->get_instance_class(), method->get_name()) != method) {
+			return false;
+		}
+		p_writer.put_string(method->get_instance_class());
+		p_writer.put_string(method->get_name());
+		p_writer.put_32(method->get_hash());
+	}
+
+	p_writer.put_32(p_function->lambdas.size());
+	for (const GDScriptFunction *lambda : p_function->lambdas) {
+		const GDScript::LambdaInfo *info = lambda->_script->lambda_info.getptr(const_cast<GDScriptFunction *>(lambda));
+		if (info == nullptr) {
+			return false;
+		}
+		p_writer.put_32(info->capture_count);
+		p_writer.put_u8(info->use_self);
+		if (!_write_function(p_writer, lambda, p_context)) {
+			return false;
+		}
+	}
+
+	p_writer.put_32(p_function->_inline_cache_count);
+
+	return true;
+}
+
+void GDScriptBytecodeCache::_write_skeleton(Writer &p_writer, const GDScript *p_script) {
+	p_writer.put_string(p_script->fully_qualified_name);
+	p_writer.put_string(p_script->local_name);
+	p_writer.put_string(p_script->global_name);
+	p_writer.put_string(p_script->simplified_icon_path);
+	p_writer.put_32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		p_writer.put_string(E.key);
+		_write_skeleton(p_writer, E.value.ptr());
+	}
+}
+
+bool GDScriptBytecodeCache::_write_class(Writer &p_writer, const GDScript *p_script, SaveContext &p_context) {
+	p_writer.put_u8(p_script->tool);
+	p_writer.put_u8(p_script->_is_abstract);
+
+	if (p_script->native.is_null()) {
+		return false;
+	}
+	p_writer.put_string(p_script->native->get_name());
+	if (!_write_script_reference(p_writer, p_script->base.ptr())) {
+		return false;
+	}
+
+	for (const HashMap<StringName, GDScript::MemberInfo> *indices : { &p_script->member_indices, &p_script->static_variables_indices }) {
+		p_writer.put_32(indices->size());
+		for (const KeyValue<StringName, GDScript::MemberInfo> &E : *indices) {
+			p_writer.put_string(E.key);
+			p_writer.put_32(E.value.index);
+			p_writer.put_string(E.value.setter);
+			p_writer.put_string(E.value.getter);
+			if (!_write_data_type(p_writer, E.value.data_type)) {
+				return false;
+			}
+			_write_property_info(p_writer, E.value.property_info);
+		}
+	}
+
+	p_writer.put_32(p_script->members.size());
+	for (const StringName &member : p_script->members) {
+		p_writer.put_string(member);
+	}
+
+	p_writer.put_32(p_script->constants.size());
+	for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+		p_writer.put_string(E.key);
+		if (!_write_variant(p_writer, E.value, p_context)) {
+			return false;
+		}
+	}
+
+	p_writer.put_32(p_script->_signals.size());
+	for (const KeyValue<StringName, MethodInfo> &E : p_script->_signals) {
+		p_writer.put_string(E.key);
+		if (!_write_method_info(p_writer, E.value, p_context)) {
+			return false;
+		}
+	}
+
+	if (!_write_variant(p_writer, p_script->rpc_config, p_context)) {
+		return false;
+	}
+
+	p_writer.put_32(p_script->member_functions.size());
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		if (!_write_function(p_writer, E.value, p_context)) {
+			return false;
+		}
+	}
+
+	for (const GDScriptFunction *function : { p_script->implicit_initializer, p_script->implicit_ready, p_script->static_initializer }) {
+		p_writer.put_u8(function != nullptr);
+		if (function && !_write_function(p_writer, function, p_context)) {
+			return false;
+		}
+	}
+
+#ifdef TOOLS_ENABLED
+	p_writer.put_32(p_script->member_default_values.size());
+	for (const KeyValue<StringName, Variant> &E : p_script->member_default_values) {
+		p_writer.put_string(E.key);
+		if (!_write_variant(p_writer, E.value, p_context)) {
+			return false;
+		}
+	}
+#endif
+
+	p_writer.put_32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		p_writer.put_string(E.key);
+		if (!_write_class(p_writer, E.value.ptr(), p_context)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Reading */
+
+Ref<Script> GDScriptBytecodeCache::_read_script_reference(Reader &p_reader, LoadContext &p_context) {
+	switch (p_reader.get_u8()) {
+		case SCRIPT_REF_NONE: {
+			return Ref<Script>();
+		} break;
+		case SCRIPT_REF_GDSCRIPT: {
+			const String path = p_reader.get_string();
+			const int class_count = p_reader.get_count();
+			if (p_reader.failed) {
+				return Ref<Script>();
+			}
+
+			GDScript *script = nullptr;
+			if (path == p_context.path) {
+				script = p_context.root;
+			} else {
+				// Registered as a dependency, so it gets fully compiled once this script is done.
+				Error err = OK;
+				Ref<GDScript> root = GDScriptCache::get_shallow_script(path, err, p_context.path);
+				if (err == OK) {
+					script = root.ptr();
+				}
+			}
+
+			for (int i = 0; i < class_count; i++) {
+				const StringName class_name = p_reader.get_string();
+				if (script) {
+					Ref<GDScript> *subclass = script->subclasses.getptr(class_name);
+					script = subclass ? subclass->ptr() : nullptr;
+				}
+			}
+
+			if (script == nullptr) {
+				p_reader.failed = true;
+				return Ref<Script>();
+			}
+			return Ref<Script>(script);
+		} break;
+		case SCRIPT_REF_RESOURCE: {
+			const String path = p_reader.get_string();
+			if (p_reader.failed) {
+				return Ref<Script>();
+			}
+			Ref<Script> script = ResourceLoader::load(path);
+			if (script.is_null()) {
+				p_reader.failed = true;
+			}
+			return script;
+		} break;
+		default: {
+			p_reader.failed = true;
+		} break;
+	}
+
+	return Ref<Script>();
+}
+
+bool GDScriptBytecodeCache::_read_variant(Reader &p_reader, LoadContext &p_context, Variant &r_variant, int p_depth) {
+	if (p_depth > MAX_VARIANT_DEPTH) {
+		p_reader.failed = true;
+	}
+	if (p_reader.failed) {
+		return false;
+	}
+
+	switch (p_reader.get_u8()) {
+		case VARIANT_PLAIN: {
+			const int length = p_reader.get_count();
+			if (p_reader.failed) {
+				return false;
+			}
+			int used = 0;
+			if (decode_variant(r_variant, p_reader.data + p_reader.position, length, &used) != OK || used != length) {
+				p_reader.failed = true;
+				return false;
+			}
+			p_reader.position += length;
+		} break;
+		case VARIANT_ARRAY: {
+			const bool read_only = p_reader.get_u8();
+			const Variant::Type type = p_reader.get_type();
+			const StringName class_name = p_reader.get_string();
+			const Ref<Script> script = _read_script_reference(p_reader, p_context);
+			const int size = p_reader.get_count();
+			if (p_reader.failed) {
+				return false;
+			}
+
+			Array array;
+			if (type != Variant::NIL) {
+				array.set_typed(type, class_name, script);
+			}
+			for (int i = 0; i < size; i++) {
+				Variant element;
+				if (!_read_variant(p_reader, p_context, element, p_depth + 1)) {
+					return false;
+				}
+				array.push_back(element);
+			}
+			if (read_only) {
+				array.make_read_only();
+			}
+			r_variant = array;
+		} break;
+		case VARIANT_DICTIONARY: {
+			const bool read_only = p_reader.get_u8();
+			const Variant::Type key_type = p_reader.get_type();
+			const StringName key_class_name = p_reader.get_string();
+			const Ref<Script> key_script = _read_script_reference(p_reader, p_context);
+			const Variant::Type value_type = p_reader.get_type();
+			const StringName value_class_name = p_reader.get_string();
+			const Ref<Script> value_script = _read_script_reference(p_reader, p_context);
+			const int size = p_reader.get_count();
+			if (p_reader.failed) {
+				return false;
+			}
+
+			Dictionary dictionary;
+			if (key_type != Variant::NIL || value_type != Variant::NIL) {
+				dictionary.set_typed(key_type, key_class_name, key_script, value_type, value_class_name, value_script);
+			}
+			for (int i = 0; i < size; i++) {
+				Variant key;
+				Variant value;
+				if (!_read_variant(p_reader, p_context, key, p_depth + 1) || !_read_variant(p_reader, p_context, value, p_depth + 1)) {
+					return false;
+				}
+				dictionary[key] = value;
+			}
+			if (read_only) {
+				dictionary.make_read_only();
+			}
+			r_variant = dictionary;
+		} break;
+		case VARIANT_NULL_OBJECT: {
+			r_variant = Variant((Object *)nullptr);
+		} break;
+		case VARIANT_SCRIPT: {
+			const Ref<Script> script = _read_script_reference(p_reader, p_context);
+			if (script.is_null()) {
+				p_reader.failed = true;
+				return false;
+			}
+			r_variant = script;
+		} break;
+		case VARIANT_GLOBAL: {
+			const StringName name = p_reader.get_string();
+			const int *index = GDScriptLanguage::get_singleton()->get_global_map().getptr(name);
+			if (index == nullptr) {
+				p_reader.failed = true;
+				return false;
+			}
+			r_variant = GDScriptLanguage::get_singleton()->get_global_array()[*index];
+		} break;
+		case VARIANT_RESOURCE: {
+			const String path = p_reader.get_string();
+			if (p_reader.failed) {
+				return false;
+			}
+			const Ref<Resource> resource = ResourceLoader::load(path);
+			if (resource.is_null()) {
+				p_reader.failed = true;
+				return false;
+			}
+			r_variant = resource;
+		} break;
+		default: {
+			p_reader.failed = true;
+		} break;
+	}
+
+	return !p_reader.failed;
+}
+
+bool GDScriptBytecodeCache::_read_data_type(Reader &p_reader, LoadContext &p_context, GDScriptDataType &r_data_type) {
+	const uint8_t kind = p_reader.get_u8();
+	if (kind > GDScriptDataType::GDSCRIPT) {
+		p_reader.failed = true;
+		return false;
+	}
+	r_data_type.kind = GDScriptDataType::Kind(kind);
+	r_data_type.has_type = p_reader.get_u8();
+	r_data_type.builtin_type = p_reader.get_type();
+	r_data_type.native_type = p_reader.get_string();
+
+	const bool holds_reference = p_reader.get_u8();
+	const Ref<Script> script = _read_script_reference(p_reader, p_context);
+	r_data_type.script_type = script.ptr();
+	if (holds_reference) {
+		r_data_type.script_type_ref = script;
+	}
+
+	const int element_count = p_reader.get_count();
+	for (int i = 0; i < element_count; i++) {
+		GDScriptDataType element_type;
+		if (!_read_data_type(p_reader, p_context, element_type)) {
+			return false;
+		}
+		r_data_type.container_element_types.push_back(element_type);
+	}
+
+	return !p_reader.failed;
+}
+
+bool GDScriptBytecodeCache::_read_property_info(Reader &p_reader, PropertyInfo &r_info) {
+	r_info.type = p_reader.get_type();
+	r_info.name = p_reader.get_string();
+	r_info.class_name = p_reader.get_string();
+	r_info.hint = PropertyHint(p_reader.get_32());
+	r_info.hint_string = p_reader.get_string();
+	r_info.usage = p_reader.get_32();
+	return !p_reader.failed;
+}
+
+bool GDScriptBytecodeCache::_read_method_info(Reader &p_reader, LoadContext &p_context, MethodInfo &r_info) {
+	r_info.name = p_reader.get_string();
+	_read_property_info(p_reader, r_info.return_val);
+	r_info.flags = p_reader.get_32();
+	r_info.id = p_reader.get_int();
+
+	const int argument_count = p_reader.get_count();
+	for (int i = 0; i < argument_count; i++) {
+		PropertyInfo argument;
+		if (!_read_property_info(p_reader, argument)) {
+			return false;
+		}
+		r_info.arguments.push_back(argument);
+	}
+
+	const int default_argument_count = p_reader.get_count();
+	for (int i = 0; i < default_argument_count; i++) {
+		Variant default_argument;
+		if (!_read_variant(p_reader, p_context, default_argument)) {
+			return false;
+		}
+		r_info.default_arguments.push_back(default_argument);
+	}
+
+	r_info.return_val_metadata = p_reader.get_int();
+	const int metadata_count = p_reader.get_count();
+	for (int i = 0; i < metadata_count; i++) {
+		r_info.arguments_metadata.push_back(p_reader.get_int());
+	}
+
+	return !p_reader.failed;
+}
+
+bool GDScriptBytecodeCache::_validate_function(GDScriptFunction *p_function, int p_member_count) {
+	// The VM trusts compiled code and only checks most operands in debug builds, so everything it will index
+	// with is checked against the tables it was restored with before the function can be called.
+	const int stack_size = p_function->_stack_size;
+	if (p_function->_argument_count < 0 || p_function->argument_types.size() != p_function->_argument_count || p_function->_instruction_args_size < 0) {
+		return false;
+	}
+	if (stack_size < GDScriptFunction::FIXED_ADDRESSES_MAX + p_function->_argument_count) {
+		return false;
+	}
+	if (p_function->_vararg_index != -1 && (p_function->_vararg_index < GDScriptFunction::FIXED_ADDRESSES_MAX || p_function->_vararg_index >= stack_size)) {
+		return false;
+	}
+	if (p_function->default_arguments.size() > p_function->_argument_count + 1) {
+		return false;
+	}
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		if (E.key < 0 || E.key >= stack_size || E.value < 0 || E.value >= Variant::VARIANT_MAX) {
+			return false;
+		}
+	}
+
+	int *code = p_function->code.ptrw();
+	const int code_size = p_function->code.size();
+	if (code_size == 0) {
+		return p_function->default_arguments.is_empty();
+	}
+
+	LocalVector<bool> boundaries;
+	boundaries.resize(code_size);
+	for (int i = 0; i < code_size; i++) {
+		boundaries[i] = false;
+	}
+	LocalVector<int> jumps;
+	LocalVector<int> followers; // Offsets of instructions that must be followed by a given one, then the opcode.
+
+	int ip = 0;
+	int opcode = -1;
+	while (ip < code_size) {
+		boundaries[ip] = true;
+		opcode = code[ip];
+		const OpcodeLayout layout = _get_opcode_layout(opcode);
+		if (layout.operands == nullptr) {
+			return false;
+		}
+
+		int next = ip + 1;
+		if (layout.variadic) {
+			if (next >= code_size) {
+				return false;
+			}
+			const int address_count = code[next++];
+			if (address_count < 0 || address_count > p_function->_instruction_args_size || address_count > code_size - next) {
+				return false;
+			}
+			next += address_count;
+		}
+		const int address_end = next;
+		const int operand_count = strlen(layout.operands);
+		if (operand_count > code_size - next) {
+			return false;
+		}
+		next += operand_count;
+
+		// All addresses come before the trailing operands, so they can be checked in one go.
+		for (int i = ip + 1; i < next; i++) {
+			const int operand = code[i];
+			char kind = 'a';
+			if (i >= address_end) {
+				kind = layout.operands[i - address_end];
+			} else if (layout.variadic && i == ip + 1) {
+				continue; // Address count, checked above.
+			}
+
+			int limit = 0;
+			switch (kind) {
+				case 'a': {
+					const int index = operand & GDScriptFunction::ADDR_MASK;
+					switch ((operand & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS) {
+						case GDScriptFunction::ADDR_TYPE_STACK:
+							limit = stack_size;
+							break;
+						case GDScriptFunction::ADDR_TYPE_CONSTANT:
+							limit = p_function->_constant_count;
+							break;
+						case GDScriptFunction::ADDR_TYPE_MEMBER:
+							limit = p_function->_static ? 0 : p_member_count;
+							break;
+						default:
+							return false;
+					}
+					if (index >= limit) {
+						return false;
+					}
+					continue;
+				}
+				case 'j': {
+					jumps.push_back(operand);
+					continue;
+				}
+				case '#': {
+					if (operand < 0 || operand > code_size || operand * layout.addresses_per_argument + layout.extra_addresses > address_end - ip - 2) {
+						return false;
+					}
+					continue;
+				}
+				case '-':
+					continue;
+				case 't':
+					limit = Variant::VARIANT_MAX;
+					break;
+				case 'v':
+					limit = Variant::OP_MAX;
+					break;
+				case 'n':
+					limit = p_function->_global_names_count;
+					break;
+				case 'o':
+					limit = p_function->_operator_funcs_count;
+					break;
+				case 'i':
+					limit = p_function->_inline_cache_count;
+					break;
+				case 's':
+					limit = p_function->_setters_count;
+					break;
+				case 'g':
+					limit = p_function->_getters_count;
+					break;
+				case 'k':
+					limit = p_function->_keyed_setters_count;
+					break;
+				case 'K':
+					limit = p_function->_keyed_getters_count;
+					break;
+				case 'x':
+					limit = p_function->_indexed_setters_count;
+					break;
+				case 'X':
+					limit = p_function->_indexed_getters_count;
+					break;
+				case 'b':
+					limit = p_function->_builtin_methods_count;
+					break;
+				case 'c':
+					limit = p_function->_constructors_count;
+					break;
+				case 'u':
+					limit = p_function->_utilities_count;
+					break;
+				case 'U':
+					limit = p_function->_gds_utilities_count;
+					break;
+				case 'm':
+					limit = p_function->_methods_count;
+					break;
+				case 'l':
+					limit = p_function->_lambdas_count;
+					break;
+				case 'G':
+					limit = GDScriptLanguage::get_singleton()->get_global_array_size();
+					break;
+				default:
+					return false;
+			}
+			if (operand < 0 || operand >= limit) {
+				return false;
+			}
+		}
+
+		switch (opcode) {
+			case GDScriptFunction::OPCODE_OPERATOR: {
+				// The signature, return type and evaluator the VM fills in on first use. Starting over keeps a
+				// stale or forged evaluator pointer from ever being called.
+				constexpr int pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*code);
+				if (2 + pointer_size > code_size - next) {
+					return false;
+				}
+				for (int i = 0; i < 2 + pointer_size; i++) {
+					code[next++] = 0;
+				}
+			} break;
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+				followers.push_back(next);
+				followers.push_back(GDScriptFunction::OPCODE_JUMP_IF);
+				break;
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT:
+				followers.push_back(next);
+				followers.push_back(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+				break;
+			case GDScriptFunction::OPCODE_AWAIT:
+				followers.push_back(next);
+				followers.push_back(GDScriptFunction::OPCODE_AWAIT_RESUME);
+				break;
+			case GDScriptFunction::OPCODE_GET_MEMBER_OPERATOR_VALIDATED:
+				// Any validated operator, its evaluator index is checked on its own.
+				if (next >= code_size || !(code[next] == GDScriptFunction::OPCODE_OPERATOR_VALIDATED || (code[next] >= GDScriptFunction::OPCODE_OPERATOR_ADD_INT && code[next] <= GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT))) {
+					return false;
+				}
+				break;
+			default:
+				break;
+		}
+
+		ip = next;
+	}
+
+	// The VM doesn't check for the end of the code in release builds.
+	if (opcode != GDScriptFunction::OPCODE_END) {
+		return false;
+	}
+	for (uint32_t i = 0; i < followers.size(); i += 2) {
+		if (followers[i] >= code_size || code[followers[i]] != followers[i + 1]) {
+			return false;
+		}
+	}
+	for (int target : jumps) {
+		if (target < 0 || target >= code_size || !boundaries[target]) {
+			return false;
+		}
+	}
+	for (int offset : p_function->default_arguments) {
+		if (offset < 0 || offset >= code_size || !boundaries[offset]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+GDScriptFunction *GDScriptBytecodeCache::_read_function(Reader &p_reader, LoadContext &p_context, GDScript *p_script) {
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	function->_script = p_script;
+	function->source = p_script->get_script_path();
+
+	function->name = p_reader.get_string();
+	function->_static = p_reader.get_u8();
+	function->_initial_line = p_reader.get_int();
+	function->_argument_count = p_reader.get_int();
+	function->_vararg_index = p_reader.get_int();
+	function->_stack_size = p_reader.get_int();
+	function->_instruction_args_size = p_reader.get_int();
+
+	const int argument_type_count = p_reader.get_count();
+	for (int i = 0; i < argument_type_count && !p_reader.failed; i++) {
+		GDScriptDataType argument_type;
+		_read_data_type(p_reader, p_context, argument_type);
+		function->argument_types.push_back(argument_type);
+	}
+	_read_data_type(p_reader, p_context, function->return_type);
+	_read_method_info(p_reader, p_context, function->method_info);
+	_read_variant(p_reader, p_context, function->rpc_config);
+
+	const int temporary_count = p_reader.get_count();
+	for (int i = 0; i < temporary_count; i++) {
+		const int slot = p_reader.get_int();
+		function->temporary_slots[slot] = p_reader.get_type();
+	}
+
+	const int code_size = p_reader.get_count();
+	function->code.resize(code_size);
+	for (int i = 0; i < code_size; i++) {
+		function->code.write[i] = p_reader.get_int();
+	}
+
+	const int global_index_count = p_reader.get_count();
+	for (int i = 0; i < global_index_count && !p_reader.failed; i++) {
+		const int offset = p_reader.get_int();
+		const int *index = GDScriptLanguage::get_singleton()->get_global_map().getptr(p_reader.get_string());
+		if (offset < 0 || offset >= code_size || index == nullptr) {
+			p_reader.failed = true;
+			break;
+		}
+		function->code.write[offset] = *index;
+		function->global_index_offsets.push_back(offset);
+	}
+
+	const int default_argument_count = p_reader.get_count();
+	for (int i = 0; i < default_argument_count; i++) {
+		function->default_arguments.push_back(p_reader.get_int());
+	}
+
+	const int constant_count = p_reader.get_count();
+	for (int i = 0; i < constant_count && !p_reader.failed; i++) {
+		Variant constant;
+		_read_variant(p_reader, p_context, constant);
+		function->constants.push_back(constant);
+	}
+
+	const int global_name_count = p_reader.get_count();
+	for (int i = 0; i < global_name_count; i++) {
+		function->global_names.push_back(p_reader.get_string());
+	}
+
+	const int operator_count = p_reader.get_count();
+	for (int i = 0; i < operator_count && !p_reader.failed; i++) {
+		const uint32_t op = p_reader.get_32();
+		const Variant::Type left = p_reader.get_type();
+		const Variant::Type right = p_reader.get_type();
+		Variant::ValidatedOperatorEvaluator evaluator = op < Variant::OP_MAX ? Variant::get_validated_operator_evaluator(Variant::Operator(op), left, right) : nullptr;
+		if (evaluator == nullptr) {
+			p_reader.failed = true;
+		}
+		function->operator_funcs.push_back(evaluator);
+#ifdef DEBUG_ENABLED
+		function->operator_names.push_back(op < Variant::OP_MAX ? Variant::get_operator_name(Variant::Operator(op)) : String());
+#endif
+	}
+
+	const int setter_count = p_reader.get_count();
+	for (int i = 0; i < setter_count && !p_reader.failed; i++) {
+		const Variant::Type type = p_reader.get_type();
+		const StringName name = p_reader.get_string();
+		Variant::ValidatedSetter setter = Variant::get_member_validated_setter(type, name);
+		if (setter == nullptr) {
+			p_reader.failed = true;
+		}
+		function->setters.push_back(setter);
+#ifdef DEBUG_ENABLED
+		function->setter_names.push_back(name);
+#endif
+	}
+
+	const int getter_count = p_reader.get_count();
+	for (int i = 0; i < getter_count && !p_reader.failed; i++) {
+		const Variant::Type type = p_reader.get_type();
+		const StringName name = p_reader.get_string();
+		Variant::ValidatedGetter getter = Variant::get_member_validated_getter(type, name);
+		if (getter == nullptr) {
+			p_reader.failed = true;
+		}
+		function->getters.push_back(getter);
+#ifdef DEBUG_ENABLED
+		function->getter_names.push_back(name);
+#endif
+	}
+
+	const int keyed_setter_count = p_reader.get_count();
+	for (int i = 0; i < keyed_setter_count && !p_reader.failed; i++) {
+		Variant::ValidatedKeyedSetter keyed_setter = Variant::get_member_validated_keyed_setter(p_reader.get_type());
+		if (keyed_setter == nullptr) {
+			p_reader.failed = true;
+		}
+		function->keyed_setters.push_back(keyed_setter);
+	}
+
+	const int keyed_getter_count = p_reader.get_count();
+	for (int i = 0; i < keyed_getter_count && !p_reader.failed; i++) {
+		Variant::ValidatedKeyedGetter keyed_getter = Variant::get_member_validated_keyed_getter(p_reader.get_type());
+		if (keyed_getter == nullptr) {
+			p_reader.failed = true;
+		}
+		function->keyed_getters.push_back(keyed_getter);
+	}
+
+	const int indexed_setter_count = p_reader.get_count();
+	for (int i = 0; i < indexed_setter_count && !p_reader.failed; i++) {
+		Variant::ValidatedIndexedSetter indexed_setter = Variant::get_member_validated_indexed_setter(p_reader.get_type());
+		if (indexed_setter == nullptr) {
+			p_reader.failed = true;
+		}
+		function->indexed_setters.push_back(indexed_setter);
+	}
+
+	const int indexed_getter_count = p_reader.get_count();
+	for (int i = 0; i < indexed_getter_count && !p_reader.failed; i++) {
+		Variant::ValidatedIndexedGetter indexed_getter = Variant::get_member_validated_indexed_getter(p_reader.get_type());
+		if (indexed_getter == nullptr) {
+			p_reader.failed = true;
+		}
+		function->indexed_getters.push_back(indexed_getter);
+	}
+
+	const int builtin_method_count = p_reader.get_count();
+	for (int i = 0; i < builtin_method_count && !p_reader.failed; i++) {
+		const Variant::Type type = p_reader.get_type();
+		const StringName name = p_reader.get_string();
+		Variant::ValidatedBuiltInMethod builtin_method = Variant::get_validated_builtin_method(type, name);
+		if (builtin_method == nullptr) {
+			p_reader.failed = true;
+		}
+		function->builtin_methods.push_back(builtin_method);
+#ifdef DEBUG_ENABLED
+		function->builtin_methods_names.push_back(name);
+#endif
+	}
+
+	const int constructor_count = p_reader.get_count();
+	for (int i = 0; i < constructor_count && !p_reader.failed; i++) {
+		const Variant::Type type = p_reader.get_type();
+		const int index = p_reader.get_int();
+		Variant::ValidatedConstructor constructor = index >= 0 && index < Variant::get_constructor_count(type) ? Variant::get_validated_constructor(type, index) : nullptr;
+		if (constructor == nullptr) {
+			p_reader.failed = true;
+		}
+		function->constructors.push_back(constructor);
+#ifdef DEBUG_ENABLED
+		function->constructors_names.push_back(Variant::get_type_name(type));
+#endif
+	}
+
+	const int utility_count = p_reader.get_count();
+	for (int i = 0; i < utility_count && !p_reader.failed; i++) {
+		const StringName name = p_reader.get_string();
+		Variant::ValidatedUtilityFunction utility = Variant::get_validated_utility_function(name);
+		if (utility == nullptr) {
+			p_reader.failed = true;
+		}
+		function->utilities.push_back(utility);
+#ifdef DEBUG_ENABLED
+		function->utilities_names.push_back(name);
+#endif
+	}
+
+	const int gds_utility_count = p_reader.get_count();
+	for (int i = 0; i < gds_utility_count && !p_reader.failed; i++) {
+		const StringName name = p_reader.get_string();
+		GDScriptUtilityFunctions::FunctionPtr gds_utility = GDScriptUtilityFunctions::get_function(name);
+		if (gds_utility == nullptr) {
+			p_reader.failed = true;
+		}
+		function->gds_utilities.push_back(gds_utility);
+#ifdef DEBUG_ENABLED
+		function->gds_utilities_names.push_back(name);
+#endif
+	}
+
+	const int method_count = p_reader.get_count();
+	for (int i = 0; i < method_count && !p_reader.failed; i++) {
+		const StringName class_name = p_reader.get_string();
+		const StringName method_name = p_reader.get_string();
+		const uint32_t hash = p_reader.get_32();
+		MethodBind *method = ClassDB::get_method(class_name, method_name);
+		if (method == nullptr || method->get_hash() != hash) {
+			p_reader.failed = true;
+		}
+		function->methods.push_back(method);
+	}
+
+	const int lambda_count = p_reader.get_count();
+	for (int i = 0; i < lambda_count && !p_reader.failed; i++) {
+		GDScript::LambdaInfo info;
+		info.capture_count = p_reader.get_int();
+		info.use_self = p_reader.get_u8();
+		GDScriptFunction *lambda = _read_function(p_reader, p_context, p_script);
+		if (lambda == nullptr) {
+			break;
+		}
+		function->lambdas.push_back(lambda);
+		p_script->lambda_info.insert(lambda, info);
+	}
+
+	function->_inline_cache_count = p_reader.get_int();
+
+	if (p_reader.failed || function->_inline_cache_count < 0) {
+		p_reader.failed = true;
+		memdelete(function);
+		return nullptr;
+	}
+
+	// Same layout as `GDScriptByteCodeGenerator::write_end()` produces.
+	function->_code_size = function->code.size();
+	function->_code_ptr = function->_code_size ? function->code.ptrw() : nullptr;
+	function->_default_arg_count = function->default_arguments.size() ? function->default_arguments.size() - 1 : 0;
+	function->_default_arg_ptr = function->default_arguments.size() ? function->default_arguments.ptr() : nullptr;
+	function->_constant_count = function->constants.size();
+	function->_constants_ptr = function->_constant_count ? function->constants.ptrw() : nullptr;
+	function->_global_names_count = function->global_names.size();
+	function->_global_names_ptr = function->_global_names_count ? function->global_names.ptr() : nullptr;
+	function->_operator_funcs_count = function->operator_funcs.size();
+	function->_operator_funcs_ptr = function->_operator_funcs_count ? function->operator_funcs.ptr() : nullptr;
+	function->_setters_count = function->setters.size();
+	function->_setters_ptr = function->_setters_count ? function->setters.ptr() : nullptr;
+	function->_getters_count = function->getters.size();
+	function->_getters_ptr = function->_getters_count ? function->getters.ptr() : nullptr;
+	function->_keyed_setters_count = function->keyed_setters.size();
+	function->_keyed_setters_ptr = function->_keyed_setters_count ? function->keyed_setters.ptr() : nullptr;
+	function->_keyed_getters_count = function->keyed_getters.size();
+	function->_keyed_getters_ptr = function->_keyed_getters_count ? function->keyed_getters.ptr() : nullptr;
+	function->_indexed_setters_count = function->indexed_setters.size();
+	function->_indexed_setters_ptr = function->_indexed_setters_count ? function->indexed_setters.ptr() : nullptr;
+	function->_indexed_getters_count = function->indexed_getters.size();
+	function->_indexed_getters_ptr = function->_indexed_getters_count ? function->indexed_getters.ptr() : nullptr;
+	function->_builtin_methods_count = function->builtin_methods.size();
+	function->_builtin_methods_ptr = function->_builtin_methods_count ? function->builtin_methods.ptr() : nullptr;
+	function->_constructors_count = function->constructors.size();
+	function->_constructors_ptr = function->_constructors_count ? function->constructors.ptr() : nullptr;
+	function->_utilities_count = function->utilities.size();
+	function->_utilities_ptr = function->_utilities_count ? function->utilities.ptr() : nullptr;
+	function->_gds_utilities_count = function->gds_utilities.size();
+	function->_gds_utilities_ptr = function->_gds_utilities_count ? function->gds_utilities.ptr() : nullptr;
+	function->_methods_count = function->methods.size();
+	function->_methods_ptr = function->_methods_count ? function->methods.ptrw() : nullptr;
+	function->_lambdas_count = function->lambdas.size();
+	function->_lambdas_ptr = function->_lambdas_count ? function->lambdas.ptrw() : nullptr;
+
+	if (!_validate_function(function, p_script->member_indices.size())) {
+		p_reader.failed = true;
+		memdelete(function);
+		return nullptr;
+	}
+
+	if (function->_inline_cache_count) {
+		function->_inline_caches = memnew_arr(GDScriptFunction::InlineCache, function->_inline_cache_count);
+	}
+
+#ifdef DEBUG_ENABLED
+	function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+	function->_func_cname = function->func_cname.get_data();
+#endif
+
+	GDScriptNativeCompiler::bind(function);
+
+	return function;
+}
+
+bool GDScriptBytecodeCache::_read_skeleton(Reader &p_reader, GDScript *p_script) {
+	// Same as `GDScriptCompiler::make_scripts()`, so other scripts can refer to inner classes of this one
+	// while it is being loaded.
+	p_script->fully_qualified_name = p_reader.get_string();
+	p_script->local_name = p_reader.get_string();
+	p_script->global_name = p_reader.get_string();
+	p_script->simplified_icon_path = p_reader.get_string();
+
+	const int subclass_count = p_reader.get_count();
+	for (int i = 0; i < subclass_count && !p_reader.failed; i++) {
+		const StringName name = p_reader.get_string();
+		Ref<GDScript> &subclass = p_script->subclasses[name];
+		if (subclass.is_null()) {
+			subclass.instantiate();
+		}
+		subclass->_owner = p_script;
+		subclass->path = p_script->path;
+		_read_skeleton(p_reader, subclass.ptr());
+	}
+
+	return !p_reader.failed;
+}
+
+bool GDScriptBytecodeCache::_read_class(Reader &p_reader, LoadContext &p_context, GDScript *p_script) {
+	p_script->tool = p_reader.get_u8();
+	p_script->_is_abstract = p_reader.get_u8();
+
+	const int *native_index = GDScriptLanguage::get_singleton()->get_global_map().getptr(p_reader.get_string());
+	if (native_index == nullptr) {
+		p_reader.failed = true;
+		return false;
+	}
+	p_script->native = GDScriptLanguage::get_singleton()->get_global_array()[*native_index];
+	if (p_script->native.is_null()) {
+		p_reader.failed = true;
+		return false;
+	}
+
+	p_script->base = _read_script_reference(p_reader, p_context);
+	p_script->_base = p_script->base.ptr();
+
+	for (HashMap<StringName, GDScript::MemberInfo> *indices : { &p_script->member_indices, &p_script->static_variables_indices }) {
+		const int count = p_reader.get_count();
+		for (int i = 0; i < count && !p_reader.failed; i++) {
+			const StringName name = p_reader.get_string();
+			GDScript::MemberInfo info;
+			info.index = p_reader.get_int();
+			info.setter = p_reader.get_string();
+			info.getter = p_reader.get_string();
+			_read_data_type(p_reader, p_context, info.data_type);
+			_read_property_info(p_reader, info.property_info);
+			indices->insert(name, info);
+		}
+	}
+	p_script->static_variables.resize(p_script->static_variables_indices.size());
+
+	const int member_count = p_reader.get_count();
+	for (int i = 0; i < member_count; i++) {
+		p_script->members.insert(p_reader.get_string());
+	}
+
+	const int constant_count = p_reader.get_count();
+	for (int i = 0; i < constant_count && !p_reader.failed; i++) {
+		const StringName name = p_reader.get_string();
+		Variant constant;
+		_read_variant(p_reader, p_context, constant);
+		p_script->constants.insert(name, constant);
+	}
+
+	const int signal_count = p_reader.get_count();
+	for (int i = 0; i < signal_count && !p_reader.failed; i++) {
+		const StringName name = p_reader.get_string();
+		MethodInfo signal;
+		_read_method_info(p_reader, p_context, signal);
+		p_script->_signals.insert(name, signal);
+	}
+
+	Variant rpc_config;
+	_read_variant(p_reader, p_context, rpc_config);
+	p_script->rpc_config = rpc_config;
+
+	const int function_count = p_reader.get_count();
+	for (int i = 0; i < function_count && !p_reader.failed; i++) {
+		GDScriptFunction *function = _read_function(p_reader, p_context, p_script);
+		if (function) {
+			p_script->member_functions[function->name] = function;
+		}
+	}
+	GDScriptFunction **initializer = p_script->member_functions.getptr(GDScriptLanguage::get_singleton()->strings._init);
+	p_script->initializer = initializer ? *initializer : nullptr;
+
+	for (GDScriptFunction **function : { &p_script->implicit_initializer, &p_script->implicit_ready, &p_script->static_initializer }) {
+		if (p_reader.get_u8() && !p_reader.failed) {
+			*function = _read_function(p_reader, p_context, p_script);
+		}
+	}
+
+#ifdef TOOLS_ENABLED
+	const int default_value_count = p_reader.get_count();
+	for (int i = 0; i < default_value_count && !p_reader.failed; i++) {
+		const StringName name = p_reader.get_string();
+		Variant default_value;
+		_read_variant(p_reader, p_context, default_value);
+		p_script->member_default_values[name] = default_value;
+	}
+#endif
+
+	const int subclass_count = p_reader.get_count();
+	for (int i = 0; i < subclass_count && !p_reader.failed; i++) {
+		Ref<GDScript> *subclass = p_script->subclasses.getptr(p_reader.get_string());
+		if (subclass == nullptr) {
+			p_reader.failed = true;
+			break;
+		}
+		_read_class(p_reader, p_context, subclass->ptr());
+	}
+
+	return !p_reader.failed;
+}
+
+void GDScriptBytecodeCache::_clear_class(GDScript *p_script) {
+	for (KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		_clear_class(E.value.ptr());
+	}
+
+	// Functions remove themselves from `member_functions` when deleted.
+	HashMap<StringName, GDScriptFunction *> member_functions = p_script->member_functions;
+	p_script->member_functions.clear();
+	for (const KeyValue<StringName, GDScriptFunction *> &E : member_functions) {
+		memdelete(E.value);
+	}
+	for (GDScriptFunction **function : { &p_script->implicit_initializer, &p_script->implicit_ready, &p_script->static_initializer }) {
+		if (*function) {
+			memdelete(*function);
+			*function = nullptr;
+		}
+	}
+	p_script->initializer = nullptr;
+
+	p_script->native = Ref<GDScriptNativeClass>();
+	p_script->base = Ref<GDScript>();
+	p_script->_base = nullptr;
+	p_script->member_indices.clear();
+	p_script->members.clear();
+	p_script->static_variables_indices.clear();
+	p_script->static_variables.clear();
+	p_script->constants.clear();
+	p_script->_signals.clear();
+	p_script->rpc_config.clear();
+	p_script->lambda_info.clear();
+#ifdef TOOLS_ENABLED
+	p_script->member_default_values.clear();
+#endif
+	p_script->valid = false;
+}
+
+void GDScriptBytecodeCache::_finish_class(GDScript *p_script) {
+	for (KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		_finish_class(E.value.ptr());
+	}
+	p_script->_static_default_init();
+	p_script->valid = true;
+}
+
+/* Public API */
+
+bool GDScriptBytecodeCache::is_enabled() {
+	// The editor reloads scripts as they are edited, and debugging needs the stack and line
+	// information only a real compilation produces.
+	return GDScriptLanguage::get_singleton()->should_cache_bytecode() && !Engine::get_singleton()->is_editor_hint() && !EngineDebugger::is_active();
+}
+
+bool GDScriptBytecodeCache::_open_entry(const String &p_path, Vector<uint8_t> &r_buffer, Reader &r_reader) {
+	if (p_path.is_empty() || p_path.contains("::")) {
+		return false;
+	}
+
+	const String cache_file = _get_cache_file(p_path);
+	if (!FileAccess::exists(cache_file)) {
+		return false;
+	}
+	r_buffer = FileAccess::get_file_as_bytes(cache_file);
+	if (r_buffer.size() < 8 || hash_murmur3_buffer(r_buffer.ptr(), r_buffer.size() - 4) != decode_uint32(r_buffer.ptr() + r_buffer.size() - 4)) {
+		print_verbose(vformat("GDScript: Ignoring corrupted bytecode cache for \"%s\".", p_path));
+		return false;
+	}
+
+	r_reader.data = r_buffer.ptr();
+	r_reader.size = r_buffer.size() - 4;
+
+	if (!r_reader.has(4) || memcmp(r_reader.data, CACHE_MAGIC, 4) != 0) {
+		return false;
+	}
+	r_reader.position += 4;
+	if (r_reader.get_32() != FORMAT_VERSION || r_reader.get_string() != _get_build_key() || r_reader.get_string() != p_path) {
+		print_verbose(vformat("GDScript: Bytecode cache for \"%s\" was made by a different build.", p_path));
+		return false;
+	}
+
+	MutexLock lock(mutex);
+	bool up_to_date = r_reader.get_string() == _get_source_hash(p_path);
+	const int dependency_count = r_reader.get_count();
+	for (int i = 0; i < dependency_count && up_to_date && !r_reader.failed; i++) {
+		const String dependency = r_reader.get_string();
+		up_to_date = r_reader.get_string() == _get_source_hash(dependency);
+	}
+	if (!up_to_date || r_reader.failed) {
+		print_verbose(vformat("GDScript: Bytecode cache for \"%s\" is outdated.", p_path));
+		return false;
+	}
+	return true;
+}
+
+bool GDScriptBytecodeCache::has_entry(const String &p_path) {
+	Vector<uint8_t> buffer;
+	Reader reader;
+	return _open_entry(p_path, buffer, reader);
+}
+
+bool GDScriptBytecodeCache::load(GDScript *p_script) {
+	const String path = p_script->path;
+	Vector<uint8_t> buffer;
+	Reader reader;
+	if (!_open_entry(path, buffer, reader)) {
+		return false;
+	}
+
+	const bool keep_static_data = reader.get_u8();
+	if (!_read_skeleton(reader, p_script)) {
+		return false;
+	}
+
+	LoadContext context;
+	context.root = p_script;
+	context.path = path;
+	if (!_read_class(reader, context, p_script) || reader.position != reader.size) {
+		_clear_class(p_script);
+		print_verbose(vformat("GDScript: Could not restore \"%s\" from the bytecode cache, compiling it instead.", path));
+		return false;
+	}
+
+	_finish_class(p_script);
+
+	// What `GDScriptCompiler::compile()` and `GDScript::reload()` do after compiling.
+	if (keep_static_data) {
+		GDScriptCache::add_static_script(p_script);
+	}
+	GDScriptCache::finish_compiling(path);
+	if (ScriptServer::is_scripting_enabled() || p_script->is_tool()) {
+		p_script->_static_init();
+	}
+
+	return true;
+}
+
+static bool _has_static_data(const GDScript *p_script) {
+	if (p_script->get_static_initializer()) {
+		return true;
+	}
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->get_subclasses()) {
+		if (_has_static_data(E.value.ptr())) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void GDScriptBytecodeCache::save(GDScript *p_script, GDScriptParser &p_parser) {
+	const String path = p_script->path;
+	if (path.is_empty() || path.contains("::") || !p_script->is_root_script() || !p_script->valid) {
+		return;
+	}
+
+	// Only scripts whose source is what is on disk can be validated on the next run.
+	const String remapped_path = ResourceLoader::path_remap(path);
+	if (!FileAccess::exists(remapped_path)) {
+		return;
+	}
+	if (remapped_path.get_extension().to_lower() == "gdc") {
+		if (GDScriptCache::get_binary_tokens(remapped_path) != p_script->binary_tokens) {
+			return;
+		}
+	} else if (!p_script->binary_tokens.is_empty() || GDScriptCache::get_source_code(remapped_path) != p_script->source) {
+		return;
+	}
+
+	HashSet<String> dependencies;
+	_collect_dependencies(&p_parser, path, dependencies);
+
+	SaveContext context;
+	const Variant *global_array = GDScriptLanguage::get_singleton()->get_global_array();
+	for (const KeyValue<StringName, int> &E : GDScriptLanguage::get_singleton()->get_global_map()) {
+		context.global_names.insert(E.value, E.key);
+		const Variant &global = global_array[E.value];
+		if (global.get_type() == Variant::OBJECT) {
+			const Object *object = global.get_validated_object();
+			if (object) {
+				context.global_objects.insert(object->get_instance_id(), E.key);
+			}
+		}
+	}
+
+	Writer writer;
+	writer.put_buffer((const uint8_t *)CACHE_MAGIC, 4);
+	writer.put_32(FORMAT_VERSION);
+	writer.put_string(_get_build_key());
+	writer.put_string(path);
+
+	{
+		MutexLock lock(mutex);
+
+		const String source_hash = _get_source_hash(path);
+		if (source_hash.is_empty()) {
+			return;
+		}
+		writer.put_string(source_hash);
+		writer.put_32(dependencies.size());
+		for (const String &dependency : dependencies) {
+			const String dependency_hash = _get_source_hash(dependency);
+			if (dependency_hash.is_empty()) {
+				return;
+			}
+			writer.put_string(dependency);
+			writer.put_string(dependency_hash);
+		}
+
+		const GDScriptParser::ClassNode *root = p_parser.get_tree();
+		writer.put_u8(_has_static_data(p_script) && !(root && root->annotated_static_unload));
+		_write_skeleton(writer, p_script);
+		if (!_write_class(writer, p_script, context)) {
+			print_verbose(vformat("GDScript: \"%s\" holds values that can't be stored in the bytecode cache.", path));
+			return;
+		}
+	}
+
+	writer.put_32(hash_murmur3_buffer(writer.data.ptr(), writer.data.size()));
+
+	// Written to a temporary file first, so other processes never read a partial cache entry.
+	const String cache_file = _get_cache_file(path);
+	const String temp_file = vformat("%s.%d.tmp", cache_file, OS::get_singleton()->get_process_id());
+	Error err = DirAccess::make_dir_recursive_absolute(cache_file.get_base_dir());
+	if (err != OK) {
+		return;
+	}
+	{
+		Ref<FileAccess> file = FileAccess::open(temp_file, FileAccess::WRITE, &err);
+		if (err != OK) {
+			return;
+		}
+		file->store_buffer(writer.data.ptr(), writer.data.size());
+	}
+	Ref<DirAccess> dir = DirAccess::create_for_path(cache_file);
+	if (dir.is_valid() && dir->rename(temp_file, cache_file) != OK) {
+		dir->remove(temp_file);
+	}
+}
+
+void GDScriptBytecodeCache::clear() {
+	MutexLock lock(mutex);
+	if (reverse_lookup) {
+		memdelete(reverse_lookup);
+		reverse_lookup = nullptr;
+	}
+	source_hashes.clear();
+}
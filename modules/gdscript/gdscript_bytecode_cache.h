@@ -0,0 +1,149 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "gdscript.h"
+
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+
+class GDScriptParser;
+
+// Stores compiled GDScript classes on disk so later runs can skip parsing, analyzing and compiling them.
+// A cached class is only used when the engine build, the script source and the sources of every script
+// it was analyzed against are unchanged. Anything that can't be restored by name or path on load (such as
+// constants holding arbitrary objects) makes the script be compiled as usual instead.
+class GDScriptBytecodeCache {
+	static constexpr uint32_t FORMAT_VERSION = 1;
+
+	struct Writer;
+	struct Reader;
+	struct SaveContext;
+	struct LoadContext;
+
+	enum ScriptReference {
+		SCRIPT_REF_NONE,
+		SCRIPT_REF_GDSCRIPT, // Root script path, then the inner class names leading to it.
+		SCRIPT_REF_RESOURCE, // Script of another language, loaded by path.
+	};
+
+	enum VariantTag {
+		VARIANT_PLAIN, // Anything `encode_variant()` handles without objects.
+		VARIANT_ARRAY,
+		VARIANT_DICTIONARY,
+		VARIANT_NULL_OBJECT,
+		VARIANT_SCRIPT,
+		VARIANT_GLOBAL, // Native class or singleton found in the GDScript global array.
+		VARIANT_RESOURCE,
+	};
+
+	// Maps the validated function pointers stored in `GDScriptFunction` back to what they were looked up by.
+	struct ReverseLookup {
+		struct Operator {
+			Variant::Operator op = Variant::OP_MAX;
+			Variant::Type left = Variant::NIL;
+			Variant::Type right = Variant::NIL;
+		};
+		struct Member {
+			Variant::Type type = Variant::NIL;
+			StringName name;
+		};
+		struct Constructor {
+			Variant::Type type = Variant::NIL;
+			int index = 0;
+		};
+
+		struct FunctionHasher {
+			template <typename T>
+			static _FORCE_INLINE_ uint32_t hash(T p_function) { return hash_one_uint64((uint64_t)(uintptr_t)p_function); }
+		};
+
+		HashMap<Variant::ValidatedOperatorEvaluator, Operator, FunctionHasher> operators;
+		HashMap<Variant::ValidatedSetter, Member, FunctionHasher> setters;
+		HashMap<Variant::ValidatedGetter, Member, FunctionHasher> getters;
+		HashMap<Variant::ValidatedKeyedSetter, Variant::Type, FunctionHasher> keyed_setters;
+		HashMap<Variant::ValidatedKeyedGetter, Variant::Type, FunctionHasher> keyed_getters;
+		HashMap<Variant::ValidatedIndexedSetter, Variant::Type, FunctionHasher> indexed_setters;
+		HashMap<Variant::ValidatedIndexedGetter, Variant::Type, FunctionHasher> indexed_getters;
+		HashMap<Variant::ValidatedBuiltInMethod, Member, FunctionHasher> builtin_methods;
+		HashMap<Variant::ValidatedConstructor, Constructor, FunctionHasher> constructors;
+		HashMap<Variant::ValidatedUtilityFunction, StringName, FunctionHasher> utilities;
+		HashMap<GDScriptUtilityFunctions::FunctionPtr, StringName, FunctionHasher> gds_utilities;
+	};
+
+	static Mutex mutex;
+	static ReverseLookup *reverse_lookup;
+	static HashMap<String, String> source_hashes; // Script path to the MD5 of its (possibly remapped) file.
+
+	static String _get_cache_file(const String &p_path);
+	// Checks the entry of `p_path` up to its class data, leaving `r_reader` there.
+	static bool _open_entry(const String &p_path, Vector<uint8_t> &r_buffer, Reader &r_reader);
+	static String _get_build_key();
+	static String _get_source_hash(const String &p_path);
+	static const ReverseLookup &_get_reverse_lookup();
+	static void _collect_dependencies(GDScriptParser *p_parser, const String &p_root_path, HashSet<String> &r_dependencies);
+
+	static bool _write_script_reference(Writer &p_writer, const Script *p_script);
+	static bool _write_variant(Writer &p_writer, const Variant &p_variant, SaveContext &p_context, int p_depth = 0);
+	static bool _write_data_type(Writer &p_writer, const GDScriptDataType &p_data_type);
+	static void _write_property_info(Writer &p_writer, const PropertyInfo &p_info);
+	static bool _write_method_info(Writer &p_writer, const MethodInfo &p_info, SaveContext &p_context);
+	static bool _write_function(Writer &p_writer, const GDScriptFunction *p_function, SaveContext &p_context);
+	static void _write_skeleton(Writer &p_writer, const GDScript *p_script);
+	static bool _write_class(Writer &p_writer, const GDScript *p_script, SaveContext &p_context);
+
+	static Ref<Script> _read_script_reference(Reader &p_reader, LoadContext &p_context);
+	static bool _read_variant(Reader &p_reader, LoadContext &p_context, Variant &r_variant, int p_depth = 0);
+	static bool _read_data_type(Reader &p_reader, LoadContext &p_context, GDScriptDataType &r_data_type);
+	static bool _read_property_info(Reader &p_reader, PropertyInfo &r_info);
+	static bool _read_method_info(Reader &p_reader, LoadContext &p_context, MethodInfo &r_info);
+	static bool _validate_function(GDScriptFunction *p_function, int p_member_count);
+	static GDScriptFunction *_read_function(Reader &p_reader, LoadContext &p_context, GDScript *p_script);
+	static bool _read_skeleton(Reader &p_reader, GDScript *p_script);
+	static bool _read_class(Reader &p_reader, LoadContext &p_context, GDScript *p_script);
+	static void _clear_class(GDScript *p_script);
+	static void _finish_class(GDScript *p_script);
+
+public:
+	static bool is_enabled();
+
+	// Whether `p_path` has an entry `load()` can use, unless its class data turns out to be corrupted.
+	static bool has_entry(const String &p_path);
+
+	// Restores a freshly created, not yet parsed script from the cache. Returns `false` and leaves the
+	// script empty when there is no usable cache entry.
+	static bool load(GDScript *p_script);
+	// Stores a script that was just compiled from `p_parser`.
+	static void save(GDScript *p_script, GDScriptParser &p_parser);
+
+	static void clear();
+};
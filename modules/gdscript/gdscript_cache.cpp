@@ -32,11 +32,15 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
 #include "core/io/file_access.h"
+#include "core/io/resource_uid.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/vector.h"
+#include "servers/text_server.h"
 
 GDScriptParserRef::Status GDScriptParserRef::get_status() const {
 	return status;
@@ -205,6 +209,7 @@ void GDScriptCache::remove_script(const String &p_path) {
 	remove_parser(p_path);
 
 	singleton->dependencies.erase(p_path);
+	singleton->preparsed_parsers.erase(p_path);
 	singleton->shallow_gdscript_cache.erase(p_path);
 	singleton->full_gdscript_cache.erase(p_path);
 }
@@ -237,6 +242,125 @@ Ref<GDScriptParserRef> GDScriptCache::get_parser(const String &p_path, GDScriptP
 	return ref;
 }
 
+void GDScriptCache::_preparse_task(void *p_parser_ref) {
+	static_cast<GDScriptParserRef *>(p_parser_ref)->raise_status(GDScriptParserRef::PARSED);
+}
+
+Vector<String> GDScriptCache::preparse(const String &p_path) {
+	Vector<String> preparsed;
+	if (singleton == nullptr || WorkerThreadPool::get_singleton() == nullptr) {
+		return preparsed;
+	}
+
+	// Restored from the bytecode cache without parsing, and so are its dependencies with their own entries.
+	if (GDScriptBytecodeCache::is_enabled() && GDScriptBytecodeCache::has_entry(p_path)) {
+		return preparsed;
+	}
+
+#ifdef DEBUG_ENABLED
+	// Set up lazily by the text server on first use, which the parser does to check identifiers.
+	if (TS->has_feature(TextServer::FEATURE_UNICODE_SECURITY)) {
+		TS->spoof_check(String());
+	}
+#endif
+
+	// Parsed in waves: each one finds the scripts for the next, through the paths and class names
+	// seen by the parser. Analysis and compilation still happen in order, on the loading thread.
+	HashSet<String> visited;
+	Vector<String> pending;
+	pending.push_back(p_path);
+
+	while (!pending.is_empty()) {
+		LocalVector<Ref<GDScriptParserRef>> parser_refs;
+		{
+			MutexLock lock(singleton->mutex);
+			if (singleton->cleared) {
+				return preparsed;
+			}
+			for (const String &path : pending) {
+				if (visited.has(path)) {
+					continue;
+				}
+				visited.insert(path);
+				if (singleton->parser_map.has(path) || singleton->full_gdscript_cache.has(path) || !FileAccess::exists(ResourceLoader::path_remap(path))) {
+					continue;
+				}
+				Ref<GDScriptParserRef> parser_ref;
+				parser_ref.instantiate();
+				parser_ref->path = path;
+				parser_ref->get_parser(); // The first parser ever made sets up shared tables, so not on a worker.
+				parser_refs.push_back(parser_ref);
+			}
+		}
+		pending.clear();
+
+		// The new parsers aren't in `parser_map` yet, so nothing else can reach them meanwhile.
+		if (parser_refs.size() == 1) {
+			parser_refs[0]->raise_status(GDScriptParserRef::PARSED);
+		} else if (parser_refs.size() > 1) {
+			LocalVector<WorkerThreadPool::TaskID> tasks;
+			for (Ref<GDScriptParserRef> &parser_ref : parser_refs) {
+				tasks.push_back(WorkerThreadPool::get_singleton()->add_native_task(&GDScriptCache::_preparse_task, parser_ref.ptr(), false, "GDScript parsing"));
+			}
+			for (WorkerThreadPool::TaskID task : tasks) {
+				WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+			}
+		}
+
+		MutexLock lock(singleton->mutex);
+		for (Ref<GDScriptParserRef> &parser_ref : parser_refs) {
+			if (singleton->cleared || singleton->parser_map.has(parser_ref->path)) {
+				// Another thread got there first, keep its parser.
+				parser_ref->abandoned = true;
+				continue;
+			}
+			singleton->parser_map[parser_ref->path] = parser_ref.ptr();
+			singleton->preparsed_parsers[parser_ref->path] = parser_ref;
+			preparsed.push_back(parser_ref->path);
+			if (parser_ref->result != OK) {
+				continue;
+			}
+
+			const GDScriptParser *parser = parser_ref->get_parser();
+			const String base_dir = parser_ref->path.get_base_dir();
+			for (const String &referenced_path : parser->get_referenced_paths()) {
+				String path = ResourceUID::ensure_path(referenced_path);
+				if (path.is_relative_path()) {
+					path = base_dir.path_join(path);
+				}
+				path = path.simplify_path();
+				if (path.get_extension().to_lower() == "gd") {
+					pending.push_back(path);
+				}
+			}
+			for (const StringName &class_name : parser->get_referenced_class_names()) {
+				if (ScriptServer::is_global_class(class_name) && ScriptServer::get_global_class_language(class_name) == "GDScript") {
+					pending.push_back(ScriptServer::get_global_class_path(class_name));
+				}
+			}
+		}
+	}
+
+	return preparsed;
+}
+
+void GDScriptCache::release_preparsed(const Vector<String> &p_paths) {
+	// Dependencies were compiled by now and released then. What is left was only guessed from a name,
+	// the parser goes away with the last reference.
+	if (p_paths.is_empty()) {
+		return;
+	}
+	MutexLock lock(singleton->mutex);
+	for (const String &path : p_paths) {
+		singleton->preparsed_parsers.erase(path);
+	}
+}
+
+bool GDScriptCache::has_preparsed_parser(const String &p_path) {
+	MutexLock lock(singleton->mutex);
+	return singleton->preparsed_parsers.has(p_path);
+}
+
 bool GDScriptCache::has_parser(const String &p_path) {
 	MutexLock lock(singleton->mutex);
 	return singleton->parser_map.has(p_path);
@@ -327,6 +451,17 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
+	if (GDScriptBytecodeCache::is_enabled()) {
+		// Cached before loading, so scripts referring back to this one find it.
+		singleton->shallow_gdscript_cache[p_path] = script;
+		singleton->bytecode_loading.insert(p_path);
+		const bool loaded = GDScriptBytecodeCache::load(script.ptr());
+		singleton->bytecode_loading.erase(p_path);
+		if (loaded) {
+			return script; // Already moved to the full cache.
+		}
+	}
+
 	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
 	if (r_error == OK) {
 		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
@@ -359,6 +494,11 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 		if (script.is_null()) {
 			return script;
 		}
+		// Restored from the bytecode cache, either completely or still in progress further up the stack.
+		if (singleton->bytecode_loading.has(p_path) || singleton->full_gdscript_cache.has(p_path)) {
+			singleton->preparsed_parsers.erase(p_path);
+			return script;
+		}
 	}
 
 	const String remapped_path = ResourceLoader::path_remap(p_path);
@@ -384,6 +524,7 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 	uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(singleton->mutex);
 	r_error = script->reload(true);
 	WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
+	singleton->preparsed_parsers.erase(p_path);
 	if (r_error) {
 		return script;
 	}
@@ -457,6 +598,7 @@ void GDScriptCache::clear() {
 	singleton->cleared = true;
 
 	singleton->parser_inverse_dependencies.clear();
+	singleton->preparsed_parsers.clear();
 
 	for (const KeyValue<String, Vector<ObjectID>> &KV : singleton->abandoned_parser_map) {
 		for (ObjectID parser_ref_id : KV.value) {
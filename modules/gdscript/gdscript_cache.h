@@ -87,6 +87,8 @@ class GDScriptCache {
 	HashMap<String, Ref<GDScript>> static_gdscript_cache;
 	HashMap<String, HashSet<String>> dependencies;
 	HashMap<String, HashSet<String>> parser_inverse_dependencies;
+	HashSet<String> bytecode_loading; // Scripts being restored from the bytecode cache.
+	HashMap<String, Ref<GDScriptParserRef>> preparsed_parsers; // Kept alive by `preparse()` until the script is compiled.
 
 	friend class GDScript;
 	friend class GDScriptParserRef;
@@ -103,9 +105,18 @@ private:
 	static SafeBinaryMutex<BINARY_MUTEX_TAG> mutex;
 	friend SafeBinaryMutex<BINARY_MUTEX_TAG> &_get_gdscript_cache_mutex();
 
+	static void _preparse_task(void *p_parser_ref);
+
 public:
 	static void move_script(const String &p_from, const String &p_to);
 	static void remove_script(const String &p_path);
+	// Parses the script at `p_path` and the scripts it seems to depend on concurrently, so the
+	// analyzer finds them already parsed. Must not be called while holding the cache mutex.
+	// Returns the scripts it parsed, to pass to `release_preparsed()` once `p_path` is loaded.
+	static Vector<String> preparse(const String &p_path);
+	// Drops what `preparse()` kept for scripts that turned out not to be dependencies.
+	static void release_preparsed(const Vector<String> &p_paths);
+	static bool has_preparsed_parser(const String &p_path);
 	static Ref<GDScriptParserRef> get_parser(const String &p_path, GDScriptParserRef::Status status, Error &r_error, const String &p_owner = String());
 	static bool has_parser(const String &p_path);
 	static void remove_parser(const String &p_path);
@@ -2709,6 +2709,9 @@ Error GDScriptCompiler::_prepare_compilation(GDScript *p_script, const GDScriptP
 
 	parsing_classes.insert(p_script);
 
+	// Functions and member layout are about to change, drop cached lookups into them.
+	p_script->invalidate_inline_caches();
+
 	p_script->clearing = true;
 
 	p_script->cancel_pending_functions(true);
@@ -3329,6 +3332,8 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 	}
 
 	err = _compile_class(main_script, root, p_keep_state);
+	// Anything cached while the class was half-built must not survive.
+	main_script->invalidate_inline_caches();
 	if (err) {
 		return err;
 	}
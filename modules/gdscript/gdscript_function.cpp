@@ -32,6 +32,9 @@
 
 #include "gdscript.h"
 
+#include "core/object/class_db.h"
+#include "scene/scene_string_names.h"
+
 Variant GDScriptFunction::get_constant(int p_idx) const {
 	ERR_FAIL_INDEX_V(p_idx, constants.size(), "<errconst>");
 	return constants[p_idx];
@@ -104,6 +107,210 @@ void GDScriptFunction::debug_get_stack_member_state(int p_line, List<Pair<String
 	}
 }
 
+bool GDScriptFunction::_get_inline_cache_key(const Variant *p_base, InlineCacheKey &r_key) {
+	r_key.base_type = p_base->get_type();
+	if (r_key.base_type != Variant::OBJECT) {
+		return true;
+	}
+
+	Object *obj = p_base->get_validated_object();
+	if (!obj) {
+		// Let the regular path report null and freed instances.
+		return false;
+	}
+	r_key.object = obj;
+
+	ScriptInstance *script_instance = obj->get_script_instance();
+	if (script_instance) {
+		if (script_instance->is_placeholder() || script_instance->get_language() != GDScriptLanguage::get_singleton()) {
+			return false;
+		}
+		r_key.instance = static_cast<GDScriptInstance *>(script_instance);
+		r_key.script = r_key.instance->script.ptr();
+		// Rebuilding a base script changes inherited members and functions too.
+		for (const GDScript *sptr = r_key.script; sptr; sptr = sptr->_base) {
+			r_key.epoch = MAX(r_key.epoch, sptr->get_inline_cache_epoch());
+		}
+	}
+	return true;
+}
+
+const GDScriptFunction::InlineCacheEntry *GDScriptFunction::_publish_inline_cache_entry(int p_cache, InlineCacheEntry *p_entry) {
+	InlineCache &cache = _inline_caches[p_cache];
+	uint32_t epoch = cache.epoch.load(std::memory_order_relaxed);
+	if (p_entry->epoch > epoch && cache.epoch.compare_exchange_strong(epoch, p_entry->epoch, std::memory_order_relaxed)) {
+		// Entries resolved before the rebuild can no longer match, start counting the site's receivers again.
+		cache.fills.store(0, std::memory_order_relaxed);
+	}
+	const uint32_t fill = cache.fills.fetch_add(1, std::memory_order_relaxed);
+	if (fill >= InlineCache::MAX_FILLS) {
+		// Lost the race against other threads filling the last slots, the site is megamorphic now.
+		memdelete(p_entry);
+		return nullptr;
+	}
+
+	{
+		MutexLock lock(inline_cache_mutex);
+		inline_cache_entries.push_back(p_entry);
+	}
+	// Replaced entries may still be read by other threads, they are only freed with the function.
+	cache.entries[fill % InlineCache::MAX_ENTRIES].store(p_entry, std::memory_order_release);
+	return p_entry;
+}
+
+GDScriptFunction::InlineCacheEntry *GDScriptFunction::_new_inline_cache_entry(const InlineCacheKey &p_key) {
+	InlineCacheEntry *entry = memnew(InlineCacheEntry);
+	entry->base_type = p_key.base_type;
+	entry->script = p_key.script;
+	entry->epoch = p_key.epoch;
+	if (p_key.object) {
+		entry->class_name = p_key.object->get_class_name();
+	}
+	return entry;
+}
+
+const GDScriptFunction::InlineCacheEntry *GDScriptFunction::_resolve_get_named(int p_cache, const InlineCacheKey &p_key, const StringName &p_name) {
+	if (p_key.instance) {
+		// Mirrors the first lookup of GDScriptInstance::get(), members with a getter need the full call.
+		const GDScript::MemberInfo *member = p_key.script->member_indices.getptr(p_name);
+		if (!member || member->getter != StringName()) {
+			return nullptr;
+		}
+		InlineCacheEntry *entry = _new_inline_cache_entry(p_key);
+		entry->kind = InlineCacheEntry::KIND_SCRIPT_MEMBER;
+		entry->member_index = member->index;
+		return _publish_inline_cache_entry(p_cache, entry);
+	}
+
+	if (!p_key.object) {
+		Variant::ValidatedGetter getter = Variant::get_member_validated_getter(p_key.base_type, p_name);
+		if (!getter) {
+			return nullptr;
+		}
+		InlineCacheEntry *entry = _new_inline_cache_entry(p_key);
+		entry->kind = InlineCacheEntry::KIND_BUILTIN_MEMBER;
+		entry->getter = getter;
+		entry->member_type = Variant::get_member_type(p_key.base_type, p_name);
+		return _publish_inline_cache_entry(p_cache, entry);
+	}
+
+	// Native properties may be served by `_get()` overrides, which can answer differently on every call.
+	return nullptr;
+}
+
+const GDScriptFunction::InlineCacheEntry *GDScriptFunction::_resolve_set_named(int p_cache, const InlineCacheKey &p_key, const StringName &p_name) {
+	if (p_key.instance) {
+#ifdef TOOLS_ENABLED
+		// Object::set() also flags the object as edited in editor builds.
+		return nullptr;
+#else
+		// Mirrors the first lookup of GDScriptInstance::set(), members with a setter need the full call.
+		const GDScript::MemberInfo *member = p_key.script->member_indices.getptr(p_name);
+		if (!member || member->setter != StringName()) {
+			return nullptr;
+		}
+		InlineCacheEntry *entry = _new_inline_cache_entry(p_key);
+		entry->kind = InlineCacheEntry::KIND_SCRIPT_MEMBER;
+		entry->member_index = member->index;
+		entry->member_data_type = member->data_type;
+		return _publish_inline_cache_entry(p_cache, entry);
+#endif
+	}
+
+	if (!p_key.object) {
+		Variant::ValidatedSetter setter = Variant::get_member_validated_setter(p_key.base_type, p_name);
+		if (!setter) {
+			return nullptr;
+		}
+		InlineCacheEntry *entry = _new_inline_cache_entry(p_key);
+		entry->kind = InlineCacheEntry::KIND_BUILTIN_MEMBER;
+		entry->setter = setter;
+		entry->member_type = Variant::get_member_type(p_key.base_type, p_name);
+		return _publish_inline_cache_entry(p_cache, entry);
+	}
+
+	return nullptr;
+}
+
+bool GDScriptFunction::_overrides_callp(const Object *p_object) {
+	if (Object::cast_to<Script>(p_object) || Object::cast_to<GDScriptNativeClass>(p_object)) {
+		return true;
+	}
+	static const char *platform_classes[] = { "JavaClass", "JavaObject", "JNISingleton" };
+	for (const char *platform_class : platform_classes) {
+		if (ClassDB::is_parent_class(p_object->get_class_name(), platform_class)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+const GDScriptFunction::InlineCacheEntry *GDScriptFunction::_get_inline_call(int p_cache, const Variant *p_base, const StringName &p_method, InlineCacheKey &r_key) {
+	if (!_get_inline_cache_key(p_base, r_key)) {
+		return nullptr;
+	}
+	const InlineCacheEntry *entry = _find_inline_cache_entry(p_cache, r_key);
+	if (!entry && !_is_inline_cache_full(p_cache, r_key)) {
+		entry = _resolve_call(p_cache, r_key, p_method);
+	}
+	return entry;
+}
+
+GDScriptFunction::InlineCallTarget GDScriptFunction::resolve_inline_call(int p_cache, const Variant &p_base, const StringName &p_method) {
+	ERR_FAIL_INDEX_V(p_cache, _inline_cache_count, INLINE_CALL_NONE);
+	InlineCacheKey key;
+	const InlineCacheEntry *entry = _get_inline_call(p_cache, &p_base, p_method, key);
+	if (!entry) {
+		return INLINE_CALL_NONE;
+	}
+	return entry->kind == InlineCacheEntry::KIND_SCRIPT_FUNCTION ? INLINE_CALL_SCRIPT_FUNCTION : INLINE_CALL_METHOD_BIND;
+}
+
+const GDScriptFunction::InlineCacheEntry *GDScriptFunction::_resolve_call(int p_cache, const InlineCacheKey &p_key, const StringName &p_method) {
+	// Built-in types dispatch through a single hash lookup already. `free` and `_ready` have
+	// special handling in Object::callp() and GDScriptInstance::callp() respectively.
+	if (!p_key.object || p_method == CoreStringName(free_) || p_method == SceneStringName(_ready)) {
+		return nullptr;
+	}
+
+	if (p_key.instance) {
+		// Mirrors GDScriptInstance::callp().
+		for (const GDScript *sptr = p_key.script; sptr; sptr = sptr->_base) {
+			if (!sptr->valid) {
+				return nullptr;
+			}
+			GDScriptFunction *const *function = sptr->member_functions.getptr(p_method);
+			if (function) {
+				InlineCacheEntry *entry = _new_inline_cache_entry(p_key);
+				entry->kind = InlineCacheEntry::KIND_SCRIPT_FUNCTION;
+				entry->function = *function;
+				return _publish_inline_cache_entry(p_cache, entry);
+			}
+		}
+	}
+
+	// Script-less receivers are called through Object::callp(), which these classes override to
+	// reach other targets first, such as static members of scripts or Java methods.
+	if (!p_key.instance && _overrides_callp(p_key.object)) {
+		return nullptr;
+	}
+
+	// Method binds of extension classes go away when the extension is reloaded.
+	const StringName &class_name = p_key.object->get_class_name();
+	const ClassDB::APIType api = ClassDB::get_api_type(class_name);
+	if (api == ClassDB::API_EXTENSION || api == ClassDB::API_EDITOR_EXTENSION) {
+		return nullptr;
+	}
+	MethodBind *method = ClassDB::get_method(class_name, p_method);
+	if (!method) {
+		return nullptr;
+	}
+	InlineCacheEntry *entry = _new_inline_cache_entry(p_key);
+	entry->kind = InlineCacheEntry::KIND_METHOD_BIND;
+	entry->method = method;
+	return _publish_inline_cache_entry(p_cache, entry);
+}
+
 GDScriptFunction::GDScriptFunction() {
 	name = "<anonymous>";
 #ifdef DEBUG_ENABLED
@@ -117,6 +324,13 @@ GDScriptFunction::GDScriptFunction() {
 GDScriptFunction::~GDScriptFunction() {
 	get_script()->member_functions.erase(name);
 
+	for (InlineCacheEntry *entry : inline_cache_entries) {
+		memdelete(entry);
+	}
+	if (_inline_caches) {
+		memdelete_arr(_inline_caches);
+	}
+
 	for (int i = 0; i < lambdas.size(); i++) {
 		memdelete(lambdas[i]);
 	}
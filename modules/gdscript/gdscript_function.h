@@ -34,12 +34,16 @@
 
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/os/mutex.h"
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
 
+#include <atomic>
+
 class GDScriptInstance;
 class GDScript;
 
@@ -269,6 +273,34 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,
+		OPCODE_OPERATOR_ADD_INT,
+		OPCODE_OPERATOR_SUBTRACT_INT,
+		OPCODE_OPERATOR_MULTIPLY_INT,
+		OPCODE_OPERATOR_EQUAL_INT,
+		OPCODE_OPERATOR_NOT_EQUAL_INT,
+		OPCODE_OPERATOR_LESS_INT,
+		OPCODE_OPERATOR_LESS_EQUAL_INT,
+		OPCODE_OPERATOR_GREATER_INT,
+		OPCODE_OPERATOR_GREATER_EQUAL_INT,
+		OPCODE_OPERATOR_ADD_FLOAT,
+		OPCODE_OPERATOR_SUBTRACT_FLOAT,
+		OPCODE_OPERATOR_MULTIPLY_FLOAT,
+		OPCODE_OPERATOR_EQUAL_FLOAT,
+		OPCODE_OPERATOR_NOT_EQUAL_FLOAT,
+		OPCODE_OPERATOR_LESS_FLOAT,
+		OPCODE_OPERATOR_LESS_EQUAL_FLOAT,
+		OPCODE_OPERATOR_GREATER_FLOAT,
+		OPCODE_OPERATOR_GREATER_EQUAL_FLOAT,
+		OPCODE_OPERATOR_ADD_VECTOR2,
+		OPCODE_OPERATOR_SUBTRACT_VECTOR2,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR2,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT,
+		OPCODE_OPERATOR_ADD_VECTOR3,
+		OPCODE_OPERATOR_SUBTRACT_VECTOR3,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR3,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_DICTIONARY,
@@ -286,6 +318,7 @@ public:
 		OPCODE_GET_NAMED_VALIDATED,
 		OPCODE_SET_MEMBER,
 		OPCODE_GET_MEMBER,
+		OPCODE_GET_MEMBER_OPERATOR_VALIDATED,
 		OPCODE_SET_STATIC_VARIABLE, // Only for GDScript.
 		OPCODE_GET_STATIC_VARIABLE, // Only for GDScript.
 		OPCODE_ASSIGN,
@@ -454,11 +487,79 @@ public:
 		StringName identifier;
 	};
 
+	// State shared with the ahead-of-time compiled version of a function (see `GDScriptNativeCompiler`).
+	struct NativeFrame {
+		GDScriptFunction *function = nullptr;
+		Variant *stack = nullptr;
+		Variant *members = nullptr;
+		int member_count = 0;
+		Variant *retvalue = nullptr;
+		int *line = nullptr;
+		int defarg = 0;
+		int ip = 0; // Instruction to start at.
+	};
+
+	// Runs the function from `NativeFrame::ip`. Returns -1 once the function has returned,
+	// otherwise the address of the instruction the VM has to continue with.
+	typedef int (*NativeFunction)(NativeFrame &p_frame);
+
 private:
 	friend class GDScript;
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
 	friend class GDScriptLanguage;
+	friend class GDScriptBytecodeCache;
+	friend class GDScriptSamplingProfiler;
+	friend class GDScriptNativeCompiler;
+
+	// Inline caches for OPCODE_GET_NAMED, OPCODE_SET_NAMED and OPCODE_CALL(_RETURN/_ASYNC) on
+	// receivers whose type is only known at runtime. Each such instruction carries the index of
+	// its cache site. Entries are immutable once published and stay alive as long as the function,
+	// so concurrent readers never see a partially written entry.
+	struct InlineCacheEntry {
+		enum Kind {
+			KIND_SCRIPT_MEMBER, // Member variable without getter/setter of a GDScript instance.
+			KIND_SCRIPT_FUNCTION, // Function found in the instance's script inheritance chain.
+			KIND_METHOD_BIND, // Native method not overridden by the receiver's script.
+			KIND_BUILTIN_MEMBER, // Named member of a built-in type, such as `Vector2.x`.
+		};
+
+		Kind kind = KIND_SCRIPT_MEMBER;
+		// Guard: the receiver's built-in type, its script (`nullptr` when it has none) and
+		// native class, and the newest inline cache epoch in the script's inheritance chain.
+		Variant::Type base_type = Variant::NIL;
+		const GDScript *script = nullptr;
+		StringName class_name;
+		uint32_t epoch = 0;
+
+		int member_index = -1;
+		GDScriptDataType member_data_type;
+		GDScriptFunction *function = nullptr;
+		MethodBind *method = nullptr;
+		Variant::ValidatedGetter getter = nullptr;
+		Variant::ValidatedSetter setter = nullptr;
+		Variant::Type member_type = Variant::NIL;
+	};
+
+	struct InlineCache {
+		static constexpr int MAX_ENTRIES = 4; // Polymorphic up to this many receiver types.
+		static constexpr uint32_t MAX_FILLS = 16; // Sites missing more often are treated as megamorphic.
+
+		std::atomic<const InlineCacheEntry *> entries[MAX_ENTRIES] = {};
+		std::atomic<uint32_t> fills = { 0 };
+		// Newest epoch among the published entries. Fills are counted anew once a receiver's script is
+		// rebuilt, otherwise every reload would bring the site closer to being treated as megamorphic.
+		std::atomic<uint32_t> epoch = { 0 };
+	};
+
+	// What a receiver is matched on.
+	struct InlineCacheKey {
+		Variant::Type base_type = Variant::NIL;
+		Object *object = nullptr;
+		GDScriptInstance *instance = nullptr;
+		const GDScript *script = nullptr;
+		uint32_t epoch = 0;
+	};
 
 	StringName name;
 	StringName source;
@@ -470,6 +571,7 @@ private:
 
 	GDScript *_script = nullptr;
 	int _initial_line = 0;
+	SafeNumeric<uint32_t> sampling_id; // Assigned by `GDScriptSamplingProfiler` on first use, zero until then.
 	int _argument_count = 0;
 	int _vararg_index = -1;
 	int _stack_size = 0;
@@ -497,6 +599,12 @@ private:
 	Vector<GDScriptUtilityFunctions::FunctionPtr> gds_utilities;
 	Vector<MethodBind *> methods;
 	Vector<GDScriptFunction *> lambdas;
+	Vector<int> global_index_offsets; // Code positions holding global array indices, which vary between runs.
+
+	InlineCache *_inline_caches = nullptr;
+	int _inline_cache_count = 0;
+	Mutex inline_cache_mutex;
+	LocalVector<InlineCacheEntry *> inline_cache_entries; // Owned, freed with the function.
 
 	int _code_size = 0;
 	int _default_arg_count = 0;
@@ -516,6 +624,8 @@ private:
 	int _methods_count = 0;
 	int _lambdas_count = 0;
 
+	NativeFunction native_function = nullptr;
+
 	int *_code_ptr = nullptr;
 	const int *_default_arg_ptr = nullptr;
 	mutable Variant *_constants_ptr = nullptr;
@@ -571,9 +681,42 @@ private:
 	String _get_callable_call_error(const String &p_where, const Callable &p_callable, const Variant **p_argptrs, int p_argcount, const Variant &p_ret, const Callable::CallError &p_err) const;
 	Variant _get_default_variant_for_data_type(const GDScriptDataType &p_data_type);
 
+	static bool _get_inline_cache_key(const Variant *p_base, InlineCacheKey &r_key);
+	_FORCE_INLINE_ const InlineCacheEntry *_find_inline_cache_entry(int p_cache, const InlineCacheKey &p_key) const {
+		const InlineCache &cache = _inline_caches[p_cache];
+		for (int i = 0; i < InlineCache::MAX_ENTRIES; i++) {
+			const InlineCacheEntry *entry = cache.entries[i].load(std::memory_order_acquire);
+			if (entry && entry->epoch == p_key.epoch && entry->base_type == p_key.base_type && entry->script == p_key.script && (!p_key.object || entry->class_name == p_key.object->get_class_name())) {
+				return entry;
+			}
+		}
+		return nullptr;
+	}
+	_FORCE_INLINE_ bool _is_inline_cache_full(int p_cache, const InlineCacheKey &p_key) const {
+		const InlineCache &cache = _inline_caches[p_cache];
+		return cache.fills.load(std::memory_order_relaxed) >= InlineCache::MAX_FILLS && p_key.epoch <= cache.epoch.load(std::memory_order_relaxed);
+	}
+	static InlineCacheEntry *_new_inline_cache_entry(const InlineCacheKey &p_key);
+	const InlineCacheEntry *_resolve_get_named(int p_cache, const InlineCacheKey &p_key, const StringName &p_name);
+	const InlineCacheEntry *_resolve_set_named(int p_cache, const InlineCacheKey &p_key, const StringName &p_name);
+	static bool _overrides_callp(const Object *p_object);
+	const InlineCacheEntry *_resolve_call(int p_cache, const InlineCacheKey &p_key, const StringName &p_method);
+	const InlineCacheEntry *_get_inline_call(int p_cache, const Variant *p_base, const StringName &p_method, InlineCacheKey &r_key);
+	const InlineCacheEntry *_publish_inline_cache_entry(int p_cache, InlineCacheEntry *p_entry);
+
 public:
 	static constexpr int MAX_CALL_DEPTH = 2048; // Limit to try to avoid crash because of a stack overflow.
 
+	enum InlineCallTarget {
+		INLINE_CALL_NONE, // Called through Variant::callp().
+		INLINE_CALL_SCRIPT_FUNCTION,
+		INLINE_CALL_METHOD_BIND,
+	};
+
+	// What the call site using inline cache `p_cache` runs for `p_base`, filling the cache like the VM does.
+	// Only release builds call through the inline caches, this makes them testable in any build.
+	InlineCallTarget resolve_inline_call(int p_cache, const Variant &p_base, const StringName &p_method);
+
 	struct CallState {
 		Signal completed;
 		GDScript *script = nullptr;
@@ -608,7 +751,8 @@ public:
 
 #ifdef DEBUG_ENABLED
 	void _profile_native_call(uint64_t p_t_taken, const String &p_function_name, const String &p_instance_class_name = String());
-	void disassemble(const Vector<String> &p_code_lines) const;
+	// When `r_opcodes` is given, the opcodes are collected in code order instead of being printed.
+	void disassemble(const Vector<String> &p_code_lines, LocalVector<Opcode> *r_opcodes = nullptr) const;
 #endif
 
 	GDScriptFunction();
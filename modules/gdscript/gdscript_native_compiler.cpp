@@ -0,0 +1,819 @@
+/**************************************************************************/
+/*  gdscript_native_compiler.cpp                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_native_compiler.h"
+
+#include "gdscript.h"
+
+#ifdef TOOLS_ENABLED
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/string/string_builder.h"
+#endif
+
+HashMap<GDScriptNativeCompiler::FunctionKey, GDScriptFunction::NativeFunction, GDScriptNativeCompiler::FunctionKey> GDScriptNativeCompiler::functions;
+bool GDScriptNativeCompiler::enabled = true;
+
+bool GDScriptNativeCompiler::is_resume_point(int p_opcode) {
+	switch (p_opcode) {
+		case GDScriptFunction::OPCODE_OPERATOR:
+		case GDScriptFunction::OPCODE_SET_KEYED:
+		case GDScriptFunction::OPCODE_GET_KEYED:
+		case GDScriptFunction::OPCODE_SET_NAMED:
+		case GDScriptFunction::OPCODE_GET_NAMED:
+		case GDScriptFunction::OPCODE_SET_MEMBER:
+		case GDScriptFunction::OPCODE_GET_MEMBER:
+		case GDScriptFunction::OPCODE_SET_STATIC_VARIABLE:
+		case GDScriptFunction::OPCODE_GET_STATIC_VARIABLE:
+		case GDScriptFunction::OPCODE_CALL:
+		case GDScriptFunction::OPCODE_CALL_RETURN:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_RET:
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_STATIC:
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC:
+		case GDScriptFunction::OPCODE_CALL_UTILITY:
+		case GDScriptFunction::OPCODE_CALL_GDSCRIPT_UTILITY:
+		case GDScriptFunction::OPCODE_CALL_SELF_BASE:
+			return true;
+		default:
+			return false;
+	}
+}
+
+uint64_t GDScriptNativeCompiler::hash_function(const GDScriptFunction *p_function) {
+	// Everything the generated code depends on is in the code and the layout of the stack. Constants and
+	// validated function pointers are read from the function at runtime, so only their indices matter.
+	uint32_t low = hash_murmur3_one_32(p_function->_code_size);
+	uint32_t high = hash_murmur3_one_32(p_function->_code_size, low);
+	const auto mix = [&](int p_value) {
+		low = hash_murmur3_one_32(p_value, low);
+		high = hash_murmur3_one_32(p_value, high ^ low);
+	};
+
+	mix(p_function->_stack_size);
+	mix(p_function->_constant_count);
+	mix(p_function->_argument_count);
+	mix(p_function->default_arguments.size());
+	for (int default_argument : p_function->default_arguments) {
+		mix(default_argument);
+	}
+
+	// Global indices depend on the order classes and singletons were registered in, so they are left out.
+	int next_global = 0;
+	for (int i = 0; i < p_function->_code_size; i++) {
+		if (next_global < p_function->global_index_offsets.size() && p_function->global_index_offsets[next_global] == i) {
+			next_global++;
+			mix(0);
+			continue;
+		}
+		mix(p_function->_code_ptr[i]);
+	}
+
+	return (uint64_t(hash_fmix32(high)) << 32) | hash_fmix32(low);
+}
+
+void GDScriptNativeCompiler::register_function(const StringName &p_name, uint64_t p_hash, GDScriptFunction::NativeFunction p_function) {
+	ERR_FAIL_NULL(p_function);
+	functions.insert({ p_name, p_hash }, p_function);
+}
+
+void GDScriptNativeCompiler::unregister_function(const StringName &p_name, uint64_t p_hash) {
+	functions.erase({ p_name, p_hash });
+}
+
+GDScriptFunction::NativeFunction GDScriptNativeCompiler::get_function(const StringName &p_name, uint64_t p_hash) {
+	const GDScriptFunction::NativeFunction *function = functions.getptr({ p_name, p_hash });
+	return function ? *function : nullptr;
+}
+
+void GDScriptNativeCompiler::clear_functions() {
+	functions.clear();
+}
+
+void GDScriptNativeCompiler::bind(GDScriptFunction *p_function) {
+	if (functions.is_empty() || p_function->_code_ptr == nullptr) {
+		return;
+	}
+
+	const GDScriptFunction::NativeFunction *native_function = functions.getptr({ p_function->name, hash_function(p_function) });
+	p_function->native_function = native_function ? *native_function : nullptr;
+}
+
+#ifdef TOOLS_ENABLED
+
+// Sizes as the VM steps through the code. Fused instructions that keep the instruction they absorbed
+// intact are treated as their first part only, so the absorbed instruction is translated on its own.
+int GDScriptNativeCompiler::_get_instruction_size(const GDScriptFunction *p_function, int p_ip) {
+	const int *code = p_function->_code_ptr;
+
+	switch (code[p_ip]) {
+		case GDScriptFunction::OPCODE_OPERATOR:
+			return 7 + sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*code);
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT:
+		case GDScriptFunction::OPCODE_SET_KEYED_VALIDATED:
+		case GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED:
+		case GDScriptFunction::OPCODE_GET_KEYED_VALIDATED:
+		case GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED:
+		case GDScriptFunction::OPCODE_SET_NAMED:
+		case GDScriptFunction::OPCODE_GET_NAMED:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_ARRAY:
+			return 5;
+		case GDScriptFunction::OPCODE_TYPE_TEST_BUILTIN:
+		case GDScriptFunction::OPCODE_TYPE_TEST_NATIVE:
+		case GDScriptFunction::OPCODE_TYPE_TEST_SCRIPT:
+		case GDScriptFunction::OPCODE_SET_KEYED:
+		case GDScriptFunction::OPCODE_GET_KEYED:
+		case GDScriptFunction::OPCODE_SET_NAMED_VALIDATED:
+		case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED:
+		case GDScriptFunction::OPCODE_SET_STATIC_VARIABLE:
+		case GDScriptFunction::OPCODE_GET_STATIC_VARIABLE:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_NATIVE:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_SCRIPT:
+		case GDScriptFunction::OPCODE_CAST_TO_BUILTIN:
+		case GDScriptFunction::OPCODE_CAST_TO_NATIVE:
+		case GDScriptFunction::OPCODE_CAST_TO_SCRIPT:
+			return 4;
+		case GDScriptFunction::OPCODE_TYPE_TEST_ARRAY:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_ARRAY:
+			return 6;
+		case GDScriptFunction::OPCODE_TYPE_TEST_DICTIONARY:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_DICTIONARY:
+			return 9;
+		case GDScriptFunction::OPCODE_SET_MEMBER:
+		case GDScriptFunction::OPCODE_GET_MEMBER:
+		case GDScriptFunction::OPCODE_GET_MEMBER_OPERATOR_VALIDATED:
+		case GDScriptFunction::OPCODE_ASSIGN:
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+		case GDScriptFunction::OPCODE_JUMP_IF_SHARED:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_NATIVE:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_SCRIPT:
+		case GDScriptFunction::OPCODE_STORE_GLOBAL:
+		case GDScriptFunction::OPCODE_STORE_NAMED_GLOBAL:
+		case GDScriptFunction::OPCODE_ASSERT:
+			return 3;
+		case GDScriptFunction::OPCODE_ASSIGN_NULL:
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+		case GDScriptFunction::OPCODE_AWAIT:
+		case GDScriptFunction::OPCODE_AWAIT_RESUME:
+		case GDScriptFunction::OPCODE_JUMP:
+		case GDScriptFunction::OPCODE_RETURN:
+		case GDScriptFunction::OPCODE_LINE:
+			return 2;
+		case GDScriptFunction::OPCODE_RETURN_TYPED_DICTIONARY:
+			return 8;
+		case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT:
+		case GDScriptFunction::OPCODE_BREAKPOINT:
+		case GDScriptFunction::OPCODE_END:
+			return 1;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_RANGE:
+			return 7;
+		case GDScriptFunction::OPCODE_ITERATE_RANGE:
+			return 6;
+		// Instructions with a variable number of addresses: opcode, address count, addresses, then the rest.
+		case GDScriptFunction::OPCODE_CONSTRUCT_ARRAY:
+		case GDScriptFunction::OPCODE_CONSTRUCT_DICTIONARY:
+			return 3 + code[p_ip + 1];
+		case GDScriptFunction::OPCODE_CONSTRUCT:
+		case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_RET:
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC:
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN:
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN:
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED:
+		case GDScriptFunction::OPCODE_CALL_UTILITY:
+		case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED:
+		case GDScriptFunction::OPCODE_CALL_GDSCRIPT_UTILITY:
+		case GDScriptFunction::OPCODE_CALL_SELF_BASE:
+		case GDScriptFunction::OPCODE_CREATE_LAMBDA:
+		case GDScriptFunction::OPCODE_CREATE_SELF_LAMBDA:
+			return 4 + code[p_ip + 1];
+		case GDScriptFunction::OPCODE_CONSTRUCT_TYPED_ARRAY:
+		case GDScriptFunction::OPCODE_CALL:
+		case GDScriptFunction::OPCODE_CALL_RETURN:
+		case GDScriptFunction::OPCODE_CALL_ASYNC:
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_STATIC:
+			return 5 + code[p_ip + 1];
+		case GDScriptFunction::OPCODE_CONSTRUCT_TYPED_DICTIONARY:
+			return 7 + code[p_ip + 1];
+		default:
+			break;
+	}
+
+	const int opcode = code[p_ip];
+	if ((opcode >= GDScriptFunction::OPCODE_OPERATOR_ADD_INT && opcode <= GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT) ||
+			(opcode >= GDScriptFunction::OPCODE_ITERATE_BEGIN && opcode <= GDScriptFunction::OPCODE_ITERATE_OBJECT)) {
+		return 5;
+	}
+	if (opcode >= GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL && opcode <= GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY) {
+		return 2;
+	}
+
+	return -1;
+}
+
+struct GDScriptNativeCompiler::Translation {
+	const GDScriptFunction *function = nullptr;
+	bool failed = false;
+	bool uses_constants = false;
+	int member_count = 0; // Highest member index used, plus one.
+	HashSet<int> instructions;
+	HashSet<int> jump_targets;
+
+	String address(int p_address) {
+		const int type = (p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS;
+		const int index = p_address & GDScriptFunction::ADDR_MASK;
+		switch (type) {
+			case GDScriptFunction::ADDR_TYPE_STACK:
+				if (index < function->_stack_size) {
+					return vformat("s[%d]", index);
+				}
+				break;
+			case GDScriptFunction::ADDR_TYPE_CONSTANT:
+				if (index < function->_constant_count) {
+					uses_constants = true;
+					return vformat("c[%d]", index);
+				}
+				break;
+			case GDScriptFunction::ADDR_TYPE_MEMBER:
+				member_count = MAX(member_count, index + 1);
+				return vformat("m[%d]", index);
+		}
+		failed = true;
+		return "s[0]";
+	}
+
+	// Declares `args` for the first `p_argc` instruction arguments.
+	String argument_array(int p_ip, int p_argc) {
+		if (p_argc == 0) {
+			return "\t\tconst Variant **args = nullptr;\n";
+		}
+		String list;
+		for (int i = 0; i < p_argc; i++) {
+			list += (i > 0 ? ", &" : "&") + address(function->_code_ptr[p_ip + 2 + i]);
+		}
+		return "\t\tconst Variant *args[] = { " + list + " };\n";
+	}
+
+	String jump(int p_target) {
+		if (!instructions.has(p_target)) {
+			failed = true;
+		}
+		jump_targets.insert(p_target);
+		return vformat("goto L%d;", p_target);
+	}
+};
+
+String GDScriptNativeCompiler::translate_function(const GDScriptFunction *p_function, const String &p_symbol) {
+	static const char *adjust_types[] = {
+		"bool",
+		"int64_t",
+		"double",
+		"String",
+		"Vector2",
+		"Vector2i",
+		"Rect2",
+		"Rect2i",
+		"Vector3",
+		"Vector3i",
+		"Transform2D",
+		"Vector4",
+		"Vector4i",
+		"Plane",
+		"Quaternion",
+		"AABB",
+		"Basis",
+		"Transform3D",
+		"Projection",
+		"Color",
+		"StringName",
+		"NodePath",
+		"RID",
+		"Object *",
+		"Callable",
+		"Signal",
+		"Dictionary",
+		"Array",
+		"PackedByteArray",
+		"PackedInt32Array",
+		"PackedInt64Array",
+		"PackedFloat32Array",
+		"PackedFloat64Array",
+		"PackedStringArray",
+		"PackedVector2Array",
+		"PackedVector3Array",
+		"PackedColorArray",
+		"PackedVector4Array",
+	};
+	static_assert(std::size(adjust_types) == GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY - GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL + 1, "Type adjust opcodes changed.");
+
+	struct TypedOperator {
+		const char *op;
+		const char *left;
+		const char *right;
+		const char *result;
+	};
+	static const TypedOperator typed_operators[] = {
+		{ "+", "get_int", "get_int", "get_int" },
+		{ "-", "get_int", "get_int", "get_int" },
+		{ "*", "get_int", "get_int", "get_int" },
+		{ "==", "get_int", "get_int", "get_bool" },
+		{ "!=", "get_int", "get_int", "get_bool" },
+		{ "<", "get_int", "get_int", "get_bool" },
+		{ "<=", "get_int", "get_int", "get_bool" },
+		{ ">", "get_int", "get_int", "get_bool" },
+		{ ">=", "get_int", "get_int", "get_bool" },
+		{ "+", "get_float", "get_float", "get_float" },
+		{ "-", "get_float", "get_float", "get_float" },
+		{ "*", "get_float", "get_float", "get_float" },
+		{ "==", "get_float", "get_float", "get_bool" },
+		{ "!=", "get_float", "get_float", "get_bool" },
+		{ "<", "get_float", "get_float", "get_bool" },
+		{ "<=", "get_float", "get_float", "get_bool" },
+		{ ">", "get_float", "get_float", "get_bool" },
+		{ ">=", "get_float", "get_float", "get_bool" },
+		{ "+", "get_vector2", "get_vector2", "get_vector2" },
+		{ "-", "get_vector2", "get_vector2", "get_vector2" },
+		{ "*", "get_vector2", "get_vector2", "get_vector2" },
+		{ "*", "get_vector2", "get_float", "get_vector2" },
+		{ "+", "get_vector3", "get_vector3", "get_vector3" },
+		{ "-", "get_vector3", "get_vector3", "get_vector3" },
+		{ "*", "get_vector3", "get_vector3", "get_vector3" },
+		{ "*", "get_vector3", "get_float", "get_vector3" },
+	};
+	static_assert(std::size(typed_operators) == GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT - GDScriptFunction::OPCODE_OPERATOR_ADD_INT + 1, "Typed operator opcodes changed.");
+
+	const int *code = p_function->_code_ptr;
+	const int code_size = p_function->_code_size;
+	if (code == nullptr) {
+		return String();
+	}
+
+	Translation t;
+	t.function = p_function;
+
+	// First pass: instruction boundaries and the points the VM may hand control back at.
+	LocalVector<int> instructions;
+	HashSet<int> entries;
+	entries.insert(0);
+	for (int ip = 0; ip < code_size;) {
+		const int size = _get_instruction_size(p_function, ip);
+		if (size <= 0 || ip + size > code_size) {
+			return String();
+		}
+		instructions.push_back(ip);
+		t.instructions.insert(ip);
+		if (is_resume_point(code[ip])) {
+			entries.insert(ip + size);
+		}
+		ip += size;
+	}
+	// Jumping to the end of the code returns, like running past the last instruction does in the VM.
+	t.instructions.insert(code_size);
+
+	// Second pass: one block per instruction. Whatever isn't handled here returns to the VM at that instruction.
+	LocalVector<String> blocks;
+	int translated = 0;
+	int total = 0;
+	for (int ip : instructions) {
+		const int opcode = code[ip];
+		String block;
+		bool counts = true;
+
+#define ADDR(m_offset) t.address(code[ip + 1 + (m_offset)])
+
+		switch (opcode) {
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
+				if (code[ip + 4] < 0 || code[ip + 4] >= p_function->_operator_funcs_count) {
+					break;
+				}
+				block = vformat("\tGDScriptNativeCompiler::get_operator_func(f, %d)(&%s, &%s, &%s);\n", code[ip + 4], ADDR(0), ADDR(1), ADDR(2));
+			} break;
+			case GDScriptFunction::OPCODE_TYPE_TEST_BUILTIN: {
+				block = vformat("\t%s = %s.get_type() == Variant::Type(%d);\n", ADDR(0), ADDR(1), code[ip + 3]);
+			} break;
+			case GDScriptFunction::OPCODE_SET_KEYED_VALIDATED: {
+				if (code[ip + 4] < 0 || code[ip + 4] >= p_function->_keyed_setters_count) {
+					break;
+				}
+				block = vformat("\t{\n\t\tbool valid;\n\t\tGDScriptNativeCompiler::get_keyed_setter(f, %d)(&%s, &%s, &%s, &valid);\n#ifdef DEBUG_ENABLED\n\t\tif (unlikely(!valid)) {\n\t\t\treturn %d;\n\t\t}\n#endif\n\t}\n",
+						code[ip + 4], ADDR(0), ADDR(1), ADDR(2), ip);
+			} break;
+			case GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED: {
+				if (code[ip + 4] < 0 || code[ip + 4] >= p_function->_indexed_setters_count) {
+					break;
+				}
+				block = vformat("\t{\n\t\tbool oob;\n\t\tGDScriptNativeCompiler::get_indexed_setter(f, %d)(&%s, *VariantInternal::get_int(&%s), &%s, &oob);\n#ifdef DEBUG_ENABLED\n\t\tif (unlikely(oob)) {\n\t\t\treturn %d;\n\t\t}\n#endif\n\t}\n",
+						code[ip + 4], ADDR(0), ADDR(1), ADDR(2), ip);
+			} break;
+			case GDScriptFunction::OPCODE_GET_KEYED_VALIDATED: {
+				if (code[ip + 4] < 0 || code[ip + 4] >= p_function->_keyed_getters_count) {
+					break;
+				}
+				block = vformat("\t{\n\t\tbool valid;\n#ifdef DEBUG_ENABLED\n\t\tVariant ret;\n\t\tGDScriptNativeCompiler::get_keyed_getter(f, %d)(&%s, &%s, &ret, &valid);\n\t\tif (unlikely(!valid)) {\n\t\t\treturn %d;\n\t\t}\n\t\t%s = ret;\n#else\n\t\tGDScriptNativeCompiler::get_keyed_getter(f, %d)(&%s, &%s, &%s, &valid);\n#endif\n\t}\n",
+						code[ip + 4], ADDR(0), ADDR(1), ip, ADDR(2), code[ip + 4], ADDR(0), ADDR(1), ADDR(2));
+			} break;
+			case GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED: {
+				if (code[ip + 4] < 0 || code[ip + 4] >= p_function->_indexed_getters_count) {
+					break;
+				}
+				block = vformat("\t{\n\t\tbool oob;\n\t\tGDScriptNativeCompiler::get_indexed_getter(f, %d)(&%s, *VariantInternal::get_int(&%s), &%s, &oob);\n#ifdef DEBUG_ENABLED\n\t\tif (unlikely(oob)) {\n\t\t\treturn %d;\n\t\t}\n#endif\n\t}\n",
+						code[ip + 4], ADDR(0), ADDR(1), ADDR(2), ip);
+			} break;
+			case GDScriptFunction::OPCODE_SET_NAMED_VALIDATED: {
+				if (code[ip + 3] < 0 || code[ip + 3] >= p_function->_setters_count) {
+					break;
+				}
+				block = vformat("\tGDScriptNativeCompiler::get_setter(f, %d)(&%s, &%s);\n", code[ip + 3], ADDR(0), ADDR(1));
+			} break;
+			case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED: {
+				if (code[ip + 3] < 0 || code[ip + 3] >= p_function->_getters_count) {
+					break;
+				}
+				block = vformat("\tGDScriptNativeCompiler::get_getter(f, %d)(&%s, &%s);\n", code[ip + 3], ADDR(0), ADDR(1));
+			} break;
+			case GDScriptFunction::OPCODE_ASSIGN: {
+				block = vformat("\t%s = %s;\n", ADDR(0), ADDR(1));
+			} break;
+			case GDScriptFunction::OPCODE_ASSIGN_NULL: {
+				block = vformat("\t%s = Variant();\n", ADDR(0));
+			} break;
+			case GDScriptFunction::OPCODE_ASSIGN_TRUE: {
+				block = vformat("\t%s = true;\n", ADDR(0));
+			} break;
+			case GDScriptFunction::OPCODE_ASSIGN_FALSE: {
+				block = vformat("\t%s = false;\n", ADDR(0));
+			} break;
+			case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN: {
+				// Conversions are left to the VM.
+				block = vformat("\tif (unlikely(%s.get_type() != Variant::Type(%d))) {\n\t\treturn %d;\n\t}\n\t%s = %s;\n", ADDR(1), code[ip + 3], ip, ADDR(0), ADDR(1));
+			} break;
+			case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED: {
+				const int argc = code[ip + 2 + code[ip + 1]];
+				const int index = code[ip + 3 + code[ip + 1]];
+				if (argc < 0 || argc + 1 != code[ip + 1] || index < 0 || index >= p_function->_constructors_count) {
+					break;
+				}
+				block = vformat("\t{\n%s\t\tGDScriptNativeCompiler::get_constructor(f, %d)(&%s, %s);\n\t}\n",
+						t.argument_array(ip, argc), index, t.address(code[ip + 2 + argc]), "args");
+			} break;
+			case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED: {
+				const int argc = code[ip + 2 + code[ip + 1]];
+				const int index = code[ip + 3 + code[ip + 1]];
+				if (argc < 0 || argc + 2 != code[ip + 1] || index < 0 || index >= p_function->_builtin_methods_count) {
+					break;
+				}
+				block = vformat("\t{\n%s\t\tGDScriptNativeCompiler::get_builtin_method(f, %d)(&%s, %s, %d, &%s);\n\t}\n",
+						t.argument_array(ip, argc), index, t.address(code[ip + 2 + argc]), "args", argc, t.address(code[ip + 3 + argc]));
+			} break;
+			case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED: {
+				const int argc = code[ip + 2 + code[ip + 1]];
+				const int index = code[ip + 3 + code[ip + 1]];
+				if (argc < 0 || argc + 1 != code[ip + 1] || index < 0 || index >= p_function->_utilities_count) {
+					break;
+				}
+				block = vformat("\t{\n%s\t\tGDScriptNativeCompiler::get_utility(f, %d)(&%s, %s, %d);\n\t}\n",
+						t.argument_array(ip, argc), index, t.address(code[ip + 2 + argc]), "args", argc);
+			} break;
+			case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+			case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN: {
+				const int argc = code[ip + 2 + code[ip + 1]];
+				const int index = code[ip + 3 + code[ip + 1]];
+				if (argc < 0 || argc + 2 != code[ip + 1] || index < 0 || index >= p_function->_methods_count) {
+					break;
+				}
+				// Calls on null or freed objects are reported by the VM.
+				const String base = t.address(code[ip + 2 + argc]);
+				const String ret = t.address(code[ip + 3 + argc]);
+				String call;
+				if (opcode == GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN) {
+					call = vformat("\t\tGDScriptNativeCompiler::get_method(f, %d)->validated_call(base_obj, %s, &%s);\n", index, "args", ret);
+				} else {
+					call = vformat("\t\tVariantInternal::initialize(&%s, Variant::NIL);\n\t\tGDScriptNativeCompiler::get_method(f, %d)->validated_call(base_obj, %s, nullptr);\n", ret, index, "args");
+				}
+				block = vformat("\t{\n#ifdef DEBUG_ENABLED\n\t\tbool freed = false;\n\t\tObject *base_obj = %s.get_validated_object_with_check(freed);\n\t\tif (unlikely(freed || !base_obj)) {\n\t\t\treturn %d;\n\t\t}\n#else\n\t\tObject *base_obj = *VariantInternal::get_object(&%s);\n#endif\n%s%s\t}\n",
+						base, ip, base, t.argument_array(ip, argc), call);
+			} break;
+			case GDScriptFunction::OPCODE_JUMP: {
+				block = "\t" + t.jump(code[ip + 1]);
+				block += "\n";
+			} break;
+			case GDScriptFunction::OPCODE_JUMP_IF:
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+				const String jump = t.jump(code[ip + 2]);
+				block = vformat("\tif (%s%s.booleanize()) {\n\t\t%s\n\t}\n", opcode == GDScriptFunction::OPCODE_JUMP_IF_NOT ? "!" : "", ADDR(0), jump);
+			} break;
+			case GDScriptFunction::OPCODE_JUMP_IF_SHARED: {
+				const String jump = t.jump(code[ip + 2]);
+				block = vformat("\tif (%s.is_shared()) {\n\t\t%s\n\t}\n", ADDR(0), jump);
+			} break;
+			case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT: {
+				block = "\tswitch (p_frame.defarg) {\n";
+				for (int i = 0; i < p_function->default_arguments.size(); i++) {
+					const String jump = t.jump(p_function->default_arguments[i]);
+					block += vformat("\t\tcase %d:\n\t\t\t%s\n", i, jump);
+				}
+				block += vformat("\t\tdefault:\n\t\t\treturn %d;\n\t}\n", ip);
+			} break;
+			case GDScriptFunction::OPCODE_RETURN: {
+				block = vformat("\t*p_frame.retvalue = %s;\n\treturn -1;\n", ADDR(0));
+			} break;
+			case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN: {
+				block = vformat("\tif (unlikely(%s.get_type() != Variant::Type(%d))) {\n\t\treturn %d;\n\t}\n\t*p_frame.retvalue = %s;\n\treturn -1;\n", ADDR(0), code[ip + 2], ip, ADDR(0));
+			} break;
+			case GDScriptFunction::OPCODE_ITERATE_BEGIN_INT:
+			case GDScriptFunction::OPCODE_ITERATE_BEGIN_FLOAT: {
+				const bool is_int = opcode == GDScriptFunction::OPCODE_ITERATE_BEGIN_INT;
+				const char *type = is_int ? "int64_t" : "double";
+				const char *getter = is_int ? "get_int" : "get_float";
+				const char *variant_type = is_int ? "INT" : "FLOAT";
+				const String jump = t.jump(code[ip + 4]);
+				block = vformat("\t{\n\t\tconst %s size = *VariantInternal::%s(&%s);\n\t\tVariantInternal::initialize(&%s, Variant::%s);\n\t\t*VariantInternal::%s(&%s) = 0;\n\t\tif (size <= 0) {\n\t\t\t%s\n\t\t}\n\t\tVariantInternal::initialize(&%s, Variant::%s);\n\t\t*VariantInternal::%s(&%s) = 0;\n\t}\n",
+						type, getter, ADDR(1), ADDR(0), variant_type, getter, ADDR(0), jump, ADDR(2), variant_type, getter, ADDR(2));
+			} break;
+			case GDScriptFunction::OPCODE_ITERATE_INT:
+			case GDScriptFunction::OPCODE_ITERATE_FLOAT: {
+				const bool is_int = opcode == GDScriptFunction::OPCODE_ITERATE_INT;
+				const char *type = is_int ? "int64_t" : "double";
+				const char *getter = is_int ? "get_int" : "get_float";
+				const String jump = t.jump(code[ip + 4]);
+				block = vformat("\t{\n\t\tconst %s size = *VariantInternal::%s(&%s);\n\t\t%s *count = VariantInternal::%s(&%s);\n\t\t(*count)++;\n\t\tif (*count >= size) {\n\t\t\t%s\n\t\t}\n\t\t*VariantInternal::%s(&%s) = *count;\n\t}\n",
+						type, getter, ADDR(1), type, getter, ADDR(0), jump, getter, ADDR(2));
+			} break;
+			case GDScriptFunction::OPCODE_ITERATE_BEGIN_RANGE: {
+				const String jump = t.jump(code[ip + 6]);
+				block = vformat("\t{\n\t\tconst int64_t from = *VariantInternal::get_int(&%s);\n\t\tconst int64_t to = *VariantInternal::get_int(&%s);\n\t\tconst int64_t step = *VariantInternal::get_int(&%s);\n\t\tVariantInternal::initialize(&%s, Variant::INT);\n\t\t*VariantInternal::get_int(&%s) = from;\n\t\tconst bool do_continue = from == to ? false : (from < to ? step > 0 : step < 0);\n\t\tif (!do_continue) {\n\t\t\t%s\n\t\t}\n\t\tVariantInternal::initialize(&%s, Variant::INT);\n\t\t*VariantInternal::get_int(&%s) = from;\n\t}\n",
+						ADDR(1), ADDR(2), ADDR(3), ADDR(0), ADDR(0), jump, ADDR(4), ADDR(4));
+			} break;
+			case GDScriptFunction::OPCODE_ITERATE_RANGE: {
+				const String jump = t.jump(code[ip + 5]);
+				block = vformat("\t{\n\t\tconst int64_t to = *VariantInternal::get_int(&%s);\n\t\tconst int64_t step = *VariantInternal::get_int(&%s);\n\t\tint64_t *count = VariantInternal::get_int(&%s);\n\t\t*count += step;\n\t\tif ((step < 0 && *count <= to) || (step > 0 && *count >= to)) {\n\t\t\t%s\n\t\t}\n\t\t*VariantInternal::get_int(&%s) = *count;\n\t}\n",
+						ADDR(1), ADDR(2), ADDR(0), jump, ADDR(3));
+			} break;
+			case GDScriptFunction::OPCODE_ITERATE_BEGIN_ARRAY: {
+				const String jump = t.jump(code[ip + 4]);
+				block = vformat("\t{\n\t\tArray *array = VariantInternal::get_array(&%s);\n\t\tVariantInternal::initialize(&%s, Variant::INT);\n\t\t*VariantInternal::get_int(&%s) = 0;\n\t\tif (array->is_empty()) {\n\t\t\t%s\n\t\t}\n\t\t%s = array->get(0);\n\t}\n",
+						ADDR(1), ADDR(0), ADDR(0), jump, ADDR(2));
+			} break;
+			case GDScriptFunction::OPCODE_ITERATE_ARRAY: {
+				const String jump = t.jump(code[ip + 4]);
+				block = vformat("\t{\n\t\tconst Array *array = VariantInternal::get_array((const Variant *)&%s);\n\t\tint64_t *idx = VariantInternal::get_int(&%s);\n\t\t(*idx)++;\n\t\tif (*idx >= array->size()) {\n\t\t\t%s\n\t\t}\n\t\t%s = array->get(*idx);\n\t}\n",
+						ADDR(1), ADDR(0), jump, ADDR(2));
+			} break;
+			case GDScriptFunction::OPCODE_LINE: {
+				block = vformat("\t*p_frame.line = %d;\n", code[ip + 1]);
+				counts = false;
+			} break;
+			case GDScriptFunction::OPCODE_END: {
+				block = "\treturn -1;\n";
+				counts = false;
+			} break;
+			default: {
+				if (opcode >= GDScriptFunction::OPCODE_OPERATOR_ADD_INT && opcode <= GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT) {
+					const TypedOperator &op = typed_operators[opcode - GDScriptFunction::OPCODE_OPERATOR_ADD_INT];
+					if (opcode <= GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_INT) {
+						// Wraps around on overflow like the VM.
+						block = vformat("\t*VariantInternal::get_int(&%s) = int64_t(uint64_t(*VariantInternal::get_int(&%s)) %s uint64_t(*VariantInternal::get_int(&%s)));\n", ADDR(2), ADDR(0), op.op, ADDR(1));
+					} else {
+						block = vformat("\t*VariantInternal::%s(&%s) = *VariantInternal::%s(&%s) %s *VariantInternal::%s(&%s);\n", op.result, ADDR(2), op.left, ADDR(0), op.op, op.right, ADDR(1));
+					}
+				} else if (opcode >= GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL && opcode <= GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY) {
+					block = vformat("\tVariantTypeAdjust<%s>::adjust(&%s);\n", adjust_types[opcode - GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL], ADDR(0));
+				}
+			} break;
+		}
+
+#undef ADDR
+
+		if (t.failed) {
+			return String();
+		}
+
+		if (counts) {
+			total++;
+		}
+		if (block.is_empty()) {
+			block = vformat("\treturn %d;\n", ip);
+		} else if (counts) {
+			translated++;
+		}
+
+		blocks.push_back(block);
+	}
+
+	// Mostly untyped code gains little and mostly bounces between the VM and the native code.
+	if (translated == 0 || translated * 2 < total) {
+		return String();
+	}
+
+	StringBuilder source;
+	source.append(vformat("static int %s(GDScriptFunction::NativeFrame &p_frame) {\n", p_symbol));
+	source.append("\tconst GDScriptFunction *f = p_frame.function;\n");
+	source.append("\tVariant *s = p_frame.stack;\n");
+	if (t.uses_constants) {
+		source.append("\tVariant *c = GDScriptNativeCompiler::get_constants(f);\n");
+	}
+	if (t.member_count > 0) {
+		source.append("\tVariant *m = p_frame.members;\n");
+		// Missing instance or members: let the VM report it.
+		source.append(vformat("\tif (unlikely(p_frame.member_count < %d)) {\n\t\treturn p_frame.ip;\n\t}\n", t.member_count));
+	}
+	source.append("\t(void)f;\n\t(void)s;\n");
+
+	LocalVector<int> sorted_entries;
+	for (int entry : entries) {
+		if (t.instructions.has(entry)) {
+			sorted_entries.push_back(entry);
+		}
+	}
+	sorted_entries.sort();
+
+	source.append("\tswitch (p_frame.ip) {\n");
+	for (int entry : sorted_entries) {
+		t.jump_targets.insert(entry);
+		source.append(vformat("\t\tcase %d:\n\t\t\tgoto L%d;\n", entry, entry));
+	}
+	source.append("\t\tdefault:\n\t\t\treturn p_frame.ip;\n\t}\n");
+
+	// Labels are only emitted where they are used, so the generated code compiles without warnings.
+	for (uint32_t i = 0; i < instructions.size(); i++) {
+		if (t.jump_targets.has(instructions[i])) {
+			source.append(vformat("L%d:\n", instructions[i]));
+		}
+		source.append(blocks[i]);
+	}
+	if (t.jump_targets.has(code_size)) {
+		source.append(vformat("L%d:\n", code_size));
+	}
+	source.append("\treturn -1;\n}\n");
+
+	return source.as_string();
+}
+
+void GDScriptNativeCompiler::_collect_lambdas(const GDScriptFunction *p_function, List<const GDScriptFunction *> &r_functions) {
+	for (int i = 0; i < p_function->_lambdas_count; i++) {
+		r_functions.push_back(p_function->_lambdas_ptr[i]);
+		_collect_lambdas(p_function->_lambdas_ptr[i], r_functions);
+	}
+}
+
+void GDScriptNativeCompiler::_collect_functions(const GDScript *p_script, List<const GDScriptFunction *> &r_functions) {
+	List<const GDScriptFunction *> functions_found;
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->get_member_functions()) {
+		functions_found.push_back(E.value);
+	}
+	if (p_script->get_implicit_initializer()) {
+		functions_found.push_back(p_script->get_implicit_initializer());
+	}
+	if (p_script->get_implicit_ready()) {
+		functions_found.push_back(p_script->get_implicit_ready());
+	}
+	if (p_script->get_static_initializer()) {
+		functions_found.push_back(p_script->get_static_initializer());
+	}
+
+	for (const GDScriptFunction *function : functions_found) {
+		r_functions.push_back(function);
+		_collect_lambdas(function, r_functions);
+	}
+
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->get_subclasses()) {
+		_collect_functions(E.value.ptr(), r_functions);
+	}
+}
+
+Error GDScriptNativeCompiler::generate_module(const Vector<Ref<GDScript>> &p_scripts, const String &p_dir) {
+	const String module_dir = p_dir.path_join("gdscript_native");
+	Error err = DirAccess::make_dir_recursive_absolute(module_dir);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat(R"(Cannot create the native GDScript module directory "%s".)", module_dir));
+
+	List<const GDScriptFunction *> script_functions;
+	for (const Ref<GDScript> &script : p_scripts) {
+		ERR_CONTINUE(script.is_null() || !script->is_valid());
+		_collect_functions(script.ptr(), script_functions);
+	}
+
+	StringBuilder definitions;
+	StringBuilder registrations;
+	HashSet<FunctionKey, FunctionKey> generated;
+	int translated = 0;
+	for (const GDScriptFunction *function : script_functions) {
+		const FunctionKey key = { function->get_name(), hash_function(function) };
+		if (generated.has(key)) {
+			continue;
+		}
+
+		const String symbol = vformat("gdscript_native_%d", translated);
+		const String definition = translate_function(function, symbol);
+		if (definition.is_empty()) {
+			continue;
+		}
+		generated.insert(key);
+		translated++;
+
+		definitions.append(vformat("// %s::%s\n", String(function->get_source()), String(function->get_name())));
+		definitions.append(definition);
+		definitions.append("\n");
+		registrations.append(vformat("\t\tGDScriptNativeCompiler::register_function(StringName(\"%s\"), UINT64_C(0x%s), %s);\n",
+				String(function->get_name()).c_escape(), String::num_uint64(key.code_hash, 16), symbol));
+	}
+
+	HashMap<String, String> files;
+	files["config.py"] = R"(def can_build(env, platform):
+    env.module_add_dependencies("gdscript_native", ["gdscript"])
+    return True
+
+
+def configure(env):
+    pass
+)";
+	files["SCsub"] = R"(#!/usr/bin/env python
+from misc.utility.scons_hints import *
+
+Import("env")
+Import("env_modules")
+
+env_gdscript_native = env_modules.Clone()
+
+env_gdscript_native.add_source_files(env.modules_sources, "*.cpp")
+)";
+	files["register_types.h"] = R"(/* THIS FILE IS GENERATED DO NOT EDIT */
+
+#pragma once
+
+#include "modules/register_module_types.h"
+
+void initialize_gdscript_native_module(ModuleInitializationLevel p_level);
+void uninitialize_gdscript_native_module(ModuleInitializationLevel p_level);
+)";
+	files["register_types.cpp"] = R"(/* THIS FILE IS GENERATED DO NOT EDIT */
+
+#include "register_types.h"
+
+#include "core/object/method_bind.h"
+#include "core/variant/variant_internal.h"
+#include "modules/gdscript/gdscript_native_compiler.h"
+
+)" + definitions.as_string() +
+			"void initialize_gdscript_native_module(ModuleInitializationLevel p_level) {\n"
+			"\tif (p_level == MODULE_INITIALIZATION_LEVEL_SERVERS) {\n" +
+			registrations.as_string() +
+			R"(	}
+}
+
+void uninitialize_gdscript_native_module(ModuleInitializationLevel p_level) {
+	if (p_level == MODULE_INITIALIZATION_LEVEL_SERVERS) {
+		GDScriptNativeCompiler::clear_functions();
+	}
+}
+)";
+
+	for (const KeyValue<String, String> &E : files) {
+		const String path = module_dir.path_join(E.key);
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE, &err);
+		ERR_FAIL_COND_V_MSG(err != OK, err, vformat(R"(Cannot write "%s".)", path));
+		f->store_string(E.value);
+	}
+
+	print_verbose(vformat("GDScript: Translated %d functions to C++ in \"%s\".", translated, module_dir));
+	return OK;
+}
+
+#endif // TOOLS_ENABLED
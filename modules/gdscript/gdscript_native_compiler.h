@@ -0,0 +1,108 @@
+/**************************************************************************/
+/*  gdscript_native_compiler.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "gdscript_function.h"
+
+#include "core/templates/hash_map.h"
+
+class GDScript;
+
+// Ahead-of-time translation of GDScript bytecode to C++, built into the engine as a module.
+//
+// The generated code follows the VM instruction by instruction and works on the same stack, so the
+// VM can take over at any instruction. Instructions the translator doesn't handle, as well as the
+// unusual paths of the ones it does (type conversions, errors), are left to the VM, which hands
+// control back to the native code after calls and other resume points. Each generated function is
+// registered with the hash of the bytecode it was translated from; functions whose bytecode is
+// different at runtime keep running in the VM.
+class GDScriptNativeCompiler {
+	struct FunctionKey {
+		StringName name;
+		uint64_t code_hash = 0;
+
+		bool operator==(const FunctionKey &p_other) const { return code_hash == p_other.code_hash && name == p_other.name; }
+
+		static uint32_t hash(const FunctionKey &p_key) { return hash_murmur3_one_64(p_key.code_hash, p_key.name.hash()); }
+	};
+
+	static HashMap<FunctionKey, GDScriptFunction::NativeFunction, FunctionKey> functions;
+	static bool enabled;
+
+#ifdef TOOLS_ENABLED
+	struct Translation;
+
+	static int _get_instruction_size(const GDScriptFunction *p_function, int p_ip);
+	static void _collect_functions(const GDScript *p_script, List<const GDScriptFunction *> &r_functions);
+	static void _collect_lambdas(const GDScriptFunction *p_function, List<const GDScriptFunction *> &r_functions);
+#endif
+
+public:
+	// Instructions after which the VM re-enters the native code.
+	static bool is_resume_point(int p_opcode);
+	static uint64_t hash_function(const GDScriptFunction *p_function);
+
+	// Called by generated modules while they are initialized.
+	static void register_function(const StringName &p_name, uint64_t p_hash, GDScriptFunction::NativeFunction p_function);
+	static void unregister_function(const StringName &p_name, uint64_t p_hash);
+	static GDScriptFunction::NativeFunction get_function(const StringName &p_name, uint64_t p_hash);
+	static void clear_functions();
+	static bool has_functions() { return !functions.is_empty(); }
+
+	// Attaches the matching native function, if any, to a newly compiled function.
+	static void bind(GDScriptFunction *p_function);
+
+	static void set_enabled(bool p_enabled) { enabled = p_enabled; }
+	_FORCE_INLINE_ static bool is_enabled() { return enabled; }
+
+	// Accessors for generated code.
+	_FORCE_INLINE_ static Variant *get_constants(const GDScriptFunction *p_function) { return p_function->_constants_ptr; }
+	_FORCE_INLINE_ static Variant::ValidatedOperatorEvaluator get_operator_func(const GDScriptFunction *p_function, int p_index) { return p_function->_operator_funcs_ptr[p_index]; }
+	_FORCE_INLINE_ static Variant::ValidatedSetter get_setter(const GDScriptFunction *p_function, int p_index) { return p_function->_setters_ptr[p_index]; }
+	_FORCE_INLINE_ static Variant::ValidatedGetter get_getter(const GDScriptFunction *p_function, int p_index) { return p_function->_getters_ptr[p_index]; }
+	_FORCE_INLINE_ static Variant::ValidatedKeyedSetter get_keyed_setter(const GDScriptFunction *p_function, int p_index) { return p_function->_keyed_setters_ptr[p_index]; }
+	_FORCE_INLINE_ static Variant::ValidatedKeyedGetter get_keyed_getter(const GDScriptFunction *p_function, int p_index) { return p_function->_keyed_getters_ptr[p_index]; }
+	_FORCE_INLINE_ static Variant::ValidatedIndexedSetter get_indexed_setter(const GDScriptFunction *p_function, int p_index) { return p_function->_indexed_setters_ptr[p_index]; }
+	_FORCE_INLINE_ static Variant::ValidatedIndexedGetter get_indexed_getter(const GDScriptFunction *p_function, int p_index) { return p_function->_indexed_getters_ptr[p_index]; }
+	_FORCE_INLINE_ static Variant::ValidatedBuiltInMethod get_builtin_method(const GDScriptFunction *p_function, int p_index) { return p_function->_builtin_methods_ptr[p_index]; }
+	_FORCE_INLINE_ static Variant::ValidatedConstructor get_constructor(const GDScriptFunction *p_function, int p_index) { return p_function->_constructors_ptr[p_index]; }
+	_FORCE_INLINE_ static Variant::ValidatedUtilityFunction get_utility(const GDScriptFunction *p_function, int p_index) { return p_function->_utilities_ptr[p_index]; }
+	_FORCE_INLINE_ static MethodBind *get_method(const GDScriptFunction *p_function, int p_index) { return p_function->_methods_ptr[p_index]; }
+
+#ifdef TOOLS_ENABLED
+	// Returns the C++ definition of a function named `p_symbol` running `p_function`, or an empty string
+	// if too little of it can be translated to be worth it.
+	static String translate_function(const GDScriptFunction *p_function, const String &p_symbol);
+	// Writes a module named `gdscript_native` with the translation of every function of the given scripts
+	// into `p_dir`, to be built into export templates with `custom_modules`.
+	static Error generate_module(const Vector<Ref<GDScript>> &p_scripts, const String &p_dir);
+#endif
+};
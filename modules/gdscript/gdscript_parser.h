@@ -1341,6 +1341,10 @@ private:
 	bool can_continue = false;
 	List<bool> multiline_stack;
 	HashMap<String, Ref<GDScriptParserRef>> depended_parsers;
+	// Likely dependencies seen while parsing (`extends` targets, literal preloads and type names),
+	// so other scripts can be parsed ahead of analysis. Not resolved nor checked to exist.
+	HashSet<String> referenced_paths;
+	HashSet<StringName> referenced_class_names;
 
 	ClassNode *head = nullptr;
 	Node *list = nullptr;
@@ -1600,6 +1604,8 @@ public:
 	bool is_tool() const { return _is_tool; }
 	Ref<GDScriptParserRef> get_depended_parser_for(const String &p_path);
 	const HashMap<String, Ref<GDScriptParserRef>> &get_depended_parsers();
+	const HashSet<String> &get_referenced_paths() const { return referenced_paths; }
+	const HashSet<StringName> &get_referenced_class_names() const { return referenced_class_names; }
 	ClassNode *find_class(const String &p_qualified_name) const;
 	bool has_class(const GDScriptParser::ClassNode *p_class) const;
 	static Variant::Type get_builtin_type(const StringName &p_type); // Excluding `Variant::NIL` and `Variant::OBJECT`.
@@ -0,0 +1,322 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampling_profiler.h"
+
+#include "gdscript_function.h"
+
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "core/templates/hash_map.h"
+
+// Stops recording samples past this many frames in total (about 64 MiB), so a forgotten profiler
+// can't exhaust memory.
+static constexpr uint32_t MAX_SAMPLE_FRAMES = 16 * 1024 * 1024;
+
+SafeFlag GDScriptSamplingProfiler::active;
+SafeNumeric<uint32_t> GDScriptSamplingProfiler::generation;
+thread_local GDScriptSamplingProfiler::ThreadStackOwner GDScriptSamplingProfiler::thread_stack;
+
+Mutex GDScriptSamplingProfiler::mutex;
+LocalVector<GDScriptSamplingProfiler::ThreadStack *> GDScriptSamplingProfiler::thread_stacks;
+LocalVector<String> GDScriptSamplingProfiler::function_names;
+LocalVector<Thread::ID> GDScriptSamplingProfiler::thread_ids;
+LocalVector<GDScriptSamplingProfiler::Sample> GDScriptSamplingProfiler::samples;
+LocalVector<uint32_t> GDScriptSamplingProfiler::sample_frames;
+uint64_t GDScriptSamplingProfiler::start_time = 0;
+uint64_t GDScriptSamplingProfiler::interval_usec = 1000;
+bool GDScriptSamplingProfiler::overflowed = false;
+Thread GDScriptSamplingProfiler::sampler_thread;
+
+GDScriptSamplingProfiler::ThreadStackOwner::~ThreadStackOwner() {
+	if (stack == nullptr) {
+		return;
+	}
+	MutexLock lock(mutex);
+	thread_stacks.erase(stack);
+	memdelete(stack);
+	stack = nullptr;
+}
+
+uint32_t GDScriptSamplingProfiler::_register_function(GDScriptFunction *p_function) {
+	MutexLock lock(mutex);
+
+	// Another thread may have registered it meanwhile.
+	uint32_t id = p_function->sampling_id.get();
+	if (id == 0) {
+		function_names.push_back(vformat("%s (%s:%d)", p_function->get_name(), p_function->get_source(), p_function->_initial_line).replace(";", ":"));
+		id = function_names.size();
+		p_function->sampling_id.set(id);
+	}
+	return id;
+}
+
+void GDScriptSamplingProfiler::_enter(GDScriptFunction *p_function) {
+	ThreadStack *stack = thread_stack.stack;
+	if (unlikely(stack == nullptr)) {
+		stack = memnew(ThreadStack);
+		stack->thread_id = Thread::get_caller_id();
+		stack->generation = generation.get();
+
+		MutexLock lock(mutex);
+		stack->index = thread_ids.size();
+		thread_ids.push_back(stack->thread_id);
+		thread_stacks.push_back(stack);
+		thread_stack.stack = stack;
+	}
+
+	// Frames pushed during an earlier profiling session may never have been popped.
+	const uint32_t current_generation = generation.get();
+	if (unlikely(stack->generation != current_generation)) {
+		stack->generation = current_generation;
+		stack->depth.set(0);
+	}
+
+	uint32_t id = p_function->sampling_id.get();
+	if (unlikely(id == 0)) {
+		id = _register_function(p_function);
+	}
+
+	const uint32_t depth = stack->depth.get();
+	if (depth < MAX_DEPTH) {
+		stack->frames[depth].store(id, std::memory_order_relaxed);
+	}
+	stack->depth.set(depth + 1);
+}
+
+void GDScriptSamplingProfiler::_exit() {
+	ThreadStack *stack = thread_stack.stack;
+	if (stack == nullptr || stack->generation != generation.get()) {
+		return;
+	}
+	// Functions entered before profiling started return without a matching push.
+	const uint32_t depth = stack->depth.get();
+	if (depth > 0) {
+		stack->depth.set(depth - 1);
+	}
+}
+
+void GDScriptSamplingProfiler::_take_sample() {
+	MutexLock lock(mutex);
+
+	const uint64_t time = OS::get_singleton()->get_ticks_usec();
+	const uint32_t current_generation = generation.get();
+	for (ThreadStack *stack : thread_stacks) {
+		uint32_t depth = stack->generation == current_generation ? MIN(stack->depth.get(), MAX_DEPTH) : 0;
+		// Idle threads are only recorded when they become idle, to end their last stack.
+		if (depth == 0 && stack->last_sampled_depth == 0) {
+			continue;
+		}
+		if (sample_frames.size() + depth > MAX_SAMPLE_FRAMES) {
+			overflowed = true;
+			return;
+		}
+
+		Sample sample;
+		sample.time = time;
+		sample.thread = stack->index;
+		sample.frame_offset = sample_frames.size();
+		// The thread keeps running meanwhile, so a sample can mix two stacks of the same thread.
+		// That is as rare as the switch happening exactly while sampling, which is fine statistically.
+		for (uint32_t i = 0; i < depth; i++) {
+			const uint32_t id = stack->frames[i].load(std::memory_order_relaxed);
+			if (id == 0) {
+				depth = i;
+				break;
+			}
+			sample_frames.push_back(id);
+		}
+		sample.depth = depth;
+		samples.push_back(sample);
+		stack->last_sampled_depth = depth;
+	}
+}
+
+void GDScriptSamplingProfiler::_sampler_loop(void *p_userdata) {
+	Thread::set_name("GDScript Sampling Profiler");
+	while (active.is_set()) {
+		OS::get_singleton()->delay_usec(interval_usec);
+		if (!overflowed) {
+			_take_sample();
+		}
+	}
+}
+
+void GDScriptSamplingProfiler::start(uint64_t p_interval_usec) {
+	ERR_FAIL_COND_MSG(active.is_set(), "The GDScript sampling profiler is already running.");
+
+	clear();
+	{
+		MutexLock lock(mutex);
+		interval_usec = MAX(p_interval_usec, 10u);
+		start_time = OS::get_singleton()->get_ticks_usec();
+		for (ThreadStack *stack : thread_stacks) {
+			stack->last_sampled_depth = 0;
+		}
+	}
+	generation.increment();
+	active.set();
+	sampler_thread.start(_sampler_loop, nullptr);
+}
+
+void GDScriptSamplingProfiler::stop() {
+	if (!active.is_set()) {
+		return;
+	}
+	active.clear();
+	sampler_thread.wait_to_finish();
+	if (overflowed) {
+		WARN_PRINT(vformat("GDScript sampling profiler stopped recording after %d samples, the profile only covers the beginning of the run.", samples.size()));
+	}
+}
+
+String GDScriptSamplingProfiler::_get_thread_name(uint32_t p_thread) {
+	if (thread_ids[p_thread] == Thread::get_main_id()) {
+		return "Main Thread";
+	}
+	return vformat("Thread %d", p_thread);
+}
+
+Error GDScriptSamplingProfiler::_save_folded(const String &p_path) {
+	// Identical stacks are merged by hashing their frame IDs; collisions are resolved by comparing them.
+	struct FoldedStack {
+		uint32_t sample = 0; // First sample with this stack.
+		uint64_t count = 0;
+	};
+	HashMap<uint32_t, LocalVector<FoldedStack>> stacks;
+	for (uint32_t i = 0; i < samples.size(); i++) {
+		const Sample &sample = samples[i];
+		if (sample.depth == 0) {
+			continue;
+		}
+		uint32_t hash = hash_murmur3_one_32(sample.thread);
+		hash = hash_murmur3_buffer(sample_frames.ptr() + sample.frame_offset, sample.depth * sizeof(uint32_t), hash);
+
+		LocalVector<FoldedStack> &bucket = stacks[hash];
+		bool found = false;
+		for (FoldedStack &folded : bucket) {
+			const Sample &other = samples[folded.sample];
+			if (other.thread == sample.thread && other.depth == sample.depth && memcmp(sample_frames.ptr() + other.frame_offset, sample_frames.ptr() + sample.frame_offset, sample.depth * sizeof(uint32_t)) == 0) {
+				folded.count++;
+				found = true;
+				break;
+			}
+		}
+		if (!found) {
+			FoldedStack folded;
+			folded.sample = i;
+			folded.count = 1;
+			bucket.push_back(folded);
+		}
+	}
+
+	Error err = OK;
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat(R"(Could not open "%s" to save the GDScript sampling profile.)", p_path));
+
+	for (const KeyValue<uint32_t, LocalVector<FoldedStack>> &E : stacks) {
+		for (const FoldedStack &folded : E.value) {
+			const Sample &sample = samples[folded.sample];
+			String line = _get_thread_name(sample.thread);
+			for (uint32_t i = 0; i < sample.depth; i++) {
+				line += ";" + function_names[sample_frames[sample.frame_offset + i] - 1];
+			}
+			file->store_line(line + " " + itos(folded.count));
+		}
+	}
+
+	return OK;
+}
+
+Error GDScriptSamplingProfiler::_save_chrome_trace(const String &p_path) {
+	Error err = OK;
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat(R"(Could not open "%s" to save the GDScript sampling profile.)", p_path));
+
+	// Consecutive samples of a thread are turned into begin and end events for the frames that
+	// differ, so a function shows as running from the first sample it's seen in until the last.
+	file->store_string("{\"traceEvents\":[\n");
+	for (uint32_t i = 0; i < thread_ids.size(); i++) {
+		file->store_string(vformat(R"({"name":"thread_name","ph":"M","pid":1,"tid":%d,"args":{"name":"%s"}},)", i, _get_thread_name(i).json_escape()) + "\n");
+	}
+
+	LocalVector<LocalVector<uint32_t>> open_frames;
+	open_frames.resize(thread_ids.size());
+	uint64_t last_time = start_time;
+
+	for (const Sample &sample : samples) {
+		LocalVector<uint32_t> &open = open_frames[sample.thread];
+		const uint32_t *frames = sample_frames.ptr() + sample.frame_offset;
+		const uint64_t time = sample.time - start_time;
+
+		uint32_t common = 0;
+		while (common < open.size() && common < sample.depth && open[common] == frames[common]) {
+			common++;
+		}
+		while (open.size() > common) {
+			file->store_string(vformat(R"({"ph":"E","pid":1,"tid":%d,"ts":%d},)", sample.thread, time) + "\n");
+			open.resize(open.size() - 1);
+		}
+		for (uint32_t i = common; i < sample.depth; i++) {
+			file->store_string(vformat(R"({"name":"%s","ph":"B","pid":1,"tid":%d,"ts":%d},)", function_names[frames[i] - 1].json_escape(), sample.thread, time) + "\n");
+			open.push_back(frames[i]);
+		}
+		last_time = sample.time;
+	}
+
+	for (uint32_t thread = 0; thread < open_frames.size(); thread++) {
+		for (uint32_t i = 0; i < open_frames[thread].size(); i++) {
+			file->store_string(vformat(R"({"ph":"E","pid":1,"tid":%d,"ts":%d},)", thread, last_time - start_time) + "\n");
+		}
+	}
+
+	// Metadata event without a trailing comma, so every event above can have one.
+	file->store_string(R"({"name":"process_name","ph":"M","pid":1,"args":{"name":"GDScript"}}]})");
+	file->store_string("\n");
+
+	return OK;
+}
+
+Error GDScriptSamplingProfiler::save(const String &p_path) {
+	ERR_FAIL_COND_V_MSG(active.is_set(), ERR_BUSY, "Stop the GDScript sampling profiler before saving its results.");
+
+	MutexLock lock(mutex);
+	if (p_path.get_extension().to_lower() == "json") {
+		return _save_chrome_trace(p_path);
+	}
+	return _save_folded(p_path);
+}
+
+void GDScriptSamplingProfiler::clear() {
+	MutexLock lock(mutex);
+	samples.clear();
+	sample_frames.clear();
+	overflowed = false;
+}
@@ -0,0 +1,119 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+class GDScriptFunction;
+
+// Statistical profiler for GDScript. Instead of timing every call like the instrumenting profiler,
+// running threads only keep a small stack of function IDs, which a separate thread samples at a
+// fixed interval. Results are saved as folded stacks (for flamegraph tools), or as a Chrome trace
+// when the output file has a `.json` extension.
+class GDScriptSamplingProfiler {
+public:
+	static constexpr uint32_t MAX_DEPTH = 256;
+
+private:
+	struct ThreadStack {
+		Thread::ID thread_id = Thread::UNASSIGNED_ID;
+		uint32_t index = 0; // In `thread_ids`, which outlives the thread.
+		uint32_t generation = 0;
+		uint32_t last_sampled_depth = 0; // Only used by the sampler.
+		SafeNumeric<uint32_t> depth; // Can exceed `MAX_DEPTH`, deeper frames are not recorded.
+		std::atomic<uint32_t> frames[MAX_DEPTH]; // Function IDs, written by the owning thread only.
+
+		ThreadStack() {
+			for (std::atomic<uint32_t> &frame : frames) {
+				frame.store(0, std::memory_order_relaxed);
+			}
+		}
+	};
+
+	// Unregisters the stack of a thread when it exits.
+	struct ThreadStackOwner {
+		ThreadStack *stack = nullptr;
+		~ThreadStackOwner();
+	};
+
+	struct Sample {
+		uint64_t time = 0;
+		uint32_t thread = 0; // Index in `thread_ids`.
+		uint32_t frame_offset = 0; // Into `sample_frames`, outermost frame first.
+		uint32_t depth = 0;
+	};
+
+	static SafeFlag active;
+	static SafeNumeric<uint32_t> generation;
+	static thread_local ThreadStackOwner thread_stack;
+
+	static Mutex mutex;
+	static LocalVector<ThreadStack *> thread_stacks;
+	static LocalVector<String> function_names; // By function ID minus one.
+	static LocalVector<Thread::ID> thread_ids;
+	static LocalVector<Sample> samples;
+	static LocalVector<uint32_t> sample_frames;
+	static uint64_t start_time;
+	static uint64_t interval_usec;
+	static bool overflowed;
+	static Thread sampler_thread;
+
+	static void _enter(GDScriptFunction *p_function);
+	static void _exit();
+	static uint32_t _register_function(GDScriptFunction *p_function);
+	static void _take_sample();
+	static void _sampler_loop(void *p_userdata);
+	static String _get_thread_name(uint32_t p_thread);
+	static Error _save_folded(const String &p_path);
+	static Error _save_chrome_trace(const String &p_path);
+
+public:
+	_FORCE_INLINE_ static void enter(GDScriptFunction *p_function) {
+		if (unlikely(active.is_set())) {
+			_enter(p_function);
+		}
+	}
+
+	_FORCE_INLINE_ static void exit() {
+		if (unlikely(active.is_set())) {
+			_exit();
+		}
+	}
+
+	static bool is_active() { return active.is_set(); }
+	static void start(uint64_t p_interval_usec);
+	static void stop();
+	static Error save(const String &p_path);
+	static void clear();
+};
@@ -31,6 +31,7 @@
 #include "gdscript.h"
 #include "gdscript_function.h"
 #include "gdscript_lambda_callable.h"
+#include "gdscript_native_compiler.h"
 
 #include "core/os/os.h"
 
@@ -254,6 +255,34 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {            \
 		&&OPCODE_OPERATOR,                               \
 		&&OPCODE_OPERATOR_VALIDATED,                     \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF,             \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,         \
+		&&OPCODE_OPERATOR_ADD_INT,                       \
+		&&OPCODE_OPERATOR_SUBTRACT_INT,                  \
+		&&OPCODE_OPERATOR_MULTIPLY_INT,                  \
+		&&OPCODE_OPERATOR_EQUAL_INT,                     \
+		&&OPCODE_OPERATOR_NOT_EQUAL_INT,                 \
+		&&OPCODE_OPERATOR_LESS_INT,                      \
+		&&OPCODE_OPERATOR_LESS_EQUAL_INT,                \
+		&&OPCODE_OPERATOR_GREATER_INT,                   \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_INT,             \
+		&&OPCODE_OPERATOR_ADD_FLOAT,                     \
+		&&OPCODE_OPERATOR_SUBTRACT_FLOAT,                \
+		&&OPCODE_OPERATOR_MULTIPLY_FLOAT,                \
+		&&OPCODE_OPERATOR_EQUAL_FLOAT,                   \
+		&&OPCODE_OPERATOR_NOT_EQUAL_FLOAT,               \
+		&&OPCODE_OPERATOR_LESS_FLOAT,                    \
+		&&OPCODE_OPERATOR_LESS_EQUAL_FLOAT,              \
+		&&OPCODE_OPERATOR_GREATER_FLOAT,                 \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_FLOAT,           \
+		&&OPCODE_OPERATOR_ADD_VECTOR2,                   \
+		&&OPCODE_OPERATOR_SUBTRACT_VECTOR2,              \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR2,              \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT,        \
+		&&OPCODE_OPERATOR_ADD_VECTOR3,                   \
+		&&OPCODE_OPERATOR_SUBTRACT_VECTOR3,              \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR3,              \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT,        \
 		&&OPCODE_TYPE_TEST_BUILTIN,                      \
 		&&OPCODE_TYPE_TEST_ARRAY,                        \
 		&&OPCODE_TYPE_TEST_DICTIONARY,                   \
@@ -271,6 +300,7 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_GET_NAMED_VALIDATED,                    \
 		&&OPCODE_SET_MEMBER,                             \
 		&&OPCODE_GET_MEMBER,                             \
+		&&OPCODE_GET_MEMBER_OPERATOR_VALIDATED,          \
 		&&OPCODE_SET_STATIC_VARIABLE,                    \
 		&&OPCODE_GET_STATIC_VARIABLE,                    \
 		&&OPCODE_ASSIGN,                                 \
@@ -452,6 +482,13 @@ void (*type_init_function_table[])(Variant *) = {
 #define OPCODE_OUT break
 #endif // defined(__GNUC__) || defined(__clang__)
 
+// Used after instructions the ahead-of-time compiled code hands over to the VM, see `GDScriptNativeCompiler`.
+#define DISPATCH_OPCODE_OR_RESUME_NATIVE \
+	if (native) {                        \
+		goto native_resume;              \
+	}                                    \
+	DISPATCH_OPCODE
+
 // Helpers for VariantInternal methods in macros.
 #define OP_GET_BOOL get_bool
 #define OP_GET_INT get_int
@@ -737,6 +774,28 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	bool awaited = false;
 	Variant *variant_addresses[ADDR_TYPE_MAX] = { stack, _constants_ptr, p_instance ? p_instance->members.ptrw() : nullptr };
 
+	// Functions with an ahead-of-time compiled version run it, and only fall back to the VM for the
+	// instructions it doesn't handle. The VM returns to it after the instructions listed by
+	// `GDScriptNativeCompiler::is_resume_point()`. Resumed coroutines and debugging sessions stay in the VM.
+	GDScriptFunction::NativeFrame native_frame;
+	const NativeFunction native = (native_function && !p_state && GDScriptNativeCompiler::is_enabled() && !EngineDebugger::is_active()) ? native_function : nullptr;
+	if (native) {
+		native_frame.function = this;
+		native_frame.stack = stack;
+		native_frame.members = variant_addresses[ADDR_TYPE_MEMBER];
+		native_frame.member_count = p_instance ? (int)p_instance->members.size() : 0;
+		native_frame.retvalue = &retvalue;
+		native_frame.line = &line;
+		native_frame.defarg = defarg;
+
+	native_resume:
+		native_frame.ip = ip;
+		ip = native(native_frame);
+		if (ip < 0) {
+			goto native_exit;
+		}
+	}
+
 #ifdef DEBUG_ENABLED
 	OPCODE_WHILE(ip < _code_size) {
 		int last_opcode = _code_ptr[ip];
@@ -830,7 +889,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 				ip += 7 + _pointer_size;
 			}
-			DISPATCH_OPCODE;
+			DISPATCH_OPCODE_OR_RESUME_NATIVE;
 
 			OPCODE(OPCODE_OPERATOR_VALIDATED) {
 				CHECK_SPACE(5);
@@ -849,6 +908,112 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			// Superinstructions produced by the bytecode optimizer: a validated operator fused
+			// with the conditional jump that immediately follows it (and usually tests its result).
+			// The jump instruction is kept intact after the operator, so its operands are read from there.
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF) {
+				CHECK_SPACE(8);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				GET_VARIANT_PTR(test, 5);
+
+				if (test->booleanize()) {
+					int to = _code_ptr[ip + 7];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 8;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+				CHECK_SPACE(8);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				GET_VARIANT_PTR(test, 5);
+
+				if (!test->booleanize()) {
+					int to = _code_ptr[ip + 7];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 8;
+				}
+			}
+			DISPATCH_OPCODE;
+
+// Arithmetic and comparisons on operands the analyzer proved to be of a given builtin type.
+// Same contract as the validated evaluators (the result slot already holds the right type),
+// but the payloads are accessed directly instead of going through the evaluator function pointer.
+#define OPCODE_OPERATOR_TYPED(m_name, m_op, m_left, m_right, m_result)                                     \
+	OPCODE(OPCODE_OPERATOR_##m_name) {                                                                     \
+		CHECK_SPACE(5);                                                                                    \
+		GET_VARIANT_PTR(a, 0);                                                                             \
+		GET_VARIANT_PTR(b, 1);                                                                             \
+		GET_VARIANT_PTR(dst, 2);                                                                           \
+		*VariantInternal::m_result(dst) = (*VariantInternal::m_left(a))m_op(*VariantInternal::m_right(b)); \
+		ip += 5;                                                                                           \
+	}                                                                                                      \
+	DISPATCH_OPCODE
+
+// Integer arithmetic wraps around on overflow, computed unsigned so it is well defined.
+#define OPCODE_OPERATOR_TYPED_INT(m_name, m_op)                                                                                       \
+	OPCODE(OPCODE_OPERATOR_##m_name) {                                                                                                \
+		CHECK_SPACE(5);                                                                                                               \
+		GET_VARIANT_PTR(a, 0);                                                                                                        \
+		GET_VARIANT_PTR(b, 1);                                                                                                        \
+		GET_VARIANT_PTR(dst, 2);                                                                                                      \
+		*VariantInternal::get_int(dst) = int64_t(uint64_t(*VariantInternal::get_int(a)) m_op uint64_t(*VariantInternal::get_int(b))); \
+		ip += 5;                                                                                                                      \
+	}                                                                                                                                 \
+	DISPATCH_OPCODE
+
+			OPCODE_OPERATOR_TYPED_INT(ADD_INT, +);
+			OPCODE_OPERATOR_TYPED_INT(SUBTRACT_INT, -);
+			OPCODE_OPERATOR_TYPED_INT(MULTIPLY_INT, *);
+			OPCODE_OPERATOR_TYPED(EQUAL_INT, ==, get_int, get_int, get_bool);
+			OPCODE_OPERATOR_TYPED(NOT_EQUAL_INT, !=, get_int, get_int, get_bool);
+			OPCODE_OPERATOR_TYPED(LESS_INT, <, get_int, get_int, get_bool);
+			OPCODE_OPERATOR_TYPED(LESS_EQUAL_INT, <=, get_int, get_int, get_bool);
+			OPCODE_OPERATOR_TYPED(GREATER_INT, >, get_int, get_int, get_bool);
+			OPCODE_OPERATOR_TYPED(GREATER_EQUAL_INT, >=, get_int, get_int, get_bool);
+			OPCODE_OPERATOR_TYPED(ADD_FLOAT, +, get_float, get_float, get_float);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_FLOAT, -, get_float, get_float, get_float);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_FLOAT, *, get_float, get_float, get_float);
+			OPCODE_OPERATOR_TYPED(EQUAL_FLOAT, ==, get_float, get_float, get_bool);
+			OPCODE_OPERATOR_TYPED(NOT_EQUAL_FLOAT, !=, get_float, get_float, get_bool);
+			OPCODE_OPERATOR_TYPED(LESS_FLOAT, <, get_float, get_float, get_bool);
+			OPCODE_OPERATOR_TYPED(LESS_EQUAL_FLOAT, <=, get_float, get_float, get_bool);
+			OPCODE_OPERATOR_TYPED(GREATER_FLOAT, >, get_float, get_float, get_bool);
+			OPCODE_OPERATOR_TYPED(GREATER_EQUAL_FLOAT, >=, get_float, get_float, get_bool);
+			OPCODE_OPERATOR_TYPED(ADD_VECTOR2, +, get_vector2, get_vector2, get_vector2);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_VECTOR2, -, get_vector2, get_vector2, get_vector2);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR2, *, get_vector2, get_vector2, get_vector2);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR2_FLOAT, *, get_vector2, get_float, get_vector2);
+			OPCODE_OPERATOR_TYPED(ADD_VECTOR3, +, get_vector3, get_vector3, get_vector3);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_VECTOR3, -, get_vector3, get_vector3, get_vector3);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR3, *, get_vector3, get_vector3, get_vector3);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR3_FLOAT, *, get_vector3, get_float, get_vector3);
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1016,7 +1181,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 				ip += 4;
 			}
-			DISPATCH_OPCODE;
+			DISPATCH_OPCODE_OR_RESUME_NATIVE;
 
 			OPCODE(OPCODE_SET_KEYED_VALIDATED) {
 				CHECK_SPACE(4);
@@ -1122,7 +1287,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 				ip += 4;
 			}
-			DISPATCH_OPCODE;
+			DISPATCH_OPCODE_OR_RESUME_NATIVE;
 
 			OPCODE(OPCODE_GET_KEYED_VALIDATED) {
 				CHECK_SPACE(4);
@@ -1193,7 +1358,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
@@ -1203,6 +1368,32 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_cache_count);
+				{
+					InlineCacheKey key;
+					if (_get_inline_cache_key(dst, key)) {
+						const InlineCacheEntry *entry = _find_inline_cache_entry(cache_idx, key);
+						if (!entry && !_is_inline_cache_full(cache_idx, key)) {
+							entry = _resolve_set_named(cache_idx, key, *index);
+						}
+						// Values needing a conversion take the regular path.
+						if (entry) {
+							if (entry->kind == InlineCacheEntry::KIND_SCRIPT_MEMBER) {
+								if (!entry->member_data_type.has_type || entry->member_data_type.is_type(*value)) {
+									key.instance->members.write[entry->member_index] = *value;
+									ip += 5;
+									DISPATCH_OPCODE;
+								}
+							} else if (value->get_type() == entry->member_type) {
+								entry->setter(dst, value);
+								ip += 5;
+								DISPATCH_OPCODE;
+							}
+						}
+					}
+				}
+
 				bool valid;
 				dst->set_named(*index, *value, valid);
 
@@ -1225,9 +1416,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
-			DISPATCH_OPCODE;
+			DISPATCH_OPCODE_OR_RESUME_NATIVE;
 
 			OPCODE(OPCODE_SET_NAMED_VALIDATED) {
 				CHECK_SPACE(3);
@@ -1245,7 +1436,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1255,6 +1446,31 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_cache_count);
+				// Overwriting the base in place could free it mid-read, leave that case to the regular path.
+				if (src != dst) {
+					InlineCacheKey key;
+					if (_get_inline_cache_key(src, key)) {
+						const InlineCacheEntry *entry = _find_inline_cache_entry(cache_idx, key);
+						if (!entry && !_is_inline_cache_full(cache_idx, key)) {
+							entry = _resolve_get_named(cache_idx, key, *index);
+						}
+						if (entry) {
+							if (entry->kind == InlineCacheEntry::KIND_SCRIPT_MEMBER) {
+								*dst = key.instance->members[entry->member_index];
+							} else {
+								if (dst->get_type() != entry->member_type) {
+									VariantInternal::initialize(dst, entry->member_type);
+								}
+								entry->getter(src, dst);
+							}
+							ip += 5;
+							DISPATCH_OPCODE;
+						}
+					}
+				}
+
 				bool valid;
 #ifdef DEBUG_ENABLED
 				//allow better error message in cases where src and dst are the same stack position
@@ -1270,9 +1486,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 				*dst = ret;
 #endif
-				ip += 4;
+				ip += 5;
 			}
-			DISPATCH_OPCODE;
+			DISPATCH_OPCODE_OR_RESUME_NATIVE;
 
 			OPCODE(OPCODE_GET_NAMED_VALIDATED) {
 				CHECK_SPACE(3);
@@ -1311,7 +1527,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 				ip += 3;
 			}
-			DISPATCH_OPCODE;
+			DISPATCH_OPCODE_OR_RESUME_NATIVE;
 
 			OPCODE(OPCODE_GET_MEMBER) {
 				CHECK_SPACE(3);
@@ -1330,6 +1546,38 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 				ip += 3;
 			}
+			DISPATCH_OPCODE_OR_RESUME_NATIVE;
+
+			OPCODE(OPCODE_GET_MEMBER_OPERATOR_VALIDATED) {
+				// Native property read fused with the validated operator that follows it.
+				CHECK_SPACE(8);
+				GET_VARIANT_PTR(dst, 0);
+				int indexname = _code_ptr[ip + 2];
+				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
+				const StringName *index = &_global_names_ptr[indexname];
+#ifndef DEBUG_ENABLED
+				ClassDB::get_property(p_instance->owner, *index, *dst);
+#else
+				bool ok = ClassDB::get_property(p_instance->owner, *index, *dst);
+				if (!ok) {
+					err_text = "Internal error getting property: " + String(*index);
+					OPCODE_BREAK;
+				}
+#endif
+				ip += 3;
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(op_dst, 2);
+
+				operator_func(a, b, op_dst);
+
+				ip += 5;
+			}
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_SET_STATIC_VARIABLE) {
@@ -1348,7 +1596,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				ip += 4;
 			}
-			DISPATCH_OPCODE;
+			DISPATCH_OPCODE_OR_RESUME_NATIVE;
 
 			OPCODE(OPCODE_GET_STATIC_VARIABLE) {
 				CHECK_SPACE(4);
@@ -1366,7 +1614,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				ip += 4;
 			}
-			DISPATCH_OPCODE;
+			DISPATCH_OPCODE_OR_RESUME_NATIVE;
 
 			OPCODE(OPCODE_ASSIGN) {
 				CHECK_SPACE(3);
@@ -1889,7 +2137,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1900,6 +2148,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int cache_idx = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_cache_count);
+
 				GET_INSTRUCTION_ARG(base, argc);
 				Variant **argptrs = instruction_args;
 
@@ -1916,9 +2167,25 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				Variant temp_ret;
 				Callable::CallError err;
+#ifndef DEBUG_ENABLED
+				// Debug builds keep going through Object::callp(), which guards the receiver against being freed mid-call.
+				InlineCacheKey call_key;
+				const InlineCacheEntry *call_entry = _get_inline_call(cache_idx, base, *methodname, call_key);
+				if (call_entry) {
+					err.error = Callable::CallError::CALL_OK;
+					if (call_entry->kind == InlineCacheEntry::KIND_SCRIPT_FUNCTION) {
+						temp_ret = call_entry->function->call(call_key.instance, (const Variant **)argptrs, argc, err);
+					} else {
+						temp_ret = call_entry->method->call(call_key.object, (const Variant **)argptrs, argc, err);
+					}
+				} else
+#endif
+				{
+					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+				}
+
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
 					*ret = temp_ret;
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
@@ -1947,8 +2214,6 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 						}
 					}
 #endif
-				} else {
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
 				}
 #ifdef DEBUG_ENABLED
 
@@ -2003,9 +2268,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif // DEBUG_ENABLED
 
-				ip += 3;
+				ip += 4;
 			}
-			DISPATCH_OPCODE;
+			DISPATCH_OPCODE_OR_RESUME_NATIVE;
 
 			OPCODE(OPCODE_CALL_METHOD_BIND)
 			OPCODE(OPCODE_CALL_METHOD_BIND_RET) {
@@ -2090,7 +2355,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 				ip += 3;
 			}
-			DISPATCH_OPCODE;
+			DISPATCH_OPCODE_OR_RESUME_NATIVE;
 
 			OPCODE(OPCODE_CALL_BUILTIN_STATIC) {
 				LOAD_INSTRUCTION_ARGS
@@ -2124,7 +2389,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				ip += 4;
 			}
-			DISPATCH_OPCODE;
+			DISPATCH_OPCODE_OR_RESUME_NATIVE;
 
 			OPCODE(OPCODE_CALL_NATIVE_STATIC) {
 				LOAD_INSTRUCTION_ARGS
@@ -2167,7 +2432,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				ip += 3;
 			}
-			DISPATCH_OPCODE;
+			DISPATCH_OPCODE_OR_RESUME_NATIVE;
 
 			OPCODE(OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN) {
 				LOAD_INSTRUCTION_ARGS
@@ -2399,7 +2664,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 				ip += 3;
 			}
-			DISPATCH_OPCODE;
+			DISPATCH_OPCODE_OR_RESUME_NATIVE;
 
 			OPCODE(OPCODE_CALL_UTILITY_VALIDATED) {
 				LOAD_INSTRUCTION_ARGS
@@ -2456,7 +2721,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 				ip += 3;
 			}
-			DISPATCH_OPCODE;
+			DISPATCH_OPCODE_OR_RESUME_NATIVE;
 
 			OPCODE(OPCODE_CALL_SELF_BASE) {
 				LOAD_INSTRUCTION_ARGS
@@ -2523,7 +2788,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				ip += 3;
 			}
-			DISPATCH_OPCODE;
+			DISPATCH_OPCODE_OR_RESUME_NATIVE;
 
 			OPCODE(OPCODE_AWAIT) {
 				CHECK_SPACE(2);
@@ -3956,6 +4221,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	}
 
 	OPCODES_OUT
+native_exit:
 #ifdef DEBUG_ENABLED
 	if (GDScriptLanguage::get_singleton()->profiling) {
 		uint64_t time_taken = OS::get_singleton()->get_ticks_usec() - function_start_time;
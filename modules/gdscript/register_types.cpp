@@ -32,6 +32,7 @@
 
 #include "gdscript.h"
 #include "gdscript_cache.h"
+#include "gdscript_native_compiler.h"
 #include "gdscript_parser.h"
 #include "gdscript_tokenizer_buffer.h"
 #include "gdscript_utility_functions.h"
@@ -53,6 +54,7 @@
 #include "core/io/resource_loader.h"
 
 #ifdef TOOLS_ENABLED
+#include "core/config/project_settings.h"
 #include "editor/editor_node.h"
 #include "editor/export/editor_export.h"
 #include "editor/translations/editor_translation_parser.h"
@@ -81,18 +83,42 @@ class EditorExportGDScript : public EditorExportPlugin {
 	static constexpr int DEFAULT_SCRIPT_MODE = EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED;
 	int script_mode = DEFAULT_SCRIPT_MODE;
 
+	// Scripts to translate to C++, see `GDScriptNativeCompiler`.
+	bool native_code = false;
+	Vector<Ref<GDScript>> native_scripts;
+
 protected:
+	virtual void _get_export_options(const Ref<EditorExportPlatform> &p_export_platform, List<EditorExportPlatform::ExportOption> *r_options) const override {
+		r_options->push_back(EditorExportPlatform::ExportOption(PropertyInfo(Variant::BOOL, "gdscript/native_code/enabled"), false));
+		r_options->push_back(EditorExportPlatform::ExportOption(PropertyInfo(Variant::STRING, "gdscript/native_code/output_directory", PROPERTY_HINT_GLOBAL_DIR), ""));
+	}
+
 	virtual void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override {
 		script_mode = DEFAULT_SCRIPT_MODE;
+		native_code = false;
+		native_scripts.clear();
 
 		const Ref<EditorExportPreset> &preset = get_export_preset();
 		if (preset.is_valid()) {
 			script_mode = preset->get_script_export_mode();
+			native_code = get_option("gdscript/native_code/enabled");
 		}
 	}
 
 	virtual void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override {
-		if (p_path.get_extension() != "gd" || script_mode == EditorExportPreset::MODE_SCRIPT_TEXT) {
+		if (p_path.get_extension() != "gd") {
+			return;
+		}
+
+		if (native_code) {
+			// Compiled on its own, so the bytecode isn't affected by anything the editor ran.
+			Ref<GDScript> script = ResourceLoader::load(p_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+			if (script.is_valid()) {
+				native_scripts.push_back(script);
+			}
+		}
+
+		if (script_mode == EditorExportPreset::MODE_SCRIPT_TEXT) {
 			return;
 		}
 
@@ -111,6 +137,28 @@ protected:
 		add_file(p_path.get_basename() + ".gdc", file, true);
 	}
 
+	virtual void _export_end() override {
+		if (native_code && !native_scripts.is_empty()) {
+			String output_directory = get_option("gdscript/native_code/output_directory");
+			if (output_directory.is_empty()) {
+				// Generated sources are a build artifact, keep them with the project's other cached data.
+				output_directory = ProjectSettings::get_singleton()->globalize_path(ProjectSettings::get_singleton()->get_project_data_path().path_join("gdscript_native"));
+			}
+			const Error err = GDScriptNativeCompiler::generate_module(native_scripts, output_directory);
+			if (err != OK) {
+				// Without the module, the exported project silently runs its scripts in the VM only.
+				const String message = vformat(TTR("Could not generate the native code module in \"%s\": %s."), output_directory, error_names[err]);
+				const Ref<EditorExportPlatform> platform = get_export_platform();
+				if (platform.is_valid()) {
+					platform->add_message(EditorExportPlatform::EXPORT_MESSAGE_ERROR, TTR("GDScript Native Code"), message);
+				} else {
+					ERR_PRINT(message);
+				}
+			}
+		}
+		native_scripts.clear();
+	}
+
 public:
 	virtual String get_name() const override { return "GDScript"; }
 };
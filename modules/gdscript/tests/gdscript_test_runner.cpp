@@ -33,6 +33,7 @@
 #include "../gdscript.h"
 #include "../gdscript_analyzer.h"
 #include "../gdscript_compiler.h"
+#include "../gdscript_native_compiler.h"
 #include "../gdscript_parser.h"
 #include "../gdscript_tokenizer_buffer.h"
 
@@ -196,26 +197,36 @@ int GDScriptTestRunner::run_tests() {
 		return -1;
 	}
 
+	// With a generated `gdscript_native` module built in, every test also has to give the same output
+	// when running the translated functions.
+	const bool native_code = GDScriptNativeCompiler::has_functions();
+
 	int failed = 0;
 	for (int i = 0; i < tests.size(); i++) {
 		GDScriptTest test = tests[i];
 		if (print_filenames) {
 			print_line(test.get_source_relative_filepath());
 		}
-		GDScriptTest::TestResult result = test.run_test();
 
 		String expected = FileAccess::get_file_as_string(test.get_output_file());
 #ifndef DEBUG_ENABLED
 		expected = strip_warnings(expected);
 #endif
 		INFO(test.get_source_file());
-		if (!result.passed) {
-			INFO(expected);
-			failed++;
-		}
 
-		CHECK_MESSAGE(result.passed, (result.passed ? String() : result.output));
+		for (int pass = 0; pass < (native_code ? 2 : 1); pass++) {
+			GDScriptNativeCompiler::set_enabled(pass == 1);
+			GDScriptTest::TestResult result = test.run_test();
+
+			if (!result.passed) {
+				INFO(expected);
+				failed++;
+			}
+
+			CHECK_MESSAGE(result.passed, (result.passed ? String() : (pass == 1 ? "With native code:\n" : "") + result.output));
+		}
 	}
+	GDScriptNativeCompiler::set_enabled(true);
 
 	return failed;
 }
@@ -252,6 +263,45 @@ bool GDScriptTestRunner::generate_outputs() {
 	return true;
 }
 
+#ifdef TOOLS_ENABLED
+bool GDScriptTestRunner::generate_native_module(const String &p_dir) {
+	if (!make_tests()) {
+		print_line("Failed to make the tests.");
+		return false;
+	}
+
+	if (!generate_class_index()) {
+		return false;
+	}
+
+	Vector<Ref<GDScript>> scripts;
+	for (int i = 0; i < tests.size(); i++) {
+		GDScriptTest test = tests[i];
+		if (print_filenames) {
+			print_line(test.get_source_relative_filepath());
+		}
+
+		// Tests that are expected to fail compiling are skipped.
+		Ref<GDScript> script = test.compile_script();
+		if (script.is_valid()) {
+			scripts.push_back(script);
+		}
+	}
+
+	Error err = GDScriptNativeCompiler::generate_module(scripts, p_dir);
+
+	for (const Ref<GDScript> &script : scripts) {
+		GDScriptCache::remove_script(script->get_path());
+	}
+
+	if (err != OK) {
+		return false;
+	}
+	print_line(vformat("Generated the native module for %d test scripts in \"%s\".", scripts.size(), p_dir));
+	return true;
+}
+#endif
+
 bool GDScriptTestRunner::make_tests_for_dir(const String &p_dir) {
 	Error err = OK;
 	Ref<DirAccess> dir(DirAccess::open(p_dir, &err));
@@ -426,6 +476,17 @@ void GDScriptTestRunner::handle_cmdline() {
 			int failed = completed ? 0 : -1;
 			exit(failed);
 		}
+#ifdef TOOLS_ENABLED
+		if (cmd == "--gdscript-generate-native") {
+			ERR_FAIL_COND_MSG(!E->next(), "Missing the output directory for the generated module.");
+
+			GDScriptTestRunner runner("modules/gdscript/tests/scripts", false, cmdline_args.find("--print-filenames") != nullptr);
+
+			bool completed = runner.generate_native_module(E->next()->get());
+			int failed = completed ? 0 : -1;
+			exit(failed);
+		}
+#endif
 	}
 }
 
@@ -686,6 +747,28 @@ GDScriptTest::TestResult GDScriptTest::run_test() {
 	return execute_test_code(false);
 }
 
+#ifdef TOOLS_ENABLED
+Ref<GDScript> GDScriptTest::compile_script() {
+	disable_stdout();
+
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_path(source_file);
+	Error err = script->load_source_code(source_file);
+	if (err == OK) {
+		err = script->reload();
+	}
+
+	enable_stdout();
+
+	if (err != OK) {
+		GDScriptCache::remove_script(source_file);
+		return Ref<GDScript>();
+	}
+	return script;
+}
+#endif
+
 bool GDScriptTest::generate_output() {
 	TestResult result = execute_test_code(true);
 	if (result.status == GDTEST_LOAD_ERROR) {
@@ -97,6 +97,9 @@ public:
 	static void error_handler(void *p_this, const char *p_function, const char *p_file, int p_line, const char *p_error, const char *p_explanation, bool p_editor_notify, ErrorHandlerType p_type);
 	TestResult run_test();
 	bool generate_output();
+#ifdef TOOLS_ENABLED
+	Ref<GDScript> compile_script();
+#endif
 
 	const String &get_source_file() const { return source_file; }
 	const String get_source_relative_filepath() const { return source_file.trim_prefix(base_dir); }
@@ -129,6 +132,9 @@ public:
 	static void handle_cmdline();
 	int run_tests();
 	bool generate_outputs();
+#ifdef TOOLS_ENABLED
+	bool generate_native_module(const String &p_dir);
+#endif
 
 	GDScriptTestRunner(const String &p_source_dir, bool p_init_language, bool p_print_filenames = false, bool p_use_binary_tokens = false);
 	~GDScriptTestRunner();
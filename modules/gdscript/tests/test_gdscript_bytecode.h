@@ -0,0 +1,573 @@
+/**************************************************************************/
+/*  test_gdscript_bytecode.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript.h"
+
+#include "core/os/os.h"
+#include "tests/test_macros.h"
+
+namespace TestGDScriptBytecode {
+
+// Hot loops dominated by the instruction sequences the bytecode optimizer rewrites:
+// comparisons feeding conditional jumps, native property reads feeding operators,
+// and untyped operator results copied into locals.
+static const char *benchmark_source = R"(
+extends Resource
+
+func compare_and_jump(n: int) -> int:
+	var total := 0
+	var i := 0
+	while i < n:
+		if (i & 3) == 0:
+			total += i
+		i += 1
+	return total
+
+func member_operator(n: int) -> int:
+	var hits := 0
+	for i in n:
+		if not resource_local_to_scene:
+			hits += 1
+	return hits
+
+func float_arithmetic(n: int) -> float:
+	var x := 0.0
+	for i in n:
+		x = x * 0.5 + 1.0
+		if x > 1.5:
+			x -= 0.25
+	return x
+
+func self_assign(n: int) -> int:
+	var a = 1
+	for i in n:
+		a = a
+		a += 1
+	return a
+
+func copy_propagation(n: int) -> int:
+	var a = 1
+	var b = 2
+	for i in n:
+		var c = (a + b) % 1000
+		a = b * 2 - c
+		b = c
+	return a * 1000 + b
+)";
+
+static Ref<GDScript> _compile_benchmark_script(bool p_optimize) {
+	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
+	const bool was_optimizing = lang->should_optimize_bytecode();
+	lang->set_optimize_bytecode(p_optimize);
+
+	Ref<GDScript> gdscript;
+	gdscript.instantiate();
+	gdscript->set_source_code(benchmark_source);
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+
+	lang->set_optimize_bytecode(was_optimizing);
+	return error == OK ? gdscript : Ref<GDScript>();
+}
+
+#ifdef DEBUG_ENABLED
+static int _count_opcodes(const Ref<GDScript> &p_script, const StringName &p_function, GDScriptFunction::Opcode p_opcode) {
+	GDScriptFunction *function = p_script->get_member_functions().get(p_function);
+	LocalVector<GDScriptFunction::Opcode> opcodes;
+	function->disassemble(Vector<String>(), &opcodes);
+
+	int count = 0;
+	for (const GDScriptFunction::Opcode opcode : opcodes) {
+		count += opcode == p_opcode;
+	}
+	return count;
+}
+
+TEST_CASE("[Modules][GDScript] Bytecode optimizer fuses and removes instructions") {
+	GDScriptLanguage::get_singleton()->init();
+
+	Ref<GDScript> plain_script = _compile_benchmark_script(false);
+	Ref<GDScript> optimized_script = _compile_benchmark_script(true);
+	REQUIRE(plain_script.is_valid());
+	REQUIRE(optimized_script.is_valid());
+
+	// Untyped, so the assignment compiles to a plain ASSIGN.
+	CHECK(_count_opcodes(optimized_script, "self_assign", GDScriptFunction::OPCODE_ASSIGN) == _count_opcodes(plain_script, "self_assign", GDScriptFunction::OPCODE_ASSIGN) - 1);
+
+	// The operator results are written straight to `c` and `a` instead of being copied from temporaries.
+	CHECK(_count_opcodes(optimized_script, "copy_propagation", GDScriptFunction::OPCODE_ASSIGN) == _count_opcodes(plain_script, "copy_propagation", GDScriptFunction::OPCODE_ASSIGN) - 2);
+
+	// `not resource_local_to_scene` reads a native member, applies a validated operator and jumps on it.
+	CHECK(_count_opcodes(plain_script, "member_operator", GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) == 0);
+	CHECK(_count_opcodes(optimized_script, "member_operator", GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) == 1);
+	CHECK(_count_opcodes(plain_script, "member_operator", GDScriptFunction::OPCODE_GET_MEMBER_OPERATOR_VALIDATED) == 0);
+	CHECK(_count_opcodes(optimized_script, "member_operator", GDScriptFunction::OPCODE_GET_MEMBER_OPERATOR_VALIDATED) == 1);
+}
+#endif // DEBUG_ENABLED
+
+TEST_CASE("[Modules][GDScript] Optimized bytecode matches unoptimized results") {
+	GDScriptLanguage::get_singleton()->init();
+
+	Ref<GDScript> plain_script = _compile_benchmark_script(false);
+	Ref<GDScript> optimized_script = _compile_benchmark_script(true);
+	REQUIRE(plain_script.is_valid());
+	REQUIRE(optimized_script.is_valid());
+
+	Ref<Resource> plain = memnew(Resource);
+	plain->set_script(plain_script);
+	Ref<Resource> optimized = memnew(Resource);
+	optimized->set_script(optimized_script);
+
+	const StringName methods[] = { "compare_and_jump", "member_operator", "float_arithmetic", "self_assign", "copy_propagation" };
+	for (const StringName &method : methods) {
+		const Variant expected = plain->call(method, 1000);
+		CHECK_MESSAGE(expected.get_type() != Variant::NIL, vformat("`%s` should run.", method));
+		CHECK_MESSAGE(optimized->call(method, 1000) == expected, vformat("`%s` should return the same value with the optimizer enabled.", method));
+	}
+
+	// Property reads must observe the object's current state, not a value captured at compile time.
+	optimized->set_local_to_scene(true);
+	CHECK(int(optimized->call("member_operator", 100)) == 0);
+}
+
+TEST_CASE("[Modules][GDScript][Benchmark] Bytecode optimizer" * doctest::skip(true)) {
+	GDScriptLanguage::get_singleton()->init();
+
+	Ref<GDScript> plain_script = _compile_benchmark_script(false);
+	Ref<GDScript> optimized_script = _compile_benchmark_script(true);
+	REQUIRE(plain_script.is_valid());
+	REQUIRE(optimized_script.is_valid());
+
+	Ref<Resource> plain = memnew(Resource);
+	plain->set_script(plain_script);
+	Ref<Resource> optimized = memnew(Resource);
+	optimized->set_script(optimized_script);
+
+	const int iterations = 200000;
+	const StringName methods[] = { "compare_and_jump", "member_operator", "float_arithmetic", "self_assign", "copy_propagation" };
+	for (const StringName &method : methods) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		const Variant plain_result = plain->call(method, iterations);
+		const uint64_t plain_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		const Variant optimized_result = optimized->call(method, iterations);
+		const uint64_t optimized_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		CHECK(plain_result == optimized_result);
+		MESSAGE(vformat("%s: %d usec unoptimized, %d usec optimized.", method, plain_usec, optimized_usec));
+	}
+}
+
+// The same integration step written with and without static types. The typed version
+// compiles to the unboxed int/float/vector opcodes, the untyped one to generic operators.
+static const char *typed_math_source = R"(
+extends RefCounted
+
+func integrate(steps: int) -> Vector3:
+	var position := Vector3()
+	var velocity := Vector3(1.0, 2.0, 3.0)
+	var gravity := Vector3(0.0, -9.8, 0.0)
+	var delta := 1.0 / 60.0
+	var bounces := 0
+	for i in steps:
+		velocity = velocity + gravity * delta
+		position = position + velocity * delta
+		if position.y < 0.0:
+			velocity = velocity * Vector3(1.0, -0.5, 1.0)
+			bounces = bounces + 1
+	return position + Vector3(float(bounces), 0.0, 0.0)
+)";
+
+static const char *untyped_math_source = R"(
+extends RefCounted
+
+func integrate(steps):
+	var position = Vector3()
+	var velocity = Vector3(1.0, 2.0, 3.0)
+	var gravity = Vector3(0.0, -9.8, 0.0)
+	var delta = 1.0 / 60.0
+	var bounces = 0
+	for i in steps:
+		velocity = velocity + gravity * delta
+		position = position + velocity * delta
+		if position.y < 0.0:
+			velocity = velocity * Vector3(1.0, -0.5, 1.0)
+			bounces = bounces + 1
+	return position + Vector3(float(bounces), 0.0, 0.0)
+)";
+
+static Ref<RefCounted> _instantiate_source(const char *p_source) {
+	Ref<GDScript> gdscript;
+	gdscript.instantiate();
+	gdscript->set_source_code(p_source);
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	if (error != OK) {
+		return Ref<RefCounted>();
+	}
+	Ref<RefCounted> instance = memnew(RefCounted);
+	instance->set_script(gdscript);
+	return instance;
+}
+
+// Every operator with a typed opcode, once per function. The untyped twin runs the generic evaluator.
+static const char *typed_operators_source = R"(
+extends RefCounted
+
+func int_ops(a: int, b: int) -> Array:
+	return [a + b, a - b, a * b, a == b, a != b, a < b, a <= b, a > b, a >= b]
+
+func float_ops(a: float, b: float) -> Array:
+	return [a + b, a - b, a * b, a == b, a != b, a < b, a <= b, a > b, a >= b]
+
+func vector2_ops(a: Vector2, b: Vector2, s: float) -> Array:
+	return [a + b, a - b, a * b, a * s]
+
+func vector3_ops(a: Vector3, b: Vector3, s: float) -> Array:
+	return [a + b, a - b, a * b, a * s]
+)";
+
+static const char *untyped_operators_source = R"(
+extends RefCounted
+
+func int_ops(a, b):
+	return [a + b, a - b, a * b, a == b, a != b, a < b, a <= b, a > b, a >= b]
+
+func float_ops(a, b):
+	return [a + b, a - b, a * b, a == b, a != b, a < b, a <= b, a > b, a >= b]
+
+func vector2_ops(a, b, s):
+	return [a + b, a - b, a * b, a * s]
+
+func vector3_ops(a, b, s):
+	return [a + b, a - b, a * b, a * s]
+)";
+
+// Element-wise equality where two NaNs count as the same result.
+static bool _same_results(const Array &p_a, const Array &p_b) {
+	if (p_a.size() != p_b.size()) {
+		return false;
+	}
+	for (int i = 0; i < p_a.size(); i++) {
+		const Variant &a = p_a[i];
+		const Variant &b = p_b[i];
+		if (a.get_type() != b.get_type()) {
+			return false;
+		}
+		if (a.get_type() == Variant::FLOAT && Math::is_nan(double(a)) && Math::is_nan(double(b))) {
+			continue;
+		}
+		if (a != b) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[Modules][GDScript] Typed operators") {
+	GDScriptLanguage::get_singleton()->init();
+
+	Ref<RefCounted> typed = _instantiate_source(typed_operators_source);
+	Ref<RefCounted> untyped = _instantiate_source(untyped_operators_source);
+	REQUIRE(typed.is_valid());
+	REQUIRE(untyped.is_valid());
+
+#ifdef DEBUG_ENABLED
+	SUBCASE("Typed operands compile to the unboxed opcodes") {
+		const Ref<GDScript> typed_script = typed->get_script();
+		const Ref<GDScript> untyped_script = untyped->get_script();
+
+		for (int opcode = GDScriptFunction::OPCODE_OPERATOR_ADD_INT; opcode <= GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_INT; opcode++) {
+			CHECK(_count_opcodes(typed_script, "int_ops", GDScriptFunction::Opcode(opcode)) == 1);
+			CHECK(_count_opcodes(untyped_script, "int_ops", GDScriptFunction::Opcode(opcode)) == 0);
+		}
+		for (int opcode = GDScriptFunction::OPCODE_OPERATOR_ADD_FLOAT; opcode <= GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_FLOAT; opcode++) {
+			CHECK(_count_opcodes(typed_script, "float_ops", GDScriptFunction::Opcode(opcode)) == 1);
+			CHECK(_count_opcodes(untyped_script, "float_ops", GDScriptFunction::Opcode(opcode)) == 0);
+		}
+		for (int opcode = GDScriptFunction::OPCODE_OPERATOR_ADD_VECTOR2; opcode <= GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT; opcode++) {
+			CHECK(_count_opcodes(typed_script, "vector2_ops", GDScriptFunction::Opcode(opcode)) == 1);
+			CHECK(_count_opcodes(untyped_script, "vector2_ops", GDScriptFunction::Opcode(opcode)) == 0);
+		}
+		for (int opcode = GDScriptFunction::OPCODE_OPERATOR_ADD_VECTOR3; opcode <= GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT; opcode++) {
+			CHECK(_count_opcodes(typed_script, "vector3_ops", GDScriptFunction::Opcode(opcode)) == 1);
+			CHECK(_count_opcodes(untyped_script, "vector3_ops", GDScriptFunction::Opcode(opcode)) == 0);
+		}
+	}
+#endif // DEBUG_ENABLED
+
+	SUBCASE("Integers") {
+		const int64_t values[] = { 0, 1, -1, 7, -12, INT64_MAX, INT64_MIN, INT64_MAX / 3 };
+		for (const int64_t a : values) {
+			for (const int64_t b : values) {
+				const Array result = typed->call("int_ops", a, b);
+				CHECK_MESSAGE(_same_results(result, untyped->call("int_ops", a, b)), vformat("int operators on %d and %d.", a, b));
+			}
+		}
+
+		// Arithmetic wraps around on overflow.
+		const Array overflow = typed->call("int_ops", INT64_MAX, 1);
+		CHECK(int64_t(overflow[0]) == INT64_MIN);
+		const Array underflow = typed->call("int_ops", INT64_MIN, 1);
+		CHECK(int64_t(underflow[1]) == INT64_MAX);
+		const Array product = typed->call("int_ops", INT64_MAX, 2);
+		CHECK(int64_t(product[2]) == -2);
+	}
+
+	SUBCASE("Floats") {
+		const double values[] = { 0.0, -0.0, 1.5, -2.25, 1e308, Math::INF, -Math::INF, Math::NaN };
+		for (const double a : values) {
+			for (const double b : values) {
+				const Array result = typed->call("float_ops", a, b);
+				CHECK_MESSAGE(_same_results(result, untyped->call("float_ops", a, b)), vformat("float operators on %f and %f.", a, b));
+			}
+		}
+
+		// Every comparison with NaN is false, except inequality.
+		const Array nan = typed->call("float_ops", Math::NaN, 1.0);
+		CHECK(Math::is_nan(double(nan[0])));
+		CHECK(bool(nan[3]) == false);
+		CHECK(bool(nan[4]) == true);
+		CHECK(bool(nan[5]) == false);
+		CHECK(bool(nan[6]) == false);
+		CHECK(bool(nan[7]) == false);
+		CHECK(bool(nan[8]) == false);
+		const Array nan_self = typed->call("float_ops", Math::NaN, Math::NaN);
+		CHECK(bool(nan_self[3]) == false);
+		CHECK(bool(nan_self[4]) == true);
+
+		// Overflow goes to infinity.
+		const Array overflow = typed->call("float_ops", 1e308, 1e308);
+		CHECK(double(overflow[0]) == Math::INF);
+	}
+
+	SUBCASE("Vectors") {
+		const Array vector2 = typed->call("vector2_ops", Vector2(1, -2), Vector2(0.5, 4), 3.0);
+		CHECK(_same_results(vector2, untyped->call("vector2_ops", Vector2(1, -2), Vector2(0.5, 4), 3.0)));
+		CHECK(Vector2(vector2[0]) == Vector2(1.5, 2));
+		CHECK(Vector2(vector2[1]) == Vector2(0.5, -6));
+		CHECK(Vector2(vector2[2]) == Vector2(0.5, -8));
+		CHECK(Vector2(vector2[3]) == Vector2(3, -6));
+
+		const Array vector3 = typed->call("vector3_ops", Vector3(1, -2, 3), Vector3(0.5, 4, -1), -2.0);
+		CHECK(_same_results(vector3, untyped->call("vector3_ops", Vector3(1, -2, 3), Vector3(0.5, 4, -1), -2.0)));
+		CHECK(Vector3(vector3[0]) == Vector3(1.5, 2, 2));
+		CHECK(Vector3(vector3[1]) == Vector3(0.5, -6, 4));
+		CHECK(Vector3(vector3[2]) == Vector3(0.5, -8, -3));
+		CHECK(Vector3(vector3[3]) == Vector3(-2, 4, -6));
+
+		Ref<RefCounted> typed_math = _instantiate_source(typed_math_source);
+		Ref<RefCounted> untyped_math = _instantiate_source(untyped_math_source);
+		REQUIRE(typed_math.is_valid());
+		REQUIRE(untyped_math.is_valid());
+		CHECK_MESSAGE(typed_math->call("integrate", 1000) == untyped_math->call("integrate", 1000), "Typed and untyped math should produce the same result.");
+	}
+}
+
+TEST_CASE("[Modules][GDScript][Benchmark] Typed operators" * doctest::skip(true)) {
+	GDScriptLanguage::get_singleton()->init();
+
+	Ref<RefCounted> typed = _instantiate_source(typed_math_source);
+	Ref<RefCounted> untyped = _instantiate_source(untyped_math_source);
+	REQUIRE(typed.is_valid());
+	REQUIRE(untyped.is_valid());
+
+	CHECK_MESSAGE(typed->call("integrate", 1000) == untyped->call("integrate", 1000), "Typed and untyped math should produce the same result.");
+
+	const int steps = 200000;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	typed->call("integrate", steps);
+	const uint64_t typed_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	untyped->call("integrate", steps);
+	const uint64_t untyped_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(vformat("Vector3 integration: %d usec typed, %d usec untyped.", typed_usec, untyped_usec));
+}
+
+// Duck-typed access, so every named access and call goes through the inline caches.
+static const char *duck_typed_source = R"(
+extends RefCounted
+
+func read_x(items: Array) -> float:
+	var total := 0.0
+	for item in items:
+		total += item.x
+	return total
+
+func write_x(items: Array, value) -> void:
+	for item in items:
+		item.x = value
+
+func call_get_x(items: Array) -> float:
+	var total := 0.0
+	for item in items:
+		total += item.get_x()
+	return total
+
+func call_native(items: Array) -> int:
+	var ids := 0
+	for item in items:
+		ids = ids ^ item.get_instance_id()
+	return ids
+)";
+
+TEST_CASE("[Modules][GDScript] Inline caches for untyped property access and calls") {
+	GDScriptLanguage::get_singleton()->init();
+
+	Ref<RefCounted> driver = _instantiate_source(duck_typed_source);
+	// Same member and method names at different member indices and with different behavior.
+	Ref<RefCounted> a = _instantiate_source("extends RefCounted\nvar pad := 0\nvar x := 1.5\nfunc get_x():\n\treturn x\n");
+	Ref<RefCounted> b = _instantiate_source("extends RefCounted\nvar x := 2.5\nfunc get_x():\n\treturn x * 2.0\n");
+	REQUIRE(driver.is_valid());
+	REQUIRE(a.is_valid());
+	REQUIRE(b.is_valid());
+
+	Array items = { a, b, Vector2(3, 0), Vector3(4, 0, 0) };
+	for (int pass = 0; pass < 3; pass++) {
+		CHECK(double(driver->call("read_x", items)) == doctest::Approx(11.0));
+	}
+
+	Array objects = { a, b };
+	driver->call("write_x", objects, 7.0);
+	CHECK(double(a->get("x")) == doctest::Approx(7.0));
+	CHECK(double(b->get("x")) == doctest::Approx(7.0));
+	CHECK(double(driver->call("call_get_x", objects)) == doctest::Approx(21.0));
+
+	// Values that need a conversion must still be converted by the member's type.
+	driver->call("write_x", objects, 3);
+	CHECK(a->get("x").get_type() == Variant::FLOAT);
+	CHECK(double(driver->call("call_get_x", objects)) == doctest::Approx(9.0));
+
+	// Script receivers fall back to the native method when the script does not define it.
+	// Call sites are only cached in release builds, so tests built with `target=template_release`
+	// run these calls through the cached method binds and script functions.
+	const int64_t expected_ids = int64_t(a->get_instance_id()) ^ int64_t(b->get_instance_id());
+	for (int pass = 0; pass < 3; pass++) {
+		CHECK(int64_t(driver->call("call_native", objects)) == expected_ids);
+		CHECK(double(driver->call("call_get_x", objects)) == doctest::Approx(9.0));
+	}
+
+	// More receiver types than the cache can hold.
+	Array many;
+	double expected_total = 0.0;
+	for (int i = 0; i < 24; i++) {
+		many.push_back(_instantiate_source(vformat("extends RefCounted\nvar x := %d.0\n", i).utf8().get_data()));
+		expected_total += i;
+	}
+	for (int pass = 0; pass < 3; pass++) {
+		CHECK(double(driver->call("read_x", many)) == doctest::Approx(expected_total));
+	}
+}
+
+// One untyped call per function, so each uses its function's only inline cache.
+static const char *inline_call_source = R"(
+extends RefCounted
+
+func call_get_x(item):
+	return item.get_x()
+
+func call_get_instance_id(item):
+	return item.get_instance_id()
+
+func call_length(item):
+	return item.length()
+)";
+
+TEST_CASE("[Modules][GDScript] Inline caches resolve calls like Object::callp()") {
+	GDScriptLanguage::get_singleton()->init();
+
+	Ref<RefCounted> driver = _instantiate_source(inline_call_source);
+	Ref<RefCounted> item = _instantiate_source("extends RefCounted\nfunc get_x():\n\treturn 1.5\n");
+	REQUIRE(driver.is_valid());
+	REQUIRE(item.is_valid());
+	Ref<RefCounted> plain = memnew(RefCounted);
+	const Ref<GDScript> item_script = item->get_script();
+
+	const Ref<GDScript> driver_script = driver->get_script();
+	const HashMap<StringName, GDScriptFunction *> &functions = driver_script->get_member_functions();
+	REQUIRE(functions.has("call_get_x"));
+	REQUIRE(functions.has("call_get_instance_id"));
+	REQUIRE(functions.has("call_length"));
+
+	CHECK(functions["call_get_x"]->resolve_inline_call(0, item, "get_x") == GDScriptFunction::INLINE_CALL_SCRIPT_FUNCTION);
+
+	GDScriptFunction *call_get_instance_id = functions["call_get_instance_id"];
+	CHECK(call_get_instance_id->resolve_inline_call(0, item, "get_instance_id") == GDScriptFunction::INLINE_CALL_METHOD_BIND);
+	CHECK(call_get_instance_id->resolve_inline_call(0, plain, "get_instance_id") == GDScriptFunction::INLINE_CALL_METHOD_BIND);
+	// Scripts override Object::callp() to reach their static members first.
+	CHECK(call_get_instance_id->resolve_inline_call(0, item_script, "get_instance_id") == GDScriptFunction::INLINE_CALL_NONE);
+
+	// Built-in types already dispatch through a single lookup.
+	CHECK(functions["call_length"]->resolve_inline_call(0, Vector2(3, 4), "length") == GDScriptFunction::INLINE_CALL_NONE);
+}
+
+#ifdef DEBUG_ENABLED
+// Reloading while keeping state remaps the members of live instances, which is only done in debug builds.
+TEST_CASE("[Modules][GDScript] Inline caches follow script reloads") {
+	GDScriptLanguage::get_singleton()->init();
+
+	Ref<RefCounted> driver = _instantiate_source(duck_typed_source);
+	Ref<RefCounted> item = _instantiate_source("extends RefCounted\nvar x := 1.5\nfunc get_x():\n\treturn x\n");
+	REQUIRE(driver.is_valid());
+	REQUIRE(item.is_valid());
+
+	Array items = { item };
+	CHECK(double(driver->call("read_x", items)) == doctest::Approx(1.5));
+	CHECK(double(driver->call("call_get_x", items)) == doctest::Approx(1.5));
+
+	// Loading an unrelated script leaves the cached entries alone.
+	Ref<RefCounted> unrelated = _instantiate_source("extends RefCounted\nvar x := 8.0\n");
+	REQUIRE(unrelated.is_valid());
+	CHECK(double(driver->call("read_x", items)) == doctest::Approx(1.5));
+
+	// `x` moves to another member index and `get_x()` changes, the old entries must not be used.
+	Ref<GDScript> script = item->get_script();
+	script->set_source_code("extends RefCounted\nvar pad := 0\nvar x := 1.5\nfunc get_x():\n\treturn x * 10.0\n");
+	ERR_PRINT_OFF;
+	const Error error = script->reload(true);
+	ERR_PRINT_ON;
+	REQUIRE(error == OK);
+	item->set("x", 4.0);
+
+	for (int pass = 0; pass < 3; pass++) {
+		CHECK(double(driver->call("read_x", items)) == doctest::Approx(4.0));
+		CHECK(double(driver->call("call_get_x", items)) == doctest::Approx(40.0));
+	}
+}
+#endif // DEBUG_ENABLED
+
+} // namespace TestGDScriptBytecode
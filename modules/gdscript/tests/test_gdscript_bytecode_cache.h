@@ -0,0 +1,166 @@
+/**************************************************************************/
+/*  test_gdscript_bytecode_cache.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript.h"
+#include "../gdscript_analyzer.h"
+#include "../gdscript_bytecode_cache.h"
+#include "../gdscript_parser.h"
+
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestGDScriptBytecodeCache {
+
+static const char *cache_source = R"(
+extends RefCounted
+
+var scale := 3
+
+func sum(values: Array[int], offset := 1) -> int:
+	var total := 0
+	for value in values:
+		total += value * scale
+	return total + offset
+
+func describe(count) -> String:
+	return "%d items" % count
+
+func run(n: int) -> Array:
+	var squares: Array[int] = []
+	for i in n:
+		squares.append(i * i)
+	return [sum(squares), sum(squares, 0), describe(squares.size())]
+)";
+
+// Same file as `GDScriptBytecodeCache::_get_cache_file()` uses.
+static String _get_cache_file(const String &p_path) {
+	return String("user://gdscript_cache").path_join(p_path.md5_text() + ".gdbc");
+}
+
+static void _store_entry(const String &p_cache_file, Vector<uint8_t> p_entry) {
+	// Recomputes the trailing checksum, so the entry gets past it and has to be rejected by what follows.
+	const int body_size = p_entry.size() - 4;
+	encode_uint32(hash_murmur3_buffer(p_entry.ptr(), body_size), p_entry.ptrw() + body_size);
+
+	Ref<FileAccess> file = FileAccess::open(p_cache_file, FileAccess::WRITE);
+	REQUIRE(file.is_valid());
+	file->store_buffer(p_entry);
+}
+
+static bool _load_cached(const String &p_path, Ref<GDScript> &r_script) {
+	r_script.instantiate();
+	r_script->set_path(p_path, true);
+	ERR_PRINT_OFF;
+	const bool loaded = GDScriptBytecodeCache::load(r_script.ptr());
+	ERR_PRINT_ON;
+	return loaded;
+}
+
+TEST_CASE("[Modules][GDScript] Bytecode cache") {
+	const String path = TestUtils::get_temp_path("bytecode_cache.gd");
+	{
+		Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(file.is_valid());
+		file->store_string(cache_source);
+	}
+
+	Ref<GDScript> compiled;
+	compiled.instantiate();
+	compiled->set_path(path, true);
+	compiled->set_source_code(cache_source);
+	REQUIRE(compiled->reload() == OK);
+
+	GDScriptParser parser;
+	REQUIRE(parser.parse(cache_source, path, false) == OK);
+	GDScriptAnalyzer analyzer(&parser);
+	REQUIRE(analyzer.analyze() == OK);
+
+	GDScriptBytecodeCache::save(compiled.ptr(), parser);
+	const String cache_file = _get_cache_file(path);
+	REQUIRE(FileAccess::exists(cache_file));
+	const Vector<uint8_t> entry = FileAccess::get_file_as_bytes(cache_file);
+	REQUIRE(entry.size() > 16);
+
+	SUBCASE("Round trip") {
+		Ref<GDScript> cached;
+		REQUIRE(_load_cached(path, cached));
+		CHECK(cached->is_valid());
+
+		Ref<RefCounted> expected = memnew(RefCounted);
+		expected->set_script(compiled);
+		Ref<RefCounted> instance = memnew(RefCounted);
+		instance->set_script(cached);
+		const Array result = instance->call("run", 5);
+		CHECK(result == Array(expected->call("run", 5)));
+		CHECK(int(result[0]) == 91);
+		CHECK(int(result[1]) == 90);
+		CHECK(String(result[2]) == "5 items");
+	}
+
+	SUBCASE("Truncated entries are rejected") {
+		// Only the checksum guards a plain truncation.
+		Vector<uint8_t> truncated = entry;
+		truncated.resize(entry.size() / 2);
+		{
+			Ref<FileAccess> file = FileAccess::open(cache_file, FileAccess::WRITE);
+			REQUIRE(file.is_valid());
+			file->store_buffer(truncated);
+		}
+		Ref<GDScript> cached;
+		CHECK_FALSE(_load_cached(path, cached));
+
+		// With a matching checksum, the reader runs out of data somewhere in the entry.
+		for (int cut = 4; cut < entry.size() - 4; cut += MAX(1, entry.size() / 64)) {
+			truncated = entry.slice(0, entry.size() - 4 - cut);
+			truncated.resize(truncated.size() + 4);
+			_store_entry(cache_file, truncated);
+			CHECK_FALSE_MESSAGE(_load_cached(path, cached), vformat("Entry cut by %d bytes should be rejected.", cut));
+		}
+	}
+
+	SUBCASE("Entries from another build are rejected") {
+		// Magic, format version, then the build key as a length-prefixed string.
+		Vector<uint8_t> other_build = entry;
+		other_build.write[12] ^= 1;
+		_store_entry(cache_file, other_build);
+		Ref<GDScript> cached;
+		CHECK_FALSE(_load_cached(path, cached));
+
+		// Restoring the original entry makes it usable again.
+		_store_entry(cache_file, entry);
+		CHECK(_load_cached(path, cached));
+	}
+}
+
+} // namespace TestGDScriptBytecodeCache
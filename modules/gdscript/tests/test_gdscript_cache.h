@@ -0,0 +1,186 @@
+/**************************************************************************/
+/*  test_gdscript_cache.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript.h"
+#include "../gdscript_analyzer.h"
+#include "../gdscript_bytecode_cache.h"
+#include "../gdscript_cache.h"
+#include "../gdscript_parser.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/resource_loader.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestGDScriptCache {
+
+static String _write_script(const String &p_dir, const String &p_file, const String &p_source) {
+	const String path = p_dir.path_join(p_file);
+	Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+	REQUIRE(file.is_valid());
+	file->store_string(p_source);
+	return path;
+}
+
+TEST_CASE("[Modules][GDScript] Preparsed dependencies are compiled and released") {
+	const String dir = TestUtils::get_temp_path("gdscript_preparse");
+	DirAccess::make_dir_recursive_absolute(dir);
+
+	const String base_path = _write_script(dir, "base.gd", R"(
+extends RefCounted
+
+func base_value() -> int:
+	return 1
+)");
+	const String constants_path = _write_script(dir, "constants.gd", R"(
+extends RefCounted
+
+const VALUE = 100
+)");
+	const String helper_path = _write_script(dir, "helper.gd", R"(
+class_name PreparseHelper
+extends RefCounted
+
+static func helper_value() -> int:
+	return 10
+)");
+	// Only named as a type in `main.gd`, where a local constant shadows it. Parsed ahead, but never needed.
+	const String unused_path = _write_script(dir, "unused.gd", R"(
+class_name PreparseUnused
+extends RefCounted
+)");
+	const String main_path = _write_script(dir, "main.gd", R"(
+extends "base.gd"
+
+const Constants = preload("constants.gd")
+
+func total() -> int:
+	return base_value() + PreparseHelper.helper_value() + Constants.VALUE
+
+func shadowed() -> bool:
+	const PreparseUnused = Constants
+	var value: PreparseUnused = null
+	return value == null
+)");
+
+	ScriptServer::add_global_class("PreparseHelper", "RefCounted", "GDScript", helper_path, false, false);
+	ScriptServer::add_global_class("PreparseUnused", "RefCounted", "GDScript", unused_path, false, false);
+
+	Ref<GDScript> main = ResourceLoader::load(main_path, "", ResourceFormatLoader::CACHE_MODE_REPLACE);
+	REQUIRE(main.is_valid());
+	CHECK(main->is_valid());
+
+	for (const String &path : { base_path, constants_path, helper_path }) {
+		const Ref<GDScript> dependency = GDScriptCache::get_cached_script(path);
+		REQUIRE_MESSAGE(dependency.is_valid(), vformat("\"%s\" should have been loaded.", path.get_file()));
+		CHECK_MESSAGE(dependency->is_valid(), vformat("\"%s\" should have been compiled.", path.get_file()));
+	}
+
+	Ref<RefCounted> instance = memnew(RefCounted);
+	instance->set_script(main);
+	CHECK(int(instance->call("total")) == 111);
+	CHECK(bool(instance->call("shadowed")));
+
+	for (const String &path : { main_path, base_path, constants_path, helper_path, unused_path }) {
+		CHECK_MESSAGE(!GDScriptCache::has_preparsed_parser(path), vformat("\"%s\" should no longer be kept by preparsing.", path.get_file()));
+	}
+	// Nothing else refers to the parser of the script that wasn't a dependency after all.
+	CHECK(GDScriptCache::get_cached_script(unused_path).is_null());
+	CHECK_FALSE(GDScriptCache::has_parser(unused_path));
+
+	ScriptServer::remove_global_class("PreparseHelper");
+	ScriptServer::remove_global_class("PreparseUnused");
+}
+
+TEST_CASE("[Modules][GDScript] Scripts restored from the bytecode cache are not preparsed") {
+	const String dir = TestUtils::get_temp_path("gdscript_preparse_cached");
+	DirAccess::make_dir_recursive_absolute(dir);
+	const String source = R"(
+extends RefCounted
+
+func value() -> int:
+	return 42
+)";
+	const String path = _write_script(dir, "cached.gd", source);
+
+	const bool was_caching = GDScriptLanguage::get_singleton()->should_cache_bytecode();
+	GDScriptLanguage::get_singleton()->set_cache_bytecode(true);
+	REQUIRE(GDScriptBytecodeCache::is_enabled());
+
+	SUBCASE("Without a cache entry") {
+		// Same file as `GDScriptBytecodeCache::_get_cache_file()` uses.
+		DirAccess::remove_absolute(String("user://gdscript_cache").path_join(path.md5_text() + ".gdbc"));
+		CHECK_FALSE(GDScriptBytecodeCache::has_entry(path));
+
+		const Vector<String> preparsed = GDScriptCache::preparse(path);
+		CHECK(preparsed.has(path));
+		CHECK(GDScriptCache::has_preparsed_parser(path));
+		GDScriptCache::release_preparsed(preparsed);
+	}
+
+	SUBCASE("With a cache entry") {
+		Ref<GDScript> compiled;
+		compiled.instantiate();
+		compiled->set_path(path, true);
+		compiled->set_source_code(source);
+		REQUIRE(compiled->reload() == OK);
+		{
+			GDScriptParser parser;
+			REQUIRE(parser.parse(source, path, false) == OK);
+			GDScriptAnalyzer analyzer(&parser);
+			REQUIRE(analyzer.analyze() == OK);
+			GDScriptBytecodeCache::save(compiled.ptr(), parser);
+		}
+		compiled.unref();
+		REQUIRE(GDScriptBytecodeCache::has_entry(path));
+
+		const Vector<String> preparsed = GDScriptCache::preparse(path);
+		CHECK(preparsed.is_empty());
+		CHECK_FALSE(GDScriptCache::has_preparsed_parser(path));
+
+		// Loading restores the script without parsing it at all.
+		Ref<GDScript> loaded = ResourceLoader::load(path, "", ResourceFormatLoader::CACHE_MODE_REPLACE);
+		REQUIRE(loaded.is_valid());
+		CHECK(loaded->is_valid());
+		CHECK_FALSE(GDScriptCache::has_parser(path));
+
+		Ref<RefCounted> instance = memnew(RefCounted);
+		instance->set_script(loaded);
+		CHECK(int(instance->call("value")) == 42);
+	}
+
+	GDScriptBytecodeCache::clear();
+	GDScriptLanguage::get_singleton()->set_cache_bytecode(was_caching);
+}
+
+} // namespace TestGDScriptCache
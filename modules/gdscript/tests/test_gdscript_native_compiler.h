@@ -0,0 +1,154 @@
+/**************************************************************************/
+/*  test_gdscript_native_compiler.h                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript.h"
+#include "../gdscript_native_compiler.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGDScriptNativeCompiler {
+
+static const char *native_source = R"(
+extends RefCounted
+
+func add(a: int, b: int) -> int:
+	return a + b
+
+func add_untyped(value):
+	return value.first + value.second
+)";
+
+static Ref<GDScript> _compile_source(const String &p_source) {
+	Ref<GDScript> gdscript;
+	gdscript.instantiate();
+	gdscript->set_source_code(p_source);
+	REQUIRE(gdscript->reload() == OK);
+	return gdscript;
+}
+
+static const GDScriptFunction *_get_function(const Ref<GDScript> &p_script, const StringName &p_name) {
+	GDScriptFunction *const *function = p_script->get_member_functions().getptr(p_name);
+	REQUIRE(function != nullptr);
+	return *function;
+}
+
+// Stands in for a translated `add()`, so it is obvious which version ran.
+static int _fake_native_add(GDScriptFunction::NativeFrame &p_frame) {
+	*p_frame.retvalue = 42;
+	return -1;
+}
+
+// Registers a function until the end of the scope, then puts back whatever a generated module
+// built into the engine registered under the same key.
+class ScopedNativeFunction {
+	StringName name;
+	uint64_t hash = 0;
+	GDScriptFunction::NativeFunction previous = nullptr;
+
+public:
+	ScopedNativeFunction(const StringName &p_name, uint64_t p_hash, GDScriptFunction::NativeFunction p_function) :
+			name(p_name),
+			hash(p_hash),
+			previous(GDScriptNativeCompiler::get_function(p_name, p_hash)) {
+		GDScriptNativeCompiler::register_function(p_name, p_hash, p_function);
+	}
+
+	~ScopedNativeFunction() {
+		if (previous) {
+			GDScriptNativeCompiler::register_function(name, hash, previous);
+		} else {
+			GDScriptNativeCompiler::unregister_function(name, hash);
+		}
+	}
+};
+
+TEST_CASE("[Modules][GDScript] Native compiler function hashes") {
+	const Ref<GDScript> first = _compile_source(native_source);
+	const Ref<GDScript> second = _compile_source(native_source);
+	const Ref<GDScript> changed = _compile_source(String(native_source).replace("a + b", "a - b"));
+
+	// Only the bytecode matters, not which script object or compilation it came from.
+	CHECK(GDScriptNativeCompiler::hash_function(_get_function(first, "add")) == GDScriptNativeCompiler::hash_function(_get_function(second, "add")));
+	CHECK(GDScriptNativeCompiler::hash_function(_get_function(first, "add_untyped")) == GDScriptNativeCompiler::hash_function(_get_function(second, "add_untyped")));
+	CHECK(GDScriptNativeCompiler::hash_function(_get_function(first, "add")) != GDScriptNativeCompiler::hash_function(_get_function(changed, "add")));
+	CHECK(GDScriptNativeCompiler::hash_function(_get_function(first, "add")) != GDScriptNativeCompiler::hash_function(_get_function(first, "add_untyped")));
+}
+
+TEST_CASE("[Modules][GDScript] Native compiler binds functions by hash") {
+	const uint64_t hash = GDScriptNativeCompiler::hash_function(_get_function(_compile_source(native_source), "add"));
+	const bool was_enabled = GDScriptNativeCompiler::is_enabled();
+	GDScriptNativeCompiler::set_enabled(true);
+
+	SUBCASE("Matching bytecode runs the native function") {
+		ScopedNativeFunction native_add("add", hash, &_fake_native_add);
+		Ref<RefCounted> instance = memnew(RefCounted);
+		instance->set_script(_compile_source(native_source));
+		CHECK(int(instance->call("add", 2, 3)) == 42);
+	}
+
+	SUBCASE("Different bytecode stays in the VM") {
+		ScopedNativeFunction native_add("add", hash ^ 1, &_fake_native_add);
+		Ref<RefCounted> instance = memnew(RefCounted);
+		instance->set_script(_compile_source(native_source));
+		CHECK(int(instance->call("add", 2, 3)) == 5);
+	}
+
+	SUBCASE("Functions are matched by name too") {
+		ScopedNativeFunction native_other("other", hash, &_fake_native_add);
+		Ref<RefCounted> instance = memnew(RefCounted);
+		instance->set_script(_compile_source(native_source));
+		CHECK(int(instance->call("add", 2, 3)) == 5);
+	}
+
+	GDScriptNativeCompiler::set_enabled(was_enabled);
+}
+
+#ifdef TOOLS_ENABLED
+TEST_CASE("[Modules][GDScript] Native compiler translates typed functions") {
+	const Ref<GDScript> gdscript = _compile_source(native_source);
+
+	const String add = GDScriptNativeCompiler::translate_function(_get_function(gdscript, "add"), "gdscript_native_add");
+	REQUIRE_FALSE(add.is_empty());
+	CHECK(add.begins_with("static int gdscript_native_add(GDScriptFunction::NativeFrame &p_frame) {\n"));
+	// The typed addition is done inline and wraps around like in the VM, then the function returns.
+	CHECK(add.contains("int64_t(uint64_t(*VariantInternal::get_int(&s["));
+	CHECK(add.contains(")) + uint64_t(*VariantInternal::get_int(&s["));
+	CHECK(add.contains("*p_frame.retvalue = s["));
+	CHECK(add.contains("return -1;"));
+	CHECK(add.ends_with("}\n"));
+
+	// Untyped property access and operators would only bounce back to the VM.
+	CHECK(GDScriptNativeCompiler::translate_function(_get_function(gdscript, "add_untyped"), "gdscript_native_add_untyped").is_empty());
+}
+#endif // TOOLS_ENABLED
+
+} // namespace TestGDScriptNativeCompiler
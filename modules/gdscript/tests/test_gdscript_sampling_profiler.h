@@ -0,0 +1,186 @@
+/**************************************************************************/
+/*  test_gdscript_sampling_profiler.h                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript.h"
+#include "../gdscript_sampling_profiler.h"
+
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/os/os.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestGDScriptSamplingProfiler {
+
+static const char *profiler_source = R"(
+extends RefCounted
+
+func outer():
+	pass
+
+func inner():
+	pass
+)";
+
+// Sampling interval and how long a stack is held, so it gets sampled many times over.
+static constexpr uint64_t INTERVAL_USEC = 200;
+static constexpr uint64_t HOLD_USEC = 50000;
+
+static Ref<GDScript> _compile_profiler_script() {
+	Ref<GDScript> gdscript;
+	gdscript.instantiate();
+	gdscript->set_source_code(profiler_source);
+	REQUIRE(gdscript->reload() == OK);
+	return gdscript;
+}
+
+// Folded stacks of the saved profile, without their sample counts.
+static Vector<String> _get_folded_stacks(const String &p_path) {
+	Vector<String> stacks;
+	for (const String &line : FileAccess::get_file_as_string(p_path).split("\n", false)) {
+		const int separator = line.rfind_char(' ');
+		REQUIRE(separator > 0);
+		CHECK(line.substr(separator + 1).to_int() > 0);
+		stacks.push_back(line.substr(0, separator));
+	}
+	return stacks;
+}
+
+TEST_CASE("[Modules][GDScript] Sampling profiler records the call stack") {
+	const Ref<GDScript> gdscript = _compile_profiler_script();
+	GDScriptFunction *outer = gdscript->get_member_functions().get("outer");
+	GDScriptFunction *inner = gdscript->get_member_functions().get("inner");
+
+	GDScriptSamplingProfiler::start(INTERVAL_USEC);
+	GDScriptSamplingProfiler::enter(outer);
+	GDScriptSamplingProfiler::enter(inner);
+	OS::get_singleton()->delay_usec(HOLD_USEC);
+	GDScriptSamplingProfiler::exit();
+	GDScriptSamplingProfiler::exit();
+	GDScriptSamplingProfiler::stop();
+
+	SUBCASE("Folded stacks") {
+		const String path = TestUtils::get_temp_path("gdscript_profile.folded");
+		REQUIRE(GDScriptSamplingProfiler::save(path) == OK);
+
+		// A sample taken right between two calls only has `outer`, any other stack would be wrong.
+		String full_stack;
+		for (const String &stack : _get_folded_stacks(path)) {
+			const Vector<String> frames = stack.split(";");
+			REQUIRE(frames.size() >= 2);
+			REQUIRE(frames.size() <= 3);
+			CHECK(frames[0] == "Main Thread");
+			CHECK(frames[1].begins_with("outer ("));
+			if (frames.size() == 3) {
+				CHECK(frames[2].begins_with("inner ("));
+				CHECK(full_stack.is_empty());
+				full_stack = stack;
+			}
+		}
+		CHECK_FALSE(full_stack.is_empty());
+	}
+
+	SUBCASE("Chrome trace") {
+		const String path = TestUtils::get_temp_path("gdscript_profile.json");
+		REQUIRE(GDScriptSamplingProfiler::save(path) == OK);
+
+		const Dictionary trace = JSON::parse_string(FileAccess::get_file_as_string(path));
+		const Array events = trace.get("traceEvents", Array());
+		REQUIRE_FALSE(events.is_empty());
+
+		// Both functions begin once, outer first, and every begin is ended on the same thread.
+		Vector<String> begun;
+		HashMap<int, int> open_per_thread;
+		int max_open = 0;
+		for (const Dictionary event : events) {
+			const String phase = event["ph"];
+			if (phase == "B") {
+				begun.push_back(event["name"]);
+				const int open = ++open_per_thread[int(event["tid"])];
+				max_open = MAX(max_open, open);
+			} else if (phase == "E") {
+				CHECK(--open_per_thread[int(event["tid"])] >= 0);
+			}
+		}
+		REQUIRE(begun.size() == 2);
+		CHECK(begun[0].begins_with("outer ("));
+		CHECK(begun[1].begins_with("inner ("));
+		CHECK(max_open == 2);
+		for (const KeyValue<int, int> &E : open_per_thread) {
+			CHECK(E.value == 0);
+		}
+	}
+
+	GDScriptSamplingProfiler::clear();
+}
+
+TEST_CASE("[Modules][GDScript] Sampling profiler ignores unmatched exits") {
+	const Ref<GDScript> gdscript = _compile_profiler_script();
+	GDScriptFunction *outer = gdscript->get_member_functions().get("outer");
+	GDScriptFunction *inner = gdscript->get_member_functions().get("inner");
+	const String path = TestUtils::get_temp_path("gdscript_profile_unmatched.folded");
+
+	SUBCASE("Across restarts") {
+		// `outer` is still running when profiling restarts, and returns during the new session.
+		GDScriptSamplingProfiler::start(INTERVAL_USEC);
+		GDScriptSamplingProfiler::enter(outer);
+		GDScriptSamplingProfiler::stop();
+
+		GDScriptSamplingProfiler::start(INTERVAL_USEC);
+		GDScriptSamplingProfiler::exit();
+		GDScriptSamplingProfiler::enter(inner);
+		OS::get_singleton()->delay_usec(HOLD_USEC);
+		GDScriptSamplingProfiler::exit();
+		GDScriptSamplingProfiler::stop();
+	}
+
+	SUBCASE("Returning from functions entered before starting") {
+		GDScriptSamplingProfiler::start(INTERVAL_USEC);
+		GDScriptSamplingProfiler::exit();
+		GDScriptSamplingProfiler::exit();
+		GDScriptSamplingProfiler::enter(inner);
+		OS::get_singleton()->delay_usec(HOLD_USEC);
+		GDScriptSamplingProfiler::exit();
+		GDScriptSamplingProfiler::stop();
+	}
+
+	REQUIRE(GDScriptSamplingProfiler::save(path) == OK);
+	const Vector<String> stacks = _get_folded_stacks(path);
+	REQUIRE(stacks.size() == 1);
+	const Vector<String> frames = stacks[0].split(";");
+	REQUIRE(frames.size() == 2);
+	CHECK(frames[1].begins_with("inner ("));
+
+	GDScriptSamplingProfiler::clear();
+}
+
+} // namespace TestGDScriptSamplingProfiler
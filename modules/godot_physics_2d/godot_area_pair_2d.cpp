@@ -96,6 +96,7 @@ GodotAreaPair2D::GodotAreaPair2D(GodotBody2D *p_body, int p_body_shape, GodotAre
 	area = p_area;
 	body_shape = p_body_shape;
 	area_shape = p_area_shape;
+	set_order_key(area->get_self(), body->get_self(), area_shape, body_shape);
 	body->add_constraint(this, 0);
 	area->add_constraint(this);
 	if (p_body->get_mode() == PhysicsServer2D::BODY_MODE_KINEMATIC) { //need to be active to process pair
@@ -181,6 +182,7 @@ GodotArea2Pair2D::GodotArea2Pair2D(GodotArea2D *p_area_a, int p_shape_a, GodotAr
 	shape_b = p_shape_b;
 	area_a_monitorable = area_a->is_monitorable();
 	area_b_monitorable = area_b->is_monitorable();
+	set_order_key(area_a->get_self(), area_b->get_self(), shape_a, shape_b);
 	area_a->add_constraint(this);
 	area_b->add_constraint(this);
 }
@@ -389,6 +389,37 @@ Variant GodotBody2D::get_state(PhysicsServer2D::BodyState p_state) const {
 	return Variant();
 }
 
+void GodotBody2D::save_state(SavedState &r_state) const {
+	r_state.rid = get_self().get_id();
+	r_state.transform = get_transform();
+	r_state.inv_transform = get_inv_transform();
+	r_state.linear_velocity = linear_velocity;
+	r_state.prev_linear_velocity = prev_linear_velocity;
+	r_state.applied_force = applied_force;
+	r_state.angular_velocity = angular_velocity;
+	r_state.prev_angular_velocity = prev_angular_velocity;
+	r_state.applied_torque = applied_torque;
+	r_state.still_time = still_time;
+}
+
+void GodotBody2D::restore_state(const SavedState &p_state) {
+	// The kinematic target is reset, so that restored kinematic bodies don't move until a new one is set.
+	new_transform = p_state.transform;
+	_set_transform(p_state.transform);
+	_set_inv_transform(p_state.inv_transform);
+	_update_transform_dependent();
+
+	linear_velocity = p_state.linear_velocity;
+	prev_linear_velocity = p_state.prev_linear_velocity;
+	applied_force = p_state.applied_force;
+	angular_velocity = p_state.angular_velocity;
+	prev_angular_velocity = p_state.prev_angular_velocity;
+	applied_torque = p_state.applied_torque;
+	biased_linear_velocity = Vector2();
+	biased_angular_velocity = 0.0;
+	still_time = p_state.still_time;
+}
+
 void GodotBody2D::set_space(GodotSpace2D *p_space) {
 	if (get_space()) {
 		wakeup_neighbours();
@@ -300,6 +300,23 @@ public:
 	void set_state(PhysicsServer2D::BodyState p_state, const Variant &p_variant);
 	Variant get_state(PhysicsServer2D::BodyState p_state) const;
 
+	// Simulation state stored in space snapshots, see GodotSpace2D::save_state().
+	struct SavedState {
+		uint64_t rid = 0;
+		Transform2D transform;
+		Transform2D inv_transform;
+		Vector2 linear_velocity;
+		Vector2 prev_linear_velocity;
+		Vector2 applied_force;
+		real_t angular_velocity = 0.0;
+		real_t prev_angular_velocity = 0.0;
+		real_t applied_torque = 0.0;
+		real_t still_time = 0.0;
+	};
+
+	void save_state(SavedState &r_state) const;
+	void restore_state(const SavedState &p_state);
+
 	_FORCE_INLINE_ void set_continuous_collision_detection_mode(PhysicsServer2D::CCDMode p_mode) { continuous_cd_mode = p_mode; }
 	_FORCE_INLINE_ PhysicsServer2D::CCDMode get_continuous_collision_detection_mode() const { return continuous_cd_mode; }
 
@@ -593,13 +593,75 @@ void GodotBodyPair2D::solve(real_t p_step) {
 	}
 }
 
+void GodotBodyPair2D::get_saved_state_key(SavedState &r_state) const {
+	r_state.body_A = A->get_self().get_id();
+	r_state.body_B = B->get_self().get_id();
+	r_state.shape_A = shape_A;
+	r_state.shape_B = shape_B;
+}
+
+void GodotBodyPair2D::save_state(SavedState &r_state) const {
+	get_saved_state_key(r_state);
+	r_state.contact_count = contact_count;
+	r_state.flags = (collided ? 1 : 0) | (oneway_disabled ? 2 : 0);
+	r_state.sep_axis = sep_axis;
+
+	for (int i = 0; i < contact_count; i++) {
+		const Contact &c = contacts[i];
+		SavedState::SavedContact &saved = r_state.contacts[i];
+		saved.normal = c.normal;
+		saved.local_A = c.local_A;
+		saved.local_B = c.local_B;
+		saved.acc_impulse = c.acc_impulse;
+		saved.acc_normal_impulse = c.acc_normal_impulse;
+		saved.acc_tangent_impulse = c.acc_tangent_impulse;
+		saved.acc_bias_impulse = c.acc_bias_impulse;
+		saved.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
+		saved.depth = c.depth;
+		saved.active = c.active;
+	}
+}
+
+void GodotBodyPair2D::restore_state(const SavedState *p_state) {
+	if (!p_state) {
+		contact_count = 0;
+		collided = false;
+		oneway_disabled = false;
+		sep_axis = Vector2();
+		return;
+	}
+
+	contact_count = CLAMP(p_state->contact_count, 0, (int)MAX_CONTACTS);
+	collided = p_state->flags & 1;
+	oneway_disabled = p_state->flags & 2;
+	sep_axis = p_state->sep_axis;
+
+	for (int i = 0; i < contact_count; i++) {
+		const SavedState::SavedContact &saved = p_state->contacts[i];
+		Contact &c = contacts[i];
+		c.normal = saved.normal;
+		c.local_A = saved.local_A;
+		c.local_B = saved.local_B;
+		c.acc_impulse = saved.acc_impulse;
+		c.acc_normal_impulse = saved.acc_normal_impulse;
+		c.acc_tangent_impulse = saved.acc_tangent_impulse;
+		c.acc_bias_impulse = saved.acc_bias_impulse;
+		c.acc_bias_impulse_center_of_mass = saved.acc_bias_impulse_center_of_mass;
+		c.depth = saved.depth;
+		c.active = saved.active;
+		c.used = false;
+	}
+}
+
 GodotBodyPair2D::GodotBodyPair2D(GodotBody2D *p_A, int p_shape_A, GodotBody2D *p_B, int p_shape_B) :
-		GodotConstraint2D(_arr, 2) {
+		GodotConstraint2D(_arr, 2),
+		space_list(this) {
 	A = p_A;
 	B = p_B;
 	shape_A = p_shape_A;
 	shape_B = p_shape_B;
 	space = A->get_space();
+	set_order_key(A->get_self(), B->get_self(), shape_A, shape_B);
 	A->add_constraint(this, 0);
 	B->add_constraint(this, 1);
 }
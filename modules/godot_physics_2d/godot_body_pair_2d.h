@@ -83,12 +83,59 @@ class GodotBodyPair2D : public GodotConstraint2D {
 	bool oneway_disabled = false;
 	bool report_contacts_only = false;
 
+	SelfList<GodotBodyPair2D> space_list;
+
 	bool _test_ccd(real_t p_step, GodotBody2D *p_A, int p_shape_A, const Transform2D &p_xform_A, GodotBody2D *p_B, int p_shape_B, const Transform2D &p_xform_B);
 	void _validate_contacts();
 	static void _add_contact(const Vector2 &p_point_A, const Vector2 &p_point_B, void *p_self);
 	_FORCE_INLINE_ void _contact_added_callback(const Vector2 &p_point_A, const Vector2 &p_point_B);
 
 public:
+	// Contact cache stored in space snapshots, see GodotSpace2D::save_state().
+	struct SavedState {
+		uint64_t body_A = 0;
+		uint64_t body_B = 0;
+		int32_t shape_A = 0;
+		int32_t shape_B = 0;
+		int32_t contact_count = 0;
+		uint32_t flags = 0;
+		Vector2 sep_axis;
+
+		struct SavedContact {
+			Vector2 normal;
+			Vector2 local_A, local_B;
+			Vector2 acc_impulse;
+			real_t acc_normal_impulse = 0.0;
+			real_t acc_tangent_impulse = 0.0;
+			real_t acc_bias_impulse = 0.0;
+			real_t acc_bias_impulse_center_of_mass = 0.0;
+			real_t depth = 0.0;
+			uint32_t active = 0;
+		} contacts[MAX_CONTACTS];
+	};
+
+	struct SavedStateComparator {
+		_FORCE_INLINE_ bool operator()(const SavedState &p_a, const SavedState &p_b) const {
+			if (p_a.body_A != p_b.body_A) {
+				return p_a.body_A < p_b.body_A;
+			}
+			if (p_a.body_B != p_b.body_B) {
+				return p_a.body_B < p_b.body_B;
+			}
+			if (p_a.shape_A != p_b.shape_A) {
+				return p_a.shape_A < p_b.shape_A;
+			}
+			return p_a.shape_B < p_b.shape_B;
+		}
+	};
+
+	_FORCE_INLINE_ SelfList<GodotBodyPair2D> *get_space_list() { return &space_list; }
+
+	void get_saved_state_key(SavedState &r_state) const;
+	void save_state(SavedState &r_state) const;
+	// Passing nullptr clears the contact cache.
+	void restore_state(const SavedState *p_state);
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
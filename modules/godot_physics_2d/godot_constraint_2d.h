@@ -33,6 +33,32 @@
 #include "godot_body_2d.h"
 
 class GodotConstraint2D {
+public:
+	// Identifies a constraint independently of the order it was created in,
+	// used to sort constraint islands when the space is deterministic.
+	struct OrderKey {
+		uint64_t first = 0;
+		uint64_t second = 0;
+		uint64_t shapes = 0;
+
+		_FORCE_INLINE_ bool operator<(const OrderKey &p_key) const {
+			if (first != p_key.first) {
+				return first < p_key.first;
+			}
+			if (second != p_key.second) {
+				return second < p_key.second;
+			}
+			return shapes < p_key.shapes;
+		}
+	};
+
+	struct OrderComparator {
+		_FORCE_INLINE_ bool operator()(const GodotConstraint2D *p_a, const GodotConstraint2D *p_b) const {
+			return p_a->order_key < p_b->order_key;
+		}
+	};
+
+private:
 	GodotBody2D **_body_ptr;
 	int _body_count;
 	uint64_t island_step = 0;
@@ -41,14 +67,26 @@ class GodotConstraint2D {
 	RID self;
 
 protected:
+	OrderKey order_key;
+
+	_FORCE_INLINE_ void set_order_key(const RID &p_first, const RID &p_second, int p_shape_first, int p_shape_second) {
+		order_key.first = p_first.get_id();
+		order_key.second = p_second.get_id();
+		order_key.shapes = (uint64_t(uint32_t(p_shape_first)) << 32) | uint32_t(p_shape_second);
+	}
+
 	GodotConstraint2D(GodotBody2D **p_body_ptr = nullptr, int p_body_count = 0) {
 		_body_ptr = p_body_ptr;
 		_body_count = p_body_count;
 	}
 
 public:
-	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
+	_FORCE_INLINE_ void set_self(const RID &p_self) {
+		self = p_self;
+		order_key.first = p_self.get_id();
+	}
 	_FORCE_INLINE_ RID get_self() const { return self; }
+	_FORCE_INLINE_ const OrderKey &get_order_key() const { return order_key; }
 
 	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
 	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
@@ -34,6 +34,7 @@
 #include "godot_physics_server_2d.h"
 
 #include "core/config/project_settings.h"
+#include "core/templates/sort_array.h"
 #include "godot_area_pair_2d.h"
 #include "godot_body_pair_2d.h"
 
@@ -1036,6 +1037,7 @@ void *GodotSpace2D::_broadphase_pair(GodotCollisionObject2D *A, int p_subindex_A
 
 	} else {
 		GodotBodyPair2D *b = memnew(GodotBodyPair2D(static_cast<GodotBody2D *>(A), p_subindex_A, static_cast<GodotBody2D *>(B), p_subindex_B));
+		self->body_pair_list.add(b->get_space_list());
 		return b;
 	}
 }
@@ -1173,6 +1175,9 @@ void GodotSpace2D::set_param(PhysicsServer2D::SpaceParameter p_param, real_t p_v
 		case PhysicsServer2D::SPACE_PARAM_SOLVER_ITERATIONS:
 			solver_iterations = p_value;
 			break;
+		case PhysicsServer2D::SPACE_PARAM_DETERMINISTIC:
+			deterministic = p_value != 0.0;
+			break;
 	}
 }
 
@@ -1196,10 +1201,173 @@ real_t GodotSpace2D::get_param(PhysicsServer2D::SpaceParameter p_param) const {
 			return constraint_bias;
 		case PhysicsServer2D::SPACE_PARAM_SOLVER_ITERATIONS:
 			return solver_iterations;
+		case PhysicsServer2D::SPACE_PARAM_DETERMINISTIC:
+			return deterministic ? 1.0 : 0.0;
 	}
 	return 0;
 }
 
+// Space snapshots are a header followed by the body states sorted by RID, the
+// RIDs of the active bodies in active list order and the contact caches of the
+// body pairs sorted by bodies and shapes. Sorting keeps the snapshot of a given
+// simulation state identical regardless of how the space was built.
+struct GodotSpaceSavedStateHeader2D {
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	uint32_t body_state_size = 0;
+	uint32_t pair_state_size = 0;
+	uint32_t body_count = 0;
+	uint32_t active_body_count = 0;
+	uint32_t pair_count = 0;
+	uint32_t reserved = 0;
+};
+
+static constexpr uint32_t SPACE_STATE_MAGIC_2D = 0x32535047; // "GPS2"
+static constexpr uint32_t SPACE_STATE_VERSION_2D = 1;
+
+struct GodotSpaceSavedBodyComparator2D {
+	_FORCE_INLINE_ bool operator()(const GodotBody2D *p_a, const GodotBody2D *p_b) const {
+		return p_a->get_self() < p_b->get_self();
+	}
+};
+
+Vector<uint8_t> GodotSpace2D::save_state() const {
+	LocalVector<const GodotBody2D *> bodies;
+	for (const GodotCollisionObject2D *object : objects) {
+		if (object->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+			bodies.push_back(static_cast<const GodotBody2D *>(object));
+		}
+	}
+	bodies.sort_custom<GodotSpaceSavedBodyComparator2D>();
+
+	uint32_t active_body_count = 0;
+	for (const SelfList<GodotBody2D> *e = active_list.first(); e; e = e->next()) {
+		active_body_count++;
+	}
+
+	uint32_t pair_count = 0;
+	for (const SelfList<GodotBodyPair2D> *e = body_pair_list.first(); e; e = e->next()) {
+		pair_count++;
+	}
+
+	const uint32_t body_count = bodies.size();
+
+	const uint32_t bodies_offset = sizeof(GodotSpaceSavedStateHeader2D);
+	const uint32_t active_bodies_offset = bodies_offset + body_count * sizeof(GodotBody2D::SavedState);
+	const uint32_t pairs_offset = active_bodies_offset + active_body_count * sizeof(uint64_t);
+	const uint32_t state_size = pairs_offset + pair_count * sizeof(GodotBodyPair2D::SavedState);
+
+	Vector<uint8_t> state;
+	state.resize_initialized(state_size);
+	uint8_t *w = state.ptrw();
+
+	GodotSpaceSavedStateHeader2D *header = reinterpret_cast<GodotSpaceSavedStateHeader2D *>(w);
+	header->magic = SPACE_STATE_MAGIC_2D;
+	header->version = SPACE_STATE_VERSION_2D;
+	header->body_state_size = sizeof(GodotBody2D::SavedState);
+	header->pair_state_size = sizeof(GodotBodyPair2D::SavedState);
+	header->body_count = body_count;
+	header->active_body_count = active_body_count;
+	header->pair_count = pair_count;
+
+	GodotBody2D::SavedState *body_states = reinterpret_cast<GodotBody2D::SavedState *>(w + bodies_offset);
+	for (uint32_t i = 0; i < body_count; i++) {
+		bodies[i]->save_state(body_states[i]);
+	}
+
+	uint64_t *active_bodies = reinterpret_cast<uint64_t *>(w + active_bodies_offset);
+	for (const SelfList<GodotBody2D> *e = active_list.first(); e; e = e->next()) {
+		*active_bodies++ = e->self()->get_self().get_id();
+	}
+
+	GodotBodyPair2D::SavedState *pair_states = reinterpret_cast<GodotBodyPair2D::SavedState *>(w + pairs_offset);
+	uint32_t pair_index = 0;
+	for (const SelfList<GodotBodyPair2D> *e = body_pair_list.first(); e; e = e->next()) {
+		e->self()->save_state(pair_states[pair_index++]);
+	}
+	SortArray<GodotBodyPair2D::SavedState, GodotBodyPair2D::SavedStateComparator> sorter;
+	sorter.sort(pair_states, pair_count);
+
+	return state;
+}
+
+Error GodotSpace2D::restore_state(const Vector<uint8_t> &p_state) {
+	ERR_FAIL_COND_V_MSG(locked, ERR_LOCKED, "Can't restore the space state while the space is being stepped.");
+	ERR_FAIL_COND_V((uint32_t)p_state.size() < sizeof(GodotSpaceSavedStateHeader2D), ERR_INVALID_DATA);
+
+	const uint8_t *r = p_state.ptr();
+	const GodotSpaceSavedStateHeader2D *header = reinterpret_cast<const GodotSpaceSavedStateHeader2D *>(r);
+	ERR_FAIL_COND_V_MSG(header->magic != SPACE_STATE_MAGIC_2D || header->version != SPACE_STATE_VERSION_2D, ERR_INVALID_DATA, "Invalid space state, it wasn't saved by this version of Godot Physics 2D.");
+	ERR_FAIL_COND_V_MSG(header->body_state_size != sizeof(GodotBody2D::SavedState) || header->pair_state_size != sizeof(GodotBodyPair2D::SavedState), ERR_INVALID_DATA, "Invalid space state, it was saved with a different floating-point precision.");
+
+	const uint64_t bodies_offset = sizeof(GodotSpaceSavedStateHeader2D);
+	const uint64_t active_bodies_offset = bodies_offset + uint64_t(header->body_count) * sizeof(GodotBody2D::SavedState);
+	const uint64_t pairs_offset = active_bodies_offset + uint64_t(header->active_body_count) * sizeof(uint64_t);
+	const uint64_t state_size = pairs_offset + uint64_t(header->pair_count) * sizeof(GodotBodyPair2D::SavedState);
+	ERR_FAIL_COND_V_MSG(state_size != (uint64_t)p_state.size(), ERR_INVALID_DATA, "Invalid space state, the data is truncated.");
+
+	HashMap<RID, GodotBody2D *> bodies;
+	bodies.reserve(objects.size());
+	for (GodotCollisionObject2D *object : objects) {
+		if (object->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+			bodies.insert(object->get_self(), static_cast<GodotBody2D *>(object));
+		}
+	}
+
+	// Bodies that were removed from the space since the state was saved are skipped,
+	// bodies that were added keep their current state.
+	const GodotBody2D::SavedState *body_states = reinterpret_cast<const GodotBody2D::SavedState *>(r + bodies_offset);
+	for (uint32_t i = 0; i < header->body_count; i++) {
+		HashMap<RID, GodotBody2D *>::Iterator E = bodies.find(RID::from_uint64(body_states[i].rid));
+		if (E) {
+			E->value->restore_state(body_states[i]);
+		}
+	}
+
+	// Rebuild the active list in the saved order, it decides the order bodies are integrated and islands are built.
+	while (active_list.first()) {
+		active_list.first()->self()->set_active(false);
+	}
+	const uint64_t *active_bodies = reinterpret_cast<const uint64_t *>(r + active_bodies_offset);
+	for (uint32_t i = 0; i < header->active_body_count; i++) {
+		HashMap<RID, GodotBody2D *>::Iterator E = bodies.find(RID::from_uint64(active_bodies[i]));
+		if (E) {
+			E->value->set_active(true);
+		}
+	}
+
+	// Create and remove the pairs for the restored transforms, then restore their contact caches.
+	update();
+
+	const GodotBodyPair2D::SavedState *pair_states = reinterpret_cast<const GodotBodyPair2D::SavedState *>(r + pairs_offset);
+	const uint32_t pair_count = header->pair_count;
+	GodotBodyPair2D::SavedStateComparator compare;
+	for (SelfList<GodotBodyPair2D> *e = body_pair_list.first(); e; e = e->next()) {
+		GodotBodyPair2D::SavedState key;
+		e->self()->get_saved_state_key(key);
+
+		// Binary search, the pairs are sorted by key.
+		uint32_t lo = 0;
+		uint32_t hi = pair_count;
+		while (lo < hi) {
+			const uint32_t mid = (lo + hi) / 2;
+			if (compare(pair_states[mid], key)) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+
+		if (lo < pair_count && !compare(key, pair_states[lo])) {
+			e->self()->restore_state(&pair_states[lo]);
+		} else {
+			e->self()->restore_state(nullptr);
+		}
+	}
+
+	return OK;
+}
+
 void GodotSpace2D::lock() {
 	locked = true;
 }
@@ -1221,6 +1389,7 @@ GodotSpace2D::GodotSpace2D() {
 	body_angular_velocity_sleep_threshold = GLOBAL_GET("physics/2d/sleep_threshold_angular");
 	body_time_to_sleep = GLOBAL_GET("physics/2d/time_before_sleep");
 	solver_iterations = GLOBAL_GET("physics/2d/solver/solver_iterations");
+	deterministic = GLOBAL_GET("physics/2d/solver/deterministic");
 	contact_recycle_radius = GLOBAL_GET("physics/2d/solver/contact_recycle_radius");
 	contact_max_separation = GLOBAL_GET("physics/2d/solver/contact_max_separation");
 	contact_max_allowed_penetration = GLOBAL_GET("physics/2d/solver/contact_max_allowed_penetration");
@@ -78,6 +78,10 @@ void GodotStep2D::_setup_constraint(uint32_t p_constraint_index, void *p_userdat
 	constraint->setup(delta);
 }
 
+void GodotStep2D::_sort_island(uint32_t p_island_index, void *p_userdata) {
+	constraint_islands[p_island_index].sort_custom<GodotConstraint2D::OrderComparator>();
+}
+
 void GodotStep2D::_pre_solve_island(LocalVector<GodotConstraint2D *> &p_constraint_island) const {
 	uint32_t constraint_count = p_constraint_island.size();
 	uint32_t valid_constraint_count = 0;
@@ -250,6 +254,16 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 		profile_begtime = profile_endtime;
 	}
 
+	/* SORT CONSTRAINT ISLANDS */
+
+	if (p_space->is_deterministic()) {
+		// Islands are built by following the constraint lists of the bodies, which
+		// depend on the order the broadphase paired them in. Sorting each island by
+		// bodies and shapes makes impulses accumulate in the same order every time.
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_sort_island, nullptr, island_count, -1, true, SNAME("Physics2DConstraintSortIslands"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
 	/* PRE-SOLVE CONSTRAINT ISLANDS */
 
 	// WARNING: This doesn't run on threads, because it involves thread-unsafe processing.
@@ -0,0 +1,168 @@
+/**************************************************************************/
+/*  test_godot_physics_2d_determinism.h                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_physics_server_2d.h"
+
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/hashfuncs.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotPhysics2DDeterminism {
+
+static const int BODY_COUNT = 500;
+static const int COLUMN_COUNT = 20;
+static const int STEP_COUNT = 120;
+
+static uint32_t _hash_transform(const Transform2D &p_transform, uint32_t p_hash) {
+	for (int i = 0; i < 3; i++) {
+		p_hash = hash_murmur3_one_real(p_transform.columns[i].x, p_hash);
+		p_hash = hash_murmur3_one_real(p_transform.columns[i].y, p_hash);
+	}
+	return p_hash;
+}
+
+// Drops a pile of boxes and circles into a container and returns a hash of
+// the state of every body after stepping the space a fixed number of times.
+// Waking the bodies in reverse order changes the order of the active list, which
+// islands are built from, so constraints end up in a different order in each island
+// while the broadphase still pairs every body the same way.
+static uint32_t _simulate(int p_thread_count, bool p_deterministic = true, bool p_reverse_wake_order = false) {
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init(p_thread_count);
+
+	GodotPhysicsServer2D *server = memnew(GodotPhysicsServer2D);
+	server->init();
+	server->set_active(true);
+
+	RID space = server->space_create();
+	server->space_set_param(space, PhysicsServer2D::SPACE_PARAM_DETERMINISTIC, p_deterministic ? 1.0 : 0.0);
+	server->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY, 980.0);
+	server->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY_VECTOR, Vector2(0, 1));
+	server->space_set_active(space, true);
+
+	RID floor_shape = server->rectangle_shape_create();
+	server->shape_set_data(floor_shape, Vector2(1000, 20));
+	RID wall_shape = server->rectangle_shape_create();
+	server->shape_set_data(wall_shape, Vector2(20, 1000));
+
+	RID container = server->body_create();
+	server->body_set_mode(container, PhysicsServer2D::BODY_MODE_STATIC);
+	server->body_add_shape(container, floor_shape, Transform2D(0, Vector2(0, 20)));
+	server->body_add_shape(container, wall_shape, Transform2D(0, Vector2(-1000, -980)));
+	server->body_add_shape(container, wall_shape, Transform2D(0, Vector2(1000, -980)));
+	server->body_set_space(container, space);
+
+	RID box_shape = server->rectangle_shape_create();
+	server->shape_set_data(box_shape, Vector2(10, 10));
+	RID circle_shape = server->circle_shape_create();
+	server->shape_set_data(circle_shape, 10.0);
+
+	LocalVector<RID> bodies;
+	bodies.reserve(BODY_COUNT);
+	for (int i = 0; i < BODY_COUNT; i++) {
+		const int column = i % COLUMN_COUNT;
+		const int row = i / COLUMN_COUNT;
+
+		RID body = server->body_create();
+		server->body_set_mode(body, PhysicsServer2D::BODY_MODE_RIGID);
+		server->body_add_shape(body, (i % 3) == 0 ? circle_shape : box_shape);
+		// Offset every other row so bodies land on each other and tumble.
+		const Vector2 origin = Vector2(-900 + column * 90 + (row % 2) * 12, -30 - row * 24);
+		server->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(i * 0.1, origin));
+		server->body_set_space(body, space);
+		bodies.push_back(body);
+	}
+
+	for (const RID &body : bodies) {
+		server->body_set_state(body, PhysicsServer2D::BODY_STATE_SLEEPING, true);
+	}
+	for (int i = 0; i < BODY_COUNT; i++) {
+		server->body_set_state(bodies[p_reverse_wake_order ? BODY_COUNT - 1 - i : i], PhysicsServer2D::BODY_STATE_SLEEPING, false);
+	}
+
+	for (int i = 0; i < STEP_COUNT; i++) {
+		server->step(1.0 / 60.0);
+	}
+
+	uint32_t hash = HASH_MURMUR3_SEED;
+	for (const RID &body : bodies) {
+		const Transform2D transform = server->body_get_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM);
+		const Vector2 linear_velocity = server->body_get_state(body, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY);
+		const real_t angular_velocity = server->body_get_state(body, PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY);
+		hash = _hash_transform(transform, hash);
+		hash = hash_murmur3_one_real(linear_velocity.x, hash);
+		hash = hash_murmur3_one_real(linear_velocity.y, hash);
+		hash = hash_murmur3_one_real(angular_velocity, hash);
+	}
+
+	for (const RID &body : bodies) {
+		server->free(body);
+	}
+	server->free(container);
+	server->free(box_shape);
+	server->free(circle_shape);
+	server->free(wall_shape);
+	server->free(floor_shape);
+	server->free(space);
+
+	server->finish();
+	memdelete(server);
+
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init();
+
+	return hash_fmix32(hash);
+}
+
+TEST_CASE("[Modules][GodotPhysics2D] Deterministic space gives the same results with any thread count") {
+	const uint32_t hash_1 = _simulate(1);
+	const uint32_t hash_4 = _simulate(4);
+	const uint32_t hash_16 = _simulate(16);
+
+	CHECK_MESSAGE(hash_1 == hash_4, "Stepping with 4 threads should give the same state as with 1 thread.");
+	CHECK_MESSAGE(hash_1 == hash_16, "Stepping with 16 threads should give the same state as with 1 thread.");
+}
+
+TEST_CASE("[Modules][GodotPhysics2D] Deterministic space doesn't depend on the constraint order") {
+	const uint32_t hash = _simulate(4);
+	const uint32_t hash_reversed = _simulate(4, true, true);
+	CHECK_MESSAGE(hash == hash_reversed, "Building islands in a different order should give the same state when the space is deterministic.");
+
+	// Without sorting, the order changes how impulses accumulate,
+	// otherwise the case above wouldn't test anything.
+	const uint32_t unsorted_hash = _simulate(4, false);
+	const uint32_t unsorted_hash_reversed = _simulate(4, false, true);
+	CHECK_MESSAGE(unsorted_hash != unsorted_hash_reversed, "Building islands in a different order should change the state when the space isn't deterministic.");
+}
+
+} // namespace TestGodotPhysics2DDeterminism
@@ -438,6 +438,37 @@ Variant GodotBody3D::get_state(PhysicsServer3D::BodyState p_state) const {
 	return Variant();
 }
 
+void GodotBody3D::save_state(SavedState &r_state) const {
+	r_state.rid = get_self().get_id();
+	r_state.transform = get_transform();
+	r_state.inv_transform = get_inv_transform();
+	r_state.linear_velocity = linear_velocity;
+	r_state.angular_velocity = angular_velocity;
+	r_state.prev_linear_velocity = prev_linear_velocity;
+	r_state.prev_angular_velocity = prev_angular_velocity;
+	r_state.applied_force = applied_force;
+	r_state.applied_torque = applied_torque;
+	r_state.still_time = still_time;
+}
+
+void GodotBody3D::restore_state(const SavedState &p_state) {
+	// The kinematic target is reset, so that restored kinematic bodies don't move until a new one is set.
+	new_transform = p_state.transform;
+	_set_transform(p_state.transform);
+	_set_inv_transform(p_state.inv_transform);
+	_update_transform_dependent();
+
+	linear_velocity = p_state.linear_velocity;
+	angular_velocity = p_state.angular_velocity;
+	prev_linear_velocity = p_state.prev_linear_velocity;
+	prev_angular_velocity = p_state.prev_angular_velocity;
+	biased_linear_velocity = Vector3();
+	biased_angular_velocity = Vector3();
+	applied_force = p_state.applied_force;
+	applied_torque = p_state.applied_torque;
+	still_time = p_state.still_time;
+}
+
 void GodotBody3D::set_space(GodotSpace3D *p_space) {
 	if (get_space()) {
 		if (mass_properties_update_list.in_list()) {
@@ -474,7 +505,7 @@ bool GodotBody3D::is_axis_locked(PhysicsServer3D::BodyAxis p_axis) const {
 	return locked_axis & p_axis;
 }
 
-void GodotBody3D::integrate_forces(real_t p_step) {
+void GodotBody3D::integrate_forces(real_t p_step, bool p_defer_space_updates) {
 	if (mode == PhysicsServer3D::BODY_MODE_STATIC) {
 		return;
 	}
@@ -665,13 +696,18 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 	biased_linear_velocity = Vector3();
 
 	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
+		if (p_defer_space_updates) {
+			deferred_motion = motion;
+			deferred_motion_update = true;
+		} else {
+			_update_shapes_with_motion(motion);
+		}
 	}
 
 	contact_count = 0;
 }
 
-void GodotBody3D::integrate_velocities(real_t p_step) {
+void GodotBody3D::integrate_velocities(real_t p_step, bool p_defer_space_updates) {
 	if (mode == PhysicsServer3D::BODY_MODE_STATIC) {
 		return;
 	}
@@ -679,7 +715,11 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 	ERR_FAIL_NULL(get_space());
 
 	if (fi_callback_data || body_state_callback.is_valid()) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+		if (p_defer_space_updates) {
+			deferred_state_query = true;
+		} else {
+			get_space()->body_add_to_state_query_list(&direct_state_query_list);
+		}
 	}
 
 	//apply axis lock linear
@@ -702,7 +742,11 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
 		if (contacts.is_empty() && linear_velocity == Vector3() && angular_velocity == Vector3()) {
-			set_active(false); //stopped moving, deactivate
+			if (p_defer_space_updates) {
+				deferred_deactivate = true;
+			} else {
+				set_active(false); //stopped moving, deactivate
+			}
 		}
 
 		return;
@@ -731,10 +775,36 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 
 	transform_new.origin += total_linear_velocity * p_step;
 
-	_set_transform(transform_new);
+	_set_transform(transform_new, !p_defer_space_updates);
 	_set_inv_transform(get_transform().inverse());
 
 	_update_transform_dependent();
+
+	if (p_defer_space_updates) {
+		deferred_shapes_update = true;
+	}
+}
+
+void GodotBody3D::apply_deferred_space_updates() {
+	if (deferred_motion_update) {
+		deferred_motion_update = false;
+		_update_shapes_with_motion(deferred_motion);
+	}
+
+	if (deferred_state_query) {
+		deferred_state_query = false;
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+
+	if (deferred_shapes_update) {
+		deferred_shapes_update = false;
+		_update_shapes();
+	}
+
+	if (deferred_deactivate) {
+		deferred_deactivate = false;
+		set_active(false);
+	}
 }
 
 void GodotBody3D::wakeup_neighbours() {
@@ -145,6 +145,13 @@ class GodotBody3D : public GodotCollisionObject3D {
 
 	uint64_t island_step = 0;
 
+	// Space and broadphase updates recorded while integrating from worker threads.
+	Vector3 deferred_motion;
+	bool deferred_motion_update = false;
+	bool deferred_shapes_update = false;
+	bool deferred_state_query = false;
+	bool deferred_deactivate = false;
+
 	void _update_transform_dependent();
 
 	friend class GodotPhysicsDirectBodyState3D; // i give up, too many functions to expose
@@ -299,6 +306,23 @@ public:
 	void set_state(PhysicsServer3D::BodyState p_state, const Variant &p_variant);
 	Variant get_state(PhysicsServer3D::BodyState p_state) const;
 
+	// Simulation state stored in space snapshots, see GodotSpace3D::save_state().
+	struct SavedState {
+		uint64_t rid = 0;
+		Transform3D transform;
+		Transform3D inv_transform;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		Vector3 prev_linear_velocity;
+		Vector3 prev_angular_velocity;
+		Vector3 applied_force;
+		Vector3 applied_torque;
+		real_t still_time = 0.0;
+	};
+
+	void save_state(SavedState &r_state) const;
+	void restore_state(const SavedState &p_state);
+
 	_FORCE_INLINE_ void set_continuous_collision_detection(bool p_enable) { continuous_cd = p_enable; }
 	_FORCE_INLINE_ bool is_continuous_collision_detection_enabled() const { return continuous_cd; }
 
@@ -316,8 +340,12 @@ public:
 	void set_axis_lock(PhysicsServer3D::BodyAxis p_axis, bool lock);
 	bool is_axis_locked(PhysicsServer3D::BodyAxis p_axis) const;
 
-	void integrate_forces(real_t p_step);
-	void integrate_velocities(real_t p_step);
+	// If `p_defer_space_updates` is true, changes to the space lists and the broadphase are only recorded,
+	// which allows integrating several bodies concurrently. They must then be applied from a single thread
+	// with `apply_deferred_space_updates()`.
+	void integrate_forces(real_t p_step, bool p_defer_space_updates = false);
+	void integrate_velocities(real_t p_step, bool p_defer_space_updates = false);
+	void apply_deferred_space_updates();
 
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
 		return linear_velocity + angular_velocity.cross(rel_pos - center_of_mass);
@@ -595,8 +595,71 @@ void GodotBodyPair3D::solve(real_t p_step) {
 	}
 }
 
+void GodotBodyPair3D::get_saved_state_key(SavedState &r_state) const {
+	r_state.body_A = A->get_self().get_id();
+	r_state.body_B = B->get_self().get_id();
+	r_state.shape_A = shape_A;
+	r_state.shape_B = shape_B;
+}
+
+void GodotBodyPair3D::save_state(SavedState &r_state) const {
+	get_saved_state_key(r_state);
+	r_state.contact_count = contact_count;
+	r_state.collided = collided;
+	r_state.sep_axis = sep_axis;
+
+	for (int i = 0; i < contact_count; i++) {
+		const Contact &c = contacts[i];
+		SavedState::SavedContact &saved = r_state.contacts[i];
+		saved.normal = c.normal;
+		saved.local_A = c.local_A;
+		saved.local_B = c.local_B;
+		saved.acc_impulse = c.acc_impulse;
+		saved.acc_tangent_impulse = c.acc_tangent_impulse;
+		saved.index_A = c.index_A;
+		saved.index_B = c.index_B;
+		saved.acc_normal_impulse = c.acc_normal_impulse;
+		saved.acc_bias_impulse = c.acc_bias_impulse;
+		saved.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
+		saved.depth = c.depth;
+		saved.active = c.active;
+	}
+}
+
+void GodotBodyPair3D::restore_state(const SavedState *p_state) {
+	if (!p_state) {
+		contact_count = 0;
+		collided = false;
+		sep_axis = Vector3();
+		return;
+	}
+
+	contact_count = CLAMP(p_state->contact_count, 0, (int)MAX_CONTACTS);
+	collided = p_state->collided;
+	sep_axis = p_state->sep_axis;
+
+	for (int i = 0; i < contact_count; i++) {
+		const SavedState::SavedContact &saved = p_state->contacts[i];
+		Contact &c = contacts[i];
+		c.normal = saved.normal;
+		c.local_A = saved.local_A;
+		c.local_B = saved.local_B;
+		c.acc_impulse = saved.acc_impulse;
+		c.acc_tangent_impulse = saved.acc_tangent_impulse;
+		c.index_A = saved.index_A;
+		c.index_B = saved.index_B;
+		c.acc_normal_impulse = saved.acc_normal_impulse;
+		c.acc_bias_impulse = saved.acc_bias_impulse;
+		c.acc_bias_impulse_center_of_mass = saved.acc_bias_impulse_center_of_mass;
+		c.depth = saved.depth;
+		c.active = saved.active;
+		c.used = false;
+	}
+}
+
 GodotBodyPair3D::GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B) :
-		GodotBodyContact3D(_arr, 2) {
+		GodotBodyContact3D(_arr, 2),
+		space_list(this) {
 	A = p_A;
 	B = p_B;
 	shape_A = p_shape_A;
@@ -100,10 +100,58 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 
 	void contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal);
 
+	SelfList<GodotBodyPair3D> space_list;
+
 	void validate_contacts();
 	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
 
 public:
+	// Contact cache stored in space snapshots, see GodotSpace3D::save_state().
+	struct SavedState {
+		uint64_t body_A = 0;
+		uint64_t body_B = 0;
+		int32_t shape_A = 0;
+		int32_t shape_B = 0;
+		int32_t contact_count = 0;
+		uint32_t collided = 0;
+		Vector3 sep_axis;
+
+		struct SavedContact {
+			Vector3 normal;
+			Vector3 local_A, local_B;
+			Vector3 acc_impulse;
+			Vector3 acc_tangent_impulse;
+			int32_t index_A = 0, index_B = 0;
+			real_t acc_normal_impulse = 0.0;
+			real_t acc_bias_impulse = 0.0;
+			real_t acc_bias_impulse_center_of_mass = 0.0;
+			real_t depth = 0.0;
+			uint32_t active = 0;
+		} contacts[MAX_CONTACTS];
+	};
+
+	struct SavedStateComparator {
+		_FORCE_INLINE_ bool operator()(const SavedState &p_a, const SavedState &p_b) const {
+			if (p_a.body_A != p_b.body_A) {
+				return p_a.body_A < p_b.body_A;
+			}
+			if (p_a.body_B != p_b.body_B) {
+				return p_a.body_B < p_b.body_B;
+			}
+			if (p_a.shape_A != p_b.shape_A) {
+				return p_a.shape_A < p_b.shape_A;
+			}
+			return p_a.shape_B < p_b.shape_B;
+		}
+	};
+
+	_FORCE_INLINE_ SelfList<GodotBodyPair3D> *get_space_list() { return &space_list; }
+
+	void get_saved_state_key(SavedState &r_state) const;
+	void save_state(SavedState &r_state) const;
+	// Passing nullptr clears the contact cache.
+	void restore_state(const SavedState *p_state);
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
@@ -65,5 +65,8 @@ public:
 
 	virtual void update() = 0;
 
+	// When enabled, update() may find the new pairs on several threads, the pair callbacks are still sent from the calling thread.
+	virtual void set_deferred_pairing(bool p_enable) {}
+
 	virtual ~GodotBroadPhase3D();
 };
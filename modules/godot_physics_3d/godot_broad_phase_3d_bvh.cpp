@@ -32,6 +32,8 @@
 
 #include "godot_collision_object_3d.h"
 
+#include "core/object/worker_thread_pool.h"
+
 GodotBroadPhase3DBVH::ID GodotBroadPhase3DBVH::create(GodotCollisionObject3D *p_object, int p_subindex, const AABB &p_aabb, bool p_static) {
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
 	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
@@ -114,8 +116,36 @@ void GodotBroadPhase3DBVH::set_unpair_callback(UnpairCallback p_unpair_callback,
 	unpair_userdata = p_userdata;
 }
 
+void GodotBroadPhase3DBVH::_cull_changed_item(uint32_t p_index, void *p_userdata) {
+	bvh.cull_changed_item(p_index);
+}
+
 void GodotBroadPhase3DBVH::update() {
-	bvh.update();
+	if (!deferred_pairing) {
+		bvh.update();
+		return;
+	}
+
+	// The tree is not modified while the changed items are culled, so the culls can run
+	// concurrently. The results are then merged in the changed items order, which gives
+	// the same pair and unpair callbacks as the single threaded update.
+	bvh.update_tree();
+
+	uint32_t changed_count = bvh.get_changed_item_count();
+	if (changed_count >= DEFERRED_PAIRING_MIN_THREADED) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotBroadPhase3DBVH::_cull_changed_item, nullptr, changed_count, -1, true, SNAME("GodotPhysics3DBroadPhasePairing"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < changed_count; i++) {
+			bvh.cull_changed_item(i);
+		}
+	}
+
+	bvh.update_collisions_culled();
+}
+
+void GodotBroadPhase3DBVH::set_deferred_pairing(bool p_enable) {
+	deferred_pairing = p_enable;
 }
 
 GodotBroadPhase3D *GodotBroadPhase3DBVH::_create() {
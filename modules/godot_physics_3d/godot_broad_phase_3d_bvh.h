@@ -67,6 +67,13 @@ class GodotBroadPhase3DBVH : public GodotBroadPhase3D {
 	static void *_pair_callback(void *, uint32_t, GodotCollisionObject3D *, int, uint32_t, GodotCollisionObject3D *, int);
 	static void _unpair_callback(void *, uint32_t, GodotCollisionObject3D *, int, uint32_t, GodotCollisionObject3D *, int, void *);
 
+	// Below this many changed items, the pairing culls are not worth dispatching to the worker threads.
+	static const uint32_t DEFERRED_PAIRING_MIN_THREADED = 64;
+
+	bool deferred_pairing = false;
+
+	void _cull_changed_item(uint32_t p_index, void *p_userdata);
+
 	PairCallback pair_callback = nullptr;
 	void *pair_userdata = nullptr;
 	UnpairCallback unpair_callback = nullptr;
@@ -91,6 +98,7 @@ public:
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) override;
 
 	virtual void update() override;
+	virtual void set_deferred_pairing(bool p_enable) override;
 
 	static GodotBroadPhase3D *_create();
 	GodotBroadPhase3DBVH();
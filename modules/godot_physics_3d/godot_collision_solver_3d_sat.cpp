@@ -31,6 +31,7 @@
 #include "godot_collision_solver_3d_sat.h"
 
 #include "gjk_epa.h"
+#include "godot_sat_kernels_3d.h"
 
 #include "core/math/geometry_3d.h"
 
@@ -314,6 +315,11 @@ static void _generate_contacts_face_face(const Vector3 *p_points_A, int p_point_
 		// make a clip plane
 
 		Plane clip(clip_normal, edge0_B);
+
+		// distances of all points to the clip plane, four at a time
+		real_t clip_dist[max_clip];
+		GodotSATKernels3D::plane_distances(clip, clipbuf_src, clipbuf_len, clip_dist);
+
 		// avoid double clip if A is edge
 		int dst_idx = 0;
 		bool edge = clipbuf_len == 2;
@@ -323,8 +329,8 @@ static void _generate_contacts_face_face(const Vector3 *p_points_A, int p_point_
 			Vector3 edge0_A = clipbuf_src[j];
 			Vector3 edge1_A = clipbuf_src[j_n];
 
-			real_t dist0 = clip.distance_to(edge0_A);
-			real_t dist1 = clip.distance_to(edge1_A);
+			real_t dist0 = clip_dist[j];
+			real_t dist1 = clip_dist[j_n];
 
 			if (dist0 <= 0) { // behind plane
 
@@ -625,6 +631,8 @@ class SeparatorAxisTest {
 	real_t margin_A = 0.0;
 	real_t margin_B = 0.0;
 	Vector3 separator_axis;
+	Vector3 queued_axes[4];
+	int queued_axis_count = 0;
 
 public:
 	Vector3 best_axis;
@@ -638,6 +646,7 @@ public:
 	}
 
 	_FORCE_INLINE_ bool test_axis(const Vector3 &p_axis) {
+		DEV_ASSERT(queued_axis_count == 0);
 		Vector3 axis = p_axis;
 
 		if (axis.is_zero_approx()) {
@@ -650,6 +659,45 @@ public:
 		shape_A->project_range(axis, *transform_A, min_A, max_A);
 		shape_B->project_range(axis, *transform_B, min_B, max_B);
 
+		return _test_axis_range(axis, min_A, max_A, min_B, max_B);
+	}
+
+	// Same as test_axis(), but the axes are projected four at a time with project_ranges().
+	// The queued axes are still tested in order, call flush_axes() after the last one.
+	_FORCE_INLINE_ bool queue_axis(const Vector3 &p_axis) {
+		Vector3 &axis = queued_axes[queued_axis_count++];
+		axis = p_axis;
+
+		if (axis.is_zero_approx()) {
+			// strange case, try an upwards separator
+			axis = Vector3(0.0, 1.0, 0.0);
+		}
+
+		if (queued_axis_count < 4) {
+			return true;
+		}
+		return flush_axes();
+	}
+
+	_FORCE_INLINE_ bool flush_axes() {
+		int count = queued_axis_count;
+		queued_axis_count = 0;
+
+		real_t min_A[4] = {}, max_A[4] = {}, min_B[4] = {}, max_B[4] = {};
+
+		shape_A->project_ranges(queued_axes, count, *transform_A, min_A, max_A);
+		shape_B->project_ranges(queued_axes, count, *transform_B, min_B, max_B);
+
+		for (int i = 0; i < count; i++) {
+			if (!_test_axis_range(queued_axes[i], min_A[i], max_A[i], min_B[i], max_B[i])) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	_FORCE_INLINE_ bool _test_axis_range(const Vector3 &axis, real_t min_A, real_t max_A, real_t min_B, real_t max_B) {
 		if (withMargin) {
 			min_A -= margin_A;
 			max_A += margin_A;
@@ -1086,7 +1134,7 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 	for (int i = 0; i < 3; i++) {
 		Vector3 axis = p_transform_a.basis.get_column(i).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -1096,7 +1144,7 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 	for (int i = 0; i < 3; i++) {
 		Vector3 axis = p_transform_b.basis.get_column(i).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -1111,7 +1159,7 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 			}
 			axis.normalize();
 
-			if (!separator.test_axis(axis)) {
+			if (!separator.queue_axis(axis)) {
 				return;
 			}
 		}
@@ -1142,7 +1190,7 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 
 		Vector3 axis_ab = (support_a - support_b);
 
-		if (!separator.test_axis(axis_ab.normalized())) {
+		if (!separator.queue_axis(axis_ab.normalized())) {
 			return;
 		}
 
@@ -1152,19 +1200,23 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 			//a ->b
 			Vector3 axis_a = p_transform_a.basis.get_column(i);
 
-			if (!separator.test_axis(axis_ab.cross(axis_a).cross(axis_a).normalized())) {
+			if (!separator.queue_axis(axis_ab.cross(axis_a).cross(axis_a).normalized())) {
 				return;
 			}
 
 			//b ->a
 			Vector3 axis_b = p_transform_b.basis.get_column(i);
 
-			if (!separator.test_axis(axis_ab.cross(axis_b).cross(axis_b).normalized())) {
+			if (!separator.queue_axis(axis_ab.cross(axis_b).cross(axis_b).normalized())) {
 				return;
 			}
 		}
 	}
 
+	if (!separator.flush_axes()) {
+		return;
+	}
+
 	separator.generate_contacts();
 }
 
@@ -1183,7 +1235,7 @@ static void _collision_box_capsule(const GodotShape3D *p_a, const Transform3D &p
 	for (int i = 0; i < 3; i++) {
 		Vector3 axis = p_transform_a.basis.get_column(i).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -1200,7 +1252,7 @@ static void _collision_box_capsule(const GodotShape3D *p_a, const Transform3D &p
 			continue;
 		}
 
-		if (!separator.test_axis(axis.normalized())) {
+		if (!separator.queue_axis(axis.normalized())) {
 			return;
 		}
 	}
@@ -1223,7 +1275,7 @@ static void _collision_box_capsule(const GodotShape3D *p_a, const Transform3D &p
 				//Vector3 axis = (point - cyl_axis * cyl_axis.dot(point)).normalized();
 				Vector3 axis = Plane(cyl_axis).project(point).normalized();
 
-				if (!separator.test_axis(axis)) {
+				if (!separator.queue_axis(axis)) {
 					return;
 				}
 			}
@@ -1248,7 +1300,7 @@ static void _collision_box_capsule(const GodotShape3D *p_a, const Transform3D &p
 		// use point to test axis
 		Vector3 point_axis = (sphere_pos - cpoint).normalized();
 
-		if (!separator.test_axis(point_axis)) {
+		if (!separator.queue_axis(point_axis)) {
 			return;
 		}
 
@@ -1257,12 +1309,16 @@ static void _collision_box_capsule(const GodotShape3D *p_a, const Transform3D &p
 		for (int j = 0; j < 3; j++) {
 			Vector3 axis = point_axis.cross(p_transform_a.basis.get_column(j)).cross(p_transform_a.basis.get_column(j)).normalized();
 
-			if (!separator.test_axis(axis)) {
+			if (!separator.queue_axis(axis)) {
 				return;
 			}
 		}
 	}
 
+	if (!separator.flush_axes()) {
+		return;
+	}
+
 	separator.generate_contacts();
 }
 
@@ -1403,7 +1459,7 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 	for (int i = 0; i < 3; i++) {
 		Vector3 axis = p_transform_a.basis.get_column(i).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -1415,7 +1471,7 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 	for (int i = 0; i < face_count; i++) {
 		Vector3 axis = b_xform_normal.xform(faces[i].plane.normal).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -1429,7 +1485,7 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 
 			Vector3 axis = e1.cross(e2).normalized();
 
-			if (!separator.test_axis(axis)) {
+			if (!separator.queue_axis(axis)) {
 				return;
 			}
 		}
@@ -1451,7 +1507,7 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 
 			Vector3 axis_ab = support_a - vtxb;
 
-			if (!separator.test_axis(axis_ab.normalized())) {
+			if (!separator.queue_axis(axis_ab.normalized())) {
 				return;
 			}
 
@@ -1461,7 +1517,7 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 				//a ->b
 				Vector3 axis_a = p_transform_a.basis.get_column(i);
 
-				if (!separator.test_axis(axis_ab.cross(axis_a).cross(axis_a).normalized())) {
+				if (!separator.queue_axis(axis_ab.cross(axis_a).cross(axis_a).normalized())) {
 					return;
 				}
 			}
@@ -1485,7 +1541,7 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 						Vector3 p2 = p_transform_b.xform(vertices[edges[e].vertex_b]);
 						Vector3 n = (p2 - p1);
 
-						if (!separator.test_axis((point - p2).cross(n).cross(n).normalized())) {
+						if (!separator.queue_axis((point - p2).cross(n).cross(n).normalized())) {
 							return;
 						}
 					}
@@ -1494,6 +1550,10 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 		}
 	}
 
+	if (!separator.flush_axes()) {
+		return;
+	}
+
 	separator.generate_contacts();
 }
 
@@ -1512,7 +1572,7 @@ static void _collision_box_face(const GodotShape3D *p_a, const Transform3D &p_tr
 
 	Vector3 normal = (vertex[0] - vertex[2]).cross(vertex[0] - vertex[1]).normalized();
 
-	if (!separator.test_axis(normal)) {
+	if (!separator.queue_axis(normal)) {
 		return;
 	}
 
@@ -1523,7 +1583,7 @@ static void _collision_box_face(const GodotShape3D *p_a, const Transform3D &p_tr
 			axis *= -1.0;
 		}
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -1539,7 +1599,7 @@ static void _collision_box_face(const GodotShape3D *p_a, const Transform3D &p_tr
 				axis *= -1.0;
 			}
 
-			if (!separator.test_axis(axis)) {
+			if (!separator.queue_axis(axis)) {
 				return;
 			}
 		}
@@ -1563,7 +1623,7 @@ static void _collision_box_face(const GodotShape3D *p_a, const Transform3D &p_tr
 				axis_ab *= -1.0;
 			}
 
-			if (!separator.test_axis(axis_ab.normalized())) {
+			if (!separator.queue_axis(axis_ab.normalized())) {
 				return;
 			}
 
@@ -1578,7 +1638,7 @@ static void _collision_box_face(const GodotShape3D *p_a, const Transform3D &p_tr
 					axis *= -1.0;
 				}
 
-				if (!separator.test_axis(axis)) {
+				if (!separator.queue_axis(axis)) {
 					return;
 				}
 			}
@@ -1608,7 +1668,7 @@ static void _collision_box_face(const GodotShape3D *p_a, const Transform3D &p_tr
 							axis *= -1.0;
 						}
 
-						if (!separator.test_axis(axis)) {
+						if (!separator.queue_axis(axis)) {
 							return;
 						}
 					}
@@ -1617,6 +1677,10 @@ static void _collision_box_face(const GodotShape3D *p_a, const Transform3D &p_tr
 		}
 	}
 
+	if (!separator.flush_axes()) {
+		return;
+	}
+
 	if (!face_B->backface_collision) {
 		if (separator.best_axis.dot(normal) < _BACKFACE_NORMAL_THRESHOLD) {
 			if (face_B->invert_backface_collision) {
@@ -1714,7 +1778,7 @@ static void _collision_capsule_convex_polygon(const GodotShape3D *p_a, const Tra
 	for (int i = 0; i < face_count; i++) {
 		Vector3 axis = b_xform_normal.xform(faces[i].plane.normal).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -1726,7 +1790,7 @@ static void _collision_capsule_convex_polygon(const GodotShape3D *p_a, const Tra
 		Vector3 edge_axis = p_transform_b.basis.xform(vertices[edges[i].vertex_a]) - p_transform_b.basis.xform(vertices[edges[i].vertex_b]);
 		Vector3 axis = edge_axis.cross(p_transform_a.basis.get_column(1)).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -1746,12 +1810,16 @@ static void _collision_capsule_convex_polygon(const GodotShape3D *p_a, const Tra
 
 			Vector3 axis = n1.cross(n2).cross(n2).normalized();
 
-			if (!separator.test_axis(axis)) {
+			if (!separator.queue_axis(axis)) {
 				return;
 			}
 		}
 	}
 
+	if (!separator.flush_axes()) {
+		return;
+	}
+
 	separator.generate_contacts();
 }
 
@@ -2073,7 +2141,7 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 	for (int i = 0; i < face_count_A; i++) {
 		Vector3 axis = a_xform_normal.xform(faces_A[i].plane.normal).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -2085,7 +2153,7 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 	for (int i = 0; i < face_count_B; i++) {
 		Vector3 axis = b_xform_normal.xform(faces_B[i].plane.normal).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -2109,7 +2177,7 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 			if (is_minkowski_face(u1, v1, -e1, -u2, -v2, -e2)) {
 				Vector3 axis = e1.cross(e2).normalized();
 
-				if (!separator.test_axis(axis)) {
+				if (!separator.queue_axis(axis)) {
 					return;
 				}
 			}
@@ -2122,7 +2190,7 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 			Vector3 va = p_transform_a.xform(vertices_A[i]);
 
 			for (int j = 0; j < vertex_count_B; j++) {
-				if (!separator.test_axis((va - p_transform_b.xform(vertices_B[j])).normalized())) {
+				if (!separator.queue_axis((va - p_transform_b.xform(vertices_B[j])).normalized())) {
 					return;
 				}
 			}
@@ -2137,7 +2205,7 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 			for (int j = 0; j < vertex_count_B; j++) {
 				Vector3 e3 = p_transform_b.xform(vertices_B[j]);
 
-				if (!separator.test_axis((e1 - e3).cross(n).cross(n).normalized())) {
+				if (!separator.queue_axis((e1 - e3).cross(n).cross(n).normalized())) {
 					return;
 				}
 			}
@@ -2151,13 +2219,17 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 			for (int j = 0; j < vertex_count_A; j++) {
 				Vector3 e3 = p_transform_a.xform(vertices_A[j]);
 
-				if (!separator.test_axis((e1 - e3).cross(n).cross(n).normalized())) {
+				if (!separator.queue_axis((e1 - e3).cross(n).cross(n).normalized())) {
 					return;
 				}
 			}
 		}
 	}
 
+	if (!separator.flush_axes()) {
+		return;
+	}
+
 	separator.generate_contacts();
 }
 
@@ -0,0 +1,248 @@
+/**************************************************************************/
+/*  godot_sat_kernels_3d.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/plane.h"
+#include "core/math/transform_3d.h"
+
+// Four-wide kernels for the separating axis tests. They compute the same
+// expressions, in the same order, as the scalar code in GodotShape3D, so
+// results only differ where the compiler contracts the scalar math.
+
+#if !defined(REAL_T_IS_DOUBLE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define GODOT_SAT_KERNELS_SSE2
+#include <emmintrin.h>
+#elif !defined(REAL_T_IS_DOUBLE) && (defined(__aarch64__) || defined(_M_ARM64))
+#define GODOT_SAT_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+class GodotSATKernels3D {
+#if defined(GODOT_SAT_KERNELS_SSE2)
+	typedef __m128 Lanes;
+	typedef __m128 Mask;
+
+	static _FORCE_INLINE_ Lanes load(const real_t *p_src) { return _mm_loadu_ps(p_src); }
+	static _FORCE_INLINE_ void store(real_t *r_dst, Lanes p_a) { _mm_storeu_ps(r_dst, p_a); }
+	static _FORCE_INLINE_ Lanes splat(real_t p_value) { return _mm_set1_ps(p_value); }
+	static _FORCE_INLINE_ Lanes add(Lanes p_a, Lanes p_b) { return _mm_add_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Lanes sub(Lanes p_a, Lanes p_b) { return _mm_sub_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Lanes mul(Lanes p_a, Lanes p_b) { return _mm_mul_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Lanes div(Lanes p_a, Lanes p_b) { return _mm_div_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Lanes sqrt(Lanes p_a) { return _mm_sqrt_ps(p_a); }
+	static _FORCE_INLINE_ Lanes abs(Lanes p_a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), p_a); }
+	static _FORCE_INLINE_ Lanes min(Lanes p_a, Lanes p_b) { return _mm_min_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Lanes max(Lanes p_a, Lanes p_b) { return _mm_max_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Mask greater(Lanes p_a, Lanes p_b) { return _mm_cmpgt_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Mask equal(Lanes p_a, Lanes p_b) { return _mm_cmpeq_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Lanes select(Mask p_mask, Lanes p_a, Lanes p_b) { return _mm_or_ps(_mm_and_ps(p_mask, p_a), _mm_andnot_ps(p_mask, p_b)); }
+#elif defined(GODOT_SAT_KERNELS_NEON)
+	typedef float32x4_t Lanes;
+	typedef uint32x4_t Mask;
+
+	static _FORCE_INLINE_ Lanes load(const real_t *p_src) { return vld1q_f32(p_src); }
+	static _FORCE_INLINE_ void store(real_t *r_dst, Lanes p_a) { vst1q_f32(r_dst, p_a); }
+	static _FORCE_INLINE_ Lanes splat(real_t p_value) { return vdupq_n_f32(p_value); }
+	static _FORCE_INLINE_ Lanes add(Lanes p_a, Lanes p_b) { return vaddq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Lanes sub(Lanes p_a, Lanes p_b) { return vsubq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Lanes mul(Lanes p_a, Lanes p_b) { return vmulq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Lanes div(Lanes p_a, Lanes p_b) { return vdivq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Lanes sqrt(Lanes p_a) { return vsqrtq_f32(p_a); }
+	static _FORCE_INLINE_ Lanes abs(Lanes p_a) { return vabsq_f32(p_a); }
+	static _FORCE_INLINE_ Lanes min(Lanes p_a, Lanes p_b) { return vminq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Lanes max(Lanes p_a, Lanes p_b) { return vmaxq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Mask greater(Lanes p_a, Lanes p_b) { return vcgtq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Mask equal(Lanes p_a, Lanes p_b) { return vceqq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Lanes select(Mask p_mask, Lanes p_a, Lanes p_b) { return vbslq_f32(p_mask, p_a, p_b); }
+#else
+	// Scalar fallback, also used when real_t is double.
+	struct Lanes {
+		real_t v[4];
+	};
+	struct Mask {
+		bool v[4];
+	};
+
+#define GODOT_SAT_KERNELS_LANEWISE(m_type, m_expr) \
+	m_type r;                                      \
+	for (int i = 0; i < 4; i++) {                  \
+		r.v[i] = m_expr;                           \
+	}                                              \
+	return r;
+
+	static _FORCE_INLINE_ Lanes load(const real_t *p_src) { GODOT_SAT_KERNELS_LANEWISE(Lanes, p_src[i]) }
+	static _FORCE_INLINE_ void store(real_t *r_dst, const Lanes &p_a) {
+		for (int i = 0; i < 4; i++) {
+			r_dst[i] = p_a.v[i];
+		}
+	}
+	static _FORCE_INLINE_ Lanes splat(real_t p_value) { GODOT_SAT_KERNELS_LANEWISE(Lanes, p_value) }
+	static _FORCE_INLINE_ Lanes add(const Lanes &p_a, const Lanes &p_b) { GODOT_SAT_KERNELS_LANEWISE(Lanes, p_a.v[i] + p_b.v[i]) }
+	static _FORCE_INLINE_ Lanes sub(const Lanes &p_a, const Lanes &p_b) { GODOT_SAT_KERNELS_LANEWISE(Lanes, p_a.v[i] - p_b.v[i]) }
+	static _FORCE_INLINE_ Lanes mul(const Lanes &p_a, const Lanes &p_b) { GODOT_SAT_KERNELS_LANEWISE(Lanes, p_a.v[i] * p_b.v[i]) }
+	static _FORCE_INLINE_ Lanes div(const Lanes &p_a, const Lanes &p_b) { GODOT_SAT_KERNELS_LANEWISE(Lanes, p_a.v[i] / p_b.v[i]) }
+	static _FORCE_INLINE_ Lanes sqrt(const Lanes &p_a) { GODOT_SAT_KERNELS_LANEWISE(Lanes, Math::sqrt(p_a.v[i])) }
+	static _FORCE_INLINE_ Lanes abs(const Lanes &p_a) { GODOT_SAT_KERNELS_LANEWISE(Lanes, Math::abs(p_a.v[i])) }
+	static _FORCE_INLINE_ Lanes min(const Lanes &p_a, const Lanes &p_b) { GODOT_SAT_KERNELS_LANEWISE(Lanes, p_a.v[i] < p_b.v[i] ? p_a.v[i] : p_b.v[i]) }
+	static _FORCE_INLINE_ Lanes max(const Lanes &p_a, const Lanes &p_b) { GODOT_SAT_KERNELS_LANEWISE(Lanes, p_a.v[i] > p_b.v[i] ? p_a.v[i] : p_b.v[i]) }
+	static _FORCE_INLINE_ Mask greater(const Lanes &p_a, const Lanes &p_b) { GODOT_SAT_KERNELS_LANEWISE(Mask, p_a.v[i] > p_b.v[i]) }
+	static _FORCE_INLINE_ Mask equal(const Lanes &p_a, const Lanes &p_b) { GODOT_SAT_KERNELS_LANEWISE(Mask, p_a.v[i] == p_b.v[i]) }
+	static _FORCE_INLINE_ Lanes select(const Mask &p_mask, const Lanes &p_a, const Lanes &p_b) { GODOT_SAT_KERNELS_LANEWISE(Lanes, p_mask.v[i] ? p_a.v[i] : p_b.v[i]) }
+
+#undef GODOT_SAT_KERNELS_LANEWISE
+#endif
+
+	struct Vector3Lanes {
+		Lanes x;
+		Lanes y;
+		Lanes z;
+	};
+
+	// Loads up to four vectors, unused lanes are zero.
+	static _FORCE_INLINE_ Vector3Lanes load_vectors(const Vector3 *p_vectors, int p_count) {
+		real_t x[4] = {};
+		real_t y[4] = {};
+		real_t z[4] = {};
+		for (int i = 0; i < p_count; i++) {
+			x[i] = p_vectors[i].x;
+			y[i] = p_vectors[i].y;
+			z[i] = p_vectors[i].z;
+		}
+		return { load(x), load(y), load(z) };
+	}
+
+	static _FORCE_INLINE_ void store_count(real_t *r_dst, const Lanes &p_a, int p_count) {
+		real_t values[4];
+		store(values, p_a);
+		for (int i = 0; i < p_count; i++) {
+			r_dst[i] = values[i];
+		}
+	}
+
+	// Same as Vector3::dot() with a constant vector.
+	static _FORCE_INLINE_ Lanes dot(const Vector3Lanes &p_a, const Vector3 &p_b) {
+		return add(add(mul(p_a.x, splat(p_b.x)), mul(p_a.y, splat(p_b.y))), mul(p_a.z, splat(p_b.z)));
+	}
+
+	// Same as Basis::xform_inv().
+	static _FORCE_INLINE_ Vector3Lanes basis_xform_inv(const Basis &p_basis, const Vector3Lanes &p_v) {
+		const Vector3 *rows = p_basis.rows;
+		return {
+			add(add(mul(splat(rows[0][0]), p_v.x), mul(splat(rows[1][0]), p_v.y)), mul(splat(rows[2][0]), p_v.z)),
+			add(add(mul(splat(rows[0][1]), p_v.x), mul(splat(rows[1][1]), p_v.y)), mul(splat(rows[2][1]), p_v.z)),
+			add(add(mul(splat(rows[0][2]), p_v.x), mul(splat(rows[1][2]), p_v.y)), mul(splat(rows[2][2]), p_v.z)),
+		};
+	}
+
+public:
+	// GodotBoxShape3D::project_range() for up to four normals.
+	static _FORCE_INLINE_ void project_box(const Vector3 *p_normals, int p_count, const Transform3D &p_transform, const Vector3 &p_half_extents, real_t *r_min, real_t *r_max) {
+		Vector3Lanes normal = load_vectors(p_normals, p_count);
+		Vector3Lanes local_normal = basis_xform_inv(p_transform.basis, normal);
+
+		// no matter the angle, the box is mirrored anyway
+		Lanes length = add(add(mul(abs(local_normal.x), splat(p_half_extents.x)), mul(abs(local_normal.y), splat(p_half_extents.y))), mul(abs(local_normal.z), splat(p_half_extents.z)));
+		Lanes distance = dot(normal, p_transform.origin);
+
+		store_count(r_min, sub(distance, length), p_count);
+		store_count(r_max, add(distance, length), p_count);
+	}
+
+	// GodotCapsuleShape3D::project_range() for up to four normals.
+	static _FORCE_INLINE_ void project_capsule(const Vector3 *p_normals, int p_count, const Transform3D &p_transform, real_t p_radius, real_t p_height, real_t *r_min, real_t *r_max) {
+		Vector3Lanes normal = load_vectors(p_normals, p_count);
+		Vector3Lanes n = basis_xform_inv(p_transform.basis, normal);
+
+		// Vector3::normalized(), zero length stays zero.
+		Lanes length_squared = add(add(mul(n.x, n.x), mul(n.y, n.y)), mul(n.z, n.z));
+		Mask is_zero = equal(length_squared, splat(0));
+		Lanes length = sqrt(length_squared);
+		Lanes zero = splat(0);
+		n.x = select(is_zero, zero, div(n.x, length));
+		n.y = select(is_zero, zero, div(n.y, length));
+		n.z = select(is_zero, zero, div(n.z, length));
+
+		Lanes radius = splat(p_radius);
+		n.x = mul(n.x, radius);
+		n.y = mul(n.y, radius);
+		n.z = mul(n.z, radius);
+
+		real_t h = p_height * 0.5 - p_radius;
+		n.y = add(n.y, select(greater(n.y, zero), splat(h), splat(-h)));
+
+		// Transform3D::xform() of n and -n.
+		const Vector3 *rows = p_transform.basis.rows;
+		Lanes bx = dot(n, rows[0]);
+		Lanes by = dot(n, rows[1]);
+		Lanes bz = dot(n, rows[2]);
+		const Vector3 &origin = p_transform.origin;
+
+		Vector3Lanes point_max = { add(bx, splat(origin.x)), add(by, splat(origin.y)), add(bz, splat(origin.z)) };
+		Vector3Lanes point_min = { sub(splat(origin.x), bx), sub(splat(origin.y), by), sub(splat(origin.z), bz) };
+
+		store_count(r_max, add(add(mul(normal.x, point_max.x), mul(normal.y, point_max.y)), mul(normal.z, point_max.z)), p_count);
+		store_count(r_min, add(add(mul(normal.x, point_min.x), mul(normal.y, point_min.y)), mul(normal.z, point_min.z)), p_count);
+	}
+
+	// Projects a point cloud on up to four normals, each point is only transformed once.
+	static _FORCE_INLINE_ void project_points(const Vector3 *p_normals, int p_count, const Transform3D &p_transform, const Vector3 *p_points, int p_point_count, real_t *r_min, real_t *r_max) {
+		if (p_point_count == 0) {
+			return;
+		}
+
+		Vector3Lanes normal = load_vectors(p_normals, p_count);
+
+		Vector3 point = p_transform.xform(p_points[0]);
+		Lanes d = add(add(mul(normal.x, splat(point.x)), mul(normal.y, splat(point.y))), mul(normal.z, splat(point.z)));
+		Lanes range_min = d;
+		Lanes range_max = d;
+
+		for (int i = 1; i < p_point_count; i++) {
+			point = p_transform.xform(p_points[i]);
+			d = add(add(mul(normal.x, splat(point.x)), mul(normal.y, splat(point.y))), mul(normal.z, splat(point.z)));
+			range_min = min(range_min, d);
+			range_max = max(range_max, d);
+		}
+
+		store_count(r_min, range_min, p_count);
+		store_count(r_max, range_max, p_count);
+	}
+
+	// Plane::distance_to() for any number of points.
+	static _FORCE_INLINE_ void plane_distances(const Plane &p_plane, const Vector3 *p_points, int p_point_count, real_t *r_distances) {
+		Lanes d = splat(p_plane.d);
+		for (int i = 0; i < p_point_count; i += 4) {
+			int count = MIN(4, p_point_count - i);
+			Vector3Lanes points = load_vectors(&p_points[i], count);
+			store_count(&r_distances[i], sub(dot(points, p_plane.normal), d), count);
+		}
+	}
+};
@@ -30,6 +30,8 @@
 
 #include "godot_shape_3d.h"
 
+#include "godot_sat_kernels_3d.h"
+
 #include "core/io/image.h"
 #include "core/math/convex_hull.h"
 #include "core/math/geometry_3d.h"
@@ -82,6 +84,12 @@ Vector3 GodotShape3D::get_support(const Vector3 &p_normal) const {
 	return res;
 }
 
+void GodotShape3D::project_ranges(const Vector3 *p_normals, int p_count, const Transform3D &p_transform, real_t *r_min, real_t *r_max) const {
+	for (int i = 0; i < p_count; i++) {
+		project_range(p_normals[i], p_transform, r_min[i], r_max[i]);
+	}
+}
+
 void GodotShape3D::add_owner(GodotShapeOwner3D *p_owner) {
 	HashMap<GodotShapeOwner3D *, int>::Iterator E = owners.find(p_owner);
 	if (E) {
@@ -320,6 +328,10 @@ void GodotBoxShape3D::project_range(const Vector3 &p_normal, const Transform3D &
 	r_max = distance + length;
 }
 
+void GodotBoxShape3D::project_ranges(const Vector3 *p_normals, int p_count, const Transform3D &p_transform, real_t *r_min, real_t *r_max) const {
+	GodotSATKernels3D::project_box(p_normals, p_count, p_transform, half_extents, r_min, r_max);
+}
+
 Vector3 GodotBoxShape3D::get_support(const Vector3 &p_normal) const {
 	Vector3 point(
 			(p_normal.x < 0) ? -half_extents.x : half_extents.x,
@@ -504,6 +516,10 @@ void GodotCapsuleShape3D::project_range(const Vector3 &p_normal, const Transform
 	r_min = p_normal.dot(p_transform.xform(-n));
 }
 
+void GodotCapsuleShape3D::project_ranges(const Vector3 *p_normals, int p_count, const Transform3D &p_transform, real_t *r_min, real_t *r_max) const {
+	GodotSATKernels3D::project_capsule(p_normals, p_count, p_transform, radius, height, r_min, r_max);
+}
+
 Vector3 GodotCapsuleShape3D::get_support(const Vector3 &p_normal) const {
 	Vector3 n = p_normal;
 
@@ -836,6 +852,17 @@ void GodotConvexPolygonShape3D::project_range(const Vector3 &p_normal, const Tra
 	}
 }
 
+void GodotConvexPolygonShape3D::project_ranges(const Vector3 *p_normals, int p_count, const Transform3D &p_transform, real_t *r_min, real_t *r_max) const {
+	uint32_t vertex_count = mesh.vertices.size();
+	if (vertex_count > 3 * extreme_vertices.size()) {
+		// Large meshes use get_support(), see project_range().
+		GodotShape3D::project_ranges(p_normals, p_count, p_transform, r_min, r_max);
+		return;
+	}
+
+	GodotSATKernels3D::project_points(p_normals, p_count, p_transform, mesh.vertices.ptr(), vertex_count, r_min, r_max);
+}
+
 Vector3 GodotConvexPolygonShape3D::get_support(const Vector3 &p_normal) const {
 	// Skip if there are no vertices in the mesh
 	if (mesh.vertices.is_empty()) {
@@ -1169,6 +1196,10 @@ void GodotFaceShape3D::project_range(const Vector3 &p_normal, const Transform3D
 	}
 }
 
+void GodotFaceShape3D::project_ranges(const Vector3 *p_normals, int p_count, const Transform3D &p_transform, real_t *r_min, real_t *r_max) const {
+	GodotSATKernels3D::project_points(p_normals, p_count, p_transform, vertex, 3, r_min, r_max);
+}
+
 Vector3 GodotFaceShape3D::get_support(const Vector3 &p_normal) const {
 	int vert_support_idx = -1;
 	real_t support_max = 0;
@@ -33,6 +33,7 @@
 #include "godot_space_3d.h"
 
 #include "core/math/geometry_3d.h"
+#include "core/object/worker_thread_pool.h"
 #include "servers/rendering_server.h"
 
 // Based on Bullet soft body.
@@ -158,10 +159,9 @@ void GodotSoftBody3D::update_rendering_server(PhysicsServer3DRenderingServerHand
 	const uint32_t vertex_count = map_visual_to_physics.size();
 	for (uint32_t i = 0; i < vertex_count; ++i) {
 		const uint32_t node_index = map_visual_to_physics[i];
-		const Node &node = nodes[node_index];
 
-		p_rendering_server_handler->set_vertex(i, node.x);
-		p_rendering_server_handler->set_normal(i, node.n);
+		p_rendering_server_handler->set_vertex(i, node_positions[node_index]);
+		p_rendering_server_handler->set_normal(i, nodes[node_index].n);
 	}
 
 	p_rendering_server_handler->set_aabb(bounds);
@@ -173,13 +173,16 @@ void GodotSoftBody3D::update_normals_and_centroids() {
 	}
 
 	for (Face &face : faces) {
-		const Vector3 n = vec3_cross(face.n[0]->x - face.n[2]->x, face.n[0]->x - face.n[1]->x);
-		face.n[0]->n += n;
-		face.n[1]->n += n;
-		face.n[2]->n += n;
+		const Vector3 &x0 = node_positions[face.n[0]];
+		const Vector3 &x1 = node_positions[face.n[1]];
+		const Vector3 &x2 = node_positions[face.n[2]];
+		const Vector3 n = vec3_cross(x0 - x2, x0 - x1);
+		nodes[face.n[0]].n += n;
+		nodes[face.n[1]].n += n;
+		nodes[face.n[2]].n += n;
 		face.normal = n;
 		face.normal.normalize();
-		face.centroid = 0.33333333333 * (face.n[0]->x + face.n[1]->x + face.n[2]->x);
+		face.centroid = 0.33333333333 * (x0 + x1 + x2);
 	}
 
 	for (Node &node : nodes) {
@@ -190,7 +193,7 @@ void GodotSoftBody3D::update_normals_and_centroids() {
 	}
 }
 
-void GodotSoftBody3D::update_bounds() {
+void GodotSoftBody3D::update_bounds(bool p_defer_shape_update) {
 	AABB prev_bounds = bounds;
 	prev_bounds.grow_by(collision_margin);
 
@@ -198,26 +201,33 @@ void GodotSoftBody3D::update_bounds() {
 
 	const uint32_t nodes_count = nodes.size();
 	if (nodes_count == 0) {
-		deinitialize_shape();
+		if (p_defer_shape_update) {
+			shape_update_pending = true;
+		} else {
+			deinitialize_shape();
+		}
 		return;
 	}
 
 	bool first = true;
 	bool moved = false;
 	for (uint32_t node_index = 0; node_index < nodes_count; ++node_index) {
-		const Node &node = nodes[node_index];
-		if (!prev_bounds.has_point(node.x)) {
+		const Vector3 &position = node_positions[node_index];
+		if (!prev_bounds.has_point(position)) {
 			moved = true;
 		}
 		if (first) {
-			bounds.position = node.x;
+			bounds.position = position;
 			first = false;
 		} else {
-			bounds.expand_to(node.x);
+			bounds.expand_to(position);
 		}
 	}
 
-	if (get_space()) {
+	if (p_defer_shape_update) {
+		shape_update_pending = true;
+		shape_update_moved = moved;
+	} else if (get_space()) {
 		initialize_shape(moved);
 	}
 }
@@ -233,9 +243,9 @@ void GodotSoftBody3D::update_area() {
 
 	// Face area.
 	for (Face &face : faces) {
-		const Vector3 &x0 = face.n[0]->x;
-		const Vector3 &x1 = face.n[1]->x;
-		const Vector3 &x2 = face.n[2]->x;
+		const Vector3 &x0 = node_positions[face.n[0]];
+		const Vector3 &x1 = node_positions[face.n[1]];
+		const Vector3 &x2 = node_positions[face.n[2]];
 
 		const Vector3 a = x1 - x0;
 		const Vector3 b = x2 - x0;
@@ -256,9 +266,9 @@ void GodotSoftBody3D::update_area() {
 
 	for (const Face &face : faces) {
 		for (int j = 0; j < 3; ++j) {
-			const int index = (int)(face.n[j] - &nodes[0]);
+			const uint32_t index = face.n[j];
 			counts[index]++;
-			face.n[j]->area += Math::abs(face.ra);
+			nodes[index].area += Math::abs(face.ra);
 		}
 	}
 
@@ -274,7 +284,7 @@ void GodotSoftBody3D::update_area() {
 void GodotSoftBody3D::reset_link_rest_lengths() {
 	float multiplier = 1.0 - shrinking_factor;
 	for (Link &link : links) {
-		link.rl = (link.n[0]->x - link.n[1]->x).length();
+		link.rl = (node_positions[link.n[0]] - node_positions[link.n[1]]).length();
 		link.rl *= multiplier;
 		link.c1 = link.rl * link.rl;
 	}
@@ -283,7 +293,7 @@ void GodotSoftBody3D::reset_link_rest_lengths() {
 void GodotSoftBody3D::update_link_constants() {
 	real_t inv_linear_stiffness = 1.0 / linear_stiffness;
 	for (Link &link : links) {
-		link.c0 = (link.n[0]->im + link.n[1]->im) * inv_linear_stiffness;
+		link.c0 = (node_inv_masses[link.n[0]] + node_inv_masses[link.n[1]]) * inv_linear_stiffness;
 	}
 }
 
@@ -296,13 +306,14 @@ void GodotSoftBody3D::apply_nodes_transform(const Transform3D &p_transform) {
 	Vector3 leaf_size = Vector3(collision_margin, collision_margin, collision_margin) * 2.0;
 	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
 		Node &node = nodes[node_index];
+		Vector3 &position = node_positions[node_index];
 
-		node.x = p_transform.xform(node.x);
-		node.q = node.x;
-		node.v = Vector3();
+		position = p_transform.xform(position);
+		node.q = position;
+		node_velocities[node_index] = Vector3();
 		node.bv = Vector3();
 
-		AABB node_aabb(node.x, leaf_size);
+		AABB node_aabb(position, leaf_size);
 		node_tree.update(node.leaf, node_aabb);
 	}
 
@@ -324,7 +335,7 @@ Vector3 GodotSoftBody3D::get_vertex_position(int p_index) const {
 	uint32_t node_index = map_visual_to_physics[p_index];
 
 	ERR_FAIL_COND_V(node_index >= nodes.size(), Vector3());
-	return nodes[node_index].x;
+	return node_positions[node_index];
 }
 
 void GodotSoftBody3D::set_vertex_position(int p_index, const Vector3 &p_position) {
@@ -338,9 +349,8 @@ void GodotSoftBody3D::set_vertex_position(int p_index, const Vector3 &p_position
 	uint32_t node_index = map_visual_to_physics[p_index];
 
 	ERR_FAIL_COND(node_index >= nodes.size());
-	Node &node = nodes[node_index];
-	node.q = node.x;
-	node.x = p_position;
+	nodes[node_index].q = node_positions[node_index];
+	node_positions[node_index] = p_position;
 }
 
 void GodotSoftBody3D::pin_vertex(int p_index) {
@@ -357,8 +367,7 @@ void GodotSoftBody3D::pin_vertex(int p_index) {
 		uint32_t node_index = map_visual_to_physics[p_index];
 
 		ERR_FAIL_COND(node_index >= nodes.size());
-		Node &node = nodes[node_index];
-		node.im = 0.0;
+		node_inv_masses[node_index] = 0.0;
 	}
 }
 
@@ -377,8 +386,7 @@ void GodotSoftBody3D::unpin_vertex(int p_index) {
 				ERR_FAIL_COND(node_index >= nodes.size());
 				real_t inv_node_mass = nodes.size() * inv_total_mass;
 
-				Node &node = nodes[node_index];
-				node.im = inv_node_mass;
+				node_inv_masses[node_index] = inv_node_mass;
 			}
 
 			return;
@@ -397,8 +405,7 @@ void GodotSoftBody3D::unpin_all_vertices() {
 			uint32_t node_index = map_visual_to_physics[pinned_vertex];
 
 			ERR_CONTINUE(node_index >= nodes.size());
-			Node &node = nodes[node_index];
-			node.im = inv_node_mass;
+			node_inv_masses[node_index] = inv_node_mass;
 		}
 	}
 
@@ -424,17 +431,17 @@ uint32_t GodotSoftBody3D::get_node_count() const {
 
 real_t GodotSoftBody3D::get_node_inv_mass(uint32_t p_node_index) const {
 	ERR_FAIL_UNSIGNED_INDEX_V(p_node_index, nodes.size(), 0.0);
-	return nodes[p_node_index].im;
+	return node_inv_masses[p_node_index];
 }
 
 Vector3 GodotSoftBody3D::get_node_position(uint32_t p_node_index) const {
 	ERR_FAIL_UNSIGNED_INDEX_V(p_node_index, nodes.size(), Vector3());
-	return nodes[p_node_index].x;
+	return node_positions[p_node_index];
 }
 
 Vector3 GodotSoftBody3D::get_node_velocity(uint32_t p_node_index) const {
 	ERR_FAIL_UNSIGNED_INDEX_V(p_node_index, nodes.size(), Vector3());
-	return nodes[p_node_index].v;
+	return node_velocities[p_node_index];
 }
 
 Vector3 GodotSoftBody3D::get_node_biased_velocity(uint32_t p_node_index) const {
@@ -444,8 +451,7 @@ Vector3 GodotSoftBody3D::get_node_biased_velocity(uint32_t p_node_index) const {
 
 void GodotSoftBody3D::apply_node_impulse(uint32_t p_node_index, const Vector3 &p_impulse) {
 	ERR_FAIL_UNSIGNED_INDEX(p_node_index, nodes.size());
-	Node &node = nodes[p_node_index];
-	node.v += p_impulse * node.im;
+	node_velocities[p_node_index] += p_impulse * node_inv_masses[p_node_index];
 }
 
 void GodotSoftBody3D::apply_node_force(uint32_t p_node_index, const Vector3 &p_force) {
@@ -456,26 +462,28 @@ void GodotSoftBody3D::apply_node_force(uint32_t p_node_index, const Vector3 &p_f
 
 void GodotSoftBody3D::apply_central_impulse(const Vector3 &p_impulse) {
 	const Vector3 impulse = p_impulse / nodes.size();
-	for (Node &node : nodes) {
-		if (node.im > 0) {
-			node.v += impulse * node.im;
+	const uint32_t node_count = nodes.size();
+	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+		const real_t im = node_inv_masses[node_index];
+		if (im > 0) {
+			node_velocities[node_index] += impulse * im;
 		}
 	}
 }
 
 void GodotSoftBody3D::apply_central_force(const Vector3 &p_force) {
 	const Vector3 force = p_force / nodes.size();
-	for (Node &node : nodes) {
-		if (node.im > 0) {
-			node.f += force;
+	const uint32_t node_count = nodes.size();
+	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+		if (node_inv_masses[node_index] > 0) {
+			nodes[node_index].f += force;
 		}
 	}
 }
 
 void GodotSoftBody3D::apply_node_bias_impulse(uint32_t p_node_index, const Vector3 &p_impulse) {
 	ERR_FAIL_UNSIGNED_INDEX(p_node_index, nodes.size());
-	Node &node = nodes[p_node_index];
-	node.bv += p_impulse * node.im;
+	nodes[p_node_index].bv += p_impulse * node_inv_masses[p_node_index];
 }
 
 uint32_t GodotSoftBody3D::get_face_count() const {
@@ -485,9 +493,9 @@ uint32_t GodotSoftBody3D::get_face_count() const {
 void GodotSoftBody3D::get_face_points(uint32_t p_face_index, Vector3 &r_point_1, Vector3 &r_point_2, Vector3 &r_point_3) const {
 	ERR_FAIL_UNSIGNED_INDEX(p_face_index, faces.size());
 	const Face &face = faces[p_face_index];
-	r_point_1 = face.n[0]->x;
-	r_point_2 = face.n[1]->x;
-	r_point_3 = face.n[2]->x;
+	r_point_1 = node_positions[face.n[0]];
+	r_point_2 = node_positions[face.n[1]];
+	r_point_3 = node_positions[face.n[2]];
 }
 
 Vector3 GodotSoftBody3D::get_face_normal(uint32_t p_face_index) const {
@@ -555,16 +563,20 @@ bool GodotSoftBody3D::create_from_trimesh(const Vector<int> &p_indices, const Ve
 
 	// Create nodes from vertices.
 	nodes.resize(node_count);
+	node_positions.resize(node_count);
+	node_velocities.resize(node_count);
+	node_inv_masses.resize(node_count);
 	real_t inv_node_mass = node_count * inv_total_mass;
 	Vector3 leaf_size = Vector3(collision_margin, collision_margin, collision_margin) * 2.0;
 	for (uint32_t i = 0; i < node_count; ++i) {
 		Node &node = nodes[i];
 		node.s = vertices[i];
-		node.x = node.s;
 		node.q = node.s;
-		node.im = inv_node_mass;
+		node_positions[i] = node.s;
+		node_velocities[i] = Vector3();
+		node_inv_masses[i] = inv_node_mass;
 
-		AABB node_aabb(node.x, leaf_size);
+		AABB node_aabb(node.s, leaf_size);
 		node.leaf = node_tree.insert(node_aabb, &node);
 
 		node.index = i;
@@ -601,8 +613,7 @@ bool GodotSoftBody3D::create_from_trimesh(const Vector<int> &p_indices, const Ve
 		uint32_t node_index = map_visual_to_physics[pinned_vertex];
 
 		ERR_CONTINUE(node_index >= node_count);
-		Node &node = nodes[node_index];
-		node.im = 0.0;
+		node_inv_masses[node_index] = 0.0;
 	}
 
 	generate_bending_constraints(2);
@@ -638,8 +649,8 @@ void GodotSoftBody3D::generate_bending_constraints(int p_distance) {
 			}
 		}
 		for (Link &link : links) {
-			const int ia = (int)(link.n[0] - &nodes[0]);
-			const int ib = (int)(link.n[1] - &nodes[0]);
+			const int ia = link.n[0];
+			const int ib = link.n[1];
 			int idx = ib * n + ia;
 			int idx_inv = ia * n + ib;
 			adj[idx] = 1;
@@ -654,8 +665,8 @@ void GodotSoftBody3D::generate_bending_constraints(int p_distance) {
 			node_links.resize(nodes.size());
 
 			for (Link &link : links) {
-				const int ia = (int)(link.n[0] - &nodes[0]);
-				const int ib = (int)(link.n[1] - &nodes[0]);
+				const int ia = link.n[0];
+				const int ib = link.n[1];
 				if (!node_links[ia].has(ib)) {
 					node_links[ia].push_back(ib);
 				}
@@ -749,8 +760,6 @@ void GodotSoftBody3D::reoptimize_link_order() {
 	uint32_t i;
 	Link *lr;
 	int ar, br;
-	Node *node0 = &(nodes[0]);
-	Node *node1 = &(nodes[1]);
 	LinkDepsPtr link_dep;
 	int ready_list_head, ready_list_tail, link_num, link_dep_frees, dep_link;
 
@@ -779,8 +788,8 @@ void GodotSoftBody3D::reoptimize_link_order() {
 	for (i = 0; i < link_count; i++) {
 		// Note which prior link calculations we are dependent upon & build up dependence lists.
 		lr = &(links[i]);
-		ar = (lr->n[0] - node0) / (node1 - node0);
-		br = (lr->n[1] - node0) / (node1 - node0);
+		ar = lr->n[0];
+		br = lr->n[1];
 		if (node_written_at[ar] > reop_not_dependent) {
 			link_dep_A[i] = node_written_at[ar];
 			link_dep = &link_dep_free_list[link_dep_frees++];
@@ -849,6 +858,8 @@ void GodotSoftBody3D::reoptimize_link_order() {
 	memdelete_arr(link_dep_free_list);
 	memdelete_arr(link_dep_list_starts);
 	memdelete_arr(link_buffer);
+
+	link_colors_dirty = true;
 }
 
 void GodotSoftBody3D::append_link(uint32_t p_node1, uint32_t p_node2) {
@@ -856,16 +867,14 @@ void GodotSoftBody3D::append_link(uint32_t p_node1, uint32_t p_node2) {
 		return;
 	}
 
-	Node *node1 = &nodes[p_node1];
-	Node *node2 = &nodes[p_node2];
-
 	Link link;
-	link.n[0] = node1;
-	link.n[1] = node2;
-	link.rl = (node1->x - node2->x).length();
+	link.n[0] = p_node1;
+	link.n[1] = p_node2;
+	link.rl = (node_positions[p_node1] - node_positions[p_node2]).length();
 	link.rl *= 1.0 - shrinking_factor;
 
 	links.push_back(link);
+	link_colors_dirty = true;
 }
 
 void GodotSoftBody3D::append_face(uint32_t p_node1, uint32_t p_node2, uint32_t p_node3) {
@@ -879,14 +888,10 @@ void GodotSoftBody3D::append_face(uint32_t p_node1, uint32_t p_node2, uint32_t p
 		return;
 	}
 
-	Node *node1 = &nodes[p_node1];
-	Node *node2 = &nodes[p_node2];
-	Node *node3 = &nodes[p_node3];
-
 	Face face;
-	face.n[0] = node1;
-	face.n[1] = node2;
-	face.n[2] = node3;
+	face.n[0] = p_node1;
+	face.n[1] = p_node2;
+	face.n[2] = p_node3;
 
 	face.index = faces.size();
 
@@ -906,8 +911,7 @@ void GodotSoftBody3D::set_total_mass(real_t p_val) {
 
 	uint32_t node_count = nodes.size();
 	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
-		Node &node = nodes[node_index];
-		node.im *= mass_factor;
+		node_inv_masses[node_index] *= mass_factor;
 	}
 
 	update_constants();
@@ -938,9 +942,10 @@ void GodotSoftBody3D::set_drag_coefficient(real_t p_val) {
 }
 
 void GodotSoftBody3D::add_velocity(const Vector3 &p_velocity) {
-	for (Node &node : nodes) {
-		if (node.im > 0) {
-			node.v += p_velocity;
+	const uint32_t node_count = nodes.size();
+	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+		if (node_inv_masses[node_index] > 0) {
+			node_velocities[node_index] += p_velocity;
 		}
 	}
 }
@@ -953,14 +958,14 @@ void GodotSoftBody3D::apply_forces(const LocalVector<GodotArea3D *> &p_wind_area
 	int32_t j;
 
 	real_t volume = 0.0;
-	const Vector3 &org = nodes[0].x;
+	const Vector3 &org = node_positions[0];
 
 	// Iterate over faces (try not to iterate elsewhere if possible).
 	for (const Face &face : faces) {
 		Vector3 wind_force(0, 0, 0);
 
 		// Compute volume.
-		volume += vec3_dot(face.n[0]->x - org, vec3_cross(face.n[1]->x - org, face.n[2]->x - org));
+		volume += vec3_dot(node_positions[face.n[0]] - org, vec3_cross(node_positions[face.n[1]] - org, node_positions[face.n[2]] - org));
 
 		// Compute nodal forces from area winds.
 		if (!p_wind_areas.is_empty()) {
@@ -969,8 +974,7 @@ void GodotSoftBody3D::apply_forces(const LocalVector<GodotArea3D *> &p_wind_area
 			}
 
 			for (j = 0; j < 3; j++) {
-				Node *current_node = face.n[j];
-				current_node->f += wind_force;
+				nodes[face.n[j]].f += wind_force;
 			}
 		}
 	}
@@ -979,8 +983,10 @@ void GodotSoftBody3D::apply_forces(const LocalVector<GodotArea3D *> &p_wind_area
 	// Apply nodal pressure forces.
 	if (pressure_coefficient > CMP_EPSILON) {
 		real_t ivolumetp = 1.0 / Math::abs(volume) * pressure_coefficient;
-		for (Node &node : nodes) {
-			if (node.im > 0) {
+		const uint32_t node_count = nodes.size();
+		for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+			if (node_inv_masses[node_index] > 0) {
+				Node &node = nodes[node_index];
 				node.f += node.n * (node.area * ivolumetp);
 			}
 		}
@@ -999,7 +1005,7 @@ Vector3 GodotSoftBody3D::_compute_area_windforce(const GodotArea3D *p_area, cons
 	return nodal_force_magnitude * p_face->normal;
 }
 
-void GodotSoftBody3D::predict_motion(real_t p_delta) {
+void GodotSoftBody3D::predict_motion(real_t p_delta, bool p_defer_shape_update) {
 	const real_t inv_delta = 1.0 / p_delta;
 
 	ERR_FAIL_NULL(get_space());
@@ -1064,27 +1070,32 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 	real_t clamp_delta_v = max_displacement * inv_delta;
 
 	// Integrate.
-	for (Node &node : nodes) {
-		node.q = node.x;
-		Vector3 delta_v = node.f * node.im * p_delta;
+	const uint32_t node_count = nodes.size();
+	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+		Node &node = nodes[node_index];
+		Vector3 &position = node_positions[node_index];
+		Vector3 &velocity = node_velocities[node_index];
+		node.q = position;
+		Vector3 delta_v = node.f * node_inv_masses[node_index] * p_delta;
 		for (int c = 0; c < 3; c++) {
 			delta_v[c] = CLAMP(delta_v[c], -clamp_delta_v, clamp_delta_v);
 		}
-		node.v += delta_v;
-		node.x += node.v * p_delta;
+		velocity += delta_v;
+		position += velocity * p_delta;
 		node.f = Vector3();
 	}
 
 	// Bounds and tree update.
-	update_bounds();
+	update_bounds(p_defer_shape_update);
 
 	// Node tree update.
-	for (const Node &node : nodes) {
-		AABB node_aabb(node.x, Vector3());
-		node_aabb.expand_to(node.x + node.v * p_delta);
+	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+		const Vector3 &position = node_positions[node_index];
+		AABB node_aabb(position, Vector3());
+		node_aabb.expand_to(position + node_velocities[node_index] * p_delta);
 		node_aabb.grow_by(collision_margin);
 
-		node_tree.update(node.leaf, node_aabb);
+		node_tree.update(nodes[node_index].leaf, node_aabb);
 	}
 
 	// Face tree update.
@@ -1097,50 +1108,133 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 	face_tree.optimize_incremental(1);
 }
 
-void GodotSoftBody3D::solve_constraints(real_t p_delta) {
+void GodotSoftBody3D::solve_constraints(real_t p_delta, bool p_parallel_links) {
 	const real_t inv_delta = 1.0 / p_delta;
 
 	for (Link &link : links) {
-		link.c3 = link.n[1]->q - link.n[0]->q;
+		link.c3 = nodes[link.n[1]].q - nodes[link.n[0]].q;
 		link.c2 = 1 / (link.c3.length_squared() * link.c0);
 	}
 
+	const uint32_t node_count = nodes.size();
+
 	// Solve velocities.
-	for (Node &node : nodes) {
-		node.x = node.q + node.v * p_delta;
+	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+		node_positions[node_index] = nodes[node_index].q + node_velocities[node_index] * p_delta;
 	}
 
 	// Solve positions.
+	const bool parallel_links = p_parallel_links && links.size() >= PARALLEL_LINKS_MIN_COUNT;
+	if (parallel_links && link_colors_dirty) {
+		update_link_colors();
+	}
 	for (int isolve = 0; isolve < iteration_count; ++isolve) {
 		const real_t ti = isolve / (real_t)iteration_count;
-		solve_links(1.0, ti);
+		if (parallel_links) {
+			solve_links_colored(1.0, ti);
+		} else {
+			solve_links(1.0, ti);
+		}
 	}
 	const real_t vc = (1.0 - damping_coefficient) * inv_delta;
-	for (Node &node : nodes) {
-		node.x += node.bv * p_delta;
+	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+		Node &node = nodes[node_index];
+		Vector3 &position = node_positions[node_index];
+		position += node.bv * p_delta;
 		node.bv = Vector3();
 
-		node.v = (node.x - node.q) * vc;
+		node_velocities[node_index] = (position - node.q) * vc;
 
-		node.q = node.x;
+		node.q = position;
 	}
 
 	update_normals_and_centroids();
 }
 
 void GodotSoftBody3D::solve_links(real_t kst, real_t ti) {
-	for (Link &link : links) {
-		if (link.c0 > 0) {
-			Node &node_a = *link.n[0];
-			Node &node_b = *link.n[1];
-			const Vector3 del = node_b.x - node_a.x;
-			const real_t len = del.length_squared();
-			if (link.c1 + len > CMP_EPSILON) {
-				const real_t k = ((link.c1 - len) / (link.c0 * (link.c1 + len))) * kst;
-				node_a.x -= del * (k * node_a.im);
-				node_b.x += del * (k * node_b.im);
-			}
+	for (const Link &link : links) {
+		_solve_link(link, kst);
+	}
+}
+
+void GodotSoftBody3D::update_link_colors() {
+	// Greedy coloring: links sharing a node never share a color, so every link
+	// of a given color can be relaxed concurrently. Links that don't fit in the
+	// available colors end up in a last batch that is solved serially.
+	const uint32_t link_count = links.size();
+
+	LocalVector<uint64_t> node_used_colors;
+	node_used_colors.resize(nodes.size());
+	memset(node_used_colors.ptr(), 0, node_used_colors.size() * sizeof(uint64_t));
+
+	LocalVector<uint8_t> link_colors;
+	link_colors.resize(link_count);
+
+	uint32_t color_counts[LINK_COLOR_MAX + 1] = {};
+	for (uint32_t i = 0; i < link_count; ++i) {
+		const Link &link = links[i];
+		const uint64_t used = node_used_colors[link.n[0]] | node_used_colors[link.n[1]];
+		uint32_t color = 0;
+		while (color < LINK_COLOR_MAX && (used & (uint64_t(1) << color))) {
+			color++;
 		}
+		if (color < LINK_COLOR_MAX) {
+			node_used_colors[link.n[0]] |= uint64_t(1) << color;
+			node_used_colors[link.n[1]] |= uint64_t(1) << color;
+		}
+		link_colors[i] = color;
+		color_counts[color]++;
+	}
+
+	// Link order inside each color follows the optimized link order.
+	link_color_offsets.resize(LINK_COLOR_MAX + 2);
+	link_color_offsets[0] = 0;
+	for (uint32_t color = 0; color <= LINK_COLOR_MAX; ++color) {
+		link_color_offsets[color + 1] = link_color_offsets[color] + color_counts[color];
+	}
+
+	colored_links.resize(link_count);
+	memset(color_counts, 0, sizeof(color_counts));
+	for (uint32_t i = 0; i < link_count; ++i) {
+		const uint32_t color = link_colors[i];
+		colored_links[link_color_offsets[color] + color_counts[color]++] = i;
+	}
+
+	link_colors_dirty = false;
+}
+
+void GodotSoftBody3D::_solve_link_batch(uint32_t p_batch_index, void *p_userdata) {
+	const uint32_t from = link_batch_begin + p_batch_index * PARALLEL_LINKS_BATCH_SIZE;
+	const uint32_t to = MIN(from + PARALLEL_LINKS_BATCH_SIZE, link_batch_end);
+	for (uint32_t i = from; i < to; ++i) {
+		_solve_link(links[colored_links[i]], link_batch_kst);
+	}
+}
+
+void GodotSoftBody3D::solve_links_colored(real_t kst, real_t ti) {
+	WorkerThreadPool *worker_thread_pool = WorkerThreadPool::get_singleton();
+
+	link_batch_kst = kst;
+	for (uint32_t color = 0; color < LINK_COLOR_MAX; ++color) {
+		link_batch_begin = link_color_offsets[color];
+		link_batch_end = link_color_offsets[color + 1];
+		if (link_batch_begin == link_batch_end) {
+			continue;
+		}
+
+		const uint32_t batch_count = (link_batch_end - link_batch_begin + PARALLEL_LINKS_BATCH_SIZE - 1) / PARALLEL_LINKS_BATCH_SIZE;
+		if (batch_count == 1) {
+			_solve_link_batch(0, nullptr);
+			continue;
+		}
+
+		WorkerThreadPool::GroupID group_task = worker_thread_pool->add_template_group_task(this, &GodotSoftBody3D::_solve_link_batch, nullptr, batch_count, -1, true, SNAME("GodotPhysics3DSoftBodyLinks"));
+		worker_thread_pool->wait_for_group_task_completion(group_task);
+	}
+
+	// Links that didn't fit in any color may depend on each other.
+	for (uint32_t i = link_color_offsets[LINK_COLOR_MAX]; i < link_color_offsets[LINK_COLOR_MAX + 1]; ++i) {
+		_solve_link(links[colored_links[i]], kst);
 	}
 }
 
@@ -1191,9 +1285,9 @@ void GodotSoftBody3D::initialize_face_tree() {
 	for (Face &face : faces) {
 		AABB face_aabb;
 
-		face_aabb.position = face.n[0]->x;
-		face_aabb.expand_to(face.n[1]->x);
-		face_aabb.expand_to(face.n[2]->x);
+		face_aabb.position = node_positions[face.n[0]];
+		face_aabb.expand_to(node_positions[face.n[1]]);
+		face_aabb.expand_to(node_positions[face.n[2]]);
 
 		face_aabb.grow_by(collision_margin);
 
@@ -1205,17 +1299,17 @@ void GodotSoftBody3D::update_face_tree(real_t p_delta) {
 	for (const Face &face : faces) {
 		AABB face_aabb;
 
-		const Node *node0 = face.n[0];
-		face_aabb.position = node0->x;
-		face_aabb.expand_to(node0->x + node0->v * p_delta);
+		const uint32_t node0 = face.n[0];
+		face_aabb.position = node_positions[node0];
+		face_aabb.expand_to(node_positions[node0] + node_velocities[node0] * p_delta);
 
-		const Node *node1 = face.n[1];
-		face_aabb.expand_to(node1->x);
-		face_aabb.expand_to(node1->x + node1->v * p_delta);
+		const uint32_t node1 = face.n[1];
+		face_aabb.expand_to(node_positions[node1]);
+		face_aabb.expand_to(node_positions[node1] + node_velocities[node1] * p_delta);
 
-		const Node *node2 = face.n[2];
-		face_aabb.expand_to(node2->x);
-		face_aabb.expand_to(node2->x + node2->v * p_delta);
+		const uint32_t node2 = face.n[2];
+		face_aabb.expand_to(node_positions[node2]);
+		face_aabb.expand_to(node_positions[node2] + node_velocities[node2] * p_delta);
 
 		face_aabb.grow_by(collision_margin);
 
@@ -1233,6 +1327,19 @@ void GodotSoftBody3D::initialize_shape(bool p_force_move) {
 	}
 }
 
+void GodotSoftBody3D::apply_deferred_shape_update() {
+	if (!shape_update_pending) {
+		return;
+	}
+	shape_update_pending = false;
+
+	if (nodes.is_empty()) {
+		deinitialize_shape();
+	} else if (get_space()) {
+		initialize_shape(shape_update_moved);
+	}
+}
+
 void GodotSoftBody3D::deinitialize_shape() {
 	if (get_shape_count() > 0) {
 		GodotShape3D *shape = get_shape(0);
@@ -1250,9 +1357,17 @@ void GodotSoftBody3D::destroy() {
 	face_tree.clear();
 
 	nodes.clear();
+	node_positions.clear();
+	node_velocities.clear();
+	node_inv_masses.clear();
 	links.clear();
 	faces.clear();
 
+	colored_links.clear();
+	link_color_offsets.clear();
+	link_colors_dirty = true;
+	shape_update_pending = false;
+
 	bounds = AABB();
 	deinitialize_shape();
 }
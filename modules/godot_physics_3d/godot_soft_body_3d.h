@@ -45,23 +45,23 @@ class GodotConstraint3D;
 class GodotSoftBody3D : public GodotCollisionObject3D {
 	RID soft_mesh;
 
+	// Positions, velocities and inverse masses are kept in separate arrays
+	// (see node_positions, node_velocities and node_inv_masses) since they are
+	// the only node data touched by the link solver.
 	struct Node {
 		Vector3 s; // Source position
-		Vector3 x; // Position
 		Vector3 q; // Previous step position/Test position
 		Vector3 f; // Force accumulator
-		Vector3 v; // Velocity
 		Vector3 bv; // Biased Velocity
 		Vector3 n; // Normal
 		real_t area = 0.0; // Area
-		real_t im = 0.0; // 1/mass
 		DynamicBVH::ID leaf; // Leaf data
 		uint32_t index = 0;
 	};
 
 	struct Link {
 		Vector3 c3; // gradient
-		Node *n[2] = { nullptr, nullptr }; // Node pointers
+		uint32_t n[2] = { 0, 0 }; // Node indices
 		real_t rl = 0.0; // Rest length
 		real_t c0 = 0.0; // (ima+imb)*kLST
 		real_t c1 = 0.0; // rl^2
@@ -70,7 +70,7 @@ class GodotSoftBody3D : public GodotCollisionObject3D {
 
 	struct Face {
 		Vector3 centroid;
-		Node *n[3] = { nullptr, nullptr, nullptr }; // Node pointers
+		uint32_t n[3] = { 0, 0, 0 }; // Node indices
 		Vector3 normal; // Normal
 		real_t ra = 0.0; // Rest area
 		DynamicBVH::ID leaf; // Leaf data
@@ -78,9 +78,31 @@ class GodotSoftBody3D : public GodotCollisionObject3D {
 	};
 
 	LocalVector<Node> nodes;
+	LocalVector<Vector3> node_positions;
+	LocalVector<Vector3> node_velocities;
+	LocalVector<real_t> node_inv_masses;
 	LocalVector<Link> links;
 	LocalVector<Face> faces;
 
+	// Links sorted by color for parallel relaxation, see update_link_colors().
+	// The last color range holds the links that couldn't be colored.
+	enum {
+		LINK_COLOR_MAX = 64,
+		PARALLEL_LINKS_MIN_COUNT = 4096,
+		PARALLEL_LINKS_BATCH_SIZE = 256,
+	};
+
+	LocalVector<uint32_t> colored_links;
+	LocalVector<uint32_t> link_color_offsets;
+	bool link_colors_dirty = true;
+
+	uint32_t link_batch_begin = 0;
+	uint32_t link_batch_end = 0;
+	real_t link_batch_kst = 0.0;
+
+	bool shape_update_pending = false;
+	bool shape_update_moved = false;
+
 	DynamicBVH node_tree;
 	DynamicBVH face_tree;
 
@@ -113,6 +135,22 @@ class GodotSoftBody3D : public GodotCollisionObject3D {
 
 	_FORCE_INLINE_ Vector3 _compute_area_windforce(const GodotArea3D *p_area, const Face *p_face);
 
+	_FORCE_INLINE_ void _solve_link(const Link &p_link, real_t p_kst) {
+		if (p_link.c0 > 0) {
+			Vector3 &position_a = node_positions[p_link.n[0]];
+			Vector3 &position_b = node_positions[p_link.n[1]];
+			const Vector3 del = position_b - position_a;
+			const real_t len = del.length_squared();
+			if (p_link.c1 + len > CMP_EPSILON) {
+				const real_t k = ((p_link.c1 - len) / (p_link.c0 * (p_link.c1 + len))) * p_kst;
+				position_a -= del * (k * node_inv_masses[p_link.n[0]]);
+				position_b += del * (k * node_inv_masses[p_link.n[1]]);
+			}
+		}
+	}
+
+	void _solve_link_batch(uint32_t p_batch_index, void *p_userdata);
+
 public:
 	GodotSoftBody3D();
 
@@ -207,8 +245,15 @@ public:
 	void set_drag_coefficient(real_t p_val);
 	_FORCE_INLINE_ real_t get_drag_coefficient() const { return drag_coefficient; }
 
-	void predict_motion(real_t p_delta);
-	void solve_constraints(real_t p_delta);
+	// When p_defer_shape_update is true, the collision shape isn't updated until
+	// apply_deferred_shape_update() is called, so that motion of several soft
+	// bodies can be predicted concurrently without touching the broadphase.
+	void predict_motion(real_t p_delta, bool p_defer_shape_update = false);
+	void apply_deferred_shape_update();
+	// When p_parallel_links is true, links of large soft bodies are relaxed
+	// concurrently by color through the WorkerThreadPool.
+	void solve_constraints(real_t p_delta, bool p_parallel_links = false);
+	_FORCE_INLINE_ bool has_parallel_links() const { return links.size() >= PARALLEL_LINKS_MIN_COUNT; }
 
 	_FORCE_INLINE_ uint32_t get_node_index(void *p_node) const { return static_cast<Node *>(p_node)->index; }
 	_FORCE_INLINE_ uint32_t get_face_index(void *p_face) const { return static_cast<Face *>(p_face)->index; }
@@ -225,7 +270,7 @@ protected:
 
 private:
 	void update_normals_and_centroids();
-	void update_bounds();
+	void update_bounds(bool p_defer_shape_update = false);
 	void update_constants();
 	void update_area();
 	void reset_link_rest_lengths();
@@ -244,6 +289,8 @@ private:
 	void append_face(uint32_t p_node1, uint32_t p_node2, uint32_t p_node3);
 
 	void solve_links(real_t kst, real_t ti);
+	void update_link_colors();
+	void solve_links_colored(real_t kst, real_t ti);
 
 	void initialize_face_tree();
 	void update_face_tree(real_t p_delta);
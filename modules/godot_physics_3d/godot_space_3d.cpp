@@ -34,6 +34,8 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/sort_array.h"
 #include "godot_area_pair_3d.h"
 #include "godot_body_pair_3d.h"
 
@@ -107,17 +109,31 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
+_FORCE_INLINE_ static bool _can_ray_collide_with(GodotCollisionObject3D *p_object, const PhysicsDirectSpaceState3D::RayParameters &p_parameters) {
+	if (!_can_collide_with(p_object, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		return false;
+	}
+
+	if (p_parameters.pick_ray && !(p_object->is_ray_pickable())) {
+		return false;
+	}
+
+	if (p_parameters.exclude.has(p_object->get_self())) {
+		return false;
+	}
 
+	return true;
+}
+
+// Finds the closest hit among the given broadphase results. If `p_prefiltered` is true, the results have already
+// been checked against the query parameters but may not overlap the segment, so their AABBs are tested instead.
+static bool _intersect_ray_with_objects(const PhysicsDirectSpaceState3D::RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D *const *p_objects, const int *p_subindices, int p_amount, bool p_prefiltered, PhysicsDirectSpaceState3D::RayResult &r_result) {
 	Vector3 begin, end;
 	Vector3 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
+	begin = p_from;
+	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
 	bool collided = false;
@@ -127,22 +143,18 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	const GodotCollisionObject3D *res_obj = nullptr;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
-			continue;
-		}
-
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
-			continue;
-		}
+	for (int i = 0; i < p_amount; i++) {
+		const GodotCollisionObject3D *col_obj = p_objects[i];
+		int shape_idx = p_subindices[i];
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_prefiltered) {
+			if (!col_obj->get_shape_aabb(shape_idx).intersects_segment(begin, end)) {
+				continue;
+			}
+		} else if (!_can_ray_collide_with(p_objects[i], p_parameters)) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-
-		int shape_idx = space->intersection_query_subindex_results[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -207,6 +219,78 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
+
+	int amount = space->broadphase->cull_segment(p_parameters.from, p_parameters.to, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	return _intersect_ray_with_objects(p_parameters, p_parameters.from, p_parameters.to, space->intersection_query_results, space->intersection_query_subindex_results, amount, false, r_result);
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_ray_batch(uint32_t p_index, BatchQuery *p_query) {
+	const RayParameters &parameters = *p_query->ray_parameters;
+	RayResult &result = p_query->ray_results[p_index];
+	const Vector3 &from = p_query->from[p_index];
+	const Vector3 &to = p_query->to[p_index];
+
+	bool hit = false;
+	if (p_query->shared_cull) {
+		hit = _intersect_ray_with_objects(parameters, from, to, p_query->objects.ptr(), p_query->subindices.ptr(), p_query->objects.size(), true, result);
+	} else {
+		// The batch spans too much of the space to share the broadphase results, cull each ray on its own.
+		GodotCollisionObject3D *objects[GodotSpace3D::INTERSECTION_QUERY_MAX];
+		int subindices[GodotSpace3D::INTERSECTION_QUERY_MAX];
+		int amount = space->broadphase->cull_segment(from, to, objects, GodotSpace3D::INTERSECTION_QUERY_MAX, subindices);
+		hit = _intersect_ray_with_objects(parameters, from, to, objects, subindices, amount, false, result);
+	}
+
+	if (!hit) {
+		result = RayResult();
+	}
+}
+
+int GodotPhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results) {
+	ERR_FAIL_COND_V(space->locked, 0);
+
+	if (p_ray_count <= 0) {
+		return 0;
+	}
+
+	AABB batch_aabb(p_from[0], Vector3());
+	for (int i = 0; i < p_ray_count; i++) {
+		batch_aabb.expand_to(p_from[i]);
+		batch_aabb.expand_to(p_to[i]);
+	}
+
+	BatchQuery query;
+	query.ray_parameters = &p_parameters;
+	query.from = p_from;
+	query.to = p_to;
+	query.ray_results = r_results;
+
+	// Cull the whole batch once and filter the candidates against the parameters, rays only test their AABBs afterwards.
+	int amount = space->broadphase->cull_aabb(batch_aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	query.shared_cull = amount < GodotSpace3D::INTERSECTION_QUERY_MAX;
+	if (query.shared_cull) {
+		for (int i = 0; i < amount; i++) {
+			if (_can_ray_collide_with(space->intersection_query_results[i], p_parameters)) {
+				query.objects.push_back(space->intersection_query_results[i]);
+				query.subindices.push_back(space->intersection_query_subindex_results[i]);
+			}
+		}
+	}
+
+	_run_batch_query(&GodotPhysicsDirectSpaceState3D::_intersect_ray_batch, &query, p_ray_count, SNAME("Physics3DIntersectRays"));
+
+	int hit_count = 0;
+	for (int i = 0; i < p_ray_count; i++) {
+		if (r_results[i].rid.is_valid()) {
+			hit_count++;
+		}
+	}
+	return hit_count;
+}
+
 int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	if (p_result_max <= 0) {
 		return 0;
@@ -262,22 +346,22 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
-	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, false);
-
-	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
+_FORCE_INLINE_ static AABB _get_cast_motion_aabb(const PhysicsDirectSpaceState3D::ShapeParameters &p_parameters, const GodotShape3D *p_shape) {
+	AABB aabb = p_parameters.transform.xform(p_shape->get_aabb());
 	aabb = aabb.merge(AABB(aabb.position + p_parameters.motion, aabb.size)); //motion
 	aabb = aabb.grow(p_parameters.margin);
+	return aabb;
+}
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
+// Casts the shape against the given broadphase results. If `p_prefiltered` is true, the results have already
+// been checked against the query parameters but may not overlap the motion, so their AABBs are tested instead.
+static void _cast_motion_with_objects(const PhysicsDirectSpaceState3D::ShapeParameters &p_parameters, GodotShape3D *p_shape, const AABB &p_aabb, GodotCollisionObject3D *const *p_objects, const int *p_subindices, int p_amount, bool p_prefiltered, real_t &p_closest_safe, real_t &p_closest_unsafe, PhysicsDirectSpaceState3D::ShapeRestInfo *r_info) {
 	real_t best_safe = 1;
 	real_t best_unsafe = 1;
 
 	Transform3D xform_inv = p_parameters.transform.affine_inverse();
 	GodotMotionShape3D mshape;
-	mshape.shape = shape;
+	mshape.shape = p_shape;
 	mshape.motion = xform_inv.basis.xform(p_parameters.motion);
 
 	bool best_first = true;
@@ -286,31 +370,37 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 
 	Vector3 closest_A, closest_B;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
-			continue;
-		}
+	for (int i = 0; i < p_amount; i++) {
+		const GodotCollisionObject3D *col_obj = p_objects[i];
+		int shape_idx = p_subindices[i];
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
-			continue; //ignore excluded
-		}
+		if (p_prefiltered) {
+			if (!col_obj->get_shape_aabb(shape_idx).intersects(p_aabb)) {
+				continue;
+			}
+		} else {
+			if (!_can_collide_with(p_objects[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+				continue;
+			}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+			if (p_parameters.exclude.has(p_objects[i]->get_self())) {
+				continue; //ignore excluded
+			}
+		}
 
 		Vector3 point_A, point_B;
 		Vector3 sep_axis = motion_normal;
 
 		Transform3D col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		//test initial overlap, does it collide if going all the way?
-		if (GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
+		if (GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, p_aabb, &sep_axis)) {
 			continue;
 		}
 
 		//test initial overlap, ignore objects it's inside of.
 		sep_axis = motion_normal;
 
-		if (!GodotCollisionSolver3D::solve_distance(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
+		if (!GodotCollisionSolver3D::solve_distance(p_shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, p_aabb, &sep_axis)) {
 			continue;
 		}
 
@@ -325,7 +415,7 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 
 			Vector3 lA, lB;
 			Vector3 sep = motion_normal; //important optimization for this to work fast enough
-			bool collided = !GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, lA, lB, aabb, &sep);
+			bool collided = !GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, lA, lB, p_aabb, &sep);
 
 			if (collided) {
 				hi = fraction;
@@ -377,10 +467,101 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 
 	p_closest_safe = best_safe;
 	p_closest_unsafe = best_unsafe;
+}
+
+bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, false);
+
+	AABB aabb = _get_cast_motion_aabb(p_parameters, shape);
+
+	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	_cast_motion_with_objects(p_parameters, shape, aabb, space->intersection_query_results, space->intersection_query_subindex_results, amount, false, p_closest_safe, p_closest_unsafe, r_info);
 
 	return true;
 }
 
+void GodotPhysicsDirectSpaceState3D::_cast_motion_batch(uint32_t p_index, BatchQuery *p_query) {
+	ShapeParameters parameters = *p_query->shape_parameters;
+	parameters.transform.origin = p_query->from[p_index];
+	parameters.motion = p_query->to[p_index];
+
+	AABB aabb = _get_cast_motion_aabb(parameters, p_query->shape);
+
+	if (p_query->shared_cull) {
+		_cast_motion_with_objects(parameters, p_query->shape, aabb, p_query->objects.ptr(), p_query->subindices.ptr(), p_query->objects.size(), true, p_query->closest_safe[p_index], p_query->closest_unsafe[p_index], nullptr);
+	} else {
+		// The batch spans too much of the space to share the broadphase results, cull each cast on its own.
+		GodotCollisionObject3D *objects[GodotSpace3D::INTERSECTION_QUERY_MAX];
+		int subindices[GodotSpace3D::INTERSECTION_QUERY_MAX];
+		int amount = space->broadphase->cull_aabb(aabb, objects, GodotSpace3D::INTERSECTION_QUERY_MAX, subindices);
+		_cast_motion_with_objects(parameters, p_query->shape, aabb, objects, subindices, amount, false, p_query->closest_safe[p_index], p_query->closest_unsafe[p_index], nullptr);
+	}
+}
+
+void GodotPhysicsDirectSpaceState3D::cast_motions(const ShapeParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_cast_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	for (int i = 0; i < p_cast_count; i++) {
+		r_closest_safe[i] = 1.0;
+		r_closest_unsafe[i] = 1.0;
+	}
+
+	if (p_cast_count <= 0) {
+		return;
+	}
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL(shape);
+
+	ShapeParameters parameters = p_parameters;
+	AABB batch_aabb;
+	for (int i = 0; i < p_cast_count; i++) {
+		parameters.transform.origin = p_origins[i];
+		parameters.motion = p_motions[i];
+		AABB aabb = _get_cast_motion_aabb(parameters, shape);
+		batch_aabb = i == 0 ? aabb : batch_aabb.merge(aabb);
+	}
+
+	BatchQuery query;
+	query.shape_parameters = &p_parameters;
+	query.shape = shape;
+	query.from = p_origins;
+	query.to = p_motions;
+	query.closest_safe = r_closest_safe;
+	query.closest_unsafe = r_closest_unsafe;
+
+	// Cull the whole batch once and filter the candidates against the parameters, casts only test their AABBs afterwards.
+	int amount = space->broadphase->cull_aabb(batch_aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	query.shared_cull = amount < GodotSpace3D::INTERSECTION_QUERY_MAX;
+	if (query.shared_cull) {
+		for (int i = 0; i < amount; i++) {
+			GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+			if (!_can_collide_with(col_obj, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+				continue;
+			}
+			if (p_parameters.exclude.has(col_obj->get_self())) {
+				continue;
+			}
+			query.objects.push_back(col_obj);
+			query.subindices.push_back(space->intersection_query_subindex_results[i]);
+		}
+	}
+
+	_run_batch_query(&GodotPhysicsDirectSpaceState3D::_cast_motion_batch, &query, p_cast_count, SNAME("Physics3DCastMotions"));
+}
+
+void GodotPhysicsDirectSpaceState3D::_run_batch_query(void (GodotPhysicsDirectSpaceState3D::*p_method)(uint32_t, BatchQuery *), BatchQuery *p_query, int p_count, const StringName &p_description) {
+	if (p_count < BATCH_QUERY_MIN_THREADED) {
+		for (int i = 0; i < p_count; i++) {
+			(this->*p_method)(i, p_query);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, p_method, p_query, p_count, -1, true, p_description);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 bool GodotPhysicsDirectSpaceState3D::collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) {
 	if (p_result_max <= 0) {
 		return false;
@@ -1065,6 +1246,7 @@ void *GodotSpace3D::_broadphase_pair(GodotCollisionObject3D *A, int p_subindex_A
 			return soft_pair;
 		} else {
 			GodotBodyPair3D *b = memnew(GodotBodyPair3D(static_cast<GodotBody3D *>(A), p_subindex_A, static_cast<GodotBody3D *>(B), p_subindex_B));
+			self->body_pair_list.add(b->get_space_list());
 			return b;
 		}
 	} else {
@@ -1215,6 +1397,9 @@ void GodotSpace3D::set_param(PhysicsServer3D::SpaceParameter p_param, real_t p_v
 		case PhysicsServer3D::SPACE_PARAM_SOLVER_ITERATIONS:
 			solver_iterations = p_value;
 			break;
+		case PhysicsServer3D::SPACE_PARAM_SOFT_BODY_PARALLEL_SOLVER:
+			soft_body_parallel_solver = p_value != 0;
+			break;
 	}
 }
 
@@ -1236,10 +1421,173 @@ real_t GodotSpace3D::get_param(PhysicsServer3D::SpaceParameter p_param) const {
 			return body_time_to_sleep;
 		case PhysicsServer3D::SPACE_PARAM_SOLVER_ITERATIONS:
 			return solver_iterations;
+		case PhysicsServer3D::SPACE_PARAM_SOFT_BODY_PARALLEL_SOLVER:
+			return soft_body_parallel_solver;
 	}
 	return 0;
 }
 
+// Space snapshots are a header followed by the body states sorted by RID, the
+// RIDs of the active bodies in active list order and the contact caches of the
+// body pairs sorted by bodies and shapes. Sorting keeps the snapshot of a given
+// simulation state identical regardless of how the space was built.
+struct GodotSpaceSavedStateHeader3D {
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	uint32_t body_state_size = 0;
+	uint32_t pair_state_size = 0;
+	uint32_t body_count = 0;
+	uint32_t active_body_count = 0;
+	uint32_t pair_count = 0;
+	uint32_t reserved = 0;
+};
+
+static constexpr uint32_t SPACE_STATE_MAGIC_3D = 0x33535047; // "GPS3"
+static constexpr uint32_t SPACE_STATE_VERSION_3D = 1;
+
+struct GodotSpaceSavedBodyComparator3D {
+	_FORCE_INLINE_ bool operator()(const GodotBody3D *p_a, const GodotBody3D *p_b) const {
+		return p_a->get_self() < p_b->get_self();
+	}
+};
+
+Vector<uint8_t> GodotSpace3D::save_state() const {
+	LocalVector<const GodotBody3D *> bodies;
+	for (const GodotCollisionObject3D *object : objects) {
+		if (object->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+			bodies.push_back(static_cast<const GodotBody3D *>(object));
+		}
+	}
+	bodies.sort_custom<GodotSpaceSavedBodyComparator3D>();
+
+	uint32_t active_body_count = 0;
+	for (const SelfList<GodotBody3D> *e = active_list.first(); e; e = e->next()) {
+		active_body_count++;
+	}
+
+	uint32_t pair_count = 0;
+	for (const SelfList<GodotBodyPair3D> *e = body_pair_list.first(); e; e = e->next()) {
+		pair_count++;
+	}
+
+	const uint32_t body_count = bodies.size();
+
+	const uint32_t bodies_offset = sizeof(GodotSpaceSavedStateHeader3D);
+	const uint32_t active_bodies_offset = bodies_offset + body_count * sizeof(GodotBody3D::SavedState);
+	const uint32_t pairs_offset = active_bodies_offset + active_body_count * sizeof(uint64_t);
+	const uint32_t state_size = pairs_offset + pair_count * sizeof(GodotBodyPair3D::SavedState);
+
+	Vector<uint8_t> state;
+	state.resize_initialized(state_size);
+	uint8_t *w = state.ptrw();
+
+	GodotSpaceSavedStateHeader3D *header = reinterpret_cast<GodotSpaceSavedStateHeader3D *>(w);
+	header->magic = SPACE_STATE_MAGIC_3D;
+	header->version = SPACE_STATE_VERSION_3D;
+	header->body_state_size = sizeof(GodotBody3D::SavedState);
+	header->pair_state_size = sizeof(GodotBodyPair3D::SavedState);
+	header->body_count = body_count;
+	header->active_body_count = active_body_count;
+	header->pair_count = pair_count;
+
+	GodotBody3D::SavedState *body_states = reinterpret_cast<GodotBody3D::SavedState *>(w + bodies_offset);
+	for (uint32_t i = 0; i < body_count; i++) {
+		bodies[i]->save_state(body_states[i]);
+	}
+
+	uint64_t *active_bodies = reinterpret_cast<uint64_t *>(w + active_bodies_offset);
+	for (const SelfList<GodotBody3D> *e = active_list.first(); e; e = e->next()) {
+		*active_bodies++ = e->self()->get_self().get_id();
+	}
+
+	GodotBodyPair3D::SavedState *pair_states = reinterpret_cast<GodotBodyPair3D::SavedState *>(w + pairs_offset);
+	uint32_t pair_index = 0;
+	for (const SelfList<GodotBodyPair3D> *e = body_pair_list.first(); e; e = e->next()) {
+		e->self()->save_state(pair_states[pair_index++]);
+	}
+	SortArray<GodotBodyPair3D::SavedState, GodotBodyPair3D::SavedStateComparator> sorter;
+	sorter.sort(pair_states, pair_count);
+
+	return state;
+}
+
+Error GodotSpace3D::restore_state(const Vector<uint8_t> &p_state) {
+	ERR_FAIL_COND_V_MSG(locked, ERR_LOCKED, "Can't restore the space state while the space is being stepped.");
+	ERR_FAIL_COND_V((uint32_t)p_state.size() < sizeof(GodotSpaceSavedStateHeader3D), ERR_INVALID_DATA);
+
+	const uint8_t *r = p_state.ptr();
+	const GodotSpaceSavedStateHeader3D *header = reinterpret_cast<const GodotSpaceSavedStateHeader3D *>(r);
+	ERR_FAIL_COND_V_MSG(header->magic != SPACE_STATE_MAGIC_3D || header->version != SPACE_STATE_VERSION_3D, ERR_INVALID_DATA, "Invalid space state, it wasn't saved by this version of Godot Physics 3D.");
+	ERR_FAIL_COND_V_MSG(header->body_state_size != sizeof(GodotBody3D::SavedState) || header->pair_state_size != sizeof(GodotBodyPair3D::SavedState), ERR_INVALID_DATA, "Invalid space state, it was saved with a different floating-point precision.");
+
+	const uint64_t bodies_offset = sizeof(GodotSpaceSavedStateHeader3D);
+	const uint64_t active_bodies_offset = bodies_offset + uint64_t(header->body_count) * sizeof(GodotBody3D::SavedState);
+	const uint64_t pairs_offset = active_bodies_offset + uint64_t(header->active_body_count) * sizeof(uint64_t);
+	const uint64_t state_size = pairs_offset + uint64_t(header->pair_count) * sizeof(GodotBodyPair3D::SavedState);
+	ERR_FAIL_COND_V_MSG(state_size != (uint64_t)p_state.size(), ERR_INVALID_DATA, "Invalid space state, the data is truncated.");
+
+	HashMap<RID, GodotBody3D *> bodies;
+	bodies.reserve(objects.size());
+	for (GodotCollisionObject3D *object : objects) {
+		if (object->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+			bodies.insert(object->get_self(), static_cast<GodotBody3D *>(object));
+		}
+	}
+
+	// Bodies that were removed from the space since the state was saved are skipped,
+	// bodies that were added keep their current state.
+	const GodotBody3D::SavedState *body_states = reinterpret_cast<const GodotBody3D::SavedState *>(r + bodies_offset);
+	for (uint32_t i = 0; i < header->body_count; i++) {
+		HashMap<RID, GodotBody3D *>::Iterator E = bodies.find(RID::from_uint64(body_states[i].rid));
+		if (E) {
+			E->value->restore_state(body_states[i]);
+		}
+	}
+
+	// Rebuild the active list in the saved order, it decides the order bodies are integrated and islands are built.
+	while (active_list.first()) {
+		active_list.first()->self()->set_active(false);
+	}
+	const uint64_t *active_bodies = reinterpret_cast<const uint64_t *>(r + active_bodies_offset);
+	for (uint32_t i = 0; i < header->active_body_count; i++) {
+		HashMap<RID, GodotBody3D *>::Iterator E = bodies.find(RID::from_uint64(active_bodies[i]));
+		if (E) {
+			E->value->set_active(true);
+		}
+	}
+
+	// Create and remove the pairs for the restored transforms, then restore their contact caches.
+	update();
+
+	const GodotBodyPair3D::SavedState *pair_states = reinterpret_cast<const GodotBodyPair3D::SavedState *>(r + pairs_offset);
+	const uint32_t pair_count = header->pair_count;
+	GodotBodyPair3D::SavedStateComparator compare;
+	for (SelfList<GodotBodyPair3D> *e = body_pair_list.first(); e; e = e->next()) {
+		GodotBodyPair3D::SavedState key;
+		e->self()->get_saved_state_key(key);
+
+		// Binary search, the pairs are sorted by key.
+		uint32_t lo = 0;
+		uint32_t hi = pair_count;
+		while (lo < hi) {
+			const uint32_t mid = (lo + hi) / 2;
+			if (compare(pair_states[mid], key)) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+
+		if (lo < pair_count && !compare(key, pair_states[lo])) {
+			e->self()->restore_state(&pair_states[lo]);
+		} else {
+			e->self()->restore_state(nullptr);
+		}
+	}
+
+	return OK;
+}
+
 void GodotSpace3D::lock() {
 	locked = true;
 }
@@ -1265,8 +1613,11 @@ GodotSpace3D::GodotSpace3D() {
 	contact_max_separation = GLOBAL_GET("physics/3d/solver/contact_max_separation");
 	contact_max_allowed_penetration = GLOBAL_GET("physics/3d/solver/contact_max_allowed_penetration");
 	contact_bias = GLOBAL_GET("physics/3d/solver/default_contact_bias");
+	parallel_step = GLOBAL_GET("physics/3d/solver/parallel_step");
+	soft_body_parallel_solver = GLOBAL_GET("physics/3d/solver/soft_body_parallel_solver");
 
 	broadphase = GodotBroadPhase3D::create_func();
+	broadphase->set_deferred_pairing(GLOBAL_GET("physics/3d/solver/deferred_pairing"));
 	broadphase->set_pair_callback(_broadphase_pair, this);
 	broadphase->set_unpair_callback(_broadphase_unpair, this);
 
@@ -38,16 +38,47 @@
 
 #include "core/typedefs.h"
 
+class GodotBodyPair3D;
+
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	enum {
+		BATCH_QUERY_MIN_THREADED = 32
+	};
+
+	struct BatchQuery {
+		const RayParameters *ray_parameters = nullptr;
+		RayResult *ray_results = nullptr;
+
+		const ShapeParameters *shape_parameters = nullptr;
+		GodotShape3D *shape = nullptr;
+		real_t *closest_safe = nullptr;
+		real_t *closest_unsafe = nullptr;
+
+		// Ray ends, or shape origins and motions.
+		const Vector3 *from = nullptr;
+		const Vector3 *to = nullptr;
+
+		// Broadphase results shared by the whole batch, already filtered with the query parameters.
+		bool shared_cull = false;
+		LocalVector<GodotCollisionObject3D *> objects;
+		LocalVector<int> subindices;
+	};
+
+	void _intersect_ray_batch(uint32_t p_index, BatchQuery *p_query);
+	void _cast_motion_batch(uint32_t p_index, BatchQuery *p_query);
+	void _run_batch_query(void (GodotPhysicsDirectSpaceState3D::*p_method)(uint32_t, BatchQuery *), BatchQuery *p_query, int p_count, const StringName &p_description);
+
 public:
 	GodotSpace3D *space = nullptr;
 
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
+	virtual int intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) override;
+	virtual void cast_motions(const ShapeParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_cast_count, real_t *r_closest_safe, real_t *r_closest_unsafe) override;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) override;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
 	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const override;
@@ -80,6 +111,7 @@ private:
 	SelfList<GodotArea3D>::List monitor_query_list;
 	SelfList<GodotArea3D>::List area_moved_list;
 	SelfList<GodotSoftBody3D>::List active_soft_body_list;
+	SelfList<GodotBodyPair3D>::List body_pair_list;
 
 	static void *_broadphase_pair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_self);
 	static void _broadphase_unpair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_data, void *p_self);
@@ -95,6 +127,9 @@ private:
 	real_t contact_max_allowed_penetration = 0.0;
 	real_t contact_bias = 0.0;
 
+	bool parallel_step = false;
+	bool soft_body_parallel_solver = false;
+
 	enum {
 		INTERSECTION_QUERY_MAX = 2048
 	};
@@ -163,6 +198,8 @@ public:
 	_FORCE_INLINE_ real_t get_body_linear_velocity_sleep_threshold() const { return body_linear_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_angular_velocity_sleep_threshold() const { return body_angular_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_time_to_sleep() const { return body_time_to_sleep; }
+	_FORCE_INLINE_ bool is_parallel_step_enabled() const { return parallel_step; }
+	_FORCE_INLINE_ bool is_soft_body_parallel_solver_enabled() const { return soft_body_parallel_solver; }
 
 	void update();
 	void setup();
@@ -178,6 +215,9 @@ public:
 	void set_param(PhysicsServer3D::SpaceParameter p_param, real_t p_value);
 	real_t get_param(PhysicsServer3D::SpaceParameter p_param) const;
 
+	Vector<uint8_t> save_state() const;
+	Error restore_state(const Vector<uint8_t> &p_state);
+
 	void set_island_count(int p_island_count) { island_count = p_island_count; }
 	int get_island_count() const { return island_count; }
 
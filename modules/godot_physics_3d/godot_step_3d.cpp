@@ -158,7 +158,7 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	}
 }
 
-void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
+bool GodotStep3D::_sleep_test_island(const LocalVector<GodotBody3D *> &p_body_island) const {
 	bool can_sleep = true;
 
 	uint32_t body_count = p_body_island.size();
@@ -170,18 +170,49 @@ void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island
 		}
 	}
 
+	return can_sleep;
+}
+
+void GodotStep3D::_set_island_sleeping(const LocalVector<GodotBody3D *> &p_body_island, bool p_sleeping) const {
 	// Put all to sleep or wake up everyone.
+	uint32_t body_count = p_body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
 		GodotBody3D *body = p_body_island[body_index];
 
 		bool active = body->is_active();
 
-		if (active == can_sleep) {
-			body->set_active(!can_sleep);
+		if (active == p_sleeping) {
+			body->set_active(!p_sleeping);
 		}
 	}
 }
 
+void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
+	_set_island_sleeping(p_body_island, _sleep_test_island(p_body_island));
+}
+
+void GodotStep3D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta, true);
+}
+
+void GodotStep3D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta, true);
+}
+
+void GodotStep3D::_sleep_test_body_island(uint32_t p_island_index, void *p_userdata) {
+	// Only the sleep test runs on threads, changing the active state modifies the space's active list.
+	body_island_can_sleep[p_island_index] = _sleep_test_island(body_islands[p_island_index]);
+}
+
+void GodotStep3D::_predict_soft_body_motion(uint32_t p_soft_body_index, void *p_userdata) {
+	// The collision shape update reaches the broadphase, it's applied after all soft bodies are done.
+	active_soft_bodies[p_soft_body_index]->predict_motion(delta, true);
+}
+
+void GodotStep3D::_solve_soft_body_constraints(uint32_t p_soft_body_index, void *p_userdata) {
+	active_soft_bodies[p_soft_body_index]->solve_constraints(delta);
+}
+
 void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	p_space->lock(); // can't access space during this
 
@@ -203,20 +234,56 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	int active_count = 0;
 
+	const bool parallel_step = p_space->is_parallel_step_enabled();
+	const bool soft_body_parallel_solver = p_space->is_soft_body_parallel_solver_enabled();
+
 	const SelfList<GodotBody3D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	if (parallel_step) {
+		active_bodies.clear();
+		while (b) {
+			active_bodies.push_back(b->self());
+			b = b->next();
+		}
+		active_count += active_bodies.size();
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_forces, nullptr, active_bodies.size(), -1, true, SNAME("Physics3DIntegrateForces"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		// Broadphase updates are applied in the active list order, like in the serial path.
+		for (GodotBody3D *body : active_bodies) {
+			body->apply_deferred_space_updates();
+		}
+	} else {
+		while (b) {
+			b->self()->integrate_forces(p_delta);
+			b = b->next();
+			active_count++;
+		}
 	}
 
 	/* UPDATE SOFT BODY MOTION */
 
 	const SelfList<GodotSoftBody3D> *sb = soft_body_list->first();
-	while (sb) {
-		sb->self()->predict_motion(p_delta);
-		sb = sb->next();
-		active_count++;
+	if (soft_body_parallel_solver) {
+		active_soft_bodies.clear();
+		while (sb) {
+			active_soft_bodies.push_back(sb->self());
+			sb = sb->next();
+		}
+		active_count += active_soft_bodies.size();
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_predict_soft_body_motion, nullptr, active_soft_bodies.size(), -1, true, SNAME("Physics3DSoftBodyPredictMotion"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (GodotSoftBody3D *soft_body : active_soft_bodies) {
+			soft_body->apply_deferred_shape_update();
+		}
+	} else {
+		while (sb) {
+			sb->self()->predict_motion(p_delta);
+			sb = sb->next();
+			active_count++;
+		}
 	}
 
 	p_space->set_active_objects(active_count);
@@ -373,27 +440,81 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		profile_begtime = profile_endtime;
 	}
 
-	/* INTEGRATE VELOCITIES */
+	if (parallel_step) {
+		/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody3D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n;
-	}
+		// Gather the bodies again, new pairs can have activated kinematic bodies since forces were integrated.
+		active_bodies.clear();
+		b = body_list->first();
+		while (b) {
+			active_bodies.push_back(b->self());
+			b = b->next();
+		}
+
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_velocities, nullptr, active_bodies.size(), -1, true, SNAME("Physics3DIntegrateVelocities"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (GodotBody3D *body : active_bodies) {
+			body->apply_deferred_space_updates();
+		}
 
-	/* SLEEP / WAKE UP ISLANDS */
+		/* SLEEP / WAKE UP ISLANDS */
 
-	for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
-		_check_suspend(body_islands[island_index]);
+		body_island_can_sleep.resize(body_island_count);
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_sleep_test_body_island, nullptr, body_island_count, -1, true, SNAME("Physics3DSleepTest"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
+			_set_island_sleeping(body_islands[island_index], body_island_can_sleep[island_index]);
+		}
+	} else {
+		/* INTEGRATE VELOCITIES */
+
+		b = body_list->first();
+		while (b) {
+			const SelfList<GodotBody3D> *n = b->next();
+			b->self()->integrate_velocities(p_delta);
+			b = n;
+		}
+
+		/* SLEEP / WAKE UP ISLANDS */
+
+		for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
+			_check_suspend(body_islands[island_index]);
+		}
 	}
 
 	/* UPDATE SOFT BODY CONSTRAINTS */
 
-	sb = soft_body_list->first();
-	while (sb) {
-		sb->self()->solve_constraints(p_delta);
-		sb = sb->next();
+	if (parallel_step || soft_body_parallel_solver) {
+		// Large soft bodies are solved one at a time, with their links relaxed in parallel.
+		active_soft_bodies.clear();
+		large_soft_bodies.clear();
+		sb = soft_body_list->first();
+		while (sb) {
+			GodotSoftBody3D *soft_body = sb->self();
+			if (soft_body_parallel_solver && soft_body->has_parallel_links()) {
+				large_soft_bodies.push_back(soft_body);
+			} else {
+				active_soft_bodies.push_back(soft_body);
+			}
+			sb = sb->next();
+		}
+
+		if (!active_soft_bodies.is_empty()) {
+			group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_soft_body_constraints, nullptr, active_soft_bodies.size(), -1, true, SNAME("Physics3DSoftBodySolveConstraints"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		}
+
+		for (GodotSoftBody3D *soft_body : large_soft_bodies) {
+			soft_body->solve_constraints(p_delta, true);
+		}
+	} else {
+		sb = soft_body_list->first();
+		while (sb) {
+			sb->self()->solve_constraints(p_delta);
+			sb = sb->next();
+		}
 	}
 
 	{ //profile
@@ -403,6 +524,9 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	}
 
 	all_constraints.clear();
+	active_bodies.clear();
+	active_soft_bodies.clear();
+	large_soft_bodies.clear();
 
 	p_space->unlock();
 	_step++;
@@ -412,6 +536,7 @@ GodotStep3D::GodotStep3D() {
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
+	body_island_can_sleep.reserve(BODY_ISLAND_COUNT_RESERVE);
 }
 
 GodotStep3D::~GodotStep3D() {
@@ -0,0 +1,283 @@
+/**************************************************************************/
+/*  test_godot_collision_solver_3d.h                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_collision_solver_3d.h"
+#include "../godot_shape_3d.h"
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotCollisionSolver3D {
+
+struct ContactResult {
+	LocalVector<Vector3> points_A;
+	LocalVector<Vector3> points_B;
+};
+
+static void _contact_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &p_normal, void *p_userdata) {
+	ContactResult *result = static_cast<ContactResult *>(p_userdata);
+	result->points_A.push_back(p_point_A);
+	result->points_B.push_back(p_point_B);
+}
+
+static Transform3D _random_transform(RandomPCG &p_rng, real_t p_extent) {
+	Vector3 axis = Vector3(p_rng.randf() - 0.5, p_rng.randf() - 0.5, p_rng.randf() - 0.5).normalized();
+	Basis basis(axis.is_zero_approx() ? Vector3(0, 1, 0) : axis, p_rng.randf() * Math::TAU);
+	Vector3 origin = Vector3(p_rng.randf() - 0.5, p_rng.randf() - 0.5, p_rng.randf() - 0.5) * p_extent;
+	return Transform3D(basis, origin);
+}
+
+static void _check_project_ranges(const GodotShape3D &p_shape, RandomPCG &p_rng) {
+	for (int iteration = 0; iteration < 64; iteration++) {
+		Transform3D transform = _random_transform(p_rng, 10.0);
+		if (iteration % 2) {
+			// Non uniform scale, as used by scaled collision shapes.
+			transform.basis.scale_local(Vector3(1.0 + p_rng.randf(), 1.0 + p_rng.randf(), 1.0 + p_rng.randf()));
+		}
+
+		Vector3 normals[4];
+		for (int i = 0; i < 4; i++) {
+			normals[i] = Vector3(p_rng.randf() - 0.5, p_rng.randf() - 0.5, p_rng.randf() - 0.5).normalized();
+		}
+
+		for (int count = 1; count <= 4; count++) {
+			real_t min_batched[4] = {};
+			real_t max_batched[4] = {};
+			p_shape.project_ranges(normals, count, transform, min_batched, max_batched);
+
+			for (int i = 0; i < count; i++) {
+				real_t min = 0.0, max = 0.0;
+				p_shape.project_range(normals[i], transform, min, max);
+
+				CHECK(min_batched[i] == doctest::Approx(min).epsilon(0.0001));
+				CHECK(max_batched[i] == doctest::Approx(max).epsilon(0.0001));
+			}
+		}
+	}
+}
+
+TEST_CASE("[Modules][GodotPhysics3D] Batched shape projections match project_range()") {
+	RandomPCG rng(1234);
+
+	SUBCASE("Box") {
+		GodotBoxShape3D box;
+		box.set_data(Vector3(0.5, 1.0, 2.0));
+		_check_project_ranges(box, rng);
+	}
+
+	SUBCASE("Capsule") {
+		GodotCapsuleShape3D capsule;
+		Dictionary data;
+		data["radius"] = 0.5;
+		data["height"] = 3.0;
+		capsule.set_data(data);
+		_check_project_ranges(capsule, rng);
+	}
+
+	SUBCASE("Convex polygon") {
+		Vector<Vector3> points;
+		for (int i = 0; i < 12; i++) {
+			points.push_back(Vector3(rng.randf() - 0.5, rng.randf() - 0.5, rng.randf() - 0.5) * 2.0);
+		}
+
+		GodotConvexPolygonShape3D convex;
+		convex.set_data(points);
+		_check_project_ranges(convex, rng);
+	}
+
+	SUBCASE("Face") {
+		GodotFaceShape3D face;
+		face.vertex[0] = Vector3(-1, 0, -1);
+		face.vertex[1] = Vector3(1, 0, -1);
+		face.vertex[2] = Vector3(0, 0.5, 1);
+		_check_project_ranges(face, rng);
+	}
+}
+
+static Vector<Vector3> _box_points(const Vector3 &p_half_extents) {
+	Vector<Vector3> points;
+	for (int i = 0; i < 8; i++) {
+		points.push_back(Vector3((i & 1) ? p_half_extents.x : -p_half_extents.x, (i & 2) ? p_half_extents.y : -p_half_extents.y, (i & 4) ? p_half_extents.z : -p_half_extents.z));
+	}
+	return points;
+}
+
+// Penetration depth of two boxes found by testing all 15 separating axes one at a time with
+// project_range(), independently of the solver's queued axes. Negative when they are separated.
+static real_t _reference_box_depth(const GodotShape3D &p_box, const Transform3D &p_transform_A, const Transform3D &p_transform_B) {
+	LocalVector<Vector3> axes;
+	for (int i = 0; i < 3; i++) {
+		axes.push_back(p_transform_A.basis.get_column(i).normalized());
+		axes.push_back(p_transform_B.basis.get_column(i).normalized());
+	}
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			const Vector3 axis = p_transform_A.basis.get_column(i).cross(p_transform_B.basis.get_column(j));
+			if (!axis.is_zero_approx()) {
+				axes.push_back(axis.normalized());
+			}
+		}
+	}
+
+	real_t depth = 1e20;
+	for (const Vector3 &axis : axes) {
+		real_t min_A = 0.0, max_A = 0.0, min_B = 0.0, max_B = 0.0;
+		p_box.project_range(axis, p_transform_A, min_A, max_A);
+		p_box.project_range(axis, p_transform_B, min_B, max_B);
+		depth = MIN(depth, MIN(max_A - min_B, max_B - min_A));
+	}
+	return depth;
+}
+
+static real_t _contact_depth(const ContactResult &p_result) {
+	real_t depth = 0.0;
+	for (uint32_t i = 0; i < p_result.points_A.size(); i++) {
+		depth = MAX(depth, p_result.points_A[i].distance_to(p_result.points_B[i]));
+	}
+	return depth;
+}
+
+TEST_CASE("[Modules][GodotPhysics3D] Box contacts") {
+	GodotBoxShape3D box;
+	box.set_data(Vector3(0.5, 0.5, 0.5));
+
+	// Same box as a convex hull, which goes through the convex polygon separating axis tests.
+	GodotConvexPolygonShape3D convex_box;
+	convex_box.set_data(_box_points(Vector3(0.5, 0.5, 0.5)));
+
+	SUBCASE("Stacked boxes") {
+		Transform3D transform_A;
+		Transform3D transform_B(Basis(), Vector3(0, 0.9, 0));
+
+		ContactResult result;
+		CHECK(GodotCollisionSolver3D::solve_static(&box, transform_A, &box, transform_B, _contact_callback, &result));
+		CHECK(result.points_A.size() == 4);
+
+		for (uint32_t i = 0; i < result.points_A.size(); i++) {
+			CHECK(result.points_A[i].y == doctest::Approx(0.5));
+			CHECK(result.points_B[i].y == doctest::Approx(0.4));
+			CHECK(Math::abs(result.points_A[i].x) == doctest::Approx(0.5));
+			CHECK(Math::abs(result.points_A[i].z) == doctest::Approx(0.5));
+		}
+	}
+
+	SUBCASE("Separated boxes") {
+		Transform3D transform_A;
+		Transform3D transform_B(Basis(Vector3(0, 1, 0), Math::PI / 4.0), Vector3(0.6, 1.1, 0));
+
+		ContactResult result;
+		CHECK_FALSE(GodotCollisionSolver3D::solve_static(&box, transform_A, &box, transform_B, _contact_callback, &result));
+		CHECK(result.points_A.is_empty());
+	}
+
+	SUBCASE("Box and convex polygon agree") {
+		RandomPCG rng(5678);
+		const int iterations = 200;
+		int contact_count_mismatches = 0;
+
+		for (int iteration = 0; iteration < iterations; iteration++) {
+			Transform3D transform_A = _random_transform(rng, 0.2);
+			Transform3D transform_B = _random_transform(rng, 0.2);
+			transform_B.origin += Vector3(0, 0.9, 0);
+
+			ContactResult box_result;
+			bool box_collided = GodotCollisionSolver3D::solve_static(&box, transform_A, &box, transform_B, _contact_callback, &box_result);
+
+			ContactResult convex_result;
+			bool convex_collided = GodotCollisionSolver3D::solve_static(&box, transform_A, &convex_box, transform_B, _contact_callback, &convex_result);
+
+			REQUIRE(box_collided == convex_collided);
+
+			// Both go through the queued axes, so also check them against plain one axis at a time tests.
+			const real_t reference_depth = _reference_box_depth(box, transform_A, transform_B);
+			if (Math::abs(reference_depth) > 0.001) {
+				CHECK(box_collided == (reference_depth > 0.0));
+			}
+			if (!box_collided) {
+				continue;
+			}
+
+			// The contact features may be chosen differently for nearly parallel faces,
+			// but that should be rare, and the penetration depth must agree either way.
+			if (box_result.points_A.size() != convex_result.points_A.size()) {
+				contact_count_mismatches++;
+			}
+
+			const real_t box_depth = _contact_depth(box_result);
+			CHECK(box_depth == doctest::Approx(_contact_depth(convex_result)).epsilon(0.01));
+			CHECK(box_depth == doctest::Approx(reference_depth).epsilon(0.01));
+		}
+
+		CHECK_MESSAGE(contact_count_mismatches <= iterations / 20, vformat("%d of %d collisions produced a different number of contacts.", contact_count_mismatches, iterations));
+	}
+}
+
+TEST_CASE("[Modules][GodotPhysics3D][Benchmark] Separating axis test throughput" * doctest::skip(true)) {
+	GodotBoxShape3D box;
+	box.set_data(Vector3(0.5, 0.5, 0.5));
+
+	GodotConvexPolygonShape3D convex_box;
+	convex_box.set_data(_box_points(Vector3(0.5, 0.5, 0.5)));
+
+	const int pair_count = 1024;
+	const int iterations = 200;
+
+	RandomPCG rng(42);
+	LocalVector<Transform3D> transforms;
+	for (int i = 0; i < pair_count * 2; i++) {
+		transforms.push_back(_random_transform(rng, 1.5));
+	}
+
+	const GodotShape3D *shapes_B[2] = { &box, &convex_box };
+	const char *names[2] = { "box-box", "box-convex" };
+
+	for (int shape = 0; shape < 2; shape++) {
+		ContactResult result;
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+
+		for (int iteration = 0; iteration < iterations; iteration++) {
+			for (int i = 0; i < pair_count; i++) {
+				result.points_A.clear();
+				result.points_B.clear();
+				GodotCollisionSolver3D::solve_static(&box, transforms[i * 2], shapes_B[shape], transforms[i * 2 + 1], _contact_callback, &result);
+			}
+		}
+
+		uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+		double pairs_per_second = double(pair_count) * iterations * 1000000.0 / elapsed;
+		MESSAGE(names[shape], ": ", pairs_per_second, " pairs per second");
+	}
+}
+
+} // namespace TestGodotCollisionSolver3D
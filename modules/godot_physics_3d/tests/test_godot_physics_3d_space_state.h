@@ -0,0 +1,179 @@
+/**************************************************************************/
+/*  test_godot_physics_3d_space_state.h                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_physics_server_3d.h"
+
+#include "core/templates/hashfuncs.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotPhysics3DSpaceState {
+
+// A pile of boxes and spheres falling onto a floor.
+struct SpaceStateScene3D {
+	GodotPhysicsServer3D *server = nullptr;
+	RID space;
+	RID floor_shape;
+	RID box_shape;
+	RID sphere_shape;
+	RID floor;
+	LocalVector<RID> bodies;
+
+	SpaceStateScene3D() {
+		server = memnew(GodotPhysicsServer3D);
+		server->init();
+		server->set_active(true);
+
+		space = server->space_create();
+		server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY, 9.8);
+		server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY_VECTOR, Vector3(0, -1, 0));
+		server->space_set_active(space, true);
+
+		floor_shape = server->box_shape_create();
+		server->shape_set_data(floor_shape, Vector3(50, 1, 50));
+		floor = server->body_create();
+		server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+		server->body_add_shape(floor, floor_shape, Transform3D(Basis(), Vector3(0, -1, 0)));
+		server->body_set_space(floor, space);
+
+		box_shape = server->box_shape_create();
+		server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+		sphere_shape = server->sphere_shape_create();
+		server->shape_set_data(sphere_shape, 0.5);
+
+		for (int i = 0; i < 100; i++) {
+			RID body = server->body_create();
+			server->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+			server->body_add_shape(body, (i % 3) == 0 ? sphere_shape : box_shape);
+			// Offset every layer so bodies land on each other and tumble.
+			const Vector3 origin = Vector3((i % 5) * 1.5 + ((i / 25) % 2) * 0.6, 1 + (i / 25) * 1.2, ((i / 5) % 5) * 1.5);
+			server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(Vector3(1, 1, 0).normalized(), i * 0.1), origin));
+			server->body_set_space(body, space);
+			bodies.push_back(body);
+		}
+	}
+
+	void step(int p_count) {
+		for (int i = 0; i < p_count; i++) {
+			server->step(1.0 / 60.0);
+		}
+	}
+
+	uint32_t hash() const {
+		uint32_t h = HASH_MURMUR3_SEED;
+		for (const RID &body : bodies) {
+			const Transform3D transform = server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+			const Vector3 linear_velocity = server->body_get_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+			const Vector3 angular_velocity = server->body_get_state(body, PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY);
+			const bool sleeping = server->body_get_state(body, PhysicsServer3D::BODY_STATE_SLEEPING);
+			for (int i = 0; i < 3; i++) {
+				for (int j = 0; j < 3; j++) {
+					h = hash_murmur3_one_real(transform.basis.rows[i][j], h);
+				}
+				h = hash_murmur3_one_real(transform.origin[i], h);
+				h = hash_murmur3_one_real(linear_velocity[i], h);
+				h = hash_murmur3_one_real(angular_velocity[i], h);
+			}
+			h = hash_murmur3_one_32(sleeping, h);
+		}
+		return hash_fmix32(h);
+	}
+
+	~SpaceStateScene3D() {
+		for (const RID &body : bodies) {
+			server->free(body);
+		}
+		server->free(floor);
+		server->free(box_shape);
+		server->free(sphere_shape);
+		server->free(floor_shape);
+		server->free(space);
+
+		server->finish();
+		memdelete(server);
+	}
+};
+
+TEST_CASE("[Modules][GodotPhysics3D] Restoring a saved space state replays the same simulation") {
+	SpaceStateScene3D scene;
+	scene.step(30);
+
+	const PackedByteArray state = scene.server->space_save_state(scene.space);
+	REQUIRE_FALSE(state.is_empty());
+	const uint32_t saved_hash = scene.hash();
+
+	scene.step(60);
+	const uint32_t stepped_hash = scene.hash();
+	CHECK(stepped_hash != saved_hash);
+
+	REQUIRE(scene.server->space_restore_state(scene.space, state) == OK);
+	CHECK(scene.hash() == saved_hash);
+
+	scene.step(60);
+	CHECK_MESSAGE(scene.hash() == stepped_hash, "Stepping from a restored state should give the same results as the first time.");
+}
+
+TEST_CASE("[Modules][GodotPhysics3D] Malformed space states are rejected") {
+	SpaceStateScene3D scene;
+	scene.step(10);
+
+	const PackedByteArray state = scene.server->space_save_state(scene.space);
+	REQUIRE(state.size() > 16);
+	scene.step(10);
+	const uint32_t current_hash = scene.hash();
+
+	ERR_PRINT_OFF;
+	CHECK(scene.server->space_restore_state(scene.space, PackedByteArray()) == ERR_INVALID_DATA);
+
+	PackedByteArray truncated = state;
+	truncated.resize(state.size() - 1);
+	CHECK(scene.server->space_restore_state(scene.space, truncated) == ERR_INVALID_DATA);
+
+	PackedByteArray extended = state;
+	extended.push_back(0);
+	CHECK(scene.server->space_restore_state(scene.space, extended) == ERR_INVALID_DATA);
+
+	PackedByteArray bad_magic = state;
+	bad_magic.write[0] ^= 0xff;
+	CHECK(scene.server->space_restore_state(scene.space, bad_magic) == ERR_INVALID_DATA);
+
+	// The body count is the fifth field of the header, the records no longer match the data size.
+	PackedByteArray bad_count = state;
+	bad_count.write[16] += 1;
+	CHECK(scene.server->space_restore_state(scene.space, bad_count) == ERR_INVALID_DATA);
+	ERR_PRINT_ON;
+
+	// A rejected state leaves the space untouched.
+	CHECK(scene.hash() == current_hash);
+}
+
+} // namespace TestGodotPhysics3DSpaceState
@@ -1153,11 +1153,18 @@ void GridMap::_update_octants_callback() {
 
 	LocalVector<OctantKey> to_delete;
 	to_delete.reserve(octant_map.size());
+#ifndef PHYSICS_3D_DISABLED
+	// Octants add a collision shape per cell.
+	PhysicsServer3D::get_singleton()->begin_command_batch();
+#endif // PHYSICS_3D_DISABLED
 	for (const KeyValue<OctantKey, Octant *> &E : octant_map) {
 		if (_octant_update(E.key)) {
 			to_delete.push_back(E.key);
 		}
 	}
+#ifndef PHYSICS_3D_DISABLED
+	PhysicsServer3D::get_singleton()->end_command_batch();
+#endif // PHYSICS_3D_DISABLED
 
 	while (!to_delete.is_empty()) {
 		const OctantKey &octantkey = to_delete[0];
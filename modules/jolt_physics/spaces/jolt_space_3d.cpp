@@ -255,6 +255,9 @@ double JoltSpace3D::get_param(PhysicsServer3D::SpaceParameter p_param) const {
 		case PhysicsServer3D::SPACE_PARAM_SOLVER_ITERATIONS: {
 			return SPACE_DEFAULT_SOLVER_ITERATIONS;
 		}
+		case PhysicsServer3D::SPACE_PARAM_SOFT_BODY_PARALLEL_SOLVER: {
+			return 0.0;
+		}
 		default: {
 			ERR_FAIL_V_MSG(0.0, vformat("Unhandled space parameter: '%d'. This should not happen. Please report this.", p_param));
 		}
@@ -287,6 +290,9 @@ void JoltSpace3D::set_param(PhysicsServer3D::SpaceParameter p_param, double p_va
 		case PhysicsServer3D::SPACE_PARAM_SOLVER_ITERATIONS: {
 			WARN_PRINT("Space-specific solver iterations is not supported when using Jolt Physics. Any such value will be ignored.");
 		} break;
+		case PhysicsServer3D::SPACE_PARAM_SOFT_BODY_PARALLEL_SOLVER: {
+			WARN_PRINT("Space-specific soft body parallel solver is not supported when using Jolt Physics. Any such value will be ignored.");
+		} break;
 		default: {
 			ERR_FAIL_MSG(vformat("Unhandled space parameter: '%d'. This should not happen. Please report this.", p_param));
 		} break;
@@ -693,6 +693,8 @@ void TileMapLayer::_rendering_draw_cell_debug(const RID &p_canvas_item, const Ve
 #ifndef PHYSICS_2D_DISABLED
 void TileMapLayer::_physics_update(bool p_force_cleanup) {
 	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	// Bodies and shapes are recreated for every dirty quadrant.
+	ps->begin_command_batch();
 
 	// Check if we should cleanup everything.
 	bool forced_cleanup = p_force_cleanup || !enabled || !collision_enabled || !is_inside_tree() || tile_set.is_null();
@@ -911,6 +913,7 @@ void TileMapLayer::_physics_update(bool p_force_cleanup) {
 			}
 		}
 	}
+	ps->end_command_batch();
 
 	// -----------
 	// Mark the physics state as up to date.
@@ -991,6 +994,7 @@ void TileMapLayer::_physics_notification(int p_what) {
 		case NOTIFICATION_TRANSFORM_CHANGED:
 			// Move the collisison shapes along with the TileMap.
 			if (is_inside_tree() && tile_set.is_valid()) {
+				ps->begin_command_batch();
 				for (KeyValue<Vector2i, Ref<PhysicsQuadrant>> &kv : physics_quadrant_map) {
 					for (const KeyValue<PhysicsQuadrant::PhysicsBodyKey, PhysicsQuadrant::PhysicsBodyValue> &kvbody : kv.value->bodies) {
 						const RID &body = kvbody.value.body;
@@ -999,6 +1003,7 @@ void TileMapLayer::_physics_notification(int p_what) {
 						ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, xform);
 					}
 				}
+				ps->end_command_batch();
 			}
 			break;
 		case NOTIFICATION_ENTER_TREE:
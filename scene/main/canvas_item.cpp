@@ -137,6 +137,8 @@ void CanvasItem::_redraw_callback() {
 	}
 
 	RID ci = get_canvas_item();
+	// Drawing sends a command per primitive.
+	RenderingServer::get_singleton()->begin_command_batch();
 	RenderingServer::get_singleton()->canvas_item_clear(ci);
 	//todo updating = true - only allow drawing here
 	if (is_visible_in_tree()) {
@@ -155,6 +157,7 @@ void CanvasItem::_redraw_callback() {
 		}
 		drawing = false;
 	}
+	RenderingServer::get_singleton()->end_command_batch();
 	//todo updating = false
 	pending_update = false; // don't change to false until finished drawing (avoid recursive update)
 }
@@ -193,6 +193,12 @@ void SceneTree::flush_transform_notifications() {
 	_THREAD_SAFE_METHOD_
 
 	SelfList<Node> *n = xform_change_list.first();
+	if (!n) {
+		return;
+	}
+
+	// Visual nodes update their instance transforms in a burst.
+	RenderingServer::get_singleton()->begin_command_batch();
 	while (n) {
 		Node *node = n->self();
 		SelfList<Node> *nx = n->next();
@@ -200,6 +206,7 @@ void SceneTree::flush_transform_notifications() {
 		n = nx;
 		node->notification(NOTIFICATION_TRANSFORM_CHANGED);
 	}
+	RenderingServer::get_singleton()->end_command_batch();
 }
 
 bool SceneTree::is_accessibility_enabled() const {
@@ -265,6 +265,7 @@ public:
 		SPACE_PARAM_BODY_TIME_TO_SLEEP,
 		SPACE_PARAM_CONSTRAINT_DEFAULT_BIAS,
 		SPACE_PARAM_SOLVER_ITERATIONS,
+		SPACE_PARAM_DETERMINISTIC,
 	};
 
 	virtual void space_set_param(RID p_space, SpaceParameter p_param, real_t p_value) = 0;
@@ -277,6 +278,10 @@ public:
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	// Snapshot of the simulation state of a space, for rollback. Not all physics servers support it.
+	virtual PackedByteArray space_save_state(RID p_space) const;
+	virtual Error space_restore_state(RID p_space, const PackedByteArray &p_state);
+
 	//missing space parameters
 
 	/* AREA API */
@@ -600,6 +605,10 @@ public:
 	virtual void end_sync() = 0;
 	virtual void finish() = 0;
 
+	// Calls made by the current thread in between are handed over to the physics thread in batches.
+	virtual void begin_command_batch() {}
+	virtual void end_command_batch() {}
+
 	virtual bool is_flushing_queries() const = 0;
 
 	enum ProcessInfo {
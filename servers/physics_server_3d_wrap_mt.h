@@ -127,6 +127,9 @@ public:
 		return physics_server_3d->space_get_contact_count(p_space);
 	}
 
+	FUNC1RC(PackedByteArray, space_save_state, RID);
+	FUNC2R(Error, space_restore_state, RID, const PackedByteArray &);
+
 	/* AREA API */
 
 	//FUNC0RID(area);
@@ -396,6 +399,18 @@ public:
 	virtual void flush_queries() override;
 	virtual void finish() override;
 
+	virtual void begin_command_batch() override {
+		if (Thread::get_caller_id() != server_thread) {
+			command_queue.begin_batch();
+		}
+	}
+
+	virtual void end_command_batch() override {
+		if (Thread::get_caller_id() != server_thread) {
+			command_queue.end_batch();
+		}
+	}
+
 	virtual bool is_flushing_queries() const override {
 		return physics_server_3d->is_flushing_queries();
 	}
@@ -0,0 +1,637 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "raster_occlusion_cull.h"
+
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/sort_array.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RASTER_OCCLUSION_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define RASTER_OCCLUSION_NEON
+#include <arm_neon.h>
+#endif
+
+RasterOcclusionCull *RasterOcclusionCull::raster_singleton = nullptr;
+
+void RasterOcclusionCull::RasterHZBuffer::clear() {
+	HZBuffer::clear();
+
+	tiles.clear();
+	pixel_distance_scales.clear();
+	triangles.clear();
+	tile_grid_size = Size2i();
+}
+
+void RasterOcclusionCull::RasterHZBuffer::resize(const Size2i &p_size) {
+	if (p_size == Size2i()) {
+		clear();
+		return;
+	}
+
+	if (!sizes.is_empty() && p_size == sizes[0]) {
+		return; // Size didn't change
+	}
+
+	HZBuffer::resize(p_size);
+
+	tile_grid_size = Size2i(Math::division_round_up(p_size.x, TILE_SIZE), Math::division_round_up(p_size.y, TILE_SIZE));
+	tiles.resize(tile_grid_size.x * tile_grid_size.y);
+	pixel_distance_scales.resize(p_size.x * p_size.y);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::rasterize(const Rect2 &p_viewport_rect, real_t p_z_near, real_t p_z_far, bool p_cam_orthogonal) {
+	const Size2i &buffer_size = sizes[0];
+
+	perspective = !p_cam_orthogonal;
+	far_distance = p_z_far * 1.05f; // Same as the distance of raycasts that don't hit anything.
+	debug_tex_range = far_distance;
+
+	float *depth = mips[0];
+	for (int i = 0; i < buffer_size.x * buffer_size.y; i++) {
+		depth[i] = far_distance;
+	}
+
+	// The viewport can change every frame because of jittering, so this can't be cached.
+	for (int y = 0; y < buffer_size.y; y++) {
+		float near_y = (p_viewport_rect.position.y + (y + 0.5f) / buffer_size.y * p_viewport_rect.size.y) / p_z_near;
+		for (int x = 0; x < buffer_size.x; x++) {
+			float near_x = (p_viewport_rect.position.x + (x + 0.5f) / buffer_size.x * p_viewport_rect.size.x) / p_z_near;
+			pixel_distance_scales[y * buffer_size.x + x] = perspective ? Math::sqrt(1.0f + near_x * near_x + near_y * near_y) : 1.0f;
+		}
+	}
+
+	if (triangles.is_empty()) {
+		update_mips();
+		return;
+	}
+
+	// Bin the triangles in the tiles they touch.
+	for (Tile &tile : tiles) {
+		tile.triangles.clear();
+	}
+
+	for (uint32_t i = 0; i < triangles.size(); i++) {
+		const Triangle &triangle = triangles[i];
+		for (int y = triangle.rect_min_y / TILE_SIZE; y <= triangle.rect_max_y / TILE_SIZE; y++) {
+			for (int x = triangle.rect_min_x / TILE_SIZE; x <= triangle.rect_max_x / TILE_SIZE; x++) {
+				tiles[y * tile_grid_size.x + x].triangles.push_back(i);
+			}
+		}
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_rasterize_tile, (const Triangle *)triangles.ptr(), tiles.size(), -1, true, SNAME("RasterOcclusionCullRasterize"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	update_mips();
+}
+
+struct RasterTriangleDistanceComparator {
+	const RasterOcclusionCull::RasterHZBuffer::Triangle *triangles = nullptr;
+
+	_FORCE_INLINE_ bool operator()(uint32_t p_a, uint32_t p_b) const {
+		return triangles[p_a].min_distance < triangles[p_b].min_distance;
+	}
+};
+
+void RasterOcclusionCull::RasterHZBuffer::_rasterize_tile(uint32_t p_tile, const Triangle *p_triangles) {
+	Tile &tile = tiles[p_tile];
+	if (tile.triangles.is_empty()) {
+		return;
+	}
+
+	const Size2i &buffer_size = sizes[0];
+	int min_x = (p_tile % tile_grid_size.x) * TILE_SIZE;
+	int min_y = (p_tile / tile_grid_size.x) * TILE_SIZE;
+	int max_x = MIN(min_x + TILE_SIZE, buffer_size.x) - 1;
+	int max_y = MIN(min_y + TILE_SIZE, buffer_size.y) - 1;
+
+	// Front to back, so the triangles behind everything drawn so far in the tile can be skipped.
+	SortArray<uint32_t, RasterTriangleDistanceComparator> sorter;
+	sorter.compare.triangles = p_triangles;
+	sorter.sort(tile.triangles.ptr(), tile.triangles.size());
+
+	const float *depth = mips[0];
+	float tile_max_distance = far_distance;
+
+	for (uint32_t i = 0; i < tile.triangles.size(); i++) {
+		const Triangle &triangle = p_triangles[tile.triangles[i]];
+		if (triangle.min_distance >= tile_max_distance) {
+			break; // This and all the following ones are hidden.
+		}
+
+		_rasterize_triangle(triangle, MAX(min_x, triangle.rect_min_x), MAX(min_y, triangle.rect_min_y), MIN(max_x, triangle.rect_max_x), MIN(max_y, triangle.rect_max_y));
+
+		if ((i & 7) == 7) {
+			tile_max_distance = 0.0f;
+			for (int y = min_y; y <= max_y; y++) {
+				for (int x = min_x; x <= max_x; x++) {
+					tile_max_distance = MAX(tile_max_distance, depth[y * buffer_size.x + x]);
+				}
+			}
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_rasterize_triangle(const Triangle &p_triangle, int p_min_x, int p_min_y, int p_max_x, int p_max_y) {
+	const int width = sizes[0].x;
+
+#if defined(RASTER_OCCLUSION_SSE2)
+	const __m128 lane_offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 edge_a0 = _mm_set1_ps(p_triangle.edge_a[0]);
+	const __m128 edge_a1 = _mm_set1_ps(p_triangle.edge_a[1]);
+	const __m128 edge_a2 = _mm_set1_ps(p_triangle.edge_a[2]);
+	const __m128 depth_a = _mm_set1_ps(p_triangle.depth_a);
+	const __m128 depth_min = _mm_set1_ps(p_triangle.depth_min);
+	const __m128 depth_max = _mm_set1_ps(p_triangle.depth_max);
+#elif defined(RASTER_OCCLUSION_NEON)
+	const float lane_offsets_array[4] = { 0.5f, 1.5f, 2.5f, 3.5f };
+	const float32x4_t lane_offsets = vld1q_f32(lane_offsets_array);
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	const float32x4_t one = vdupq_n_f32(1.0f);
+	const float32x4_t edge_a0 = vdupq_n_f32(p_triangle.edge_a[0]);
+	const float32x4_t edge_a1 = vdupq_n_f32(p_triangle.edge_a[1]);
+	const float32x4_t edge_a2 = vdupq_n_f32(p_triangle.edge_a[2]);
+	const float32x4_t depth_a = vdupq_n_f32(p_triangle.depth_a);
+	const float32x4_t depth_min = vdupq_n_f32(p_triangle.depth_min);
+	const float32x4_t depth_max = vdupq_n_f32(p_triangle.depth_max);
+#endif
+
+	for (int y = p_min_y; y <= p_max_y; y++) {
+		const float py = y + 0.5f;
+		// Edge functions and depth at x = 0 for this row.
+		const float edge_row0 = p_triangle.edge_b[0] * py + p_triangle.edge_c[0];
+		const float edge_row1 = p_triangle.edge_b[1] * py + p_triangle.edge_c[1];
+		const float edge_row2 = p_triangle.edge_b[2] * py + p_triangle.edge_c[2];
+		const float depth_row = p_triangle.depth_b * py + p_triangle.depth_c;
+
+		float *row = &mips[0][y * width];
+		const float *row_scales = &pixel_distance_scales[y * width];
+		int x = p_min_x;
+
+#if defined(RASTER_OCCLUSION_SSE2)
+		const __m128 edge_row0_v = _mm_set1_ps(edge_row0);
+		const __m128 edge_row1_v = _mm_set1_ps(edge_row1);
+		const __m128 edge_row2_v = _mm_set1_ps(edge_row2);
+		const __m128 depth_row_v = _mm_set1_ps(depth_row);
+
+		for (; x + 3 <= p_max_x; x += 4) {
+			const __m128 px = _mm_add_ps(_mm_set1_ps(float(x)), lane_offsets);
+			const __m128 e0 = _mm_add_ps(_mm_mul_ps(edge_a0, px), edge_row0_v);
+			const __m128 e1 = _mm_add_ps(_mm_mul_ps(edge_a1, px), edge_row1_v);
+			const __m128 e2 = _mm_add_ps(_mm_mul_ps(edge_a2, px), edge_row2_v);
+			const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+			if (_mm_movemask_ps(inside) == 0) {
+				continue;
+			}
+
+			__m128 distance = _mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(depth_a, px), depth_row_v), depth_min), depth_max);
+			if (perspective) {
+				distance = _mm_div_ps(one, distance);
+			}
+			distance = _mm_mul_ps(distance, _mm_loadu_ps(&row_scales[x]));
+
+			const __m128 previous = _mm_loadu_ps(&row[x]);
+			const __m128 closest = _mm_min_ps(previous, distance);
+			_mm_storeu_ps(&row[x], _mm_or_ps(_mm_and_ps(inside, closest), _mm_andnot_ps(inside, previous)));
+		}
+#elif defined(RASTER_OCCLUSION_NEON)
+		const float32x4_t edge_row0_v = vdupq_n_f32(edge_row0);
+		const float32x4_t edge_row1_v = vdupq_n_f32(edge_row1);
+		const float32x4_t edge_row2_v = vdupq_n_f32(edge_row2);
+		const float32x4_t depth_row_v = vdupq_n_f32(depth_row);
+
+		for (; x + 3 <= p_max_x; x += 4) {
+			const float32x4_t px = vaddq_f32(vdupq_n_f32(float(x)), lane_offsets);
+			const float32x4_t e0 = vmlaq_f32(edge_row0_v, edge_a0, px);
+			const float32x4_t e1 = vmlaq_f32(edge_row1_v, edge_a1, px);
+			const float32x4_t e2 = vmlaq_f32(edge_row2_v, edge_a2, px);
+			const uint32x4_t inside = vandq_u32(vandq_u32(vcgeq_f32(e0, zero), vcgeq_f32(e1, zero)), vcgeq_f32(e2, zero));
+			if (vmaxvq_u32(inside) == 0) {
+				continue;
+			}
+
+			float32x4_t distance = vminq_f32(vmaxq_f32(vmlaq_f32(depth_row_v, depth_a, px), depth_min), depth_max);
+			if (perspective) {
+				distance = vdivq_f32(one, distance);
+			}
+			distance = vmulq_f32(distance, vld1q_f32(&row_scales[x]));
+
+			const float32x4_t previous = vld1q_f32(&row[x]);
+			vst1q_f32(&row[x], vbslq_f32(inside, vminq_f32(previous, distance), previous));
+		}
+#endif
+
+		// Remaining pixels, or all of them without SIMD.
+		for (; x <= p_max_x; x++) {
+			const float px = x + 0.5f;
+			if (p_triangle.edge_a[0] * px + edge_row0 < 0.0f || p_triangle.edge_a[1] * px + edge_row1 < 0.0f || p_triangle.edge_a[2] * px + edge_row2 < 0.0f) {
+				continue;
+			}
+
+			float distance = CLAMP(p_triangle.depth_a * px + depth_row, p_triangle.depth_min, p_triangle.depth_max);
+			if (perspective) {
+				distance = 1.0f / distance;
+			}
+			distance *= row_scales[x];
+
+			row[x] = MIN(row[x], distance);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////
+
+bool RasterOcclusionCull::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RasterOcclusionCull::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RasterOcclusionCull::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RasterOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+
+	for (const InstanceID &E : occluder->users) {
+		ERR_CONTINUE(!scenarios.has(E.scenario));
+		Scenario &scenario = scenarios[E.scenario];
+		ERR_CONTINUE(!scenario.instances.has(E.instance));
+
+		scenario.dirty_instances.insert(E.instance);
+	}
+}
+
+void RasterOcclusionCull::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_scenario(RID p_scenario) {
+	ERR_FAIL_COND(scenarios.has(p_scenario));
+	scenarios[p_scenario] = Scenario();
+}
+
+void RasterOcclusionCull::remove_scenario(RID p_scenario) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	for (const KeyValue<RID, OccluderInstance> &E : scenario.instances) {
+		Occluder *occluder = occluder_owner.get_or_null(E.value.occluder);
+		if (occluder) {
+			occluder->users.erase(InstanceID(p_scenario, E.key));
+		}
+	}
+
+	scenarios.erase(p_scenario);
+}
+
+void RasterOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (!scenario.instances.has(p_instance)) {
+		scenario.instances[p_instance] = OccluderInstance();
+	}
+
+	OccluderInstance &instance = scenario.instances[p_instance];
+
+	bool changed = false;
+
+	if (instance.occluder != p_occluder) {
+		Occluder *old_occluder = occluder_owner.get_or_null(instance.occluder);
+		if (old_occluder) {
+			old_occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		instance.occluder = p_occluder;
+
+		if (p_occluder.is_valid()) {
+			Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+			ERR_FAIL_NULL(occluder);
+			occluder->users.insert(InstanceID(p_scenario, p_instance));
+		}
+		changed = true;
+	}
+
+	if (instance.xform != p_xform) {
+		instance.xform = p_xform;
+		changed = true;
+	}
+
+	if (instance.enabled != p_enabled) {
+		instance.enabled = p_enabled;
+		changed = true;
+	}
+
+	if (changed) {
+		scenario.dirty_instances.insert(p_instance);
+	}
+}
+
+void RasterOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (scenario.instances.has(p_instance)) {
+		OccluderInstance &instance = scenario.instances[p_instance];
+
+		Occluder *occluder = occluder_owner.get_or_null(instance.occluder);
+		if (occluder) {
+			occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		scenario.instances.erase(p_instance);
+		scenario.dirty_instances.erase(p_instance);
+	}
+}
+
+void RasterOcclusionCull::Scenario::update() {
+	for (const RID &instance_rid : dirty_instances) {
+		OccluderInstance &instance = instances[instance_rid];
+		instance.xformed_vertices.clear();
+		instance.indices.clear();
+		instance.aabb = AABB();
+
+		const Occluder *occluder = raster_singleton->occluder_owner.get_or_null(instance.occluder);
+		if (!occluder || !instance.enabled) {
+			continue;
+		}
+
+		const Vector3 *read = occluder->vertices.ptr();
+		instance.xformed_vertices.resize(occluder->vertices.size());
+		for (int i = 0; i < occluder->vertices.size(); i++) {
+			instance.xformed_vertices[i] = instance.xform.xform(read[i]);
+			if (i == 0) {
+				instance.aabb.position = instance.xformed_vertices[i];
+			} else {
+				instance.aabb.expand_to(instance.xformed_vertices[i]);
+			}
+		}
+
+		instance.indices.resize(occluder->indices.size() - occluder->indices.size() % 3);
+		for (uint32_t i = 0; i < instance.indices.size(); i++) {
+			instance.indices[i] = occluder->indices[i];
+			if (instance.indices[i] >= instance.xformed_vertices.size()) {
+				instance.indices.clear();
+				ERR_PRINT("Occluder mesh has out of bounds indices, ignoring it.");
+				break;
+			}
+		}
+	}
+
+	dirty_instances.clear();
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RasterOcclusionCull::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+void RasterOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RasterOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+void RasterOcclusionCull::_setup_triangle(const Vector3 p_vertices[3], const SetupData &p_data, LocalVector<RasterHZBuffer::Triangle> &r_triangles) {
+	// Clip against the near plane, leaving up to four vertices, in view space with the depth as a positive Z.
+	Vector3 clipped[4];
+	int clipped_count = 0;
+	for (int i = 0; i < 3; i++) {
+		const Vector3 &a = p_vertices[i];
+		const Vector3 &b = p_vertices[(i + 1) % 3];
+		const bool a_inside = a.z >= p_data.z_near;
+		const bool b_inside = b.z >= p_data.z_near;
+		if (a_inside) {
+			clipped[clipped_count++] = a;
+		}
+		if (a_inside != b_inside) {
+			clipped[clipped_count++] = a.lerp(b, (p_data.z_near - a.z) / (b.z - a.z));
+		}
+	}
+
+	if (clipped_count < 3) {
+		return;
+	}
+
+	const Size2 buffer_size = p_data.buffer_size;
+	Vector2 screen[4];
+	float depth[4];
+	for (int i = 0; i < clipped_count; i++) {
+		Vector2 near_plane = Vector2(clipped[i].x, clipped[i].y);
+		if (p_data.orthogonal) {
+			depth[i] = clipped[i].z;
+		} else {
+			near_plane *= p_data.z_near / clipped[i].z;
+			depth[i] = 1.0f / clipped[i].z;
+		}
+		screen[i] = (near_plane - p_data.viewport_rect.position) / p_data.viewport_rect.size * buffer_size;
+	}
+
+	for (int i = 2; i < clipped_count; i++) {
+		int indices[3] = { 0, i - 1, i };
+
+		Vector2 v0 = screen[indices[0]];
+		Vector2 v1 = screen[indices[1]];
+		Vector2 v2 = screen[indices[2]];
+
+		float area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+		if (Math::abs(area) < CMP_EPSILON) {
+			continue;
+		}
+		if (area < 0.0f) {
+			// Occluders are double sided, make the edge functions positive inside either way.
+			SWAP(indices[1], indices[2]);
+			SWAP(v1, v2);
+			area = -area;
+		}
+
+		// Pixels whose centers are inside the bounding rectangle.
+		Vector2 rect_min = v0.min(v1).min(v2);
+		Vector2 rect_max = v0.max(v1).max(v2);
+		RasterHZBuffer::Triangle triangle;
+		triangle.rect_min_x = Math::ceil(CLAMP(rect_min.x - 0.5f, 0.0f, buffer_size.x));
+		triangle.rect_min_y = Math::ceil(CLAMP(rect_min.y - 0.5f, 0.0f, buffer_size.y));
+		triangle.rect_max_x = Math::floor(CLAMP(rect_max.x - 0.5f, -1.0f, buffer_size.x - 1.0f));
+		triangle.rect_max_y = Math::floor(CLAMP(rect_max.y - 0.5f, -1.0f, buffer_size.y - 1.0f));
+		if (triangle.rect_min_x > triangle.rect_max_x || triangle.rect_min_y > triangle.rect_max_y) {
+			continue;
+		}
+
+		const Vector2 v[3] = { v0, v1, v2 };
+		for (int j = 0; j < 3; j++) {
+			const Vector2 &a = v[j];
+			const Vector2 &b = v[(j + 1) % 3];
+			triangle.edge_a[j] = a.y - b.y;
+			triangle.edge_b[j] = b.x - a.x;
+			triangle.edge_c[j] = a.x * b.y - b.x * a.y;
+		}
+
+		const float q0 = depth[indices[0]];
+		const float q1 = depth[indices[1]];
+		const float q2 = depth[indices[2]];
+		triangle.depth_a = ((q1 - q0) * (v2.y - v0.y) - (q2 - q0) * (v1.y - v0.y)) / area;
+		triangle.depth_b = ((q2 - q0) * (v1.x - v0.x) - (q1 - q0) * (v2.x - v0.x)) / area;
+		triangle.depth_c = q0 - triangle.depth_a * v0.x - triangle.depth_b * v0.y;
+		triangle.depth_min = MIN(q0, MIN(q1, q2));
+		triangle.depth_max = MAX(q0, MAX(q1, q2));
+		triangle.min_distance = p_data.orthogonal ? triangle.depth_min : 1.0f / triangle.depth_max;
+
+		r_triangles.push_back(triangle);
+	}
+}
+
+void RasterOcclusionCull::_setup_triangles_threaded(uint32_t p_thread, SetupData *p_data) {
+	uint32_t total_instances = p_data->instances.size();
+	uint32_t from = p_thread * total_instances / p_data->thread_count;
+	uint32_t to = (p_thread + 1 == p_data->thread_count) ? total_instances : ((p_thread + 1) * total_instances / p_data->thread_count);
+
+	LocalVector<RasterHZBuffer::Triangle> &triangles = p_data->thread_triangles[p_thread];
+	triangles.clear();
+
+	LocalVector<Vector3> view_vertices;
+	for (uint32_t i = from; i < to; i++) {
+		const OccluderInstance *instance = p_data->instances[i];
+
+		view_vertices.resize(instance->xformed_vertices.size());
+		for (uint32_t j = 0; j < view_vertices.size(); j++) {
+			view_vertices[j] = p_data->cam_inv_transform.xform(instance->xformed_vertices[j]);
+			view_vertices[j].z = -view_vertices[j].z;
+		}
+
+		for (uint32_t j = 0; j < instance->indices.size(); j += 3) {
+			const Vector3 vertices[3] = { view_vertices[instance->indices[j]], view_vertices[instance->indices[j + 1]], view_vertices[instance->indices[j + 2]] };
+			_setup_triangle(vertices, *p_data, triangles);
+		}
+	}
+}
+
+void RasterOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	if (!buffers.has(p_buffer)) {
+		return;
+	}
+
+	RasterHZBuffer &buffer = buffers[p_buffer];
+
+	if (buffer.is_empty() || !scenarios.has(buffer.scenario_rid)) {
+		return;
+	}
+
+	Scenario &scenario = scenarios[buffer.scenario_rid];
+	scenario.update();
+
+	SetupData setup;
+	setup.cam_inv_transform = p_cam_transform.affine_inverse();
+	setup.viewport_rect = _get_viewport_rect(p_cam_projection);
+	setup.viewport_rect.position += _get_jitter(setup.viewport_rect, buffer.get_occlusion_buffer_size());
+	setup.buffer_size = buffer.sizes[0];
+	setup.z_near = p_cam_projection.get_z_near();
+	setup.orthogonal = p_cam_orthogonal;
+
+	Vector<Plane> planes = p_cam_projection.get_projection_planes(p_cam_transform);
+	Vector3 frustum_points[8];
+	p_cam_projection.get_endpoints(p_cam_transform, frustum_points);
+
+	for (const KeyValue<RID, OccluderInstance> &E : scenario.instances) {
+		if (!E.value.indices.is_empty() && E.value.aabb.intersects_convex_shape(planes.ptr(), planes.size(), frustum_points, 8)) {
+			setup.instances.push_back(&E.value);
+		}
+	}
+
+	buffer.triangles.clear();
+
+	if (!setup.instances.is_empty()) {
+		setup.thread_count = MIN(setup.instances.size(), (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count());
+		setup.thread_triangles.resize(setup.thread_count);
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterOcclusionCull::_setup_triangles_threaded, &setup, setup.thread_count, -1, true, SNAME("RasterOcclusionCullSetup"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (const LocalVector<RasterHZBuffer::Triangle> &triangles : setup.thread_triangles) {
+			for (const RasterHZBuffer::Triangle &triangle : triangles) {
+				buffer.triangles.push_back(triangle);
+			}
+		}
+	}
+
+	buffer.rasterize(setup.viewport_rect, setup.z_near, p_cam_projection.get_z_far(), p_cam_orthogonal);
+}
+
+RasterOcclusionCull::HZBuffer *RasterOcclusionCull::buffer_get_ptr(RID p_buffer) {
+	if (!buffers.has(p_buffer)) {
+		return nullptr;
+	}
+	return &buffers[p_buffer];
+}
+
+RID RasterOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
+
+////////////////////////////////////////////////////////
+
+RasterOcclusionCull::RasterOcclusionCull() {
+	raster_singleton = this;
+}
+
+RasterOcclusionCull::~RasterOcclusionCull() {
+	raster_singleton = nullptr;
+}
@@ -0,0 +1,176 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/projection.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rid_owner.h"
+#include "servers/rendering/renderer_scene_occlusion_cull.h"
+
+// Software occlusion culling that doesn't depend on any third-party library.
+// Occluder triangles are rasterized into the depth buffer in screen tiles, each tile on its own thread,
+// producing the same depths as the raycasting implementation (the distance to the camera at pixel centers).
+class RasterOcclusionCull : public RendererSceneOcclusionCull {
+public:
+	class RasterHZBuffer : public HZBuffer {
+		friend class RasterOcclusionCull;
+
+	public:
+		struct Triangle {
+			// Edge functions, positive inside.
+			float edge_a[3];
+			float edge_b[3];
+			float edge_c[3];
+			// Depth plane. Holds 1/z for perspective cameras, z for orthogonal ones.
+			float depth_a;
+			float depth_b;
+			float depth_c;
+			float depth_min;
+			float depth_max;
+			// The closest the triangle can get to the camera, used to skip it in tiles where it's hidden.
+			float min_distance;
+			int rect_min_x;
+			int rect_min_y;
+			int rect_max_x;
+			int rect_max_y;
+		};
+
+		struct Tile {
+			LocalVector<uint32_t> triangles;
+		};
+
+	private:
+		static const int TILE_SIZE = 16;
+
+		Size2i tile_grid_size;
+		LocalVector<Tile> tiles;
+		// Distance to the camera at each pixel center, per unit of view depth.
+		LocalVector<float> pixel_distance_scales;
+		LocalVector<Triangle> triangles;
+		bool perspective = true;
+		float far_distance = 0.0f;
+
+		void _rasterize_tile(uint32_t p_tile, const Triangle *p_triangles);
+		void _rasterize_triangle(const Triangle &p_triangle, int p_min_x, int p_min_y, int p_max_x, int p_max_y);
+
+	public:
+		RID scenario_rid;
+
+		virtual void clear() override;
+		virtual void resize(const Size2i &p_size) override;
+
+		void rasterize(const Rect2 &p_viewport_rect, real_t p_z_near, real_t p_z_far, bool p_cam_orthogonal);
+	};
+
+private:
+	struct InstanceID {
+		RID scenario;
+		RID instance;
+
+		static uint32_t hash(const InstanceID &p_ins) {
+			uint32_t h = hash_murmur3_one_64(p_ins.scenario.get_id());
+			return hash_fmix32(hash_murmur3_one_64(p_ins.instance.get_id(), h));
+		}
+		bool operator==(const InstanceID &rhs) const {
+			return instance == rhs.instance && rhs.scenario == scenario;
+		}
+
+		InstanceID() {}
+		InstanceID(RID s, RID i) :
+				scenario(s), instance(i) {}
+	};
+
+	struct Occluder {
+		PackedVector3Array vertices;
+		PackedInt32Array indices;
+		HashSet<InstanceID, InstanceID> users;
+	};
+
+	struct OccluderInstance {
+		RID occluder;
+		LocalVector<Vector3> xformed_vertices;
+		LocalVector<uint32_t> indices;
+		AABB aabb;
+		Transform3D xform;
+		bool enabled = true;
+	};
+
+	struct Scenario {
+		HashMap<RID, OccluderInstance> instances;
+		HashSet<RID> dirty_instances;
+
+		void update();
+	};
+
+	struct SetupData {
+		LocalVector<const OccluderInstance *> instances;
+		LocalVector<LocalVector<RasterHZBuffer::Triangle>> thread_triangles;
+		uint32_t thread_count = 0;
+		Transform3D cam_inv_transform;
+		Rect2 viewport_rect;
+		Size2i buffer_size;
+		float z_near = 0.0f;
+		bool orthogonal = false;
+	};
+
+	static RasterOcclusionCull *raster_singleton;
+
+	RID_PtrOwner<Occluder> occluder_owner;
+	HashMap<RID, Scenario> scenarios;
+	HashMap<RID, RasterHZBuffer> buffers;
+
+	void _setup_triangles_threaded(uint32_t p_thread, SetupData *p_data);
+	static void _setup_triangle(const Vector3 p_vertices[3], const SetupData &p_data, LocalVector<RasterHZBuffer::Triangle> &r_triangles);
+
+public:
+	virtual bool is_occluder(RID p_rid) override;
+	virtual RID occluder_allocate() override;
+	virtual void occluder_initialize(RID p_occluder) override;
+	virtual void occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) override;
+	virtual void free_occluder(RID p_occluder) override;
+
+	virtual void add_scenario(RID p_scenario) override;
+	virtual void remove_scenario(RID p_scenario) override;
+	virtual void scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) override;
+	virtual void scenario_remove_instance(RID p_scenario, RID p_instance) override;
+
+	virtual void add_buffer(RID p_buffer) override;
+	virtual void remove_buffer(RID p_buffer) override;
+	virtual HZBuffer *buffer_get_ptr(RID p_buffer) override;
+	virtual void buffer_set_scenario(RID p_buffer, RID p_scenario) override;
+	virtual void buffer_set_size(RID p_buffer, const Vector2i &p_size) override;
+	virtual void buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) override;
+
+	virtual RID buffer_get_debug_texture(RID p_buffer) override;
+
+	RasterOcclusionCull();
+	~RasterOcclusionCull();
+};
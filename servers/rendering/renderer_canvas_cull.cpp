@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/math/geometry_2d.h"
 #include "core/math/transform_interpolator.h"
+#include "core/object/worker_thread_pool.h"
 #include "renderer_viewport.h"
 #include "rendering_server_default.h"
 #include "rendering_server_globals.h"
@@ -78,8 +79,75 @@ void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas
 	memset(z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
 	memset(z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
 
+	uint32_t item_count = 0;
 	for (int i = 0; i < p_child_item_count; i++) {
-		_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, false, p_canvas_cull_mask, Point2(), 1, nullptr);
+		item_count += p_child_items[i].item->subtree_item_count;
+	}
+
+	const uint32_t thread_count = MIN((uint32_t)WorkerThreadPool::get_singleton()->get_thread_count(), (uint32_t)p_child_item_count);
+
+	if (thread_count > 1 && item_count >= thread_cull_threshold) {
+		if (cull_threads.size() < thread_count) {
+			uint32_t old_size = cull_threads.size();
+			cull_threads.resize(thread_count);
+			for (uint32_t i = old_size; i < thread_count; i++) {
+				cull_threads[i].z_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
+				cull_threads[i].z_last_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
+				memset(cull_threads[i].z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+				memset(cull_threads[i].z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+			}
+		}
+
+		// Split the top level items into contiguous ranges of similar size, so appending
+		// the lists of each thread in order keeps the draw order of the serial cull.
+		uint32_t from = 0;
+		uint32_t accum = 0;
+		for (uint32_t i = 0; i < thread_count; i++) {
+			const uint32_t target = uint64_t(item_count) * (i + 1) / thread_count;
+			uint32_t to = from;
+			while (to < (uint32_t)p_child_item_count && (accum < target || i + 1 == thread_count)) {
+				accum += p_child_items[to].item->subtree_item_count;
+				to++;
+			}
+			cull_threads[i].from = from;
+			cull_threads[i].to = to;
+			from = to;
+		}
+
+		CullData cull_data;
+		cull_data.child_items = p_child_items;
+		cull_data.transform = p_transform;
+		cull_data.clip_rect = p_clip_rect;
+		cull_data.canvas_cull_mask = p_canvas_cull_mask;
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererCanvasCull::_cull_canvas_item_tree_threaded, &cull_data, thread_count, -1, true, SNAME("RenderCanvasCull"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (uint32_t i = 0; i < thread_count; i++) {
+			CullThread &thread = cull_threads[i];
+			for (int j = thread.z_min; j <= thread.z_max; j++) {
+				if (!thread.z_list[j]) {
+					continue;
+				}
+				if (z_last_list[j]) {
+					z_last_list[j]->next = thread.z_list[j];
+				} else {
+					z_list[j] = thread.z_list[j];
+				}
+				z_last_list[j] = thread.z_last_list[j];
+				thread.z_list[j] = nullptr;
+				thread.z_last_list[j] = nullptr;
+			}
+		}
+	} else {
+		for (int i = 0; i < p_child_item_count; i++) {
+			_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, false, p_canvas_cull_mask, Point2(), 1, nullptr);
+		}
+	}
+
+	if (update_when_visible_found.is_set()) {
+		update_when_visible_found.clear();
+		RenderingServerDefault::redraw_request();
 	}
 
 	RendererCanvasRender::Item *list = nullptr;
@@ -107,6 +175,24 @@ void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas
 	}
 }
 
+void RendererCanvasCull::_cull_canvas_item_tree_threaded(uint32_t p_thread, CullData *p_data) {
+	CullThread &thread = cull_threads[p_thread];
+
+	for (uint32_t i = thread.from; i < thread.to; i++) {
+		_cull_canvas_item(p_data->child_items[i].item, p_data->transform, p_data->clip_rect, Color(1, 1, 1, 1), 0, thread.z_list, thread.z_last_list, nullptr, nullptr, false, p_data->canvas_cull_mask, Point2(), 1, nullptr);
+	}
+
+	// Find the used range here, so appending the lists afterwards doesn't need to scan all of them.
+	thread.z_min = z_range;
+	thread.z_max = -1;
+	for (int i = 0; i < z_range; i++) {
+		if (thread.z_list[i]) {
+			thread.z_min = MIN(thread.z_min, i);
+			thread.z_max = i;
+		}
+	}
+}
+
 void RendererCanvasCull::_collect_ysort_children(RendererCanvasCull::Item *p_canvas_item, RendererCanvasCull::Item *p_material_owner, const Color &p_modulate, RendererCanvasCull::Item **r_items, int &r_index, int p_z) {
 	int child_item_count = p_canvas_item->child_items.size();
 	RendererCanvasCull::Item **child_items = p_canvas_item->child_items.ptrw();
@@ -178,6 +264,66 @@ void RendererCanvasCull::_mark_ysort_dirty(RendererCanvasCull::Item *ysort_owner
 	} while (ysort_owner && ysort_owner->sort_y);
 }
 
+void RendererCanvasCull::_mark_subtree_rect_dirty(Item *p_item) {
+	// Items changed during the current frame already had their ancestors marked.
+	const uint64_t frame = RSG::rasterizer->get_frame_number();
+	while (p_item && !(p_item->subtree_rect_dirty && p_item->subtree_changed_frame == frame)) {
+		p_item->subtree_rect_dirty = true;
+		p_item->subtree_changed_frame = frame;
+		p_item = p_item->parent_item;
+	}
+}
+
+Rect2 RendererCanvasCull::_get_item_rect(Item *p_item) {
+	if (!p_item->custom_rect && (p_item->rect_dirty || p_item->update_when_visible || p_item->skeleton.is_valid())) {
+		// Recomputing the rect queries the mesh, multimesh and particles storage, which isn't thread safe
+		// (e.g. multimesh bounds flush the global dirty multimesh list), and items may be culled on worker threads.
+		MutexLock lock(storage_rect_mutex);
+		return p_item->get_rect();
+	}
+	return p_item->get_rect();
+}
+
+void RendererCanvasCull::_update_subtree_rect(Item *p_item) {
+	// These are either drawn regardless of their bounds, or have bounds that change while culling.
+	bool cullable = !p_item->use_identity_transform && !p_item->vp_render && !p_item->copy_back_buffer && !p_item->canvas_group && !p_item->repeat_source && !p_item->update_when_visible && p_item->skeleton.is_null();
+
+	Rect2 rect;
+	if (cullable) {
+		rect = _get_item_rect(p_item);
+		if (p_item->visibility_notifier && p_item->visibility_notifier->area.size != Vector2()) {
+			rect = rect.merge(p_item->visibility_notifier->area);
+		}
+	}
+
+	int child_item_count = p_item->child_items.size();
+	Item **child_items = p_item->child_items.ptrw();
+	for (int i = 0; i < child_item_count; i++) {
+		Item *child = child_items[i];
+		if (!child->visible) {
+			continue;
+		}
+		if (child->subtree_rect_dirty) {
+			_update_subtree_rect(child);
+		}
+		if (!child->subtree_cullable || (_interpolation_data.interpolation_enabled && child->interpolated && child->xform_prev != child->xform_curr)) {
+			cullable = false;
+		}
+		rect = rect.merge(child->xform_curr.xform(child->subtree_rect));
+	}
+
+	p_item->subtree_rect = rect;
+	p_item->subtree_cullable = cullable;
+	p_item->subtree_rect_dirty = false;
+}
+
+void RendererCanvasCull::_update_subtree_item_count(Item *p_parent_item, int p_delta) {
+	while (p_parent_item) {
+		p_parent_item->subtree_item_count += p_delta;
+		p_parent_item = p_parent_item->parent_item;
+	}
+}
+
 void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *ci, RendererCanvasCull::Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &p_modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from) {
 	if (ci->copy_back_buffer) {
 		ci->copy_back_buffer->screen_rect = p_transform.xform(ci->copy_back_buffer->rect).intersection(p_clip_rect);
@@ -250,7 +396,7 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 		// Something to draw?
 
 		if (ci->update_when_visible) {
-			RenderingServerDefault::redraw_request();
+			update_when_visible_found.set();
 		}
 
 		if (ci->commands != nullptr || ci->copy_back_buffer) {
@@ -278,6 +424,7 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 
 		if (ci->visibility_notifier) {
 			if (!ci->visibility_notifier->visible_element.in_list()) {
+				MutexLock lock(visibility_notifier_mutex);
 				visibility_notifier_list.add(&ci->visibility_notifier->visible_element);
 				ci->visibility_notifier->just_visible = true;
 			}
@@ -319,7 +466,7 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 		return;
 	}
 
-	Rect2 rect = ci->get_rect();
+	Rect2 rect = _get_item_rect(ci);
 
 	if (ci->visibility_notifier) {
 		if (ci->visibility_notifier->area.size != Vector2()) {
@@ -355,6 +502,23 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 		final_xform = parent_xform * self_xform;
 	}
 
+	// Skip whole subtrees that have been unchanged for a frame and are out of view. Snapping moves
+	// items by up to a pixel at every level, and repetition draws them elsewhere, so neither can use it.
+	if (!snapping_2d_transforms_to_pixel && !p_repeat_source_item) {
+		if (ci->subtree_rect_dirty && RSG::rasterizer->get_frame_number() > ci->subtree_changed_frame + 1) {
+			_update_subtree_rect(ci);
+		}
+
+		if (!ci->subtree_rect_dirty && ci->subtree_cullable) {
+			Rect2 subtree_rect = final_xform.xform(ci->subtree_rect);
+			subtree_rect.position += p_clip_rect.position;
+			// Grow to account for the rounding error of the bounds being transformed level by level.
+			if (!p_clip_rect.intersects(subtree_rect.grow(1.0), true)) {
+				return;
+			}
+		}
+	}
+
 	Point2 repeat_size = p_repeat_size;
 	int repeat_times = p_repeat_times;
 	RendererCanvasRender::Item *repeat_source_item = p_repeat_source_item;
@@ -431,7 +595,14 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			}
 
 			child_item_count = ci->ysort_children_count + 1;
-			child_items = (Item **)alloca(child_item_count * sizeof(Item *));
+			// Keep large y-sorted subtrees off the stack, as they may be culled on a worker thread.
+			LocalVector<Item *> ysort_items;
+			if (child_item_count > YSORT_MAX_STACK_ITEMS) {
+				ysort_items.resize(child_item_count);
+				child_items = ysort_items.ptr();
+			} else {
+				child_items = (Item **)alloca(child_item_count * sizeof(Item *));
+			}
 
 			ci->ysort_xform = Transform2D();
 			ci->ysort_modulate = Color(1, 1, 1, 1) / ci->modulate;
@@ -519,6 +690,7 @@ void RendererCanvasCull::canvas_set_item_mirroring(RID p_canvas, RID p_item, con
 
 	int idx = canvas->find_item(canvas_item);
 	ERR_FAIL_COND(idx == -1);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	bool is_repeat_source = (p_mirroring.x || p_mirroring.y);
 	canvas_item->repeat_source = is_repeat_source;
@@ -531,6 +703,7 @@ void RendererCanvasCull::canvas_set_item_repeat(RID p_item, const Point2 &p_repe
 	ERR_FAIL_COND(p_repeat_times < 0);
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	bool is_repeat_source = (p_repeat_size.x || p_repeat_size.y) && p_repeat_times;
 	canvas_item->repeat_source = is_repeat_source;
@@ -581,9 +754,12 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner);
 			}
+			_mark_subtree_rect_dirty(item_owner);
+			_update_subtree_item_count(item_owner, -canvas_item->subtree_item_count);
 		}
 
 		canvas_item->parent = RID();
+		canvas_item->parent_item = nullptr;
 	}
 
 	if (p_parent.is_valid()) {
@@ -602,6 +778,10 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 				_mark_ysort_dirty(item_owner);
 			}
 
+			canvas_item->parent_item = item_owner;
+			_mark_subtree_rect_dirty(item_owner);
+			_update_subtree_item_count(item_owner, canvas_item->subtree_item_count);
+
 		} else {
 			ERR_FAIL_MSG("Invalid parent.");
 		}
@@ -617,6 +797,7 @@ void RendererCanvasCull::canvas_item_set_visible(RID p_item, bool p_visible) {
 	canvas_item->visible = p_visible;
 
 	_mark_ysort_dirty(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item->parent_item);
 }
 
 void RendererCanvasCull::canvas_item_set_light_mask(RID p_item, int p_mask) {
@@ -640,6 +821,7 @@ void RendererCanvasCull::canvas_item_set_transform(RID p_item, const Transform2D
 	}
 
 	canvas_item->xform_curr = p_transform;
+	_mark_subtree_rect_dirty(canvas_item->parent_item);
 }
 
 void RendererCanvasCull::canvas_item_set_visibility_layer(RID p_item, uint32_t p_visibility_layer) {
@@ -674,6 +856,7 @@ void RendererCanvasCull::canvas_item_set_distance_field_mode(RID p_item, bool p_
 void RendererCanvasCull::canvas_item_set_custom_rect(RID p_item, bool p_custom_rect, const Rect2 &p_rect) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	canvas_item->custom_rect = p_custom_rect;
 	canvas_item->rect = p_rect;
@@ -703,6 +886,7 @@ void RendererCanvasCull::canvas_item_set_draw_behind_parent(RID p_item, bool p_e
 void RendererCanvasCull::canvas_item_set_use_identity_transform(RID p_item, bool p_enable) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	canvas_item->use_identity_transform = p_enable;
 }
@@ -710,6 +894,7 @@ void RendererCanvasCull::canvas_item_set_use_identity_transform(RID p_item, bool
 void RendererCanvasCull::canvas_item_set_update_when_visible(RID p_item, bool p_update) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	canvas_item->update_when_visible = p_update;
 }
@@ -717,6 +902,7 @@ void RendererCanvasCull::canvas_item_set_update_when_visible(RID p_item, bool p_
 void RendererCanvasCull::canvas_item_add_line(RID p_item, const Point2 &p_from, const Point2 &p_to, const Color &p_color, float p_width, bool p_antialiased) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandPrimitive *line = canvas_item->alloc_command<Item::CommandPrimitive>();
 	ERR_FAIL_NULL(line);
@@ -946,6 +1132,7 @@ void RendererCanvasCull::canvas_item_add_polyline(RID p_item, const Vector<Point
 	ERR_FAIL_COND(p_points.size() < 2);
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Color color = Color(1, 1, 1, 1);
 
@@ -1216,6 +1403,7 @@ void RendererCanvasCull::canvas_item_add_multiline(RID p_item, const Vector<Poin
 		}
 		Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 		ERR_FAIL_NULL(canvas_item);
+		_mark_subtree_rect_dirty(canvas_item);
 
 		Vector<Color> colors;
 		if (p_colors.size() == 1) {
@@ -1258,6 +1446,7 @@ void RendererCanvasCull::canvas_item_add_multiline(RID p_item, const Vector<Poin
 void RendererCanvasCull::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, const Color &p_color, bool p_antialiased) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
@@ -1422,6 +1611,7 @@ void RendererCanvasCull::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, c
 void RendererCanvasCull::canvas_item_add_circle(RID p_item, const Point2 &p_pos, float p_radius, const Color &p_color, bool p_antialiased) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	static const int circle_segments = 64;
 
@@ -1513,6 +1703,7 @@ void RendererCanvasCull::canvas_item_add_circle(RID p_item, const Point2 &p_pos,
 void RendererCanvasCull::canvas_item_add_texture_rect(RID p_item, const Rect2 &p_rect, RID p_texture, bool p_tile, const Color &p_modulate, bool p_transpose) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
@@ -1544,6 +1735,7 @@ void RendererCanvasCull::canvas_item_add_texture_rect(RID p_item, const Rect2 &p
 void RendererCanvasCull::canvas_item_add_msdf_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, int p_outline_size, float p_px_range, float p_scale) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
@@ -1578,6 +1770,7 @@ void RendererCanvasCull::canvas_item_add_msdf_texture_rect_region(RID p_item, co
 void RendererCanvasCull::canvas_item_add_lcd_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
@@ -1610,6 +1803,7 @@ void RendererCanvasCull::canvas_item_add_lcd_texture_rect_region(RID p_item, con
 void RendererCanvasCull::canvas_item_add_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, bool p_transpose, bool p_clip_uv) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
@@ -1651,6 +1845,7 @@ void RendererCanvasCull::canvas_item_add_texture_rect_region(RID p_item, const R
 void RendererCanvasCull::canvas_item_add_nine_patch(RID p_item, const Rect2 &p_rect, const Rect2 &p_source, RID p_texture, const Vector2 &p_topleft, const Vector2 &p_bottomright, RS::NinePatchAxisMode p_x_axis_mode, RS::NinePatchAxisMode p_y_axis_mode, bool p_draw_center, const Color &p_modulate) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandNinePatch *style = canvas_item->alloc_command<Item::CommandNinePatch>();
 	ERR_FAIL_NULL(style);
@@ -1675,6 +1870,7 @@ void RendererCanvasCull::canvas_item_add_primitive(RID p_item, const Vector<Poin
 
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandPrimitive *prim = canvas_item->alloc_command<Item::CommandPrimitive>();
 	ERR_FAIL_NULL(prim);
@@ -1701,6 +1897,7 @@ void RendererCanvasCull::canvas_item_add_primitive(RID p_item, const Vector<Poin
 void RendererCanvasCull::canvas_item_add_polygon(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 #ifdef DEBUG_ENABLED
 	int pointcount = p_points.size();
 	ERR_FAIL_COND(pointcount < 3);
@@ -1722,6 +1919,7 @@ void RendererCanvasCull::canvas_item_add_polygon(RID p_item, const Vector<Point2
 void RendererCanvasCull::canvas_item_add_triangle_array(RID p_item, const Vector<int> &p_indices, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, const Vector<int> &p_bones, const Vector<float> &p_weights, RID p_texture, int p_count) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	int vertex_count = p_points.size();
 	ERR_FAIL_COND(vertex_count == 0);
@@ -1743,6 +1941,7 @@ void RendererCanvasCull::canvas_item_add_triangle_array(RID p_item, const Vector
 void RendererCanvasCull::canvas_item_add_set_transform(RID p_item, const Transform2D &p_transform) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandTransform *tr = canvas_item->alloc_command<Item::CommandTransform>();
 	ERR_FAIL_NULL(tr);
@@ -1752,6 +1951,7 @@ void RendererCanvasCull::canvas_item_add_set_transform(RID p_item, const Transfo
 void RendererCanvasCull::canvas_item_add_mesh(RID p_item, const RID &p_mesh, const Transform2D &p_transform, const Color &p_modulate, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 	ERR_FAIL_COND(!p_mesh.is_valid());
 
 	Item::CommandMesh *m = canvas_item->alloc_command<Item::CommandMesh>();
@@ -1771,6 +1971,7 @@ void RendererCanvasCull::canvas_item_add_mesh(RID p_item, const RID &p_mesh, con
 void RendererCanvasCull::canvas_item_add_particles(RID p_item, RID p_particles, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandParticles *part = canvas_item->alloc_command<Item::CommandParticles>();
 	ERR_FAIL_NULL(part);
@@ -1785,6 +1986,7 @@ void RendererCanvasCull::canvas_item_add_particles(RID p_item, RID p_particles,
 void RendererCanvasCull::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandMultiMesh *mm = canvas_item->alloc_command<Item::CommandMultiMesh>();
 	ERR_FAIL_NULL(mm);
@@ -1796,6 +1998,7 @@ void RendererCanvasCull::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p
 void RendererCanvasCull::canvas_item_add_clip_ignore(RID p_item, bool p_ignore) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandClipIgnore *ci = canvas_item->alloc_command<Item::CommandClipIgnore>();
 	ERR_FAIL_NULL(ci);
@@ -1805,6 +2008,7 @@ void RendererCanvasCull::canvas_item_add_clip_ignore(RID p_item, bool p_ignore)
 void RendererCanvasCull::canvas_item_add_animation_slice(RID p_item, double p_animation_length, double p_slice_begin, double p_slice_end, double p_offset) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandAnimationSlice *as = canvas_item->alloc_command<Item::CommandAnimationSlice>();
 	ERR_FAIL_NULL(as);
@@ -1842,6 +2046,7 @@ void RendererCanvasCull::canvas_item_set_z_as_relative_to_parent(RID p_item, boo
 void RendererCanvasCull::canvas_item_attach_skeleton(RID p_item, RID p_skeleton) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 	if (canvas_item->skeleton == p_skeleton) {
 		return;
 	}
@@ -1871,6 +2076,7 @@ void RendererCanvasCull::canvas_item_attach_skeleton(RID p_item, RID p_skeleton)
 void RendererCanvasCull::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_enable, const Rect2 &p_rect) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 	if (p_enable && (canvas_item->copy_back_buffer == nullptr)) {
 		canvas_item->copy_back_buffer = memnew(RendererCanvasRender::Item::CopyBackBuffer);
 	}
@@ -1888,6 +2094,7 @@ void RendererCanvasCull::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_e
 void RendererCanvasCull::canvas_item_clear(RID p_item) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	canvas_item->clear();
 
@@ -1966,6 +2173,7 @@ void RendererCanvasCull::canvas_item_get_instance_shader_parameter_list(RID p_it
 void RendererCanvasCull::canvas_item_set_visibility_notifier(RID p_item, bool p_enable, const Rect2 &p_area, const Callable &p_enter_callable, const Callable &p_exit_callable) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	if (p_enable) {
 		if (!canvas_item->visibility_notifier) {
@@ -1995,12 +2203,14 @@ bool RendererCanvasCull::canvas_item_get_debug_redraw() const {
 void RendererCanvasCull::canvas_item_set_interpolated(RID p_item, bool p_interpolated) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item->parent_item);
 	canvas_item->interpolated = p_interpolated;
 }
 
 void RendererCanvasCull::canvas_item_reset_physics_interpolation(RID p_item) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item->parent_item);
 	canvas_item->xform_prev = canvas_item->xform_curr;
 }
 
@@ -2008,6 +2218,7 @@ void RendererCanvasCull::canvas_item_reset_physics_interpolation(RID p_item) {
 void RendererCanvasCull::canvas_item_transform_physics_interpolation(RID p_item, const Transform2D &p_transform) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item->parent_item);
 	canvas_item->xform_prev = p_transform * canvas_item->xform_prev;
 	canvas_item->xform_curr = p_transform * canvas_item->xform_curr;
 }
@@ -2015,6 +2226,7 @@ void RendererCanvasCull::canvas_item_transform_physics_interpolation(RID p_item,
 void RendererCanvasCull::canvas_item_set_canvas_group_mode(RID p_item, RS::CanvasGroupMode p_mode, float p_clear_margin, bool p_fit_empty, float p_fit_margin, bool p_blur_mipmaps) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	if (p_mode == RS::CANVAS_GROUP_MODE_DISABLED) {
 		if (canvas_item->canvas_group != nullptr) {
@@ -2593,11 +2805,14 @@ bool RendererCanvasCull::free(RID p_rid) {
 				if (item_owner->sort_y) {
 					_mark_ysort_dirty(item_owner);
 				}
+				_mark_subtree_rect_dirty(item_owner);
+				_update_subtree_item_count(item_owner, -canvas_item->subtree_item_count);
 			}
 		}
 
 		for (int i = 0; i < canvas_item->child_items.size(); i++) {
 			canvas_item->child_items[i]->parent = RID();
+			canvas_item->child_items[i]->parent_item = nullptr;
 		}
 
 		if (canvas_item->visibility_notifier != nullptr) {
@@ -2698,6 +2913,22 @@ void RendererCanvasCull::tick() {
 }
 
 void RendererCanvasCull::update_interpolation_tick(bool p_process) {
+	// The previous transforms of the items on these lists change below, which affects the bounds of their parents.
+	for (const RID &rid : *_interpolation_data.canvas_item_transform_update_list_prev) {
+		Item *item = canvas_item_owner.get_or_null(rid);
+		if (item) {
+			_mark_subtree_rect_dirty(item->parent_item);
+		}
+	}
+	if (p_process) {
+		for (const RID &rid : *_interpolation_data.canvas_item_transform_update_list_curr) {
+			Item *item = canvas_item_owner.get_or_null(rid);
+			if (item) {
+				_mark_subtree_rect_dirty(item->parent_item);
+			}
+		}
+	}
+
 #define GODOT_UPDATE_INTERPOLATION_TICK(m_list_prev, m_list_curr, m_type, m_owner_list)      \
 	/* Detect any that were on the previous transform list that are no longer active. */     \
 	for (unsigned int n = 0; n < _interpolation_data.m_list_prev->size(); n++) {             \
@@ -2772,6 +3003,8 @@ RendererCanvasCull::RendererCanvasCull() {
 	z_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
 	z_last_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
 
+	thread_cull_threshold = GLOBAL_GET("rendering/2d/culling/threaded_cull_minimum_items");
+
 	disable_scale = false;
 
 	debug_redraw_time = GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "debug/canvas_items/debug_redraw_time", PROPERTY_HINT_RANGE, "0.1,2,0.001,or_greater"), 1.0);
@@ -2781,5 +3014,9 @@ RendererCanvasCull::RendererCanvasCull() {
 RendererCanvasCull::~RendererCanvasCull() {
 	memfree(z_list);
 	memfree(z_last_list);
+	for (CullThread &thread : cull_threads) {
+		memfree(thread.z_list);
+		memfree(thread.z_last_list);
+	}
 	_canvas_cull_singleton = nullptr;
 }
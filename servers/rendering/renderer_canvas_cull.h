@@ -60,6 +60,15 @@ public:
 		uint32_t visibility_layer = 0xffffffff;
 
 		Vector<Item *> child_items;
+		Item *parent_item = nullptr; // Null when the parent is a canvas.
+
+		// Bounds of this item and its visible descendants, in the item's local space. They are
+		// only computed once the subtree stopped changing, and let culling skip whole subtrees.
+		Rect2 subtree_rect;
+		uint64_t subtree_changed_frame = 0;
+		int subtree_item_count = 1; // Kept up to date on reparenting, used to balance threaded culling.
+		bool subtree_rect_dirty = true;
+		bool subtree_cullable = false;
 
 		struct VisibilityNotifierData {
 			Rect2 area;
@@ -211,11 +220,43 @@ private:
 	int _count_ysort_children(RendererCanvasCull::Item *p_canvas_item);
 	void _mark_ysort_dirty(RendererCanvasCull::Item *ysort_owner);
 
+	void _mark_subtree_rect_dirty(Item *p_item);
+	Rect2 _get_item_rect(Item *p_item);
+	void _update_subtree_rect(Item *p_item);
+	void _update_subtree_item_count(Item *p_parent_item, int p_delta);
+
 	static constexpr int z_range = RS::CANVAS_ITEM_Z_MAX - RS::CANVAS_ITEM_Z_MIN + 1;
+	static constexpr int YSORT_MAX_STACK_ITEMS = 8192;
 
 	RendererCanvasRender::Item **z_list;
 	RendererCanvasRender::Item **z_last_list;
 
+	// Top level subtrees of large canvases are culled on multiple threads,
+	// each into its own z-lists, which are then appended in order.
+	struct CullThread {
+		RendererCanvasRender::Item **z_list = nullptr;
+		RendererCanvasRender::Item **z_last_list = nullptr;
+		uint32_t from = 0;
+		uint32_t to = 0;
+		int z_min = 0;
+		int z_max = -1;
+	};
+
+	struct CullData {
+		Canvas::ChildItem *child_items = nullptr;
+		Transform2D transform;
+		Rect2 clip_rect;
+		uint32_t canvas_cull_mask = 0;
+	};
+
+	LocalVector<CullThread> cull_threads;
+	uint32_t thread_cull_threshold = 1000;
+	BinaryMutex visibility_notifier_mutex;
+	BinaryMutex storage_rect_mutex;
+	SafeFlag update_when_visible_found;
+
+	void _cull_canvas_item_tree_threaded(uint32_t p_thread, CullData *p_data);
+
 	Transform2D _current_camera_transform;
 
 public:
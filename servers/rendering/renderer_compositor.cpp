@@ -31,6 +31,8 @@
 #include "renderer_compositor.h"
 
 #include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
+#include "servers/rendering/shader_compiler.h"
 
 #ifndef XR_DISABLED
 #include "servers/xr_server.h"
@@ -60,8 +62,34 @@ RendererCompositor::RendererCompositor() {
 		xr_enabled = XRServer::get_xr_mode() == XRServer::XRMODE_ON;
 	}
 #endif // XR_DISABLED
+
+	// Cache the shader compiler output for every renderer, including the dummy one used by headless runs.
+	// Like the shader cache, it's forcefully enabled when running the editor so it can be exported.
+	bool shader_cache_enabled = GLOBAL_GET("rendering/shader_compiler/shader_cache/enabled");
+	if (shader_cache_enabled || Engine::get_singleton()->is_editor_hint()) {
+		String shader_cache_dir = Engine::get_singleton()->get_shader_cache_path();
+		if (shader_cache_dir.is_empty()) {
+			shader_cache_dir = "user://";
+		}
+		shader_cache_dir = shader_cache_dir.path_join("shader_cache").path_join("ShaderCompiler");
+
+		Error err = DirAccess::make_dir_recursive_absolute(shader_cache_dir);
+		if (err != OK) {
+			ERR_PRINT("Can't create shader compiler cache folder, no shader compiler caching will happen: " + shader_cache_dir);
+		} else {
+			ShaderCompiler::set_cache_user_dir(shader_cache_dir);
+		}
+
+		// Exported projects ship the cache built by the editor as read-only.
+		String shader_cache_res_dir = "res://.godot/shader_cache/ShaderCompiler";
+		if (DirAccess::dir_exists_absolute(shader_cache_res_dir)) {
+			ShaderCompiler::set_cache_res_dir(shader_cache_res_dir);
+		}
+	}
 }
 
 RendererCompositor::~RendererCompositor() {
 	singleton = nullptr;
+	ShaderCompiler::set_cache_user_dir(String());
+	ShaderCompiler::set_cache_res_dir(String());
 }
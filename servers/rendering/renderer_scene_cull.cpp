@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
+#include "raster_occlusion_cull.h"
 #include "rendering_light_culler.h"
 #include "rendering_server_default.h"
 
@@ -1732,6 +1733,10 @@ void RendererSceneCull::_update_instance(Instance *p_instance) const {
 		return;
 	}
 
+	_update_instance_index(p_instance, _get_instance_bvh_aabb(p_instance));
+}
+
+AABB RendererSceneCull::_get_instance_bvh_aabb(const Instance *p_instance) {
 	//quantize to improve moving object performance
 	AABB bvh_aabb = p_instance->transformed_aabb;
 
@@ -1748,11 +1753,15 @@ void RendererSceneCull::_update_instance(Instance *p_instance) const {
 		}
 	}
 
+	return bvh_aabb;
+}
+
+void RendererSceneCull::_update_instance_index(Instance *p_instance, const AABB &p_bvh_aabb) const {
 	if (!p_instance->indexer_id.is_valid()) {
 		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
-			p_instance->indexer_id = p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].insert(bvh_aabb, p_instance);
+			p_instance->indexer_id = p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].insert(p_bvh_aabb, p_instance);
 		} else {
-			p_instance->indexer_id = p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].insert(bvh_aabb, p_instance);
+			p_instance->indexer_id = p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].insert(p_bvh_aabb, p_instance);
 		}
 
 		p_instance->array_index = p_instance->scenario->instance_data.size();
@@ -1840,9 +1849,9 @@ void RendererSceneCull::_update_instance(Instance *p_instance) const {
 		_update_instance_visibility_dependencies(p_instance);
 	} else {
 		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
-			p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].update(p_instance->indexer_id, bvh_aabb);
+			p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].update(p_instance->indexer_id, p_bvh_aabb);
 		} else {
-			p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].update(p_instance->indexer_id, bvh_aabb);
+			p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].update(p_instance->indexer_id, p_bvh_aabb);
 		}
 		p_instance->scenario->instance_aabbs[p_instance->array_index] = InstanceBounds(p_instance->transformed_aabb);
 	}
@@ -2352,14 +2361,104 @@ void RendererSceneCull::_light_instance_setup_directional_shadow(int p_shadow_in
 	}
 }
 
+RendererSceneRender::RenderShadowData &RendererSceneCull::_add_shadow_cull_pass(Instance *p_light, const Vector<Plane> &p_planes) {
+	InstanceLightData *light = static_cast<InstanceLightData *>(p_light->base_data);
+
+	ShadowCullPass &pass = shadow_cull_passes[max_shadows_used];
+	pass.light = p_light;
+	pass.planes = p_planes;
+	pass.caster_mask = RSG::light_storage->light_get_shadow_caster_mask(p_light->base);
+	if (light->is_shadow_update_full()) {
+		pass.caster_cull_planes.clear();
+	} else {
+		light_culler->get_regular_light_cull_planes(pass.caster_cull_planes);
+	}
+
+	return render_shadow_data[max_shadows_used++];
+}
+
+void RendererSceneCull::_shadow_cull_threaded(uint32_t p_index, ShadowCullData *cull_data) {
+	const uint32_t pass_index = cull_data->first_pass + p_index;
+	ShadowCullPass &pass = shadow_cull_passes[pass_index];
+	RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[pass_index];
+
+	Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&pass.planes[0], pass.planes.size());
+
+	struct CullConvex {
+		PagedArray<Instance *> *result;
+		_FORCE_INLINE_ bool operator()(void *p_data) {
+			Instance *p_instance = (Instance *)p_data;
+			result->push_back(p_instance);
+			return false;
+		}
+	};
+
+	CullConvex cull_convex;
+	cull_convex.result = &pass.cull_result;
+
+	cull_data->scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(pass.planes.ptr(), pass.planes.size(), points.ptr(), points.size(), cull_convex);
+
+	RenderingLightCuller::cull_regular_light_planes(pass.caster_cull_planes, pass.cull_result);
+
+	const uint32_t caster_mask = cull_data->visible_layers & pass.caster_mask;
+
+	for (int j = 0; j < (int)pass.cull_result.size(); j++) {
+		Instance *instance = pass.cull_result[j];
+		if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(instance->layer_mask & caster_mask)) {
+			continue;
+		} else {
+			if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
+				pass.animated_material_found = true;
+			}
+
+			if (instance->mesh_instance.is_valid()) {
+				pass.mesh_instance_updates.push_back(instance);
+			}
+		}
+
+		shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
+	}
+}
+
+void RendererSceneCull::_cull_shadow_passes(Scenario *p_scenario, uint32_t p_visible_layers, uint32_t p_from, uint32_t p_count) {
+	ShadowCullData cull_data;
+	cull_data.scenario = p_scenario;
+	cull_data.visible_layers = p_visible_layers;
+	cull_data.first_pass = p_from;
+
+	if (p_count > 1 && WorkerThreadPool::get_singleton()->get_thread_count() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneCull::_shadow_cull_threaded, &cull_data, p_count, -1, true, SNAME("RenderCullShadows"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < p_count; i++) {
+			_shadow_cull_threaded(i, &cull_data);
+		}
+	}
+
+	// Mesh storage and light dirtiness aren't thread safe, so these are handled once all passes are culled.
+	for (uint32_t i = p_from; i < p_from + p_count; i++) {
+		ShadowCullPass &pass = shadow_cull_passes[i];
+		for (uint32_t j = 0; j < pass.mesh_instance_updates.size(); j++) {
+			RSG::mesh_storage->mesh_instance_check_for_update(pass.mesh_instance_updates[j]->mesh_instance);
+		}
+		if (pass.animated_material_found) {
+			static_cast<InstanceLightData *>(pass.light->base_data)->make_shadow_dirty();
+		}
+
+		pass.cull_result.clear();
+		pass.mesh_instance_updates.clear();
+		pass.animated_material_found = false;
+	}
+
+	RSG::mesh_storage->update_mesh_instances();
+}
+
 bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_screen_mesh_lod_threshold, uint32_t p_visible_layers) {
 	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
 
 	Transform3D light_transform = p_instance->transform;
 	light_transform.orthonormalize(); //scale does not count on lights
 
-	bool animated_material_found = false;
-
 	switch (RSG::light_storage->light_get_type(p_instance->base)) {
 		case RS::LIGHT_DIRECTIONAL: {
 		} break;
@@ -2371,9 +2470,6 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 					return true;
 				}
 				for (int i = 0; i < 2; i++) {
-					//using this one ensures that raster deferred will have it
-					RENDER_TIMESTAMP("Cull OmniLight3D Shadow Paraboloid, Half " + itos(i));
-
 					real_t radius = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
 
 					real_t z = i == 0 ? -1 : 1;
@@ -2386,48 +2482,7 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 					planes.write[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
 					planes.write[5] = light_transform.xform(Plane(Vector3(0, 0, -z), 0));
 
-					instance_shadow_cull_result.clear();
-
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-					struct CullConvex {
-						PagedArray<Instance *> *result;
-						_FORCE_INLINE_ bool operator()(void *p_data) {
-							Instance *p_instance = (Instance *)p_data;
-							result->push_back(p_instance);
-							return false;
-						}
-					};
-
-					CullConvex cull_convex;
-					cull_convex.result = &instance_shadow_cull_result;
-
-					p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
-
-					RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
-
-					if (!light->is_shadow_update_full()) {
-						light_culler->cull_regular_light(instance_shadow_cull_result);
-					}
-
-					for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask & RSG::light_storage->light_get_shadow_caster_mask(p_instance->base))) {
-							continue;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-
-							if (instance->mesh_instance.is_valid()) {
-								RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
-							}
-						}
-
-						shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-					}
-
-					RSG::mesh_storage->update_mesh_instances();
+					RendererSceneRender::RenderShadowData &shadow_data = _add_shadow_cull_pass(p_instance, planes);
 
 					RSG::light_storage->light_instance_set_shadow_transform(light->instance, Projection(), light_transform, radius, 0, i, 0);
 					shadow_data.light = light->instance;
@@ -2445,9 +2500,6 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 				cm.set_perspective(90, 1, z_near, radius);
 
 				for (int i = 0; i < 6; i++) {
-					RENDER_TIMESTAMP("Cull OmniLight3D Shadow Cube, Side " + itos(i));
-					//using this one ensures that raster deferred will have it
-
 					static const Vector3 view_normals[6] = {
 						Vector3(+1, 0, 0),
 						Vector3(-1, 0, 0),
@@ -2469,47 +2521,7 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 					Vector<Plane> planes = cm.get_projection_planes(xform);
 
-					instance_shadow_cull_result.clear();
-
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-					struct CullConvex {
-						PagedArray<Instance *> *result;
-						_FORCE_INLINE_ bool operator()(void *p_data) {
-							Instance *p_instance = (Instance *)p_data;
-							result->push_back(p_instance);
-							return false;
-						}
-					};
-
-					CullConvex cull_convex;
-					cull_convex.result = &instance_shadow_cull_result;
-
-					p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
-
-					RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
-
-					if (!light->is_shadow_update_full()) {
-						light_culler->cull_regular_light(instance_shadow_cull_result);
-					}
-
-					for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask & RSG::light_storage->light_get_shadow_caster_mask(p_instance->base))) {
-							continue;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-							if (instance->mesh_instance.is_valid()) {
-								RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
-							}
-						}
-
-						shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-					}
-
-					RSG::mesh_storage->update_mesh_instances();
+					RendererSceneRender::RenderShadowData &shadow_data = _add_shadow_cull_pass(p_instance, planes);
 					RSG::light_storage->light_instance_set_shadow_transform(light->instance, cm, xform, radius, 0, i, 0);
 
 					shadow_data.light = light->instance;
@@ -2522,8 +2534,6 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 		} break;
 		case RS::LIGHT_SPOT: {
-			RENDER_TIMESTAMP("Cull SpotLight3D Shadow");
-
 			if (max_shadows_used + 1 > MAX_UPDATE_SHADOWS) {
 				return true;
 			}
@@ -2537,47 +2547,7 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 			Vector<Plane> planes = cm.get_projection_planes(light_transform);
 
-			instance_shadow_cull_result.clear();
-
-			Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-			struct CullConvex {
-				PagedArray<Instance *> *result;
-				_FORCE_INLINE_ bool operator()(void *p_data) {
-					Instance *p_instance = (Instance *)p_data;
-					result->push_back(p_instance);
-					return false;
-				}
-			};
-
-			CullConvex cull_convex;
-			cull_convex.result = &instance_shadow_cull_result;
-
-			p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
-
-			RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
-
-			if (!light->is_shadow_update_full()) {
-				light_culler->cull_regular_light(instance_shadow_cull_result);
-			}
-
-			for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-				Instance *instance = instance_shadow_cull_result[j];
-				if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask & RSG::light_storage->light_get_shadow_caster_mask(p_instance->base))) {
-					continue;
-				} else {
-					if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-						animated_material_found = true;
-					}
-
-					if (instance->mesh_instance.is_valid()) {
-						RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
-					}
-				}
-				shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-			}
-
-			RSG::mesh_storage->update_mesh_instances();
+			RendererSceneRender::RenderShadowData &shadow_data = _add_shadow_cull_pass(p_instance, planes);
 
 			RSG::light_storage->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0, 0);
 			shadow_data.light = light->instance;
@@ -2586,7 +2556,7 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 		} break;
 	}
 
-	return animated_material_found;
+	return false;
 }
 
 void RendererSceneCull::render_camera(const Ref<RenderSceneBuffers> &p_render_buffers, RID p_camera, RID p_scenario, RID p_viewport, Size2 p_viewport_size, uint32_t p_jitter_phase_count, float p_screen_mesh_lod_threshold, RID p_shadow_atlas, Ref<XRInterface> &p_xr_interface, RenderInfo *r_render_info) {
@@ -3297,6 +3267,7 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		}
 
 		// Positional Shadows
+		const uint32_t first_shadow_cull_pass = max_shadows_used;
 		for (uint32_t i = 0; i < (uint32_t)scene_cull_result.lights.size(); i++) {
 			Instance *ins = scene_cull_result.lights[i];
 
@@ -3422,6 +3393,12 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 				}
 			}
 		}
+
+		if (max_shadows_used > first_shadow_cull_pass) {
+			RENDER_TIMESTAMP("> Cull Light3D Shadows");
+			_cull_shadow_passes(scenario, p_visible_layers, first_shadow_cull_pass, max_shadows_used - first_shadow_cull_pass);
+			RENDER_TIMESTAMP("< Cull Light3D Shadows");
+		}
 	}
 
 	//render SDFGI
@@ -4139,9 +4116,102 @@ void RendererSceneCull::_update_dirty_instance(Instance *p_instance) const {
 	p_instance->update_dependencies = false;
 }
 
+bool RendererSceneCull::_is_instance_move_only(const Instance *p_instance) const {
+	if (p_instance->update_aabb || p_instance->update_dependencies) {
+		return false;
+	}
+	if (p_instance->base_type != RS::INSTANCE_MESH && p_instance->base_type != RS::INSTANCE_MULTIMESH) {
+		return false;
+	}
+	if (!p_instance->scenario || !p_instance->visible || !p_instance->indexer_id.is_valid() || !p_instance->aabb.has_surface()) {
+		return false;
+	}
+
+	// Lightmap captures go through renderer storage, which isn't thread safe.
+	const InstanceGeometryData *geom = static_cast<const InstanceGeometryData *>(p_instance->base_data);
+	return geom->geometry_instance && geom->lightmap_captures.is_empty() && p_instance->lightmap_sh.is_empty();
+}
+
+void RendererSceneCull::_update_moved_instances_threaded(uint32_t p_thread, void *p_userdata) const {
+	uint32_t total = moved_instances.size();
+	uint32_t total_threads = WorkerThreadPool::get_singleton()->get_thread_count();
+	uint32_t from = p_thread * total / total_threads;
+	uint32_t to = (p_thread + 1 == total_threads) ? total : ((p_thread + 1) * total / total_threads);
+
+	_update_moved_instances(from, to);
+}
+
+void RendererSceneCull::_update_moved_instances(uint32_t p_from, uint32_t p_to) const {
+	for (uint32_t i = p_from; i < p_to; i++) {
+		Instance *instance = moved_instances[i];
+		instance->version++;
+		instance->transformed_aabb = instance->transform.xform(instance->aabb);
+
+		InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(instance->base_data);
+		geom->geometry_instance->set_transform(instance->transform, instance->aabb, instance->transformed_aabb);
+		if (instance->teleported) {
+			geom->geometry_instance->reset_motion_vectors();
+		}
+
+		moved_instance_bvh_aabbs[i] = _get_instance_bvh_aabb(instance);
+	}
+}
+
+void RendererSceneCull::_update_moved_instances_bulk() const {
+	const uint32_t count = moved_instances.size();
+	moved_instance_bvh_aabbs.resize(count);
+
+	if (count >= thread_cull_threshold) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneCull::_update_moved_instances_threaded, (void *)nullptr, WorkerThreadPool::get_singleton()->get_thread_count(), -1, true, SNAME("RenderUpdateMovedInstances"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		_update_moved_instances(0, count);
+	}
+
+	// Lights, indexers and pairs are shared between instances, so they are updated serially.
+	for (uint32_t i = 0; i < count; i++) {
+		Instance *instance = moved_instances[i];
+		InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(instance->base_data);
+
+		if (geom->can_cast_shadows) {
+			for (const Instance *E : geom->lights) {
+				InstanceLightData *light = static_cast<InstanceLightData *>(E->base_data);
+				light->make_shadow_dirty();
+			}
+		}
+
+		if (instance->transform.basis.determinant() == 0) {
+			instance->prev_transformed_aabb = instance->transformed_aabb;
+		} else {
+			_update_instance_index(instance, moved_instance_bvh_aabbs[i]);
+		}
+
+		instance->teleported = false;
+	}
+
+	moved_instances.clear();
+}
+
 void RendererSceneCull::update_dirty_instances() const {
 	while (_instance_update_list.first()) {
-		_update_dirty_instance(_instance_update_list.first()->self());
+		// Instances that only moved are updated in bulk, the rest one by one.
+		SelfList<Instance> *item = _instance_update_list.first();
+		while (item) {
+			SelfList<Instance> *next = item->next();
+			if (_is_instance_move_only(item->self())) {
+				_instance_update_list.remove(item);
+				moved_instances.push_back(item->self());
+			}
+			item = next;
+		}
+
+		if (!moved_instances.is_empty()) {
+			_update_moved_instances_bulk();
+		}
+
+		while (_instance_update_list.first()) {
+			_update_dirty_instance(_instance_update_list.first()->self());
+		}
 	}
 
 	// Update dirty resources after dirty instances as instance updates may affect resources.
@@ -4278,10 +4348,11 @@ RendererSceneCull::RendererSceneCull() {
 	singleton = this;
 
 	instance_cull_result.set_page_pool(&instance_cull_page_pool);
-	instance_shadow_cull_result.set_page_pool(&instance_cull_page_pool);
 
 	for (uint32_t i = 0; i < MAX_UPDATE_SHADOWS; i++) {
 		render_shadow_data[i].instances.set_page_pool(&geometry_instance_cull_page_pool);
+		shadow_cull_passes[i].cull_result.set_page_pool(&instance_cull_page_pool);
+		shadow_cull_passes[i].mesh_instance_updates.set_page_pool(&instance_cull_page_pool);
 	}
 	for (uint32_t i = 0; i < SDFGI_MAX_CASCADES * SDFGI_MAX_REGIONS_PER_CASCADE; i++) {
 		render_sdfgi_data[i].instances.set_page_pool(&geometry_instance_cull_page_pool);
@@ -4298,7 +4369,8 @@ RendererSceneCull::RendererSceneCull() {
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count()); //make sure there is at least one thread per CPU
 	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = GLOBAL_GET("rendering/occlusion_culling/jitter_projection");
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	// Modules can replace it with their own implementation, like the Embree raycaster.
+	default_occlusion_culling = memnew(RasterOcclusionCull);
 
 	light_culler = memnew(RenderingLightCuller);
 
@@ -4309,10 +4381,11 @@ RendererSceneCull::RendererSceneCull() {
 
 RendererSceneCull::~RendererSceneCull() {
 	instance_cull_result.reset();
-	instance_shadow_cull_result.reset();
 
 	for (uint32_t i = 0; i < MAX_UPDATE_SHADOWS; i++) {
 		render_shadow_data[i].instances.reset();
+		shadow_cull_passes[i].cull_result.reset();
+		shadow_cull_passes[i].mesh_instance_updates.reset();
 	}
 	for (uint32_t i = 0; i < SDFGI_MAX_CASCADES * SDFGI_MAX_REGIONS_PER_CASCADE; i++) {
 		render_sdfgi_data[i].instances.reset();
@@ -4324,8 +4397,8 @@ RendererSceneCull::~RendererSceneCull() {
 	}
 	scene_cull_result_threads.clear();
 
-	if (dummy_occlusion_culling) {
-		memdelete(dummy_occlusion_culling);
+	if (default_occlusion_culling) {
+		memdelete(default_occlusion_culling);
 	}
 
 	if (light_culler) {
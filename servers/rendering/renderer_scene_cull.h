@@ -125,7 +125,7 @@ public:
 
 	/* VISIBILITY NOTIFIER API */
 
-	RendererSceneOcclusionCull *dummy_occlusion_culling = nullptr;
+	RendererSceneOcclusionCull *default_occlusion_culling = nullptr;
 
 	/* SCENARIO API */
 
@@ -877,7 +877,6 @@ public:
 	PagedArrayPool<RID> rid_cull_page_pool;
 
 	PagedArray<Instance *> instance_cull_result;
-	PagedArray<Instance *> instance_shadow_cull_result;
 
 	struct InstanceCullResult {
 		PagedArray<RenderGeometryInstance *> geometry_instances;
@@ -1005,6 +1004,24 @@ public:
 	RendererSceneRender::RenderShadowData render_shadow_data[MAX_UPDATE_SHADOWS];
 	uint32_t max_shadows_used = 0;
 
+	// Shadow pass of a positional light (a spot light, or one side of an omni light), matching the
+	// render_shadow_data entry with the same index. Passes are set up one light at a time, then all
+	// the passes of the frame are culled together, in parallel when there are several.
+	struct ShadowCullPass {
+		Instance *light = nullptr;
+		Vector<Plane> planes;
+		uint32_t caster_mask = 0;
+		// Tighter caster culling planes from the light culler, empty if not used.
+		LocalVector<Plane> caster_cull_planes;
+
+		PagedArray<Instance *> cull_result;
+		// Casters whose mesh instances must be checked for updates once culling is done.
+		PagedArray<Instance *> mesh_instance_updates;
+		bool animated_material_found = false;
+	};
+
+	ShadowCullPass shadow_cull_passes[MAX_UPDATE_SHADOWS];
+
 	RendererSceneRender::RenderSDFGIData render_sdfgi_data[SDFGI_MAX_CASCADES * SDFGI_MAX_REGIONS_PER_CASCADE];
 	RendererSceneRender::RenderSDFGIUpdateData sdfgi_update_data;
 
@@ -1070,14 +1087,31 @@ public:
 	virtual uint32_t get_pipeline_compilations(RS::PipelineSource p_source);
 
 	_FORCE_INLINE_ void _update_instance(Instance *p_instance) const;
+	_FORCE_INLINE_ static AABB _get_instance_bvh_aabb(const Instance *p_instance);
+	_FORCE_INLINE_ void _update_instance_index(Instance *p_instance, const AABB &p_bvh_aabb) const;
 	_FORCE_INLINE_ void _update_instance_aabb(Instance *p_instance) const;
 	_FORCE_INLINE_ void _update_dirty_instance(Instance *p_instance) const;
+
+	// Dirty mesh and multimesh instances whose transform is the only change are updated in bulk:
+	// their bounds and render transforms are computed first, in parallel when there are enough
+	// of them, then the indexers and pairs are updated serially. Bounds are kept apart from the
+	// instances so the serial pass reads them linearly.
+	mutable LocalVector<Instance *> moved_instances;
+	mutable LocalVector<AABB> moved_instance_bvh_aabbs;
+
+	_FORCE_INLINE_ bool _is_instance_move_only(const Instance *p_instance) const;
+	void _update_moved_instances_threaded(uint32_t p_thread, void *p_userdata) const;
+	void _update_moved_instances(uint32_t p_from, uint32_t p_to) const;
+	void _update_moved_instances_bulk() const;
 	_FORCE_INLINE_ void _update_instance_lightmap_captures(Instance *p_instance) const;
 	void _unpair_instance(Instance *p_instance);
 
 	void _light_instance_setup_directional_shadow(int p_shadow_index, Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect);
 
+	// Sets up the shadow passes of a positional light, culled later by _cull_shadow_passes().
+	// Returns true if they don't fit in this frame.
 	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_screen_mesh_lod_threshold, uint32_t p_visible_layers = 0xFFFFFF);
+	_FORCE_INLINE_ RendererSceneRender::RenderShadowData &_add_shadow_cull_pass(Instance *p_light, const Vector<Plane> &p_planes);
 
 	RID _render_get_environment(RID p_camera, RID p_scenario);
 	RID _render_get_compositor(RID p_camera, RID p_scenario);
@@ -1148,6 +1182,15 @@ public:
 
 	void _scene_cull_threaded(uint32_t p_thread, CullData *cull_data);
 	void _scene_cull(CullData &cull_data, InstanceCullResult &cull_result, uint64_t p_from, uint64_t p_to);
+
+	struct ShadowCullData {
+		Scenario *scenario = nullptr;
+		uint32_t visible_layers = 0;
+		uint32_t first_pass = 0;
+	};
+
+	void _shadow_cull_threaded(uint32_t p_index, ShadowCullData *cull_data);
+	void _cull_shadow_passes(Scenario *p_scenario, uint32_t p_visible_layers, uint32_t p_from, uint32_t p_count);
 	static void _scene_particles_set_view_axis(RID p_particles, const Vector3 &p_axis, const Vector3 &p_up_axis);
 	_FORCE_INLINE_ bool _visibility_parent_check(const CullData &p_cull_data, const InstanceData &p_instance_data);
 
@@ -38,6 +38,9 @@ class RendererSceneOcclusionCull {
 protected:
 	static RendererSceneOcclusionCull *singleton;
 
+	static Rect2 _get_viewport_rect(const Projection &p_cam_projection);
+	static Vector2 _get_jitter(const Rect2 &p_viewport_rect, const Size2i &p_buffer_size);
+
 public:
 	class HZBuffer {
 	protected:
@@ -202,6 +205,7 @@ public:
 	};
 
 	static RendererSceneOcclusionCull *get_singleton() { return singleton; }
+	static void set_singleton(RendererSceneOcclusionCull *p_singleton) { singleton = p_singleton; }
 
 	void _print_warning() {
 		WARN_PRINT_ONCE("Occlusion culling is disabled at build-time.");
@@ -221,6 +221,43 @@ void RenderingLightCuller::cull_regular_light(PagedArray<RendererSceneCull::Inst
 #endif
 }
 
+void RenderingLightCuller::get_regular_light_cull_planes(LocalVector<Plane> &r_cull_planes) const {
+	r_cull_planes.clear();
+
+	// Same conditions as cull_regular_light(), an out of range light doesn't cull its casters.
+	if (!data.is_active() || !is_caster_culling_active() || data.out_of_range) {
+		return;
+	}
+
+	r_cull_planes.resize(data.regular_cull_planes.num_cull_planes);
+	for (int p = 0; p < data.regular_cull_planes.num_cull_planes; p++) {
+		r_cull_planes[p] = data.regular_cull_planes.cull_planes[p];
+	}
+}
+
+void RenderingLightCuller::cull_regular_light_planes(const LocalVector<Plane> &p_cull_planes, PagedArray<RendererSceneCull::Instance *> &r_instance_shadow_cull_result) {
+	if (p_cull_planes.is_empty()) {
+		return;
+	}
+
+	PagedArray<RendererSceneCull::Instance *> &list = r_instance_shadow_cull_result;
+
+	for (int n = 0; n < (int)list.size(); n++) {
+		const AABB &bb = list[n]->transformed_aabb;
+
+		real_t r_min, r_max;
+		for (const Plane &plane : p_cull_planes) {
+			bb.project_range_in_plane(plane, r_min, r_max);
+			if (r_min > 0.0f) {
+				// Repeat this element next iteration of the loop as it has been removed and replaced by the last.
+				list.remove_at_unordered(n);
+				n--;
+				break;
+			}
+		}
+	}
+}
+
 void RenderingLightCuller::LightCullPlanes::add_cull_plane(const Plane &p) {
 	ERR_FAIL_COND(num_cull_planes >= MAX_CULL_PLANES);
 	cull_planes[num_cull_planes++] = p;
@@ -139,6 +139,12 @@ public:
 	// Cull according to the regular light planes that were setup in the previous call to prepare_regular_light.
 	void cull_regular_light(PagedArray<RendererSceneCull::Instance *> &r_instance_shadow_cull_result);
 
+	// Copy the regular light planes that were setup in the previous call to prepare_regular_light, so the light
+	// can be culled later with cull_regular_light_planes(), possibly alongside other lights on other threads.
+	// Nothing is copied if caster culling doesn't apply to the light.
+	void get_regular_light_cull_planes(LocalVector<Plane> &r_cull_planes) const;
+	static void cull_regular_light_planes(const LocalVector<Plane> &p_cull_planes, PagedArray<RendererSceneCull::Instance *> &r_instance_shadow_cull_result);
+
 	// Directional lights are prepared in advance, and can be culled multithreaded chopping and changing between
 	// different directional_light_id.
 	void prepare_directional_light(const RendererSceneCull::Instance *p_instance, int32_t p_directional_light_id);
@@ -1172,6 +1172,18 @@ public:
 		}
 	}
 
+	virtual void begin_command_batch() override {
+		if (Thread::get_caller_id() != server_thread) {
+			command_queue.begin_batch();
+		}
+	}
+
+	virtual void end_command_batch() override {
+		if (Thread::get_caller_id() != server_thread) {
+			command_queue.end_batch();
+		}
+	}
+
 	/* TESTING */
 
 	virtual double get_frame_setup_time_cpu() const override;
@@ -30,6 +30,11 @@
 
 #include "shader_compiler.h"
 
+#include "core/config/engine.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "core/string/string_builder.h"
+#include "core/version.h"
 #include "servers/rendering/rendering_server_globals.h"
 #include "servers/rendering/shader_types.h"
 
@@ -460,31 +465,11 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 					r_gen_code.defines.push_back(p_default_actions.render_mode_defines[pnode->render_modes[i]]);
 					used_rmode_defines.insert(pnode->render_modes[i]);
 				}
-
-				if (p_actions.render_mode_flags.has(pnode->render_modes[i])) {
-					*p_actions.render_mode_flags[pnode->render_modes[i]] = true;
-				}
-
-				if (p_actions.render_mode_values.has(pnode->render_modes[i])) {
-					Pair<int *, int> &p = p_actions.render_mode_values[pnode->render_modes[i]];
-					*p.first = p.second;
-				}
-			}
-
-			// Stencil modes.
-
-			for (int i = 0; i < pnode->stencil_modes.size(); i++) {
-				if (p_actions.stencil_mode_values.has(pnode->stencil_modes[i])) {
-					Pair<int *, int> &p = p_actions.stencil_mode_values[pnode->stencil_modes[i]];
-					*p.first = p.second;
-				}
 			}
 
-			// Stencil reference value.
+			// Render mode, stencil mode and stencil reference values.
 
-			if (p_actions.stencil_reference && pnode->stencil_reference != -1) {
-				*p_actions.stencil_reference = pnode->stencil_reference;
-			}
+			_apply_render_modes(pnode->render_modes, pnode->stencil_modes, pnode->stencil_reference, p_actions);
 
 			// structs
 
@@ -1476,7 +1461,411 @@ ShaderLanguage::DataType ShaderCompiler::_get_global_shader_uniform_type(const S
 	return (ShaderLanguage::DataType)RS::global_shader_uniform_type_get_shader_datatype(gvt);
 }
 
+void ShaderCompiler::_apply_render_modes(const Vector<StringName> &p_render_modes, const Vector<StringName> &p_stencil_modes, int p_stencil_reference, IdentifierActions &p_actions) {
+	for (const StringName &render_mode : p_render_modes) {
+		if (p_actions.render_mode_flags.has(render_mode)) {
+			*p_actions.render_mode_flags[render_mode] = true;
+		}
+
+		if (p_actions.render_mode_values.has(render_mode)) {
+			Pair<int *, int> &p = p_actions.render_mode_values[render_mode];
+			*p.first = p.second;
+		}
+	}
+
+	for (const StringName &stencil_mode : p_stencil_modes) {
+		if (p_actions.stencil_mode_values.has(stencil_mode)) {
+			Pair<int *, int> &p = p_actions.stencil_mode_values[stencil_mode];
+			*p.first = p.second;
+		}
+	}
+
+	if (p_actions.stencil_reference && p_stencil_reference != -1) {
+		*p_actions.stencil_reference = p_stencil_reference;
+	}
+}
+
+void ShaderCompiler::_apply_cached_actions(const CachedActions &p_cached, IdentifierActions &p_actions) {
+	_apply_render_modes(p_cached.render_modes, p_cached.stencil_modes, p_cached.stencil_reference, p_actions);
+
+	for (const StringName &name : p_cached.usage_flags) {
+		if (p_actions.usage_flag_pointers.has(name)) {
+			*p_actions.usage_flag_pointers[name] = true;
+		}
+	}
+
+	for (const StringName &name : p_cached.write_flags) {
+		if (p_actions.write_flag_pointers.has(name)) {
+			*p_actions.write_flag_pointers[name] = true;
+		}
+	}
+
+	if (p_actions.uniforms) {
+		for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : p_cached.uniforms) {
+			p_actions.uniforms->insert(E.key, E.value);
+		}
+	}
+}
+
+// Shader compiler cache.
+//
+// The output of a successful compilation (the generated code plus everything it
+// writes through the IdentifierActions) is stored in a file named after a hash
+// of everything it depends on, so the next time the same shader is compiled the
+// parser does not run at all.
+
+static const char *cache_file_header = "GDSP";
+static const uint32_t cache_file_version = 1;
+
+String ShaderCompiler::cache_user_dir;
+String ShaderCompiler::cache_res_dir;
+Mutex ShaderCompiler::used_cache_keys_mutex;
+HashSet<String> ShaderCompiler::used_cache_keys;
+
+void ShaderCompiler::set_cache_user_dir(const String &p_dir) {
+	cache_user_dir = p_dir;
+}
+
+const String &ShaderCompiler::get_cache_user_dir() {
+	return cache_user_dir;
+}
+
+void ShaderCompiler::set_cache_res_dir(const String &p_dir) {
+	cache_res_dir = p_dir;
+}
+
+HashSet<String> ShaderCompiler::get_used_cache_keys() {
+	MutexLock lock(used_cache_keys_mutex);
+	return used_cache_keys;
+}
+
+String ShaderCompiler::_get_cache_key(RS::ShaderMode p_mode, const String &p_code, const IdentifierActions *p_actions) const {
+	StringBuilder hash_build;
+
+	hash_build.append("[version]");
+	hash_build.append(GODOT_VERSION_FULL_BUILD);
+	hash_build.append(GODOT_VERSION_HASH);
+	hash_build.append("[renderer]");
+	hash_build.append(OS::get_singleton()->get_current_rendering_method());
+	hash_build.append(RS::get_singleton()->is_low_end() ? "low_end" : "");
+	hash_build.append("[default_actions]");
+	hash_build.append(actions_hash);
+	hash_build.append("[mode]");
+	hash_build.append(itos(p_mode));
+	hash_build.append("[entry_points]");
+	for (const KeyValue<StringName, Stage> &E : p_actions->entry_point_stages) {
+		hash_build.append(String(E.key) + ":" + itos(E.value) + ";");
+	}
+	hash_build.append("[usage_flags]");
+	for (const KeyValue<StringName, bool *> &E : p_actions->usage_flag_pointers) {
+		hash_build.append(String(E.key) + ";");
+	}
+	hash_build.append("[write_flags]");
+	for (const KeyValue<StringName, bool *> &E : p_actions->write_flag_pointers) {
+		hash_build.append(String(E.key) + ";");
+	}
+	hash_build.append("[code]");
+	hash_build.append(p_code);
+
+	return hash_build.as_string().sha256_text();
+}
+
+static void _store_string_names(const Ref<FileAccess> &p_file, const Vector<StringName> &p_names) {
+	p_file->store_32(p_names.size());
+	for (const StringName &name : p_names) {
+		p_file->store_pascal_string(name);
+	}
+}
+
+static bool _get_count(const Ref<FileAccess> &p_file, uint32_t &r_count) {
+	// Every element takes at least one byte, so this rejects corrupted counts before allocating.
+	r_count = p_file->get_32();
+	return p_file->get_error() == OK && r_count <= p_file->get_length() - p_file->get_position();
+}
+
+static bool _get_string_names(const Ref<FileAccess> &p_file, Vector<StringName> &r_names) {
+	uint32_t count;
+	if (!_get_count(p_file, count)) {
+		return false;
+	}
+	r_names.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		r_names.write[i] = p_file->get_pascal_string();
+	}
+	return true;
+}
+
+static void _store_uniform(const Ref<FileAccess> &p_file, const SL::ShaderNode::Uniform &p_uniform) {
+	p_file->store_32(p_uniform.order);
+	p_file->store_32(p_uniform.prop_order);
+	p_file->store_32(p_uniform.texture_order);
+	p_file->store_32(p_uniform.texture_binding);
+	p_file->store_32(p_uniform.type);
+	p_file->store_32(p_uniform.precision);
+	p_file->store_32(p_uniform.array_size);
+	p_file->store_32(p_uniform.default_value.size());
+	for (const SL::Scalar &value : p_uniform.default_value) {
+		uint32_t bits = 0;
+		memcpy(&bits, &value, sizeof(SL::Scalar));
+		p_file->store_32(bits);
+	}
+	p_file->store_32(p_uniform.scope);
+	p_file->store_32(p_uniform.hint);
+	p_file->store_8(p_uniform.use_color);
+	p_file->store_32(p_uniform.filter);
+	p_file->store_32(p_uniform.repeat);
+	for (int i = 0; i < 3; i++) {
+		p_file->store_float(p_uniform.hint_range[i]);
+	}
+	p_file->store_32(p_uniform.hint_enum_names.size());
+	for (const String &name : p_uniform.hint_enum_names) {
+		p_file->store_pascal_string(name);
+	}
+	p_file->store_32(p_uniform.instance_index);
+	p_file->store_pascal_string(p_uniform.group);
+	p_file->store_pascal_string(p_uniform.subgroup);
+}
+
+static bool _get_uniform(const Ref<FileAccess> &p_file, SL::ShaderNode::Uniform &r_uniform) {
+	r_uniform.order = int32_t(p_file->get_32());
+	r_uniform.prop_order = int32_t(p_file->get_32());
+	r_uniform.texture_order = int32_t(p_file->get_32());
+	r_uniform.texture_binding = int32_t(p_file->get_32());
+	r_uniform.type = SL::DataType(p_file->get_32());
+	r_uniform.precision = SL::DataPrecision(p_file->get_32());
+	r_uniform.array_size = int32_t(p_file->get_32());
+	uint32_t count;
+	if (!_get_count(p_file, count)) {
+		return false;
+	}
+	r_uniform.default_value.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t bits = p_file->get_32();
+		memcpy(&r_uniform.default_value.write[i], &bits, sizeof(SL::Scalar));
+	}
+	r_uniform.scope = SL::ShaderNode::Uniform::Scope(p_file->get_32());
+	r_uniform.hint = SL::ShaderNode::Uniform::Hint(p_file->get_32());
+	r_uniform.use_color = p_file->get_8();
+	r_uniform.filter = SL::TextureFilter(p_file->get_32());
+	r_uniform.repeat = SL::TextureRepeat(p_file->get_32());
+	for (int i = 0; i < 3; i++) {
+		r_uniform.hint_range[i] = p_file->get_float();
+	}
+	if (!_get_count(p_file, count)) {
+		return false;
+	}
+	r_uniform.hint_enum_names.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		r_uniform.hint_enum_names.write[i] = p_file->get_pascal_string();
+	}
+	r_uniform.instance_index = int32_t(p_file->get_32());
+	r_uniform.group = p_file->get_pascal_string();
+	r_uniform.subgroup = p_file->get_pascal_string();
+	return true;
+}
+
+bool ShaderCompiler::_load_from_cache(const String &p_key, IdentifierActions *p_actions, GeneratedCode &r_gen_code) {
+	const String file_name = p_key + ".cache";
+	Ref<FileAccess> f;
+	if (!cache_user_dir.is_empty()) {
+		f = FileAccess::open(cache_user_dir.path_join(file_name), FileAccess::READ);
+	}
+
+	if (f.is_null() && !cache_res_dir.is_empty()) {
+		f = FileAccess::open(cache_res_dir.path_join(file_name), FileAccess::READ);
+	}
+
+	if (f.is_null()) {
+		return false;
+	}
+
+	char header[5] = { 0, 0, 0, 0, 0 };
+	f->get_buffer((uint8_t *)header, 4);
+	if (header != String(cache_file_header) || f->get_32() != cache_file_version) {
+		return false;
+	}
+
+	// The parser rejects shaders using more varyings than the device supports, so keep doing that.
+	uint32_t varying_count = f->get_32();
+	if (RSG::utilities && varying_count > RSG::utilities->get_maximum_shader_varyings()) {
+		return false;
+	}
+
+	GeneratedCode gen_code;
+	CachedActions cached;
+	uint32_t count;
+
+	if (!_get_count(f, count)) {
+		return false;
+	}
+	gen_code.defines.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		gen_code.defines.write[i] = f->get_pascal_string();
+	}
+
+	if (!_get_count(f, count)) {
+		return false;
+	}
+	gen_code.texture_uniforms.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		GeneratedCode::Texture &texture = gen_code.texture_uniforms.write[i];
+		texture.name = f->get_pascal_string();
+		texture.type = SL::DataType(f->get_32());
+		texture.hint = SL::ShaderNode::Uniform::Hint(f->get_32());
+		texture.use_color = f->get_8();
+		texture.filter = SL::TextureFilter(f->get_32());
+		texture.repeat = SL::TextureRepeat(f->get_32());
+		texture.global = f->get_8();
+		texture.array_size = int32_t(f->get_32());
+	}
+
+	if (!_get_count(f, count)) {
+		return false;
+	}
+	gen_code.uniform_offsets.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		gen_code.uniform_offsets.write[i] = f->get_32();
+	}
+	gen_code.uniform_total_size = f->get_32();
+	gen_code.uniforms = f->get_pascal_string();
+	for (int i = 0; i < STAGE_MAX; i++) {
+		gen_code.stage_globals[i] = f->get_pascal_string();
+	}
+
+	if (!_get_count(f, count)) {
+		return false;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		String name = f->get_pascal_string();
+		gen_code.code[name] = f->get_pascal_string();
+	}
+
+	uint32_t uses = f->get_32();
+	gen_code.uses_global_textures = uses & (1 << 0);
+	gen_code.uses_fragment_time = uses & (1 << 1);
+	gen_code.uses_vertex_time = uses & (1 << 2);
+	gen_code.uses_screen_texture_mipmaps = uses & (1 << 3);
+	gen_code.uses_screen_texture = uses & (1 << 4);
+	gen_code.uses_depth_texture = uses & (1 << 5);
+	gen_code.uses_normal_roughness_texture = uses & (1 << 6);
+
+	if (!_get_string_names(f, cached.render_modes) || !_get_string_names(f, cached.stencil_modes)) {
+		return false;
+	}
+	cached.stencil_reference = int32_t(f->get_32());
+	if (!_get_string_names(f, cached.usage_flags) || !_get_string_names(f, cached.write_flags)) {
+		return false;
+	}
+
+	if (!_get_count(f, count)) {
+		return false;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		StringName name = f->get_pascal_string();
+		SL::ShaderNode::Uniform uniform;
+		if (!_get_uniform(f, uniform)) {
+			return false;
+		}
+
+		// Global uniforms are type checked in the editor only, see ShaderLanguage::_parse_shader().
+		if (uniform.scope == SL::ShaderNode::Uniform::SCOPE_GLOBAL && Engine::get_singleton()->is_editor_hint() && _get_global_shader_uniform_type(name) != uniform.type) {
+			return false;
+		}
+		cached.uniforms.insert(name, uniform);
+	}
+
+	if (f->get_error() != OK) {
+		// Truncated file.
+		return false;
+	}
+
+	r_gen_code = gen_code;
+	_apply_cached_actions(cached, *p_actions);
+	return true;
+}
+
+void ShaderCompiler::_save_to_cache(const String &p_key, const CachedActions &p_cached, uint32_t p_varying_count, const GeneratedCode &p_gen_code) {
+	if (cache_user_dir.is_empty()) {
+		return;
+	}
+
+	Ref<FileAccess> f = FileAccess::open(cache_user_dir.path_join(p_key + ".cache"), FileAccess::WRITE);
+	ERR_FAIL_COND(f.is_null());
+
+	f->store_buffer((const uint8_t *)cache_file_header, 4);
+	f->store_32(cache_file_version);
+	f->store_32(p_varying_count);
+
+	f->store_32(p_gen_code.defines.size());
+	for (const String &define : p_gen_code.defines) {
+		f->store_pascal_string(define);
+	}
+
+	f->store_32(p_gen_code.texture_uniforms.size());
+	for (const GeneratedCode::Texture &texture : p_gen_code.texture_uniforms) {
+		f->store_pascal_string(texture.name);
+		f->store_32(texture.type);
+		f->store_32(texture.hint);
+		f->store_8(texture.use_color);
+		f->store_32(texture.filter);
+		f->store_32(texture.repeat);
+		f->store_8(texture.global);
+		f->store_32(texture.array_size);
+	}
+
+	f->store_32(p_gen_code.uniform_offsets.size());
+	for (uint32_t offset : p_gen_code.uniform_offsets) {
+		f->store_32(offset);
+	}
+	f->store_32(p_gen_code.uniform_total_size);
+	f->store_pascal_string(p_gen_code.uniforms);
+	for (int i = 0; i < STAGE_MAX; i++) {
+		f->store_pascal_string(p_gen_code.stage_globals[i]);
+	}
+
+	f->store_32(p_gen_code.code.size());
+	for (const KeyValue<String, String> &E : p_gen_code.code) {
+		f->store_pascal_string(E.key);
+		f->store_pascal_string(E.value);
+	}
+
+	uint32_t uses = 0;
+	uses |= p_gen_code.uses_global_textures ? (1 << 0) : 0;
+	uses |= p_gen_code.uses_fragment_time ? (1 << 1) : 0;
+	uses |= p_gen_code.uses_vertex_time ? (1 << 2) : 0;
+	uses |= p_gen_code.uses_screen_texture_mipmaps ? (1 << 3) : 0;
+	uses |= p_gen_code.uses_screen_texture ? (1 << 4) : 0;
+	uses |= p_gen_code.uses_depth_texture ? (1 << 5) : 0;
+	uses |= p_gen_code.uses_normal_roughness_texture ? (1 << 6) : 0;
+	f->store_32(uses);
+
+	_store_string_names(f, p_cached.render_modes);
+	_store_string_names(f, p_cached.stencil_modes);
+	f->store_32(p_cached.stencil_reference);
+	_store_string_names(f, p_cached.usage_flags);
+	_store_string_names(f, p_cached.write_flags);
+
+	f->store_32(p_cached.uniforms.size());
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : p_cached.uniforms) {
+		f->store_pascal_string(E.key);
+		_store_uniform(f, E.value);
+	}
+}
+
 Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+	const bool use_cache = !cache_user_dir.is_empty() || !cache_res_dir.is_empty();
+	String cache_key;
+	if (use_cache) {
+		cache_key = _get_cache_key(p_mode, p_code, p_actions);
+		if (!cache_user_dir.is_empty()) {
+			MutexLock lock(used_cache_keys_mutex);
+			used_cache_keys.insert(cache_key);
+		}
+		if (_load_from_cache(cache_key, p_actions, r_gen_code)) {
+			return OK;
+		}
+	}
+
 	SL::ShaderCompileInfo info;
 	info.functions = ShaderTypes::get_singleton()->get_functions(p_mode);
 	info.render_modes = ShaderTypes::get_singleton()->get_modes(p_mode);
@@ -1581,8 +1970,56 @@ Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, Ident
 
 	shader = parser.get_shader();
 	function = nullptr;
+
+	if (!use_cache) {
+		// Return value only relevant within nested calls.
+		_ALLOW_DISCARD_ _dump_node_code(shader, 1, r_gen_code, *p_actions, actions, false);
+		return OK;
+	}
+
+	// Record what the generated code writes through the actions, so it can be replayed when it's loaded from the cache.
+	IdentifierActions recording;
+	recording.entry_point_stages = p_actions->entry_point_stages;
+
+	LocalVector<bool> flags;
+	flags.resize_initialized(p_actions->usage_flag_pointers.size() + p_actions->write_flag_pointers.size());
+	uint32_t flag_index = 0;
+	for (const KeyValue<StringName, bool *> &E : p_actions->usage_flag_pointers) {
+		recording.usage_flag_pointers.insert(E.key, &flags[flag_index++]);
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions->write_flag_pointers) {
+		recording.write_flag_pointers.insert(E.key, &flags[flag_index++]);
+	}
+
+	CachedActions cached;
+	recording.uniforms = &cached.uniforms;
+
 	// Return value only relevant within nested calls.
-	_ALLOW_DISCARD_ _dump_node_code(shader, 1, r_gen_code, *p_actions, actions, false);
+	_ALLOW_DISCARD_ _dump_node_code(shader, 1, r_gen_code, recording, actions, false);
+
+	cached.render_modes = shader->render_modes;
+	cached.stencil_modes = shader->stencil_modes;
+	cached.stencil_reference = shader->stencil_reference;
+
+	flag_index = 0;
+	for (const KeyValue<StringName, bool *> &E : p_actions->usage_flag_pointers) {
+		if (flags[flag_index++]) {
+			cached.usage_flags.push_back(E.key);
+		}
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions->write_flag_pointers) {
+		if (flags[flag_index++]) {
+			cached.write_flags.push_back(E.key);
+		}
+	}
+
+	_apply_cached_actions(cached, *p_actions);
+
+	uint32_t varying_count = actions.base_varying_index;
+	for (const KeyValue<StringName, SL::ShaderNode::Varying> &E : shader->varyings) {
+		varying_count += E.value.get_size();
+	}
+	_save_to_cache(cache_key, cached, varying_count, r_gen_code);
 
 	return OK;
 }
@@ -1590,6 +2027,20 @@ Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, Ident
 void ShaderCompiler::initialize(DefaultIdentifierActions p_actions) {
 	actions = p_actions;
 
+	StringBuilder hash_build;
+	const HashMap<StringName, String> *maps[] = { &actions.renames, &actions.render_mode_defines, &actions.usage_defines, &actions.custom_samplers };
+	for (const HashMap<StringName, String> *map : maps) {
+		hash_build.append("[map]");
+		for (const KeyValue<StringName, String> &E : *map) {
+			hash_build.append(String(E.key) + "=" + E.value + ";");
+		}
+	}
+	hash_build.append("[values]");
+	hash_build.append(itos(actions.default_filter) + ";" + itos(actions.default_repeat) + ";" + itos(actions.base_texture_binding_index) + ";" + itos(actions.texture_layout_set) + ";");
+	hash_build.append(actions.base_uniform_string + ";" + actions.global_buffer_array_variable + ";" + actions.instance_uniform_index_variable + ";");
+	hash_build.append(itos(actions.base_varying_index) + ";" + itos(actions.apply_luminance_multiplier) + ";" + itos(actions.check_multiview_samplers));
+	actions_hash = hash_build.as_string().sha256_text();
+
 	time_name = "TIME";
 
 	List<String> func_list;
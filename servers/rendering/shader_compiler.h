@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/os/mutex.h"
 #include "core/templates/pair.h"
 #include "servers/rendering/shader_language.h"
 #include "servers/rendering_server.h"
@@ -105,6 +106,15 @@ public:
 	};
 
 private:
+	struct CachedActions {
+		Vector<StringName> render_modes;
+		Vector<StringName> stencil_modes;
+		int stencil_reference = -1;
+		Vector<StringName> usage_flags;
+		Vector<StringName> write_flags;
+		HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+	};
+
 	ShaderLanguage parser;
 
 	String _get_sampler_name(ShaderLanguage::TextureFilter p_filter, ShaderLanguage::TextureRepeat p_repeat);
@@ -125,12 +135,32 @@ private:
 	HashSet<StringName> fragment_varyings;
 
 	DefaultIdentifierActions actions;
+	String actions_hash;
+
+	static String cache_user_dir;
+	static String cache_res_dir;
+	static Mutex used_cache_keys_mutex;
+	static HashSet<String> used_cache_keys;
 
 	static ShaderLanguage::DataType _get_global_shader_uniform_type(const StringName &p_name);
 
+	static void _apply_render_modes(const Vector<StringName> &p_render_modes, const Vector<StringName> &p_stencil_modes, int p_stencil_reference, IdentifierActions &p_actions);
+	static void _apply_cached_actions(const CachedActions &p_cached, IdentifierActions &p_actions);
+
+	String _get_cache_key(RS::ShaderMode p_mode, const String &p_code, const IdentifierActions *p_actions) const;
+	bool _load_from_cache(const String &p_key, IdentifierActions *p_actions, GeneratedCode &r_gen_code);
+	void _save_to_cache(const String &p_key, const CachedActions &p_cached, uint32_t p_varying_count, const GeneratedCode &p_gen_code);
+
 public:
 	Error compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
 
+	// Compiled output is cached by content in these directories when they are set. The resource one is read-only and used by exported projects.
+	static void set_cache_user_dir(const String &p_dir);
+	static const String &get_cache_user_dir();
+	static void set_cache_res_dir(const String &p_dir);
+	// Keys of the cache entries compiled or loaded since startup, which are the ones worth exporting.
+	static HashSet<String> get_used_cache_keys();
+
 	void initialize(DefaultIdentifierActions p_actions);
 	ShaderCompiler();
 };
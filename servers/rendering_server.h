@@ -1869,6 +1869,10 @@ public:
 	virtual bool is_on_render_thread() = 0;
 	virtual void call_on_render_thread(const Callable &p_callable) = 0;
 
+	// Calls made by the current thread in between are handed over to the render thread in batches.
+	virtual void begin_command_batch() {}
+	virtual void end_command_batch() {}
+
 	String get_current_rendering_driver_name() const;
 	String get_current_rendering_method() const;
 
@@ -33,6 +33,7 @@
 #include "core/object/class_db.h"
 #include "core/object/object.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
 
 #include "tests/test_macros.h"
 
@@ -489,6 +490,189 @@ public:
 	int order_script = -1;
 };
 
+class _SignalDisconnector : public Object {
+public:
+	Object *emitter = nullptr;
+	Callable other;
+	int calls = 0;
+
+	void disconnect_other(int p_value) {
+		calls++;
+		if (emitter->is_connected("value_changed", other)) {
+			emitter->disconnect("value_changed", other);
+		}
+	}
+};
+
+class _SignalFreer : public Object {
+public:
+	Object *target = nullptr;
+	int calls = 0;
+
+	void free_target(int p_value) {
+		calls++;
+		if (target) {
+			memdelete(target);
+			target = nullptr;
+		}
+	}
+};
+
+TEST_CASE("[Object] Signal emission to native methods") {
+	GDREGISTER_CLASS(_TestDerivedObject);
+
+	Object emitter;
+	emitter.add_user_signal(MethodInfo("value_changed", PropertyInfo(Variant::INT, "value")));
+
+	SUBCASE("Arguments of the exact type and arguments needing a conversion are both passed") {
+		_TestDerivedObject target;
+		target.set_property(0);
+		emitter.connect("value_changed", Callable(&target, "set_property"));
+
+		emitter.emit_signal("value_changed", 5);
+		CHECK(target.get_property() == 5);
+
+		emitter.emit_signal("value_changed", 2.0);
+		CHECK(target.get_property() == 2);
+
+		emitter.emit_signal("value_changed", true);
+		CHECK(target.get_property() == 1);
+	}
+
+	SUBCASE("One-shot connections are called once") {
+		_TestDerivedObject target;
+		target.set_property(0);
+		emitter.connect("value_changed", Callable(&target, "set_property"), Object::CONNECT_ONE_SHOT);
+
+		emitter.emit_signal("value_changed", 3);
+		CHECK(target.get_property() == 3);
+		CHECK_FALSE(emitter.is_connected("value_changed", Callable(&target, "set_property")));
+
+		emitter.emit_signal("value_changed", 4);
+		CHECK(target.get_property() == 3);
+	}
+
+	SUBCASE("Targets with a script instance are called through the script") {
+		class _CountingScriptInstance : public _MockScriptInstance {
+		public:
+			int calls = 0;
+
+			Variant callp(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) override {
+				calls++;
+				return Variant();
+			}
+		};
+
+		_TestDerivedObject target;
+		target.set_property(0);
+		_CountingScriptInstance *script_instance = memnew(_CountingScriptInstance);
+		target.set_script_instance(script_instance);
+		emitter.connect("value_changed", Callable(&target, "set_property"));
+
+		emitter.emit_signal("value_changed", 6);
+		CHECK(script_instance->calls == 1);
+		CHECK(target.get_property() == 0);
+
+		emitter.disconnect("value_changed", Callable(&target, "set_property"));
+	}
+
+	SUBCASE("Connections removed during an emission still receive that emission") {
+		_TestDerivedObject target;
+		target.set_property(0);
+		_SignalDisconnector disconnector;
+		disconnector.emitter = &emitter;
+		disconnector.other = Callable(&target, "set_property");
+
+		emitter.connect("value_changed", callable_mp(&disconnector, &_SignalDisconnector::disconnect_other));
+		emitter.connect("value_changed", disconnector.other);
+
+		emitter.emit_signal("value_changed", 7);
+		CHECK(disconnector.calls == 1);
+		CHECK(target.get_property() == 7);
+		CHECK_FALSE(emitter.is_connected("value_changed", disconnector.other));
+
+		emitter.emit_signal("value_changed", 8);
+		CHECK(disconnector.calls == 2);
+		CHECK(target.get_property() == 7);
+	}
+
+	SUBCASE("Freed targets are skipped") {
+		_TestDerivedObject *target = memnew(_TestDerivedObject);
+		emitter.connect("value_changed", Callable(target, "set_property"));
+		memdelete(target);
+
+		emitter.emit_signal("value_changed", 9);
+		List<Object::Connection> connections;
+		emitter.get_signal_connection_list("value_changed", &connections);
+		CHECK(connections.is_empty());
+	}
+
+	SUBCASE("Targets freed during an emission are skipped") {
+		_TestDerivedObject survivor;
+		survivor.set_property(0);
+		_SignalFreer freer;
+		freer.target = memnew(_TestDerivedObject);
+
+		// The freed target comes after the freer, so the emission already holds its slot.
+		emitter.connect("value_changed", callable_mp(&freer, &_SignalFreer::free_target));
+		emitter.connect("value_changed", Callable(freer.target, "set_property"));
+		emitter.connect("value_changed", Callable(&survivor, "set_property"));
+
+		emitter.emit_signal("value_changed", 10);
+		CHECK(freer.calls == 1);
+		CHECK(freer.target == nullptr);
+		CHECK(survivor.get_property() == 10);
+
+		List<Object::Connection> connections;
+		emitter.get_signal_connection_list("value_changed", &connections);
+		CHECK(connections.size() == 2);
+
+		emitter.disconnect("value_changed", callable_mp(&freer, &_SignalFreer::free_target));
+		emitter.disconnect("value_changed", Callable(&survivor, "set_property"));
+	}
+}
+
+TEST_CASE("[Object][Benchmark] Signal emission" * doctest::skip(true)) {
+	GDREGISTER_CLASS(_TestDerivedObject);
+
+	const int target_count = 8;
+	const int emit_count = 200000;
+
+	Object emitter;
+	emitter.add_user_signal(MethodInfo("value_changed", PropertyInfo(Variant::INT, "value")));
+	_TestDerivedObject targets[target_count];
+	for (int i = 0; i < target_count; i++) {
+		emitter.connect("value_changed", Callable(&targets[i], "set_property"));
+	}
+
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < emit_count; i++) {
+		emitter.emit_signal("value_changed", i);
+	}
+	double elapsed = (OS::get_singleton()->get_ticks_usec() - start) / 1000000.0;
+
+	for (int i = 0; i < target_count; i++) {
+		CHECK(targets[i].get_property() == emit_count - 1);
+	}
+	MESSAGE(vformat("Signal emission to %d native methods: %.2f million emissions per second.", target_count, emit_count / elapsed / 1000000.0));
+
+	for (int i = 0; i < target_count; i++) {
+		emitter.disconnect("value_changed", Callable(&targets[i], "set_property"));
+		emitter.connect("value_changed", callable_mp(&targets[i], &_TestDerivedObject::set_property));
+	}
+
+	start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < emit_count; i++) {
+		emitter.emit_signal("value_changed", i + 1);
+	}
+	elapsed = (OS::get_singleton()->get_ticks_usec() - start) / 1000000.0;
+
+	for (int i = 0; i < target_count; i++) {
+		CHECK(targets[i].get_property() == emit_count);
+	}
+	MESSAGE(vformat("Signal emission to %d method pointers: %.2f million emissions per second.", target_count, emit_count / elapsed / 1000000.0));
+}
+
 TEST_CASE("[Object] Notification order") { // GH-52325
 	NotificationObjectSubclass *object = memnew(NotificationObjectSubclass);
 
@@ -0,0 +1,154 @@
+/**************************************************************************/
+/*  test_small_object_allocator.h                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/os.h"
+#include "core/os/small_object_allocator.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+#include <cstddef>
+#include <cstdlib>
+
+namespace TestSmallObjectAllocator {
+
+TEST_CASE("[SmallObjectAllocator] Allocation and reuse") {
+	CHECK(SmallObjectAllocator::alloc(SmallObjectAllocator::MAX_SIZE + 1) == nullptr);
+
+	for (size_t size = 0; size <= SmallObjectAllocator::MAX_SIZE; size += 7) {
+		uint8_t *block = (uint8_t *)SmallObjectAllocator::alloc(size);
+		REQUIRE(block != nullptr);
+		CHECK(((uintptr_t)block % alignof(max_align_t)) == 0);
+		CHECK(SmallObjectAllocator::get_block_size(block) >= size);
+		memset(block, 0xAB, size);
+		CHECK(SmallObjectAllocator::free(block));
+	}
+
+	// Freed blocks are reused by the same thread first.
+	void *block = SmallObjectAllocator::alloc(24);
+	CHECK(SmallObjectAllocator::free(block));
+	CHECK(SmallObjectAllocator::alloc(24) == block);
+	CHECK(SmallObjectAllocator::free(block));
+
+	CHECK(SmallObjectAllocator::get_reserved_bytes() > 0);
+
+	void *system_block = malloc(32);
+	CHECK(SmallObjectAllocator::get_block_size(system_block) == 0);
+	CHECK_FALSE(SmallObjectAllocator::free(system_block));
+	free(system_block);
+}
+
+struct AllocationBenchmark {
+	static constexpr uint32_t LIVE_BLOCKS = 256;
+
+	uint32_t iterations = 0;
+	bool use_system = false;
+	SafeNumeric<uint32_t> mismatches;
+	SafeNumeric<uint32_t> thread_index;
+
+	static void thread_func(void *p_userdata) {
+		AllocationBenchmark *benchmark = static_cast<AllocationBenchmark *>(p_userdata);
+		const uint32_t index = benchmark->thread_index.postincrement();
+		uint8_t *blocks[LIVE_BLOCKS] = {};
+		for (uint32_t i = 0; i < benchmark->iterations; i++) {
+			const uint32_t slot = (i * 7919 + index * 104729) % LIVE_BLOCKS;
+			if (blocks[slot]) {
+				if (blocks[slot][0] != uint8_t(slot)) {
+					benchmark->mismatches.increment();
+				}
+				if (benchmark->use_system) {
+					free(blocks[slot]);
+				} else {
+					SmallObjectAllocator::free(blocks[slot]);
+				}
+			}
+			// Typical sizes of strings, arrays and small objects.
+			const size_t size = 8 + (i * 40) % 248;
+			blocks[slot] = (uint8_t *)(benchmark->use_system ? malloc(size) : SmallObjectAllocator::alloc(size));
+			blocks[slot][0] = uint8_t(slot);
+		}
+		for (uint8_t *block : blocks) {
+			if (benchmark->use_system) {
+				free(block);
+			} else {
+				SmallObjectAllocator::free(block);
+			}
+		}
+	}
+};
+
+TEST_CASE("[SmallObjectAllocator] Concurrent allocations keep their contents") {
+	AllocationBenchmark benchmark;
+	benchmark.iterations = 20000;
+
+	LocalVector<Thread> threads;
+	threads.resize(4);
+	for (Thread &thread : threads) {
+		thread.start(&AllocationBenchmark::thread_func, &benchmark);
+	}
+	for (Thread &thread : threads) {
+		thread.wait_to_finish();
+	}
+
+	CHECK(benchmark.mismatches.get() == 0);
+}
+
+TEST_CASE("[SmallObjectAllocator][Benchmark] Against the system allocator" * doctest::skip(true)) {
+	const uint32_t thread_counts[] = { 1, 2, 4, 8 };
+	const uint32_t iterations = 500000;
+
+	for (int mode = 0; mode < 2; mode++) {
+		for (const uint32_t thread_count : thread_counts) {
+			AllocationBenchmark benchmark;
+			benchmark.use_system = mode == 1;
+			benchmark.iterations = iterations;
+
+			LocalVector<Thread> threads;
+			threads.resize(thread_count);
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (Thread &thread : threads) {
+				thread.start(&AllocationBenchmark::thread_func, &benchmark);
+			}
+			for (Thread &thread : threads) {
+				thread.wait_to_finish();
+			}
+			const uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+
+			CHECK(benchmark.mismatches.get() == 0);
+
+			MESSAGE(vformat("%s, %d threads: %.2f million allocations per second.", benchmark.use_system ? "System allocator" : "Small object allocator", thread_count, double(iterations) * thread_count / elapsed));
+		}
+	}
+}
+
+} // namespace TestSmallObjectAllocator
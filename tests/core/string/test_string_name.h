@@ -0,0 +1,144 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName a = "interned_name";
+	const StringName b = String("interned_name");
+	const StringName c = "other_name";
+
+	CHECK(a == b);
+	CHECK(a.data_unique_pointer() == b.data_unique_pointer());
+	CHECK(a != c);
+	CHECK(a == "interned_name");
+	CHECK(StringName().is_empty());
+	CHECK(StringName("").is_empty());
+}
+
+struct InterningBenchmark {
+	LocalVector<String> names;
+	LocalVector<StringName> interned;
+	uint32_t iterations = 0;
+	bool create_new = false;
+	SafeNumeric<uint32_t> mismatches;
+	SafeNumeric<uint32_t> thread_index;
+
+	static void thread_func(void *p_userdata) {
+		InterningBenchmark *benchmark = static_cast<InterningBenchmark *>(p_userdata);
+		const uint32_t index = benchmark->thread_index.postincrement();
+		const uint32_t name_count = benchmark->names.size();
+		for (uint32_t i = 0; i < benchmark->iterations; i++) {
+			const uint32_t name_index = (i * 7919 + index * 104729) % name_count;
+			if (benchmark->create_new) {
+				// Created and released right away, exercising the insertion and removal paths.
+				const StringName name = benchmark->names[name_index] + "_" + itos(index);
+				if (name.is_empty()) {
+					benchmark->mismatches.increment();
+				}
+			} else {
+				const StringName name = benchmark->names[name_index];
+				if (name != benchmark->interned[name_index]) {
+					benchmark->mismatches.increment();
+				}
+			}
+		}
+	}
+};
+
+TEST_CASE("[StringName] Interning from several threads") {
+	for (int mode = 0; mode < 2; mode++) {
+		InterningBenchmark benchmark;
+		benchmark.create_new = mode == 1;
+		benchmark.iterations = 2000;
+		benchmark.names.resize(256);
+		benchmark.interned.resize(256);
+		for (uint32_t i = 0; i < 256; i++) {
+			benchmark.names[i] = "threaded_name_" + itos(i);
+			benchmark.interned[i] = benchmark.names[i];
+		}
+
+		Thread threads[4];
+		for (Thread &thread : threads) {
+			thread.start(&InterningBenchmark::thread_func, &benchmark);
+		}
+		for (Thread &thread : threads) {
+			thread.wait_to_finish();
+		}
+
+		CHECK(benchmark.mismatches.get() == 0);
+	}
+}
+
+TEST_CASE("[StringName][Benchmark] Multithreaded interning" * doctest::skip(true)) {
+	const uint32_t thread_counts[] = { 1, 2, 4, 8 };
+	const uint32_t name_count = 4096;
+	const uint32_t iterations = 50000;
+
+	for (int mode = 0; mode < 2; mode++) {
+		for (const uint32_t thread_count : thread_counts) {
+			InterningBenchmark benchmark;
+			benchmark.create_new = mode == 1;
+			benchmark.iterations = iterations;
+			benchmark.names.resize(name_count);
+			benchmark.interned.resize(name_count);
+			for (uint32_t i = 0; i < name_count; i++) {
+				benchmark.names[i] = "benchmark_name_" + itos(i);
+				benchmark.interned[i] = benchmark.names[i];
+			}
+
+			LocalVector<Thread> threads;
+			threads.resize(thread_count);
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (Thread &thread : threads) {
+				thread.start(&InterningBenchmark::thread_func, &benchmark);
+			}
+			for (Thread &thread : threads) {
+				thread.wait_to_finish();
+			}
+			const uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+
+			CHECK(benchmark.mismatches.get() == 0);
+
+			MESSAGE(vformat("%s, %d threads: %.2f million names per second.", benchmark.create_new ? "New names" : "Existing names", thread_count, double(iterations) * thread_count / elapsed));
+		}
+	}
+}
+
+} // namespace TestStringName
@@ -484,6 +484,223 @@ TEST_CASE("[Stress][CommandQueue] Stress test command queue") {
 			ProjectSettings::get_singleton()->property_get_revert(COMMAND_QUEUE_SETTING));
 }
 
+class BatchBenchmarkState {
+public:
+	CommandQueueMT command_queue;
+	SafeNumeric<uint64_t> commands_run;
+	SafeFlag producers_done;
+	uint32_t commands_per_producer = 0;
+	bool use_batches = false;
+
+	void command(Transform3D p_transform) {
+		commands_run.increment();
+	}
+
+	static void consumer_thread_loop(void *p_state) {
+		BatchBenchmarkState *state = static_cast<BatchBenchmarkState *>(p_state);
+		while (!state->producers_done.is_set()) {
+			state->command_queue.flush_if_pending();
+		}
+		state->command_queue.flush_all();
+	}
+
+	static void producer_thread_loop(void *p_state) {
+		BatchBenchmarkState *state = static_cast<BatchBenchmarkState *>(p_state);
+		Transform3D transform;
+		if (state->use_batches) {
+			state->command_queue.begin_batch();
+		}
+		for (uint32_t i = 0; i < state->commands_per_producer; i++) {
+			state->command_queue.push(state, &BatchBenchmarkState::command, transform);
+		}
+		if (state->use_batches) {
+			state->command_queue.end_batch();
+		}
+	}
+};
+
+TEST_CASE("[CommandQueue] Batched pushes are staged until the batch ends") {
+	SharedThreadState sts;
+	sts.init_threads();
+
+	sts.command_queue.begin_batch();
+	sts.command_queue.push(&sts, &SharedThreadState::func1, Transform3D());
+	sts.command_queue.begin_batch(); // Nested.
+	sts.command_queue.push(&sts, &SharedThreadState::func1, Transform3D());
+	sts.command_queue.end_batch();
+	CHECK_MESSAGE(sts.func1_count == 0, "Batched commands should not run before being published.");
+
+	sts.message_count_to_read = -1;
+	sts.reader_threadwork.main_start_work();
+	sts.reader_threadwork.main_wait_for_done();
+	CHECK_MESSAGE(sts.func1_count == 0, "Batched commands should stay staged until the batch ends.");
+
+	sts.command_queue.end_batch();
+	sts.reader_threadwork.main_start_work();
+	sts.reader_threadwork.main_wait_for_done();
+	CHECK_MESSAGE(sts.func1_count == 2, "Ending the batch should publish its commands.");
+
+	sts.destroy_threads();
+}
+
+TEST_CASE("[CommandQueue] Batches for another queue are ignored while batching") {
+	SharedThreadState sts;
+	sts.init_threads();
+	CommandQueueMT other_queue;
+
+	sts.command_queue.begin_batch();
+	sts.command_queue.push(&sts, &SharedThreadState::func1, Transform3D());
+	other_queue.begin_batch();
+	other_queue.push(&sts, &SharedThreadState::func1, Transform3D());
+	other_queue.flush_all();
+	CHECK_MESSAGE(sts.func1_count == 1, "Commands to the other queue should be pushed right away.");
+	other_queue.end_batch();
+	sts.command_queue.end_batch();
+
+	sts.message_count_to_read = -1;
+	sts.reader_threadwork.main_start_work();
+	sts.reader_threadwork.main_wait_for_done();
+	CHECK_MESSAGE(sts.func1_count == 2, "Ending the batch should publish its commands.");
+
+	sts.destroy_threads();
+}
+
+class BatchOrderState {
+public:
+	static const uint32_t PRODUCER_COUNT = 4;
+	static const uint32_t COMMANDS_PER_PRODUCER = 3000;
+
+	CommandQueueMT command_queue;
+	SafeFlag producers_done;
+	// Only touched by the consumer thread, while running commands.
+	LocalVector<uint32_t> log;
+	uint32_t run_counts[PRODUCER_COUNT] = {};
+	// Set by each producer.
+	bool syncs_in_order[PRODUCER_COUNT] = {};
+
+	struct ProducerData {
+		BatchOrderState *state = nullptr;
+		uint32_t producer = 0;
+	};
+	ProducerData producer_data[PRODUCER_COUNT];
+
+	void record(uint32_t p_producer, uint32_t p_sequence) {
+		log.push_back(p_producer * COMMANDS_PER_PRODUCER + p_sequence);
+		run_counts[p_producer]++;
+	}
+
+	uint32_t get_run_count(uint32_t p_producer) {
+		return run_counts[p_producer];
+	}
+
+	void store_run_count(uint32_t p_producer, uint32_t *r_run_count) {
+		*r_run_count = run_counts[p_producer];
+	}
+
+	static void consumer_thread_loop(void *p_state) {
+		BatchOrderState *state = static_cast<BatchOrderState *>(p_state);
+		while (!state->producers_done.is_set()) {
+			state->command_queue.flush_if_pending();
+		}
+		state->command_queue.flush_all();
+	}
+
+	// Pushes numbered commands in a batch, with syncs and returns in between. Every sync
+	// has to publish the staged commands first, so they run before it returns.
+	static void producer_thread_loop(void *p_data) {
+		ProducerData *data = static_cast<ProducerData *>(p_data);
+		BatchOrderState *state = data->state;
+		bool in_order = true;
+
+		state->command_queue.begin_batch();
+		for (uint32_t i = 0; i < COMMANDS_PER_PRODUCER; i++) {
+			state->command_queue.push(state, &BatchOrderState::record, data->producer, i);
+			if (i % 97 == 0) {
+				uint32_t run_count = 0;
+				state->command_queue.push_and_ret(state, &BatchOrderState::get_run_count, &run_count, data->producer);
+				in_order &= run_count == i + 1;
+			} else if (i % 61 == 0) {
+				uint32_t run_count = 0;
+				state->command_queue.push_and_sync(state, &BatchOrderState::store_run_count, data->producer, &run_count);
+				in_order &= run_count == i + 1;
+			}
+		}
+		state->command_queue.end_batch();
+
+		state->syncs_in_order[data->producer] = in_order;
+	}
+};
+
+TEST_CASE("[CommandQueue] Batched pushes from several threads keep per-thread order with syncs") {
+	BatchOrderState state;
+
+	Thread consumer;
+	consumer.start(&BatchOrderState::consumer_thread_loop, &state);
+
+	Thread producers[BatchOrderState::PRODUCER_COUNT];
+	for (uint32_t i = 0; i < BatchOrderState::PRODUCER_COUNT; i++) {
+		state.producer_data[i].state = &state;
+		state.producer_data[i].producer = i;
+		producers[i].start(&BatchOrderState::producer_thread_loop, &state.producer_data[i]);
+	}
+	for (Thread &producer : producers) {
+		producer.wait_to_finish();
+	}
+	state.producers_done.set();
+	consumer.wait_to_finish();
+
+	for (uint32_t i = 0; i < BatchOrderState::PRODUCER_COUNT; i++) {
+		CHECK_MESSAGE(state.syncs_in_order[i], "Synced commands should run after every command staged before them.");
+		CHECK(state.run_counts[i] == BatchOrderState::COMMANDS_PER_PRODUCER);
+	}
+
+	// Producers interleave freely, but each one's commands must run in the order they were pushed.
+	uint32_t next_sequences[BatchOrderState::PRODUCER_COUNT] = {};
+	bool all_in_order = true;
+	for (const uint32_t entry : state.log) {
+		const uint32_t producer = entry / BatchOrderState::COMMANDS_PER_PRODUCER;
+		const uint32_t sequence = entry % BatchOrderState::COMMANDS_PER_PRODUCER;
+		all_in_order &= sequence == next_sequences[producer];
+		next_sequences[producer] = sequence + 1;
+	}
+	CHECK(all_in_order);
+	CHECK(state.log.size() == BatchOrderState::PRODUCER_COUNT * BatchOrderState::COMMANDS_PER_PRODUCER);
+}
+
+TEST_CASE("[CommandQueue][Benchmark] Commands per second with and without batches" * doctest::skip(true)) {
+	const uint32_t producer_counts[] = { 1, 2, 4, 8 };
+	const uint32_t commands_per_producer = 100000;
+
+	for (int mode = 0; mode < 2; mode++) {
+		for (const uint32_t producer_count : producer_counts) {
+			BatchBenchmarkState state;
+			state.use_batches = mode == 1;
+			state.commands_per_producer = commands_per_producer;
+
+			Thread consumer;
+			consumer.start(&BatchBenchmarkState::consumer_thread_loop, &state);
+
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			LocalVector<Thread> producers;
+			producers.resize(producer_count);
+			for (Thread &producer : producers) {
+				producer.start(&BatchBenchmarkState::producer_thread_loop, &state);
+			}
+			for (Thread &producer : producers) {
+				producer.wait_to_finish();
+			}
+			state.producers_done.set();
+			consumer.wait_to_finish();
+			const uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+
+			const uint64_t expected = uint64_t(commands_per_producer) * producer_count;
+			CHECK(state.commands_run.get() == expected);
+
+			MESSAGE(vformat("%s, %d producers: %.2f million commands per second.", state.use_batches ? "Batched" : "Locked", producer_count, double(expected) / elapsed));
+		}
+	}
+}
+
 TEST_CASE("[CommandQueue] Test Parameter Passing Semantics") {
 	SharedThreadState sts;
 	sts.init_threads();
@@ -31,6 +31,7 @@
 #pragma once
 
 #include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
 
 #include "tests/test_macros.h"
 
@@ -106,6 +107,239 @@ TEST_CASE("[WorkerThreadPool] Process elements using group tasks") {
 	}
 }
 
+TEST_CASE("[WorkerThreadPool] Process elements using group tasks with work stealing") {
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init(-1, 0.3, true);
+
+	for (int iterations = 0; iterations < 500; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(0.0f, 12.0f));
+		const int tasks = Math::pow(2.0f, Math::random(0.0f, 5.0f));
+		const bool low_priority = Math::rand() % 2;
+
+		counter.clear();
+		counter.resize(count);
+		WorkerThreadPool::GroupID group1 = WorkerThreadPool::get_singleton()->add_native_group_task(static_group_test, (void *)2, count, tasks, !low_priority);
+		WorkerThreadPool::GroupID group2 = WorkerThreadPool::get_singleton()->add_group_task(callable_mp_static(static_callable_group_test), count, tasks, low_priority);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group1);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group2);
+
+		bool all_run_once = true;
+		for (int i = 0; i < count; i++) {
+			//Reduce number of check messages
+			all_run_once &= counter[i].get() == 2;
+		}
+		CHECK(all_run_once);
+	}
+
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init();
+}
+
+struct UnevenGroupTester {
+	LocalVector<Thread::ID> threads;
+	uint32_t heavy_count = 0;
+
+	void process(uint32_t p_index, void *p_unused) {
+		// Only the first elements are expensive, so they all land in the range of the first task.
+		if (p_index < heavy_count) {
+			OS::get_singleton()->delay_usec(200);
+		}
+		threads[p_index] = Thread::get_caller_id();
+	}
+};
+
+TEST_CASE("[WorkerThreadPool] Work stealing spreads uneven group elements across threads") {
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init(4, 0.3, true);
+
+	const uint32_t element_count = 4096;
+	UnevenGroupTester tester;
+	tester.threads.resize_initialized(element_count);
+	tester.heavy_count = element_count / 16;
+
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(&tester, &UnevenGroupTester::process, (void *)nullptr, element_count, 4, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	bool all_run = true;
+	for (uint32_t i = 0; i < element_count; i++) {
+		all_run &= tester.threads[i] != Thread::UNASSIGNED_ID;
+	}
+	CHECK(all_run);
+
+	// Without stealing, the task owning the expensive elements would process all of them on its own.
+	HashSet<Thread::ID> heavy_threads;
+	for (uint32_t i = 0; i < tester.heavy_count; i++) {
+		heavy_threads.insert(tester.threads[i]);
+	}
+	CHECK(heavy_threads.size() > 1);
+
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init();
+}
+
+static void static_throughput_group_test(void *p_arg, uint32_t p_index) {
+	uint32_t *results = (uint32_t *)p_arg;
+	results[p_index] += p_index & 1;
+}
+
+TEST_CASE("[WorkerThreadPool][Benchmark] Group task throughput against thread count" * doctest::skip(true)) {
+	const uint32_t element_count = 1 << 20;
+	const int group_count = 16;
+	const int thread_counts[] = { 1, 2, 4, 8, 16, 32 };
+
+	LocalVector<uint32_t> results;
+	results.resize(element_count);
+
+	for (int mode = 0; mode < 2; mode++) {
+		const bool work_stealing = mode == 1;
+		for (const int thread_count : thread_counts) {
+			WorkerThreadPool::get_singleton()->finish();
+			WorkerThreadPool::get_singleton()->init(thread_count, 0.3, work_stealing);
+
+			memset(results.ptr(), 0, element_count * sizeof(uint32_t));
+
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < group_count; i++) {
+				WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_throughput_group_test, results.ptr(), element_count, -1, true);
+				WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+			}
+			const uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+
+			bool all_run = true;
+			for (uint32_t i = 0; i < element_count; i++) {
+				all_run &= results[i] == (i & 1) * group_count;
+			}
+			CHECK(all_run);
+
+			MESSAGE(vformat("%s, %d threads: %.1f million elements per second.", work_stealing ? "Work stealing" : "Shared counter", thread_count, double(element_count) * group_count / elapsed));
+		}
+	}
+
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init();
+}
+
+struct TaskGraphTester {
+	SafeNumeric<uint32_t> clock;
+	uint32_t stamps[4] = {};
+	LocalVector<uint32_t> group_stamps;
+
+	void stamp(uint32_t p_node) {
+		stamps[p_node] = clock.increment();
+	}
+
+	void stamp_element(uint32_t p_index, uint32_t p_unused) {
+		group_stamps[p_index] = clock.increment();
+	}
+};
+
+TEST_CASE("[WorkerThreadPool] Task graph runs nodes after their dependencies") {
+	TaskGraphTester tester;
+	tester.group_stamps.resize(64);
+
+	// Diamond: 0 -> (1, group) -> 2, then 3 after 2.
+	WorkerThreadPool::TaskGraph graph;
+	WorkerThreadPool::TaskGraph::NodeID first = graph.add_template_task(&tester, &TaskGraphTester::stamp, 0);
+	WorkerThreadPool::TaskGraph::NodeID branch = graph.add_template_task(&tester, &TaskGraphTester::stamp, 1);
+	WorkerThreadPool::TaskGraph::NodeID group = graph.add_template_group_task(&tester, &TaskGraphTester::stamp_element, 0, 64);
+	WorkerThreadPool::TaskGraph::NodeID join = graph.add_template_task(&tester, &TaskGraphTester::stamp, 2);
+	WorkerThreadPool::TaskGraph::NodeID last = graph.add_template_task(&tester, &TaskGraphTester::stamp, 3);
+	graph.add_dependency(branch, first);
+	graph.add_dependency(group, first);
+	graph.add_dependency(join, branch);
+	graph.add_dependency(join, group);
+	graph.add_dependency(last, join);
+
+	for (int run = 0; run < 100; run++) {
+		tester.clock.set(0);
+		WorkerThreadPool::get_singleton()->submit_task_graph(&graph, run % 2);
+		WorkerThreadPool::get_singleton()->wait_for_task_graph_completion(&graph);
+
+		CHECK(tester.clock.get() == 4 + 64);
+		CHECK(tester.stamps[0] < tester.stamps[1]);
+		CHECK(tester.stamps[1] < tester.stamps[2]);
+		CHECK(tester.stamps[2] < tester.stamps[3]);
+
+		bool group_in_order = true;
+		for (uint32_t group_stamp : tester.group_stamps) {
+			group_in_order &= group_stamp > tester.stamps[0] && group_stamp < tester.stamps[2];
+		}
+		CHECK(group_in_order);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Task graph rejects cycles") {
+	TaskGraphTester tester;
+
+	WorkerThreadPool::TaskGraph graph;
+	WorkerThreadPool::TaskGraph::NodeID a = graph.add_template_task(&tester, &TaskGraphTester::stamp, 0);
+	WorkerThreadPool::TaskGraph::NodeID b = graph.add_template_task(&tester, &TaskGraphTester::stamp, 1);
+	graph.add_dependency(a, b);
+	graph.add_dependency(b, a);
+
+	ERR_PRINT_OFF;
+	WorkerThreadPool::get_singleton()->submit_task_graph(&graph);
+	ERR_PRINT_ON;
+	WorkerThreadPool::get_singleton()->wait_for_task_graph_completion(&graph);
+
+	CHECK(tester.clock.get() == 0);
+}
+
+struct NestedTaskGraphTester {
+	TaskGraphTester tester;
+	WorkerThreadPool::TaskGraph graph;
+
+	NestedTaskGraphTester() {
+		tester.group_stamps.resize(16);
+		WorkerThreadPool::TaskGraph::NodeID first = graph.add_template_task(&tester, &TaskGraphTester::stamp, 0);
+		WorkerThreadPool::TaskGraph::NodeID group = graph.add_template_group_task(&tester, &TaskGraphTester::stamp_element, 0, 16);
+		WorkerThreadPool::TaskGraph::NodeID last = graph.add_template_task(&tester, &TaskGraphTester::stamp, 1);
+		graph.add_dependency(group, first);
+		graph.add_dependency(last, group);
+	}
+
+	void run(void *p_unused) {
+		WorkerThreadPool::get_singleton()->submit_task_graph(&graph, true);
+		WorkerThreadPool::get_singleton()->wait_for_task_graph_completion(&graph);
+	}
+};
+
+TEST_CASE("[WorkerThreadPool] Task graph can be awaited from a pool thread") {
+	// With a single thread, the task waiting for the graph has to run its nodes itself.
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init(1);
+
+	NestedTaskGraphTester nested;
+	for (int run = 0; run < 10; run++) {
+		nested.tester.clock.set(0);
+		WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_template_task(&nested, &NestedTaskGraphTester::run, (void *)nullptr, true);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+
+		CHECK(nested.tester.clock.get() == 2 + 16);
+		CHECK(nested.tester.stamps[1] == 2 + 16);
+	}
+
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init();
+}
+
+TEST_CASE("[WorkerThreadPool] Task graph destroyed while running waits for its nodes") {
+	TaskGraphTester tester;
+	tester.group_stamps.resize(256);
+
+	WorkerThreadPool::TaskGraph *graph = memnew(WorkerThreadPool::TaskGraph);
+	WorkerThreadPool::TaskGraph::NodeID group = graph->add_template_group_task(&tester, &TaskGraphTester::stamp_element, 0, 256);
+	WorkerThreadPool::TaskGraph::NodeID last = graph->add_template_task(&tester, &TaskGraphTester::stamp, 0);
+	graph->add_dependency(last, group);
+
+	WorkerThreadPool::get_singleton()->submit_task_graph(graph);
+	ERR_PRINT_OFF;
+	memdelete(graph);
+	ERR_PRINT_ON;
+
+	CHECK(tester.clock.get() == 256 + 1);
+}
+
 static void static_test_daemon(void *p_arg) {
 	while (!exit.is_set()) {
 		counter[0].add(1);
@@ -0,0 +1,263 @@
+/**************************************************************************/
+/*  test_raster_occlusion_cull.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#ifndef _3D_DISABLED
+
+#include "core/os/os.h"
+#include "servers/rendering/raster_occlusion_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRasterOcclusionCull {
+
+// Drives an occlusion culling implementation through the base interface,
+// so the software rasterizer can be compared against the Embree raycaster.
+struct OcclusionScene {
+	RendererSceneOcclusionCull *occlusion_cull = nullptr;
+	RID scenario = RID::from_uint64(0x7f000001);
+	RID buffer = RID::from_uint64(0x7f000002);
+	LocalVector<RID> occluders;
+	LocalVector<RID> instances;
+
+	Transform3D cam_transform;
+	Projection cam_projection;
+
+	OcclusionScene(RendererSceneOcclusionCull *p_occlusion_cull, const Size2i &p_buffer_size = Size2i(320, 180)) {
+		occlusion_cull = p_occlusion_cull;
+		occlusion_cull->add_scenario(scenario);
+		occlusion_cull->add_buffer(buffer);
+		occlusion_cull->buffer_set_scenario(buffer, scenario);
+		occlusion_cull->buffer_set_size(buffer, p_buffer_size);
+		cam_projection.set_perspective(70, real_t(p_buffer_size.x) / p_buffer_size.y, 0.05, 200);
+	}
+
+	void add_occluder(const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices, const Transform3D &p_xform = Transform3D()) {
+		RID occluder = occlusion_cull->occluder_allocate();
+		occlusion_cull->occluder_initialize(occluder);
+		occlusion_cull->occluder_set_mesh(occluder, p_vertices, p_indices);
+		occluders.push_back(occluder);
+
+		RID instance = RID::from_uint64(0x7f100000 + instances.size());
+		occlusion_cull->scenario_set_instance(scenario, instance, occluder, p_xform, true);
+		instances.push_back(instance);
+	}
+
+	void add_quad(const Vector3 &p_a, const Vector3 &p_b, const Vector3 &p_c, const Vector3 &p_d) {
+		PackedVector3Array vertices = { p_a, p_b, p_c, p_d };
+		add_occluder(vertices, { 0, 1, 2, 0, 2, 3 });
+	}
+
+	void add_box(const AABB &p_aabb) {
+		PackedVector3Array vertices;
+		for (int i = 0; i < 8; i++) {
+			vertices.push_back(p_aabb.get_endpoint(i));
+		}
+		// Winding doesn't matter, occluders are double-sided.
+		add_occluder(vertices, { 0, 1, 3, 0, 3, 2, 4, 6, 7, 4, 7, 5, 0, 4, 5, 0, 5, 1, 2, 3, 7, 2, 7, 6, 0, 2, 6, 0, 6, 4, 1, 5, 7, 1, 7, 3 });
+	}
+
+	void update() {
+		occlusion_cull->buffer_update(buffer, cam_transform, cam_projection, false);
+	}
+
+	bool is_occluded(const AABB &p_aabb) const {
+		const RendererSceneOcclusionCull::HZBuffer *hzb = occlusion_cull->buffer_get_ptr(buffer);
+		const real_t bounds[6] = { p_aabb.position.x, p_aabb.position.y, p_aabb.position.z, p_aabb.position.x + p_aabb.size.x, p_aabb.position.y + p_aabb.size.y, p_aabb.position.z + p_aabb.size.z };
+		uint64_t timeout = 0;
+		return hzb->is_occluded(bounds, cam_transform.origin, cam_transform.affine_inverse(), cam_projection, cam_projection.get_z_near(), timeout);
+	}
+
+	~OcclusionScene() {
+		for (const RID &instance : instances) {
+			occlusion_cull->scenario_remove_instance(scenario, instance);
+		}
+		for (const RID &occluder : occluders) {
+			occlusion_cull->free_occluder(occluder);
+		}
+		occlusion_cull->remove_buffer(buffer);
+		occlusion_cull->remove_scenario(scenario);
+	}
+};
+
+// Creating an implementation makes it the singleton, so restore the one the renderer uses afterwards.
+struct RasterOcclusionCullScope {
+	RendererSceneOcclusionCull *previous = nullptr;
+	bool previous_jitter = false;
+	RasterOcclusionCull *raster = nullptr;
+
+	RasterOcclusionCullScope() {
+		previous = RendererSceneOcclusionCull::get_singleton();
+		previous_jitter = RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled;
+		RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = false;
+		raster = memnew(RasterOcclusionCull);
+	}
+
+	~RasterOcclusionCullScope() {
+		memdelete(raster);
+		RendererSceneOcclusionCull::set_singleton(previous);
+		RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = previous_jitter;
+	}
+};
+
+// A city block grid of buildings, seen from street level.
+static void build_city(OcclusionScene &p_scene) {
+	for (int x = -10; x < 10; x++) {
+		for (int z = 1; z <= 20; z++) {
+			const real_t height = 4 + ((x * 7 + z * 13) & 7) * 2;
+			p_scene.add_box(AABB(Vector3(x * 10 + 2, -2, -z * 10), Vector3(6, height, 6)));
+		}
+	}
+	p_scene.cam_transform = Transform3D(Basis(), Vector3(0, 0, 5));
+}
+
+static void city_queries(LocalVector<AABB> &r_queries) {
+	for (int x = -40; x < 40; x++) {
+		for (int z = 0; z < 80; z++) {
+			r_queries.push_back(AABB(Vector3(x * 2.5, -1, -z * 2.5), Vector3(1, 1, 1)));
+		}
+	}
+}
+
+TEST_CASE("[SceneTree][RasterOcclusionCull] Occluders hide what is behind them") {
+	RasterOcclusionCullScope scope;
+	OcclusionScene scene(scope.raster);
+
+	// A wall in front of the camera.
+	scene.add_quad(Vector3(-5, -5, -10), Vector3(5, -5, -10), Vector3(5, 5, -10), Vector3(-5, 5, -10));
+	scene.update();
+
+	CHECK(scene.is_occluded(AABB(Vector3(-1, -1, -21), Vector3(2, 2, 2))));
+	CHECK_FALSE(scene.is_occluded(AABB(Vector3(-1, -1, -6), Vector3(2, 2, 2))));
+	CHECK_FALSE(scene.is_occluded(AABB(Vector3(14, -1, -21), Vector3(2, 2, 2))));
+	// Partially hidden.
+	CHECK_FALSE(scene.is_occluded(AABB(Vector3(6, -1, -21), Vector3(8, 2, 2))));
+
+	SUBCASE("Occluders crossing the near plane are clipped") {
+		// A side wall running from behind the camera into the distance.
+		scene.add_quad(Vector3(-1, -10, 1), Vector3(-1, -10, -50), Vector3(-1, 10, -50), Vector3(-1, 10, 1));
+		scene.update();
+
+		CHECK(scene.is_occluded(AABB(Vector3(-6, -0.5, -10.5), Vector3(1, 1, 1))));
+		CHECK_FALSE(scene.is_occluded(AABB(Vector3(2.5, -0.5, -10.5), Vector3(1, 1, 1))));
+	}
+
+	SUBCASE("Disabled occluders don't hide anything") {
+		scene.occlusion_cull->scenario_set_instance(scene.scenario, scene.instances[0], scene.occluders[0], Transform3D(), false);
+		scene.update();
+
+		CHECK_FALSE(scene.is_occluded(AABB(Vector3(-1, -1, -21), Vector3(2, 2, 2))));
+	}
+
+	SUBCASE("Out of range indices are ignored") {
+		ERR_PRINT_OFF;
+		scene.add_occluder({ Vector3(-100, -100, -15), Vector3(100, -100, -15), Vector3(0, 100, -15) }, { 0, 1, 7 });
+		scene.update();
+		ERR_PRINT_ON;
+
+		CHECK_FALSE(scene.is_occluded(AABB(Vector3(14, -1, -21), Vector3(2, 2, 2))));
+	}
+}
+
+TEST_CASE("[SceneTree][RasterOcclusionCull][Benchmark] Against the active implementation" * doctest::skip(true)) {
+	// Embree when the raycast module is built, otherwise the renderer's own software rasterizer.
+	RendererSceneOcclusionCull *active = RendererSceneOcclusionCull::get_singleton();
+
+	RasterOcclusionCullScope scope;
+	const uint32_t frames = 20;
+
+	LocalVector<AABB> queries;
+	city_queries(queries);
+
+	OcclusionScene raster_scene(scope.raster);
+	build_city(raster_scene);
+
+	uint64_t raster_usec = 0;
+	for (uint32_t frame = 0; frame < frames; frame++) {
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		raster_scene.update();
+		raster_usec += OS::get_singleton()->get_ticks_usec() - begin;
+	}
+
+	LocalVector<bool> raster_occluded;
+	uint32_t raster_occluded_count = 0;
+	for (const AABB &query : queries) {
+		raster_occluded.push_back(raster_scene.is_occluded(query));
+		raster_occluded_count += raster_occluded[raster_occluded.size() - 1];
+	}
+
+	// Most of the city is hidden behind the first rows of buildings.
+	CHECK(raster_occluded_count > queries.size() / 4);
+
+	MESSAGE(vformat("Software rasterizer: %.2f ms per buffer update, %d of %d boxes occluded.", double(raster_usec) / frames / 1000.0, raster_occluded_count, queries.size()));
+
+	if (!active || dynamic_cast<RasterOcclusionCull *>(active)) {
+		return;
+	}
+
+	{
+		OcclusionScene active_scene(active);
+		build_city(active_scene);
+
+		// Embree commits the scene in the background, wait until the occluders show up.
+		const AABB hidden(Vector3(-1, -1, -150), Vector3(2, 2, 2));
+		for (int i = 0; i < 200; i++) {
+			active_scene.update();
+			if (active_scene.is_occluded(hidden)) {
+				break;
+			}
+			OS::get_singleton()->delay_usec(10000);
+		}
+
+		uint64_t active_usec = 0;
+		for (uint32_t frame = 0; frame < frames; frame++) {
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			active_scene.update();
+			active_usec += OS::get_singleton()->get_ticks_usec() - begin;
+		}
+
+		uint32_t agreement = 0;
+		uint32_t active_occluded_count = 0;
+		for (uint32_t i = 0; i < queries.size(); i++) {
+			const bool occluded = active_scene.is_occluded(queries[i]);
+			active_occluded_count += occluded;
+			agreement += occluded == raster_occluded[i];
+		}
+
+		CHECK_MESSAGE(agreement >= queries.size() * 9 / 10, "The software rasterizer should mostly agree with the raycaster.");
+
+		MESSAGE(vformat("Raycaster: %.2f ms per buffer update, %d of %d boxes occluded, %.1f%% agreement.", double(active_usec) / frames / 1000.0, active_occluded_count, queries.size(), 100.0 * agreement / queries.size()));
+	}
+}
+
+} // namespace TestRasterOcclusionCull
+
+#endif // _3D_DISABLED
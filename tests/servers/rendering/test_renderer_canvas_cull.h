@@ -0,0 +1,265 @@
+/**************************************************************************/
+/*  test_renderer_canvas_cull.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/os.h"
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererCanvasCull {
+
+static const Size2 ITEM_SIZE = Size2(10, 10);
+
+// Top level items, each with a row of children spaced horizontally.
+struct CanvasRows {
+	RID canvas;
+	LocalVector<RID> rows;
+	LocalVector<RID> items;
+	Rect2 clip_rect;
+
+	CanvasRows(uint32_t p_rows, uint32_t p_items_per_row, real_t p_spacing, const Rect2 &p_clip_rect) {
+		RenderingServer *rs = RenderingServer::get_singleton();
+		clip_rect = p_clip_rect;
+		canvas = rs->canvas_create();
+		for (uint32_t i = 0; i < p_rows; i++) {
+			RID row = rs->canvas_item_create();
+			rs->canvas_item_set_parent(row, canvas);
+			rs->canvas_item_set_transform(row, Transform2D(0, Vector2(0, i * 20)));
+			rows.push_back(row);
+
+			for (uint32_t j = 0; j < p_items_per_row; j++) {
+				RID item = rs->canvas_item_create();
+				rs->canvas_item_set_parent(item, row);
+				rs->canvas_item_set_transform(item, Transform2D(0, Vector2(j * p_spacing, 0)));
+				rs->canvas_item_add_rect(item, Rect2(Point2(), ITEM_SIZE), Color(1, 1, 1));
+				rs->canvas_item_set_visibility_notifier(item, true, Rect2(Point2(), ITEM_SIZE), Callable(), Callable());
+				items.push_back(item);
+			}
+		}
+	}
+
+	~CanvasRows() {
+		RenderingServer *rs = RenderingServer::get_singleton();
+		for (const RID &item : items) {
+			rs->free(item);
+		}
+		for (const RID &row : rows) {
+			rs->free(row);
+		}
+		rs->free(canvas);
+	}
+
+	static RendererCanvasCull::Item *get_item(const RID &p_item) {
+		return RSG::canvas->canvas_item_owner.get_or_null(p_item);
+	}
+
+	static Rect2 get_global_rect(const RID &p_item) {
+		const RendererCanvasCull::Item *item = get_item(p_item);
+		Transform2D xform = item->xform_curr;
+		if (item->parent_item) {
+			xform = item->parent_item->xform_curr * xform;
+		}
+		return xform.xform(Rect2(Point2(), ITEM_SIZE));
+	}
+
+	// Culls one frame and returns the items that were found visible.
+	LocalVector<RID> cull() {
+		RSG::rasterizer->begin_frame(0.0);
+		RSG::canvas->render_canvas(RID(), RSG::canvas->canvas_owner.get_or_null(canvas), Transform2D(), nullptr, nullptr, clip_rect, RS::CANVAS_ITEM_TEXTURE_FILTER_LINEAR, RS::CANVAS_ITEM_TEXTURE_REPEAT_DISABLED, false, false, 0xFFFFFFFF);
+		RSG::canvas->update_visibility_notifiers();
+
+		LocalVector<RID> visible;
+		for (const RID &item : items) {
+			if (get_item(item)->visibility_notifier->visible_in_frame == RSG::rasterizer->get_frame_number()) {
+				visible.push_back(item);
+			}
+		}
+		return visible;
+	}
+
+	// Checks that exactly the items in view were culled as visible, and linked for drawing in tree order.
+	void check_cull() {
+		LocalVector<RID> visible = cull();
+
+		LocalVector<RID> expected;
+		for (const RID &item : items) {
+			if (get_item(item)->visible && get_item(item)->parent_item->visible && clip_rect.intersects(get_global_rect(item), true)) {
+				expected.push_back(item);
+			}
+		}
+
+		REQUIRE(visible.size() == expected.size());
+		for (uint32_t i = 0; i < expected.size(); i++) {
+			CHECK(visible[i] == expected[i]);
+		}
+
+		// All items share the same Z index, so they form a single list.
+		const RendererCanvasRender::Item *next = expected.is_empty() ? nullptr : get_item(expected[0]);
+		for (uint32_t i = 0; i < expected.size(); i++) {
+			CHECK(next == get_item(expected[i]));
+			if (!next) {
+				break;
+			}
+			next = next->next;
+		}
+		CHECK(next == nullptr);
+	}
+};
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Culling matches the items in view") {
+	// Below and above the default threaded culling threshold.
+	const uint32_t rows[] = { 2, 16 };
+
+	for (const uint32_t row_count : rows) {
+		RenderingServer *rs = RenderingServer::get_singleton();
+		CanvasRows canvas(row_count, 100, 30, Rect2(0, 0, 1000, 1000));
+
+		// Subtree bounds are only cached after a frame without changes.
+		for (int i = 0; i < 4; i++) {
+			canvas.check_cull();
+		}
+
+		SUBCASE("Moving a top level item") {
+			rs->canvas_item_set_transform(canvas.rows[0], Transform2D(0, Vector2(-1500, 0)));
+			canvas.check_cull();
+			rs->canvas_item_set_transform(canvas.rows[1], Transform2D(0, Vector2(5000, 20)));
+			for (int i = 0; i < 4; i++) {
+				canvas.check_cull();
+			}
+			rs->canvas_item_set_transform(canvas.rows[0], Transform2D(0, Vector2(0, 0)));
+			for (int i = 0; i < 4; i++) {
+				canvas.check_cull();
+			}
+		}
+
+		SUBCASE("Moving an item into view of a cached subtree") {
+			rs->canvas_item_set_transform(canvas.rows[1], Transform2D(0, Vector2(5000, 20)));
+			for (int i = 0; i < 4; i++) {
+				canvas.check_cull();
+			}
+			rs->canvas_item_set_transform(canvas.items[100 + 99], Transform2D(0, Vector2(-4500, 0)));
+			canvas.check_cull();
+			canvas.check_cull();
+		}
+
+		SUBCASE("Growing an item of a cached subtree") {
+			rs->canvas_item_set_transform(canvas.rows[1], Transform2D(0, Vector2(1200, 20)));
+			for (int i = 0; i < 4; i++) {
+				canvas.check_cull();
+			}
+			rs->canvas_item_add_rect(canvas.items[100], Rect2(-500, 0, 10, 10), Color(1, 1, 1));
+			bool found = false;
+			for (const RID &item : canvas.cull()) {
+				found = found || item == canvas.items[100];
+			}
+			CHECK(found);
+		}
+
+		SUBCASE("Hiding and showing items") {
+			rs->canvas_item_set_visible(canvas.items[0], false);
+			rs->canvas_item_set_visible(canvas.rows[1], false);
+			for (int i = 0; i < 4; i++) {
+				canvas.check_cull();
+			}
+			rs->canvas_item_set_visible(canvas.items[0], true);
+			rs->canvas_item_set_visible(canvas.rows[1], true);
+			for (int i = 0; i < 4; i++) {
+				canvas.check_cull();
+			}
+		}
+	}
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Threaded culling of items with dirty multimesh rects") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	// Above the default threaded culling threshold.
+	CanvasRows canvas(16, 100, 30, Rect2(0, 0, 1000, 1000));
+
+	RID mesh = rs->mesh_create();
+	RID multimesh = rs->multimesh_create();
+	rs->multimesh_set_mesh(multimesh, mesh);
+	rs->multimesh_allocate_data(multimesh, 4, RS::MULTIMESH_TRANSFORM_2D);
+
+	for (int frame = 0; frame < 4; frame++) {
+		// Redrawing leaves the rects dirty, so each row recomputes them from the multimesh storage.
+		for (uint32_t i = 0; i < canvas.rows.size(); i++) {
+			const RID &item = canvas.items[i * 100 + frame];
+			rs->canvas_item_clear(item);
+			rs->canvas_item_add_rect(item, Rect2(Point2(), ITEM_SIZE), Color(1, 1, 1));
+			rs->canvas_item_add_multimesh(item, multimesh);
+			CHECK(CanvasRows::get_item(item)->rect_dirty);
+		}
+		rs->multimesh_instance_set_transform_2d(multimesh, frame, Transform2D(0, Vector2(frame, 0)));
+
+		canvas.check_cull();
+		for (uint32_t i = 0; i < canvas.rows.size(); i++) {
+			CHECK_FALSE(CanvasRows::get_item(canvas.items[i * 100 + frame])->rect_dirty);
+		}
+	}
+
+	for (const RID &item : canvas.items) {
+		rs->canvas_item_clear(item);
+	}
+	rs->free(multimesh);
+	rs->free(mesh);
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull][Benchmark] Culling" * doctest::skip(true)) {
+	// About 60,000 items over a world 30 times wider than the view.
+	const uint32_t row_count = 64;
+	const uint32_t items_per_row = 960;
+	CanvasRows canvas(row_count, items_per_row, 30, Rect2(0, 0, 950, 1280));
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	const uint32_t visible = canvas.cull().size();
+	const uint64_t first_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	CHECK(visible == row_count * 32);
+
+	// Once the subtrees' bounds are cached, culling skips the rows that are out of view.
+	for (int i = 0; i < 2; i++) {
+		canvas.cull();
+	}
+
+	const int frames = 20;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < frames; i++) {
+		// A moving item keeps its row changing, so that row is culled item by item.
+		RenderingServer::get_singleton()->canvas_item_set_transform(canvas.items[i], Transform2D(0, Vector2(i, 0)));
+		canvas.cull();
+	}
+	const uint64_t cached_usec = (OS::get_singleton()->get_ticks_usec() - begin) / frames;
+
+	MESSAGE(vformat("Culling %d canvas items: %.2f ms on the first frame, %.2f ms per frame with cached subtree bounds.", canvas.items.size() + canvas.rows.size(), first_usec / 1000.0, cached_usec / 1000.0));
+}
+
+} // namespace TestRendererCanvasCull
@@ -0,0 +1,190 @@
+/**************************************************************************/
+/*  test_renderer_scene_cull.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#ifndef _3D_DISABLED
+
+#include "core/math/geometry_3d.h"
+#include "core/os/os.h"
+#include "servers/rendering/renderer_scene_cull.h"
+#include "servers/rendering_server.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererSceneCull {
+
+struct MovingInstances {
+	RID scenario;
+	RID mesh;
+	LocalVector<RID> instances;
+
+	MovingInstances(uint32_t p_count) {
+		RenderingServer *rs = RenderingServer::get_singleton();
+		scenario = rs->scenario_create();
+		mesh = rs->mesh_create();
+		instances.resize(p_count);
+		for (uint32_t i = 0; i < p_count; i++) {
+			instances[i] = rs->instance_create2(mesh, scenario);
+			rs->instance_set_custom_aabb(instances[i], AABB(Vector3(-0.5, -0.5, -0.5), Vector3(1, 1, 1)));
+			rs->instance_attach_object_instance_id(instances[i], ObjectID(uint64_t(i + 1)));
+		}
+		move(Vector3());
+	}
+
+	// Instances are laid out along the X axis, three units apart.
+	void move(const Vector3 &p_offset) {
+		RenderingServer *rs = RenderingServer::get_singleton();
+		for (uint32_t i = 0; i < instances.size(); i++) {
+			rs->instance_set_transform(instances[i], Transform3D(Basis(), p_offset + Vector3(i * 3, 0, 0)));
+		}
+	}
+
+	int count_in(const Vector3 &p_offset) const {
+		const AABB area(p_offset + Vector3(-1, -1, -1), Vector3(instances.size() * 3, 2, 2));
+		return RenderingServer::get_singleton()->instances_cull_aabb(area, scenario).size();
+	}
+
+	~MovingInstances() {
+		RenderingServer *rs = RenderingServer::get_singleton();
+		for (const RID &instance : instances) {
+			rs->free(instance);
+		}
+		rs->free(mesh);
+		rs->free(scenario);
+	}
+};
+
+TEST_CASE("[SceneTree][RendererSceneCull] Moved instances are indexed at their new location") {
+	// Below and above the default threaded update threshold.
+	const uint32_t counts[] = { 10, 4000 };
+
+	for (const uint32_t count : counts) {
+		MovingInstances moving(count);
+		const Vector3 offset(0, 100, 0);
+
+		CHECK(moving.count_in(Vector3()) == int(count));
+		CHECK(moving.count_in(offset) == 0);
+
+		moving.move(offset);
+		CHECK(moving.count_in(Vector3()) == 0);
+		CHECK(moving.count_in(offset) == int(count));
+
+		// Small moves are absorbed by quantized bounds, but must still be found.
+		moving.move(offset + Vector3(0, 0.25, 0));
+		CHECK(moving.count_in(offset + Vector3(0, 0.25, 0)) == int(count));
+	}
+}
+
+TEST_CASE("[SceneTree][RendererSceneCull] Parallel and serial shadow culling find the same casters") {
+	RendererSceneCull *scene_cull = RendererSceneCull::singleton;
+	MovingInstances moving(400);
+	// Flushes the pending instance updates, so the casters are indexed.
+	moving.count_in(Vector3());
+	scene_cull->update_dirty_instances();
+
+	RendererSceneCull::Scenario *scenario = scene_cull->scenario_owner.get_or_null(moving.scenario);
+	REQUIRE(scenario != nullptr);
+
+	// Overlapping boxes along the row of instances, one per pass.
+	const uint32_t pass_count = 6;
+	for (uint32_t i = 0; i < pass_count; i++) {
+		RendererSceneCull::ShadowCullPass &pass = scene_cull->shadow_cull_passes[i];
+		const Transform3D box_transform(Basis(), Vector3(i * 100.0, 0, 0));
+		pass.planes = Geometry3D::build_box_planes(Vector3(80, 2, 2));
+		for (Plane &plane : pass.planes) {
+			plane = box_transform.xform(plane);
+		}
+		pass.caster_mask = 0xFFFFFFFF;
+		scene_cull->render_shadow_data[i].instances.clear();
+	}
+
+	// Threaded when the worker thread pool has several threads.
+	scene_cull->_cull_shadow_passes(scenario, 0xFFFFFFFF, 0, pass_count);
+
+	LocalVector<LocalVector<RenderGeometryInstance *>> parallel_instances;
+	parallel_instances.resize(pass_count);
+	for (uint32_t i = 0; i < pass_count; i++) {
+		PagedArray<RenderGeometryInstance *> &instances = scene_cull->render_shadow_data[i].instances;
+		for (uint32_t j = 0; j < instances.size(); j++) {
+			parallel_instances[i].push_back(instances[j]);
+		}
+		instances.clear();
+	}
+
+	RendererSceneCull::ShadowCullData cull_data;
+	cull_data.scenario = scenario;
+	cull_data.visible_layers = 0xFFFFFFFF;
+	for (uint32_t i = 0; i < pass_count; i++) {
+		scene_cull->_shadow_cull_threaded(i, &cull_data);
+	}
+
+	for (uint32_t i = 0; i < pass_count; i++) {
+		RendererSceneCull::ShadowCullPass &pass = scene_cull->shadow_cull_passes[i];
+		PagedArray<RenderGeometryInstance *> &instances = scene_cull->render_shadow_data[i].instances;
+		CHECK(parallel_instances[i].size() > 0);
+		REQUIRE(instances.size() == parallel_instances[i].size());
+		for (uint32_t j = 0; j < instances.size(); j++) {
+			CHECK(instances[j] == parallel_instances[i][j]);
+		}
+
+		instances.clear();
+		pass.planes.clear();
+		pass.cull_result.clear();
+		pass.mesh_instance_updates.clear();
+		pass.animated_material_found = false;
+	}
+}
+
+TEST_CASE("[SceneTree][RendererSceneCull][Benchmark] Moving instances" * doctest::skip(true)) {
+	const uint32_t count = 20000;
+	const uint32_t frames = 30;
+
+	MovingInstances moving(count);
+	moving.count_in(Vector3());
+
+	uint64_t update_usec = 0;
+	for (uint32_t frame = 1; frame <= frames; frame++) {
+		moving.move(Vector3(0, frame * 0.1, 0));
+
+		// Culling flushes the pending instance updates first.
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		RenderingServer::get_singleton()->instances_cull_aabb(AABB(Vector3(0, -1000, 0), Vector3(1, 1, 1)), moving.scenario);
+		update_usec += OS::get_singleton()->get_ticks_usec() - begin;
+	}
+
+	CHECK(moving.count_in(Vector3(0, frames * 0.1, 0)) == int(count));
+
+	MESSAGE(vformat("Moving %d instances: %.2f million instance updates per second.", count, double(count) * frames / MAX(update_usec, uint64_t(1))));
+}
+
+} // namespace TestRendererSceneCull
+
+#endif // _3D_DISABLED
@@ -0,0 +1,169 @@
+/**************************************************************************/
+/*  test_shader_compiler.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "servers/rendering/shader_compiler.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestShaderCompiler {
+
+struct CanvasActions {
+	int blend_mode = 0;
+	bool unshaded = false;
+	bool uses_uv = false;
+	bool writes_color = false;
+	// Not used by the test shader, so these must stay false.
+	bool uses_vertex = false;
+	bool writes_normal_map = false;
+	HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+	ShaderCompiler::IdentifierActions actions;
+
+	CanvasActions() {
+		actions.entry_point_stages["fragment"] = ShaderCompiler::STAGE_FRAGMENT;
+		actions.render_mode_values["blend_add"] = Pair<int *, int>(&blend_mode, 1);
+		actions.render_mode_flags["unshaded"] = &unshaded;
+		actions.usage_flag_pointers["UV"] = &uses_uv;
+		actions.usage_flag_pointers["VERTEX"] = &uses_vertex;
+		actions.write_flag_pointers["COLOR"] = &writes_color;
+		actions.write_flag_pointers["NORMAL_MAP"] = &writes_normal_map;
+		actions.uniforms = &uniforms;
+	}
+};
+
+TEST_CASE("[SceneTree][ShaderCompiler] Output loaded from the cache matches a fresh compilation") {
+	const String code = R"(
+shader_type canvas_item;
+render_mode blend_add, unshaded;
+
+uniform vec4 tint : source_color = vec4(1.0, 0.5, 0.25, 1.0);
+uniform sampler2D tex : filter_nearest;
+
+void fragment() {
+	COLOR = texture(tex, UV) * tint;
+}
+)";
+
+	const String previous_cache_dir = ShaderCompiler::get_cache_user_dir();
+	const String cache_dir = TestUtils::get_temp_path("shader_compiler_cache");
+	DirAccess::make_dir_recursive_absolute(cache_dir);
+	Ref<DirAccess> da = DirAccess::open(cache_dir);
+	REQUIRE(da.is_valid());
+	for (const String &file : da->get_files()) {
+		da->remove(file);
+	}
+	ShaderCompiler::set_cache_user_dir(cache_dir);
+
+	ShaderCompiler compiler;
+	compiler.initialize(ShaderCompiler::DefaultIdentifierActions());
+
+	CanvasActions compiled;
+	ShaderCompiler::GeneratedCode compiled_code;
+	CHECK(compiler.compile(RS::SHADER_CANVAS_ITEM, code, &compiled.actions, "", compiled_code) == OK);
+	CHECK_MESSAGE(da->get_files().size() == 1, "The output should be written to the cache.");
+
+	// Plant an extra define in the cache entry, so the output can only have come from the cache.
+	const String planted_define = "#define PLANTED_BY_TEST\n";
+	const String cache_path = cache_dir.path_join(da->get_files()[0]);
+	const Vector<uint8_t> entry = FileAccess::get_file_as_bytes(cache_path);
+	REQUIRE(entry.size() > 16);
+	{
+		// Header, version and varying count, then the defines.
+		const uint32_t define_count = entry[12] | (entry[13] << 8) | (entry[14] << 16) | (uint32_t(entry[15]) << 24);
+		Ref<FileAccess> f = FileAccess::open(cache_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(entry.ptr(), 12);
+		f->store_32(define_count + 1);
+		f->store_pascal_string(planted_define);
+		f->store_buffer(entry.ptr() + 16, entry.size() - 16);
+	}
+
+	CanvasActions cached;
+	ShaderCompiler::GeneratedCode cached_code;
+	CHECK(compiler.compile(RS::SHADER_CANVAS_ITEM, code, &cached.actions, "", cached_code) == OK);
+	CHECK(da->get_files().size() == 1);
+
+	ShaderCompiler::set_cache_user_dir(previous_cache_dir);
+
+	CHECK(compiled.blend_mode == 1);
+	CHECK(compiled.unshaded);
+	CHECK(compiled.uses_uv);
+	CHECK(compiled.writes_color);
+	CHECK_FALSE(compiled.uses_vertex);
+	CHECK_FALSE(compiled.writes_normal_map);
+	CHECK_FALSE(cached.uses_vertex);
+	CHECK_FALSE(cached.writes_normal_map);
+	CHECK(cached.blend_mode == compiled.blend_mode);
+	CHECK(cached.unshaded == compiled.unshaded);
+	CHECK(cached.uses_uv == compiled.uses_uv);
+	CHECK(cached.writes_color == compiled.writes_color);
+
+	REQUIRE(cached.uniforms.size() == compiled.uniforms.size());
+	for (const KeyValue<StringName, ShaderLanguage::ShaderNode::Uniform> &E : compiled.uniforms) {
+		REQUIRE(cached.uniforms.has(E.key));
+		const ShaderLanguage::ShaderNode::Uniform &uniform = cached.uniforms[E.key];
+		CHECK(uniform.type == E.value.type);
+		CHECK(uniform.order == E.value.order);
+		CHECK(uniform.texture_order == E.value.texture_order);
+		CHECK(uniform.hint == E.value.hint);
+		CHECK(uniform.filter == E.value.filter);
+		REQUIRE(uniform.default_value.size() == E.value.default_value.size());
+		for (int i = 0; i < uniform.default_value.size(); i++) {
+			CHECK(uniform.default_value[i].real == E.value.default_value[i].real);
+		}
+	}
+
+	REQUIRE(cached_code.defines.size() == compiled_code.defines.size() + 1);
+	CHECK(cached_code.defines[0] == planted_define);
+	for (int i = 0; i < compiled_code.defines.size(); i++) {
+		CHECK(cached_code.defines[i + 1] == compiled_code.defines[i]);
+	}
+	CHECK(cached_code.uniforms == compiled_code.uniforms);
+	CHECK(cached_code.uniform_offsets == compiled_code.uniform_offsets);
+	CHECK(cached_code.uniform_total_size == compiled_code.uniform_total_size);
+	CHECK(cached_code.stage_globals[ShaderCompiler::STAGE_FRAGMENT] == compiled_code.stage_globals[ShaderCompiler::STAGE_FRAGMENT]);
+	CHECK(cached_code.uses_fragment_time == compiled_code.uses_fragment_time);
+	REQUIRE(cached_code.texture_uniforms.size() == compiled_code.texture_uniforms.size());
+	for (int i = 0; i < cached_code.texture_uniforms.size(); i++) {
+		CHECK(cached_code.texture_uniforms[i].name == compiled_code.texture_uniforms[i].name);
+		CHECK(cached_code.texture_uniforms[i].filter == compiled_code.texture_uniforms[i].filter);
+	}
+	REQUIRE(cached_code.code.size() == compiled_code.code.size());
+	for (const KeyValue<String, String> &E : compiled_code.code) {
+		REQUIRE(cached_code.code.has(E.key));
+		CHECK(cached_code.code[E.key] == E.value);
+	}
+}
+
+} // namespace TestShaderCompiler